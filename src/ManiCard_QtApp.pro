@@ -29,6 +29,7 @@ SOURCES += \
     models/group_box_tree.cpp \
     models/node_rect_data.cpp \
     models/relationship.cpp \
+    models/relationship_bundler.cpp \
     models/relationships_bundle.cpp \
     models/setting_box_data.cpp \
     models/settings/abstract_setting.cpp \
@@ -43,22 +44,38 @@ SOURCES += \
     utilities/action_debouncer.cpp \
     utilities/app_instances_shared_memory.cpp \
     utilities/async_routine.cpp \
+    utilities/background_job.cpp \
 #    utilities/directed_graph.cpp \
+    utilities/edge_router.cpp \
     utilities/fonts_util.cpp \
+    utilities/force_directed_layout.cpp \
     utilities/geometry_util.cpp \
     utilities/json_util.cpp \
     utilities/logging.cpp \
     utilities/map_update.cpp \
+    utilities/markdown_render_cache.cpp \
     utilities/message_box.cpp \
+    utilities/minimap_renderer.cpp \
     utilities/periodic_checker.cpp \
     utilities/periodic_timer.cpp \
+    utilities/png_stream_writer.cpp \
+    utilities/polyline_vicinity.cpp \
+    utilities/rect_tree.cpp \
     utilities/screens_utils.cpp \
     utilities/strings_util.cpp \
+    utilities/symbol.cpp \
+    utilities/tiled_png_export.cpp \
+    utilities/time_slicing.cpp \
+    utilities/trace_recorder.cpp \
+    utilities/vector_drawing.cpp \
+    utilities/viewport_tile_cache.cpp \
     widgets/app_style_sheet.cpp \
+    widgets/board_vector_export.cpp \
     widgets/board_view.cpp \
     widgets/board_view_toolbar.cpp \
     widgets/card_properties_view.cpp \
     widgets/components/board_box_item.cpp \
+    widgets/components/board_minimap.cpp \
     widgets/components/custom_graphics_text_item.cpp \
     widgets/components/custom_list_widget.cpp \
     widgets/components/custom_tab_bar.cpp \
@@ -70,9 +87,13 @@ SOURCES += \
     widgets/components/graphics_scene.cpp \
     widgets/components/group_box.cpp \
     widgets/components/node_rect.cpp \
+    widgets/components/profiled_proxy_widget.cpp \
     widgets/components/property_value_editor.cpp \
+    widgets/components/rendering_profiler_overlay.cpp \
     widgets/components/setting_box.cpp \
     widgets/components/simple_toolbar.cpp \
+    widgets/components/static_text_item.cpp \
+    widgets/components/zoom_preview_overlay.cpp \
     widgets/dialogs/dialog_create_relationship.cpp \
     widgets/dialogs/dialog_options.cpp \
     widgets/dialogs/dialog_set_labels.cpp \
@@ -81,6 +102,7 @@ SOURCES += \
     widgets/dialogs/dialog_workspace_card_colors.cpp \
     widgets/icons.cpp \
     widgets/main_window.cpp \
+    widgets/rendering_profiler.cpp \
     widgets/right_sidebar.cpp \
     widgets/right_sidebar_toolbar.cpp \
     widgets/workspace_frame.cpp \
@@ -102,6 +124,7 @@ HEADERS += \
     file_access/unsaved_update_records_file.h \
     global_constants.h \
     models/board.h \
+    models/board_snapshot.h \
     models/card.h \
     models/custom_data_query.h \
     models/data_view_box_data.h \
@@ -111,6 +134,7 @@ HEADERS += \
     models/node_labels.h \
     models/node_rect_data.h \
     models/relationship.h \
+    models/relationship_bundler.h \
     models/relationships_bundle.h \
     models/setting_box_data.h \
     models/settings/abstract_setting.h \
@@ -125,36 +149,54 @@ HEADERS += \
     utilities/action_debouncer.h \
     utilities/app_instances_shared_memory.h \
     utilities/async_routine.h \
+    utilities/background_job.h \
     utilities/binary_search.h \
 #    utilities/directed_graph.h \
     utilities/colors_util.h \
+    utilities/edge_router.h \
     utilities/filenames_util.h \
+    utilities/flat_map.h \
     utilities/fonts_util.h \
+    utilities/force_directed_layout.h \
     utilities/functor.h \
     utilities/geometry_util.h \
     utilities/hash.h \
     utilities/json_util.h \
+    utilities/label_rules_table.h \
     utilities/lists_vectors_util.h \
     utilities/logging.h \
     utilities/map_update.h \
     utilities/maps_util.h \
     utilities/margins_util.h \
+    utilities/markdown_render_cache.h \
     utilities/message_box.h \
+    utilities/minimap_renderer.h \
     utilities/naming_rules.h \
     utilities/numbers_util.h \
     utilities/periodic_checker.h \
     utilities/periodic_timer.h \
+    utilities/png_stream_writer.h \
+    utilities/polyline_vicinity.h \
+    utilities/rect_tree.h \
     utilities/screens_utils.h \
     utilities/sets_util.h \
     utilities/strings_util.h \
+    utilities/symbol.h \
     utilities/style_sheet_util.h \
+    utilities/tiled_png_export.h \
+    utilities/time_slicing.h \
+    utilities/trace_recorder.h \
     utilities/variables_update_propagator.h \
+    utilities/vector_drawing.h \
+    utilities/viewport_tile_cache.h \
     widgets/app_style_sheet.h \
+    widgets/board_vector_export.h \
     widgets/board_view.h \
     widgets/board_view_toolbar.h \
     widgets/card_properties_view.h \
     widgets/common_types.h \
     widgets/components/board_box_item.h \
+    widgets/components/board_minimap.h \
     widgets/components/custom_graphics_text_item.h \
     widgets/components/custom_list_widget.h \
     widgets/components/custom_tab_bar.h \
@@ -166,9 +208,13 @@ HEADERS += \
     widgets/components/graphics_scene.h \
     widgets/components/group_box.h \
     widgets/components/node_rect.h \
+    widgets/components/profiled_proxy_widget.h \
     widgets/components/property_value_editor.h \
+    widgets/components/rendering_profiler_overlay.h \
     widgets/components/setting_box.h \
     widgets/components/simple_toolbar.h \
+    widgets/components/static_text_item.h \
+    widgets/components/zoom_preview_overlay.h \
     widgets/dialogs/dialog_create_relationship.h \
     widgets/dialogs/dialog_options.h \
     widgets/dialogs/dialog_set_labels.h \
@@ -177,6 +223,7 @@ HEADERS += \
     widgets/dialogs/dialog_workspace_card_colors.h \
     widgets/icons.h \
     widgets/main_window.h \
+    widgets/rendering_profiler.h \
     widgets/right_sidebar.h \
     widgets/right_sidebar_toolbar.h \
     widgets/widgets_constants.h \
@@ -207,4 +254,7 @@ else: unix:!android: target.path = /opt/$${TARGET}/bin
 
 DEFINES += QT_MESSAGELOGCONTEXT
 
+# zlib (which Qt itself is built against), for PngStreamWriter
+LIBS += -lz
+
 #include(boost_dependency.pri)
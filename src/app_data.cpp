@@ -8,7 +8,8 @@ AppData::AppData(PersistedDataAccess *persistedDataAccess_, QObject *parent)
 }
 
 void AppData::queryCards(
-        const QSet<int> &cardIds, std::function<void (bool, const QHash<int, Card> &)> callback,
+        const QSet<int> &cardIds,
+        std::function<void (bool, const QHash<int, CardSnapshot> &)> callback,
         QPointer<QObject> callbackContext) {
     persistedDataAccess->queryCards(cardIds, callback, callbackContext);
 }
@@ -62,6 +63,12 @@ void AppData::getBoardData(
     persistedDataAccess->getBoardData(boardId, callback, callbackContext);
 }
 
+void AppData::getBoardSnapshot(
+        const int boardId, std::function<void (bool, std::optional<BoardSnapshot>)> callback,
+        QPointer<QObject> callbackContext) {
+    persistedDataAccess->getBoardSnapshot(boardId, callback, callbackContext);
+}
+
 void AppData::requestNewBoardId(
         std::function<void (std::optional<int>)> callback, QPointer<QObject> callbackContext) {
     persistedDataAccess->requestNewBoardId(callback, callbackContext);
@@ -97,6 +104,10 @@ QString AppData::getExportOutputDir(){
     return persistedDataAccess->getExportOutputDir();
 }
 
+int AppData::getExportImageMemoryCapMb() {
+    return persistedDataAccess->getExportImageMemoryCapMb();
+}
+
 void AppData::createNewCardWithId(
         const EventSource &/*eventSrc*/, const int cardId, const Card &card) {
     // 1. persist
@@ -116,11 +127,24 @@ void AppData::updateCardProperties(
 }
 
 void AppData::updateCardLabels(
-        const EventSource &/*eventSrc*/, const int cardId, const QSet<QString> &updatedLabels) {
+        const EventSource &eventSrc, const int cardId, const QSet<QString> &updatedLabels) {
     // 1. persist
     persistedDataAccess->updateCardLabels(cardId, updatedLabels);
 
     // 2. update all variables and emit "updated" signals
+    emit cardLabelsUpdated(eventSrc, cardId, updatedLabels);
+}
+
+void AppData::updateCardsLabels(
+        const EventSource &eventSrc, const QHash<int, QSet<QString>> &cardIdToUpdatedLabels) {
+    // 1. persist
+    persistedDataAccess->updateCardsLabels(cardIdToUpdatedLabels);
+
+    // 2. update all variables and emit "updated" signals
+    for (auto it = cardIdToUpdatedLabels.constBegin();
+            it != cardIdToUpdatedLabels.constEnd(); ++it) {
+        emit cardLabelsUpdated(eventSrc, it.key(), it.value());
+    }
 }
 
 void AppData::createNewCustomDataQueryWithId(
@@ -142,11 +166,12 @@ void AppData::updateCustomDataQueryProperties(
     emit customDataQueryUpdated(eventSrc, customDataQueryId, update);
 }
 
-void AppData::createRelationship(const EventSource &/*eventSrc*/, const RelationshipId &id) {
+void AppData::createRelationship(const EventSource &eventSrc, const RelationshipId &id) {
     // 1. persist
     persistedDataAccess->createRelationship(id);
 
     // 2. update all variables and emit "updated" signals
+    emit relationshipCreated(eventSrc, id);
 }
 
 void AppData::updateUserRelationshipTypes(
@@ -222,6 +247,14 @@ void AppData::removeBoard(const EventSource &/*eventSrc*/, const int boardId) {
     // 2. update all variables and emit "updated" signals
 }
 
+void AppData::updateBoardItemsInBulk(
+        const EventSource &/*eventSrc*/, const int boardId, const BoardItemsBulkUpdate &update) {
+    // 1. persist
+    persistedDataAccess->updateBoardItemsInBulk(boardId, update);
+
+    // 2. update all variables and emit "updated" signals
+}
+
 void AppData::updateNodeRectProperties(
         const EventSource &/*eventSrc*/,
         const int boardId, const int cardId, const NodeRectDataUpdate &update) {
@@ -380,6 +413,13 @@ void AppData::updateExportOutputDir(const EventSource &/*eventSrc*/, const QStri
     // 2. update all variables and emit "updated" signals
 }
 
+void AppData::updateExportImageMemoryCapMb(const EventSource &/*eventSrc*/, const int memoryCapMb) {
+    // 1. persist
+    persistedDataAccess->saveExportImageMemoryCapMb(memoryCapMb);
+
+    // 2. update all variables and emit "updated" signals
+}
+
 int AppData::getSingleHighlightedCardId() const {
     return singleHighlightedCardId;
 }
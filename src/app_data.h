@@ -36,7 +36,7 @@ public:
 
     void queryCards(
             const QSet<int> &cardIds,
-            std::function<void (bool, const QHash<int, Card> &)> callback,
+            std::function<void (bool, const QHash<int, CardSnapshot> &)> callback,
             QPointer<QObject> callbackContext) override;
 
     void queryRelationship(
@@ -75,6 +75,11 @@ public:
             std::function<void (bool ok, std::optional<Board> board)> callback,
             QPointer<QObject> callbackContext) override;
 
+    void getBoardSnapshot(
+            const int boardId,
+            std::function<void (bool ok, std::optional<BoardSnapshot> snapshot)> callback,
+            QPointer<QObject> callbackContext) override;
+
     void requestNewBoardId(
             std::function<void (std::optional<int> boardId)> callback,
             QPointer<QObject> callbackContext) override;
@@ -97,6 +102,8 @@ public:
 
     QString getExportOutputDir() override;
 
+    int getExportImageMemoryCapMb() override;
+
     // ---- persisted data: update ----
 
     // If persistence fails, a record of unsaved update is added and a message box is shown.
@@ -110,6 +117,12 @@ public:
     void updateCardLabels(
             const EventSource &eventSrc, const int cardId, const QSet<QString> &updatedLabels);
 
+    //!
+    //! Emits \c cardLabelsUpdated() for each card.
+    //!
+    void updateCardsLabels(
+            const EventSource &eventSrc, const QHash<int, QSet<QString>> &cardIdToUpdatedLabels);
+
     void createNewCustomDataQueryWithId(
             const EventSource &eventSrc,
             const int customDataQueryId, const CustomDataQuery &customDataQuery);
@@ -156,6 +169,9 @@ public:
 
     void removeBoard(const EventSource &eventSrc, const int boardId);
 
+    void updateBoardItemsInBulk(
+            const EventSource &eventSrc, const int boardId, const BoardItemsBulkUpdate &update);
+
     void updateNodeRectProperties(
             const EventSource &eventSrc,
             const int boardId, const int cardId, const NodeRectDataUpdate &update);
@@ -224,6 +240,8 @@ public:
 
     void updateExportOutputDir(const EventSource &eventSrc, const QString &outputDir);
 
+    void updateExportImageMemoryCapMb(const EventSource &eventSrc, const int memoryCapMb);
+
     // ==== non-persisted independent data ====
 
     int getSingleHighlightedCardId() const override; // can return -1
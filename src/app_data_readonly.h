@@ -4,6 +4,7 @@
 #include <QWidget>
 #include "app_event_source.h"
 #include "models/board.h"
+#include "models/board_snapshot.h"
 #include "models/card.h"
 #include "models/custom_data_query.h"
 #include "models/relationship.h"
@@ -20,7 +21,7 @@ public:
 
     virtual void queryCards(
             const QSet<int> &cardIds,
-            std::function<void (bool, const QHash<int, Card> &)> callback,
+            std::function<void (bool, const QHash<int, CardSnapshot> &)> callback,
             QPointer<QObject> callbackContext) = 0;
 
     using RelId = RelationshipId;
@@ -62,6 +63,15 @@ public:
             std::function<void (bool ok, std::optional<Board> board)> callback,
             QPointer<QObject> callbackContext) = 0;
 
+    //!
+    //! Gets the board together with the cards, relationships and custom data queries shown on
+    //! it, in one DB request. \e snapshot will be \e nullopt if the board is not found.
+    //!
+    virtual void getBoardSnapshot(
+            const int boardId,
+            std::function<void (bool ok, std::optional<BoardSnapshot> snapshot)> callback,
+            QPointer<QObject> callbackContext) = 0;
+
     virtual void requestNewBoardId(
             std::function<void (std::optional<int> boardId)> callback,
             QPointer<QObject> callbackContext) = 0;
@@ -84,6 +94,8 @@ public:
 
     virtual QString getExportOutputDir() = 0;
 
+    virtual int getExportImageMemoryCapMb() = 0;
+
     // ==== non-persisted independent data ====
 
     //!
@@ -95,6 +107,9 @@ signals:
     void cardPropertiesUpdated(
             EventSource eventSrc,
             const int cardId, const CardPropertiesUpdate &cardPropertiesUpdate);
+    void cardLabelsUpdated(
+            EventSource eventSrc, const int cardId, const QSet<QString> &updatedLabels);
+    void relationshipCreated(EventSource eventSrc, const RelationshipId &relationshipId);
     void customDataQueryUpdated(
             EventSource eventSrc,
             const int customDataQueryId, const CustomDataQueryUpdate &update);
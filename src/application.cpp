@@ -6,6 +6,7 @@
 #include "services.h"
 #include "utilities/async_routine.h"
 #include "utilities/periodic_checker.h"
+#include "utilities/trace_recorder.h"
 #include "widgets/app_style_sheet.h"
 #include "widgets/main_window.h"
 
@@ -36,41 +37,53 @@ void Application::initialize() {
 }
 
 void Application::loadOnStart() {
-    auto *routine = new AsyncRoutineWithErrorFlag;
-
-    routine->addStep([this, routine]() {
-        // let `mainWindow` prepare to reload and wait until mainWindow->canReload() returns true
-        mainWindow->prepareToReload();
-
-        (new PeriodicChecker)
-                ->setPeriod(10)
-                ->setTimeOut(6000)
-                ->setPredicate([this]() { return mainWindow->canReload(); })
-                ->onPredicateReturnsTrue([routine]() { routine->nextStep(); })
-                ->onTimeOut([routine]() {
-                    qWarning().noquote() << "time-out while awaiting MainWindow::canReload()";
-                    routine->nextStep();
-                })
-                ->setAutoDelete()
-                ->start();
-    }, this);
-
-    routine->addStep([this, routine]() {
-        // show `mainWindow` and wait until it is visible
-        mainWindow->show();
-
-        (new PeriodicChecker)
-                ->setPeriod(10)
-                ->setTimeOut(6000)
-                ->setPredicate([this]() { return mainWindow->isVisible(); })
-                ->onPredicateReturnsTrue([routine]() { routine->nextStep(); })
-                ->onTimeOut([routine]() {
-                    qWarning().noquote() << "time-out while awaiting MainWindow::isVisible()";
-                    routine->nextStep();
-                })
-                ->setAutoDelete()
-                ->start();
-    }, this);
+    auto *routine = new AsyncRoutineWithErrorFlag("Application::loadOnStart");
+
+    // Showing `mainWindow` does not depend on `mainWindow` being ready to reload, so the two
+    // are done in parallel. The window shows its skeleton until data is loaded.
+    routine->addParallelSteps({
+        {[this, routine]() {
+            // let `mainWindow` prepare to reload and wait until mainWindow->canReload() returns
+            // true
+            mainWindow->prepareToReload();
+            if (mainWindow->canReload()) {
+                routine->nextStep();
+                return;
+            }
+
+            (new PeriodicChecker)
+                    ->setPeriod(10)
+                    ->setTimeOut(6000)
+                    ->setPredicate([this]() { return mainWindow->canReload(); })
+                    ->onPredicateReturnsTrue([routine]() { routine->nextStep(); })
+                    ->onTimeOut([routine]() {
+                        qWarning().noquote() << "time-out while awaiting MainWindow::canReload()";
+                        routine->nextStep();
+                    })
+                    ->setAutoDelete()
+                    ->start();
+        }, this},
+        {[this, routine]() {
+            // show `mainWindow` and wait until it is visible
+            mainWindow->show();
+            if (mainWindow->isVisible()) {
+                routine->nextStep();
+                return;
+            }
+
+            (new PeriodicChecker)
+                    ->setPeriod(10)
+                    ->setTimeOut(6000)
+                    ->setPredicate([this]() { return mainWindow->isVisible(); })
+                    ->onPredicateReturnsTrue([routine]() { routine->nextStep(); })
+                    ->onTimeOut([routine]() {
+                        qWarning().noquote() << "time-out while awaiting MainWindow::isVisible()";
+                        routine->nextStep();
+                    })
+                    ->setAutoDelete()
+                    ->start();
+        }, this}
+    });
 
     routine->addStep([this, routine]() {
         // reload
@@ -78,6 +91,13 @@ void Application::loadOnStart() {
         reload([this](bool ok) {
             if (!ok)
                 QMessageBox::warning(mainWindow, " ", "Failed to load data.");
+
+            TraceRecorder::instance()->addInstantEvent("first board loaded", "startup");
+            if (TraceRecorder::instance()->isRecording()) {
+                const bool written = TraceRecorder::instance()->finish();
+                qInfo().noquote()
+                        << (written ? "startup trace written" : "failed to write startup trace");
+            }
         });
     }, this);
 
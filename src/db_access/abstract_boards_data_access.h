@@ -6,6 +6,7 @@
 #include <QPointer>
 #include <QVector>
 #include "models/board.h"
+#include "models/board_snapshot.h"
 #include "models/data_view_box_data.h"
 #include "models/node_rect_data.h"
 #include "models/setting_box_data.h"
@@ -38,6 +39,18 @@ public:
             const int boardId,
             std::function<void (bool ok, std::optional<Board> board)> callback,
             QPointer<QObject> callbackContext) = 0;
+
+    //!
+    //! Gets the board data together with the cards, relationships and custom data queries shown
+    //! on the board, in a single DB query.
+    //! \param boardId
+    //! \param callback: argument \e snapshot will be \e nullopt if the board ID is not found
+    //! \param callbackContext
+    //!
+    virtual void getBoardSnapshot(
+            const int boardId,
+            std::function<void (bool ok, std::optional<BoardSnapshot> snapshot)> callback,
+            QPointer<QObject> callbackContext) = 0;
 };
 
 class AbstractBoardsDataAccess : public AbstractBoardsDataAccessReadOnly
@@ -114,6 +127,16 @@ public:
             const int boardId,
             std::function<void (bool ok)> callback, QPointer<QObject> callbackContext) = 0;
 
+    //!
+    //! Applies the updates & removals of the NodeRects, DataViewBoxes and GroupBoxes of a board
+    //! (and the update of the board's relationship joints) in one transaction. The items to
+    //! update must all exist, otherwise nothing is updated and the result is a failure. This
+    //! operation is atomic.
+    //!
+    virtual void updateBoardItemsInBulk(
+            const int boardId, const BoardItemsBulkUpdate &update,
+            std::function<void (bool ok)> callback, QPointer<QObject> callbackContext) = 0;
+
     // ==== NodeRect ====
 
     //!
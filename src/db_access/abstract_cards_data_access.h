@@ -107,6 +107,14 @@ public:
             const int cardId, const QSet<QString> &updatedLabels,
             std::function<void (bool ok)> callback, QPointer<QObject> callbackContext) = 0;
 
+    //!
+    //! Updates the labels of multiple cards in one transaction. The cards must all exist (if
+    //! any of them does not, none is updated). This operation is atomic and idempotent.
+    //!
+    virtual void updateCardsLabels(
+            const QHash<int, QSet<QString>> &cardIdToUpdatedLabels,
+            std::function<void (bool ok)> callback, QPointer<QObject> callbackContext) = 0;
+
     // ==== relationships ====
 
     //!
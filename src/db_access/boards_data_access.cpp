@@ -8,8 +8,20 @@
 
 using ContinuationContext = AsyncRoutineWithErrorFlag::ContinuationContext;
 using QueryStatement = Neo4jHttpApiClient::QueryStatement;
+using QueryResponse = Neo4jHttpApiClient::QueryResponse;
 using QueryResponseSingleResult = Neo4jHttpApiClient::QueryResponseSingleResult;
 
+namespace {
+//!
+//! Parses the columns of the result of the query in \c BoardsDataAccess::getBoardSnapshot().
+//! \return nullopt if the data have unexpected format
+//!
+std::optional<BoardSnapshot> parseBoardSnapshot(
+        const QJsonObject &boardProperties, const QJsonArray &nodeRects,
+        const QJsonArray &relationships, const QJsonArray &dataViewBoxes,
+        const QJsonArray &groupBoxes, const QJsonArray &settingBoxes);
+}
+
 BoardsDataAccess::BoardsDataAccess(Neo4jHttpApiClient *neo4jHttpApiClient_)
         : AbstractBoardsDataAccess()
         , neo4jHttpApiClient(neo4jHttpApiClient_) {
@@ -377,6 +389,123 @@ void BoardsDataAccess::getBoardData(
     routine->start();
 }
 
+void BoardsDataAccess::getBoardSnapshot(
+        const int boardId, std::function<void (bool, std::optional<BoardSnapshot>)> callback,
+        QPointer<QObject> callbackContext) {
+    Q_ASSERT(callback);
+
+    // Each CALL subquery aggregates, so it yields exactly one row, and the whole query yields
+    // one row if the board exists and no row otherwise.
+    neo4jHttpApiClient->queryDb(
+            QueryStatement {
+                R"!(
+                    MATCH (b:Board {id: $boardId})
+
+                    CALL {
+                        WITH b
+                        MATCH (b)-[:HAS]->(n:NodeRect)-[:SHOWS]->(c:Card)
+                        RETURN collect({
+                            cardId: c.id, nodeRect: n, card: c, labels: labels(c)
+                        }) AS nodeRects
+                    }
+
+                    CALL {
+                        WITH b
+                        MATCH (b)-[:HAS]->(:NodeRect)-[:SHOWS]->(c:Card)
+                        WITH collect(DISTINCT c) AS cards
+                        UNWIND cards AS c0
+                        MATCH (c0)-[r]->(c1:Card)
+                        WHERE c1 IN cards
+                        RETURN collect(DISTINCT {
+                            startCardId: c0.id, endCardId: c1.id, rel: r, relType: type(r)
+                        }) AS relationships
+                    }
+
+                    CALL {
+                        WITH b
+                        MATCH (b)-[:HAS]->(dv:DataViewBox)-[:SHOWS]->(q:CustomDataQuery)
+                        RETURN collect({
+                            customDataQueryId: q.id, dataViewBox: dv, dataQuery: q
+                        }) AS dataViewBoxes
+                    }
+
+                    CALL {
+                        WITH b
+                        MATCH (b)
+                            (()-[:GROUP_ITEM]->(:GroupBox)) {1,}
+                            (g:GroupBox)
+                        WITH DISTINCT g
+                        CALL {
+                            WITH g
+                            OPTIONAL MATCH (g)-[:GROUP_ITEM]->(g1:GroupBox)
+                            RETURN collect(g1.id) AS childGroupBoxes
+                        }
+                        CALL {
+                            WITH g
+                            OPTIONAL MATCH (g)-[:GROUP_ITEM]->(:NodeRect)-[:SHOWS]->(c:Card)
+                            RETURN collect(c.id) AS childCards
+                        }
+                        RETURN collect({
+                            groupBoxId: g.id, groupBox: g,
+                            childGroupBoxes: childGroupBoxes, childCards: childCards
+                        }) AS groupBoxes
+                    }
+
+                    CALL {
+                        WITH b
+                        MATCH (b)-[:HAS]->(s:SettingBox)
+                        RETURN collect(s) AS settingBoxes
+                    }
+
+                    RETURN b AS board, nodeRects, relationships, dataViewBoxes, groupBoxes,
+                           settingBoxes
+                )!",
+                QJsonObject {{"boardId", boardId}}
+            },
+            // callback
+            [callback](const QueryResponseSingleResult &queryResponse) {
+                if (!queryResponse.getResult().has_value()) {
+                    callback(false, std::nullopt);
+                    return;
+                }
+
+                const auto queryResult = queryResponse.getResult().value();
+                if (queryResult.isEmpty()) { // board not found (not an error)
+                    callback(true, std::nullopt);
+                    return;
+                }
+
+                //
+                const auto boardOpt = queryResult.objectValueAt(0, "board");
+                const auto nodeRectsOpt = queryResult.arrayValueAt(0, "nodeRects");
+                const auto relationshipsOpt = queryResult.arrayValueAt(0, "relationships");
+                const auto dataViewBoxesOpt = queryResult.arrayValueAt(0, "dataViewBoxes");
+                const auto groupBoxesOpt = queryResult.arrayValueAt(0, "groupBoxes");
+                const auto settingBoxesOpt = queryResult.arrayValueAt(0, "settingBoxes");
+
+                if (!boardOpt.has_value() || !nodeRectsOpt.has_value()
+                        || !relationshipsOpt.has_value() || !dataViewBoxesOpt.has_value()
+                        || !groupBoxesOpt.has_value() || !settingBoxesOpt.has_value()) {
+                    qWarning().noquote() << "value not found or has unexpected type";
+                    callback(false, std::nullopt);
+                    return;
+                }
+
+                const std::optional<BoardSnapshot> snapshot = parseBoardSnapshot(
+                        boardOpt.value(), nodeRectsOpt.value(), relationshipsOpt.value(),
+                        dataViewBoxesOpt.value(), groupBoxesOpt.value(),
+                        settingBoxesOpt.value());
+                if (!snapshot.has_value()) {
+                    callback(false, std::nullopt);
+                    return;
+                }
+
+                callback(true, snapshot);
+            },
+            callbackContext
+    );
+}
+
 void BoardsDataAccess::createNewWorkspaceWithId(
         const int workspaceId, const Workspace &workspace,
         std::function<void (bool)> callback, QPointer<QObject> callbackContext) {
@@ -808,6 +937,252 @@ void BoardsDataAccess::removeBoard(
     routine->start();
 }
 
+void BoardsDataAccess::updateBoardItemsInBulk(
+        const int boardId, const BoardItemsBulkUpdate &update,
+        std::function<void (bool)> callback, QPointer<QObject> callbackContext) {
+    Q_ASSERT(callback);
+
+    // Each statement returns a count, which is compared with `expectedCounts` (-1: not checked).
+    // The statements are run in one explicit transaction, which is rolled back unless all the
+    // counts match.
+    QVector<QueryStatement> statements;
+    QVector<int> expectedCounts;
+
+    if (!update.cardIdToNodeRectUpdate.isEmpty()) {
+        QJsonArray updates;
+        for (auto it = update.cardIdToNodeRectUpdate.constBegin();
+                it != update.cardIdToNodeRectUpdate.constEnd(); ++it) {
+            updates << QJsonObject {
+                {"cardId", it.key()},
+                {"propertiesMap", it.value().toJson()}
+            };
+        }
+
+        statements << QueryStatement {
+            R"!(
+                MATCH (b:Board {id: $boardId})
+                UNWIND $updates AS u
+                MATCH (b)-[:HAS]->(n:NodeRect)-[:SHOWS]->(:Card {id: u.cardId})
+                SET n += u.propertiesMap
+                RETURN count(n) AS count
+            )!",
+            QJsonObject {
+                {"boardId", boardId},
+                {"updates", updates}
+            }
+        };
+        expectedCounts << updates.count();
+    }
+
+    if (!update.customDataQueryIdToDataViewBoxUpdate.isEmpty()) {
+        QJsonArray updates;
+        for (auto it = update.customDataQueryIdToDataViewBoxUpdate.constBegin();
+                it != update.customDataQueryIdToDataViewBoxUpdate.constEnd(); ++it) {
+            updates << QJsonObject {
+                {"customDataQueryId", it.key()},
+                {"propertiesMap", it.value().toJson()}
+            };
+        }
+
+        statements << QueryStatement {
+            R"!(
+                MATCH (b:Board {id: $boardId})
+                UNWIND $updates AS u
+                MATCH (b)-[:HAS]->(box:DataViewBox)
+                      -[:SHOWS]->(:CustomDataQuery {id: u.customDataQueryId})
+                SET box += u.propertiesMap
+                RETURN count(box) AS count
+            )!",
+            QJsonObject {
+                {"boardId", boardId},
+                {"updates", updates}
+            }
+        };
+        expectedCounts << updates.count();
+    }
+
+    if (!update.groupBoxIdToUpdate.isEmpty()) {
+        QJsonArray updates;
+        for (auto it = update.groupBoxIdToUpdate.constBegin();
+                it != update.groupBoxIdToUpdate.constEnd(); ++it) {
+            updates << QJsonObject {
+                {"groupBoxId", it.key()},
+                {"propertiesMap", it.value().toJson()}
+            };
+        }
+
+        statements << QueryStatement {
+            R"!(
+                UNWIND $updates AS u
+                MATCH (g:GroupBox {id: u.groupBoxId})
+                SET g += u.propertiesMap
+                RETURN count(g) AS count
+            )!",
+            QJsonObject {
+                {"updates", updates}
+            }
+        };
+        expectedCounts << updates.count();
+    }
+
+    if (!update.nodeRectsToRemove.isEmpty()) {
+        statements << QueryStatement {
+            R"!(
+                MATCH (:Board {id: $boardId})-[:HAS]->(n:NodeRect)-[:SHOWS]->(c:Card)
+                WHERE c.id IN $cardIds
+                DETACH DELETE n
+                RETURN count(*) AS count
+            )!",
+            QJsonObject {
+                {"boardId", boardId},
+                {"cardIds", toJsonArray(update.nodeRectsToRemove)}
+            }
+        };
+        expectedCounts << -1;
+    }
+
+    if (!update.dataViewBoxesToRemove.isEmpty()) {
+        statements << QueryStatement {
+            R"!(
+                MATCH (:Board {id: $boardId})-[:HAS]->(box:DataViewBox)
+                      -[:SHOWS]->(q:CustomDataQuery)
+                WHERE q.id IN $customDataQueryIds
+                DETACH DELETE box
+                RETURN count(*) AS count
+            )!",
+            QJsonObject {
+                {"boardId", boardId},
+                {"customDataQueryIds", toJsonArray(update.dataViewBoxesToRemove)}
+            }
+        };
+        expectedCounts << -1;
+    }
+
+    if (update.relIdToJoints.has_value()) {
+        BoardNodePropertiesUpdate propertiesUpdate;
+        propertiesUpdate.relIdToJoints = update.relIdToJoints;
+
+        statements << QueryStatement {
+            R"!(
+                MATCH (b:Board {id: $boardId})
+                SET b += $propertiesMap
+                RETURN count(b) AS count
+            )!",
+            QJsonObject {
+                {"boardId", boardId},
+                {"propertiesMap", propertiesUpdate.toJson()}
+            }
+        };
+        expectedCounts << 1;
+    }
+
+    if (statements.isEmpty()) {
+        invokeAction(callbackContext, [callback]() {
+            callback(true);
+        });
+        return;
+    }
+
+    //
+    class AsyncRoutineWithVars : public AsyncRoutineWithErrorFlag
+    {
+    public:
+        Neo4jTransaction *transaction {nullptr};
+        bool allFound {false};
+    };
+    auto *routine = new AsyncRoutineWithVars;
+
+    routine->addStep([this, routine]() {
+        // 1. open transaction
+        routine->transaction = neo4jHttpApiClient->getTransaction();
+        routine->transaction->open(
+                // callback
+                [routine](bool ok) {
+                    ContinuationContext context(routine);
+                    if (!ok)
+                        context.setErrorFlag();
+                },
+                routine
+        );
+    }, routine);
+
+    routine->addStep([routine, statements, expectedCounts, boardId]() {
+        // 2. run the statements & check the counts
+        routine->transaction->query(
+                statements,
+                // callback
+                [routine, expectedCounts, boardId](bool ok, const QueryResponse &queryResponse) {
+                    ContinuationContext context(routine);
+                    if (!ok) {
+                        context.setErrorFlag();
+                        return;
+                    }
+
+                    const QVector<Neo4jHttpApiClient::QueryResult> results
+                            = queryResponse.getResults();
+                    if (results.count() != expectedCounts.count()) {
+                        context.setErrorFlag();
+                        return;
+                    }
+
+                    routine->allFound = true;
+                    for (int i = 0; i < results.count(); ++i) {
+                        if (expectedCounts.at(i) == -1)
+                            continue;
+                        const int count = results.at(i).isEmpty()
+                                ? 0 : results.at(i).intValueAt(0, "count").value_or(0);
+                        if (count != expectedCounts.at(i))
+                            routine->allFound = false;
+                    }
+                    if (!routine->allFound) {
+                        qWarning().noquote()
+                                << QString("not all items to update are found in board %1")
+                                   .arg(boardId);
+                    }
+                },
+                routine
+        );
+    }, routine);
+
+    routine->addStep([routine]() {
+        // 3. commit transaction, or roll it back if not all items are found (so that nothing
+        //    is updated)
+        if (!routine->allFound) {
+            routine->transaction->rollback(
+                    // callback
+                    [routine](bool /*ok*/) {
+                        // (It's OK if the rollback failed, as the DB eventually closes the
+                        // transaction without committing it.)
+                        ContinuationContext context(routine);
+                        context.setErrorFlag();
+                    },
+                    routine
+            );
+            return;
+        }
+
+        routine->transaction->commit(
+                // callback
+                [routine](bool ok) {
+                    ContinuationContext context(routine);
+                    if (!ok)
+                        context.setErrorFlag();
+                },
+                routine
+        );
+    }, routine);
+
+    routine->addStep([routine, callback]() {
+        // 4. final step
+        ContinuationContext context(routine);
+        routine->transaction->deleteLater();
+        callback(!routine->errorFlag);
+    }, callbackContext);
+
+    //
+    routine->start();
+}
+
 void BoardsDataAccess::updateNodeRectProperties(
         const int boardId, const int cardId, const NodeRectDataUpdate &update,
         std::function<void (bool)> callback, QPointer<QObject> callbackContext) {
@@ -1919,3 +2294,124 @@ void BoardsDataAccess::removeSettingBox(
             callbackContext
     );
 }
+
+//====
+
+namespace {
+std::optional<BoardSnapshot> parseBoardSnapshot(
+        const QJsonObject &boardProperties, const QJsonArray &nodeRects,
+        const QJsonArray &relationships, const QJsonArray &dataViewBoxes,
+        const QJsonArray &groupBoxes, const QJsonArray &settingBoxes) {
+    BoardSnapshot snapshot;
+    Board &board = snapshot.board;
+
+    // board
+    board.updateNodeProperties(boardProperties);
+
+    // NodeRect's and cards
+    for (const QJsonValue &item: nodeRects) {
+        const QJsonValue cardIdValue = item["cardId"];
+        const QJsonValue nodeRectValue = item["nodeRect"];
+        const QJsonValue cardValue = item["card"];
+        const QJsonValue labelsValue = item["labels"];
+        if (!cardIdValue.isDouble() || !nodeRectValue.isObject()
+                || !cardValue.isObject() || !labelsValue.isArray()) {
+            qWarning().noquote() << "NodeRect data not found or has unexpected type";
+            return std::nullopt;
+        }
+
+        const int cardId = cardIdValue.toInt();
+        const std::optional<NodeRectData> nodeRectData
+                = NodeRectData::fromJson(nodeRectValue.toObject());
+        if (!nodeRectData.has_value())
+            return std::nullopt;
+        board.cardIdToNodeRectData.insert(cardId, nodeRectData.value());
+
+        snapshot.cards.insert(
+                cardId,
+                std::make_shared<const Card>(
+                    Card()
+                        .addLabels(toStringList(labelsValue.toArray(), ""))
+                        .updateProperties(cardValue.toObject()))
+        );
+    }
+
+    // relationships
+    for (const QJsonValue &item: relationships) {
+        const QJsonValue startCardId = item["startCardId"];
+        const QJsonValue endCardId = item["endCardId"];
+        const QJsonValue relProperties = item["rel"];
+        const QJsonValue relType = item["relType"];
+        if (!startCardId.isDouble() || !endCardId.isDouble()
+                || !relProperties.isObject() || !relType.isString()) {
+            qWarning().noquote() << "relationship data not found or has unexpected type";
+            return std::nullopt;
+        }
+
+        snapshot.relationships.insert(
+                RelationshipId(startCardId.toInt(), endCardId.toInt(), relType.toString()),
+                RelationshipProperties().update(relProperties.toObject())
+        );
+    }
+
+    // DataViewBox's and custom data queries
+    for (const QJsonValue &item: dataViewBoxes) {
+        const QJsonValue customDataQueryIdValue = item["customDataQueryId"];
+        const QJsonValue dataViewBoxValue = item["dataViewBox"];
+        const QJsonValue dataQueryValue = item["dataQuery"];
+        if (!customDataQueryIdValue.isDouble() || !dataViewBoxValue.isObject()
+                || !dataQueryValue.isObject()) {
+            qWarning().noquote() << "DataViewBox data not found or has unexpected type";
+            return std::nullopt;
+        }
+
+        const int customDataQueryId = customDataQueryIdValue.toInt();
+        const std::optional<DataViewBoxData> dataViewBoxData
+                = DataViewBoxData::fromJson(dataViewBoxValue.toObject());
+        if (!dataViewBoxData.has_value())
+            return std::nullopt;
+        board.customDataQueryIdToDataViewBoxData.insert(
+                customDataQueryId, dataViewBoxData.value());
+
+        snapshot.customDataQueries.insert(
+                customDataQueryId, CustomDataQuery::fromJson(dataQueryValue.toObject()));
+    }
+
+    // group-boxes
+    for (const QJsonValue &item: groupBoxes) {
+        const QJsonValue groupBoxIdValue = item["groupBoxId"];
+        const QJsonValue groupBoxValue = item["groupBox"];
+        const QJsonValue childGroupBoxesValue = item["childGroupBoxes"];
+        const QJsonValue childCardsValue = item["childCards"];
+        if (!groupBoxIdValue.isDouble() || !groupBoxValue.isObject()
+                || !childGroupBoxesValue.isArray() || !childCardsValue.isArray()) {
+            qWarning().noquote() << "group-box data not found or has unexpected type";
+            return std::nullopt;
+        }
+
+        GroupBoxData groupBoxData;
+        bool ok = groupBoxData.updateNodeProperties(groupBoxValue.toObject());
+        if (!ok)
+            return std::nullopt;
+        groupBoxData.childGroupBoxes = toIntSet(childGroupBoxesValue.toArray());
+        groupBoxData.childCards = toIntSet(childCardsValue.toArray());
+
+        board.groupBoxIdToData.insert(groupBoxIdValue.toInt(), groupBoxData);
+    }
+
+    // setting-boxes
+    for (const QJsonValue &item: settingBoxes) {
+        if (!item.isObject()) {
+            qWarning().noquote() << "setting-box data has unexpected type";
+            return std::nullopt;
+        }
+
+        const auto settingBoxDataOpt = SettingBoxData::fromJson(item.toObject());
+        if (!settingBoxDataOpt.has_value())
+            return std::nullopt;
+        board.settingBoxesData << settingBoxDataOpt.value();
+    }
+
+    return snapshot;
+}
+} // namespace
@@ -29,6 +29,11 @@ public:
             std::function<void (bool ok, std::optional<Board> board)> callback,
             QPointer<QObject> callbackContext) override;
 
+    void getBoardSnapshot(
+            const int boardId,
+            std::function<void (bool ok, std::optional<BoardSnapshot> snapshot)> callback,
+            QPointer<QObject> callbackContext) override;
+
     // ==== write operations ====
 
     void createNewWorkspaceWithId(
@@ -63,6 +68,10 @@ public:
             const int boardId,
             std::function<void (bool ok)> callback, QPointer<QObject> callbackContext) override;
 
+    void updateBoardItemsInBulk(
+            const int boardId, const BoardItemsBulkUpdate &update,
+            std::function<void (bool ok)> callback, QPointer<QObject> callbackContext) override;
+
     void updateNodeRectProperties(
             const int boardId, const int cardId, const NodeRectDataUpdate &update,
             std::function<void (bool ok)> callback, QPointer<QObject> callbackContext) override;
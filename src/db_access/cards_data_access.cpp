@@ -4,11 +4,13 @@
 #include "utilities/async_routine.h"
 #include "utilities/functor.h"
 #include "utilities/json_util.h"
+#include "utilities/maps_util.h"
 #include "utilities/strings_util.h"
 
 using ContinuationContext = AsyncRoutineWithErrorFlag::ContinuationContext;
 
 using QueryStatement = Neo4jHttpApiClient::QueryStatement;
+using QueryResponse = Neo4jHttpApiClient::QueryResponse;
 using QueryResponseSingleResult = Neo4jHttpApiClient::QueryResponseSingleResult;
 
 CardsDataAccess::CardsDataAccess(Neo4jHttpApiClient *neo4jHttpApiClient)
@@ -173,7 +175,7 @@ void CardsDataAccess::queryRelationship(
                 QJsonObject {
                     {"fromCardId", relationshipId.startCardId},
                     {"toCardId", relationshipId.endCardId},
-                    {"relationshipType", relationshipId.type}
+                    {"relationshipType", relationshipId.type.toString()}
                 }
             },
             // callback:
@@ -750,6 +752,177 @@ void CardsDataAccess::updateCardLabels(
     routine->start();
 }
 
+void CardsDataAccess::updateCardsLabels(
+        const QHash<int, QSet<QString>> &cardIdToUpdatedLabels,
+        std::function<void (bool)> callback, QPointer<QObject> callbackContext) {
+    Q_ASSERT(callback);
+
+    if (cardIdToUpdatedLabels.isEmpty()) {
+        invokeAction(callbackContext, [callback]() {
+            callback(true);
+        });
+        return;
+    }
+
+    class AsyncRoutineWithVars : public AsyncRoutineWithErrorFlag
+    {
+    public:
+        // variables used by the steps of the routine:
+        Neo4jTransaction *transaction {nullptr};
+        QHash<int, QSet<QString>> cardIdToOldLabels; // (labels other than "Card")
+    };
+    auto *routine = new AsyncRoutineWithVars;
+
+    //
+    routine->addStep([this, routine]() {
+        // 1. open transaction
+        routine->transaction = neo4jHttpApiClient->getTransaction();
+        routine->transaction->open(
+                // callback:
+                [routine](bool ok) {
+                    ContinuationContext context(routine);
+                    if (!ok)
+                        context.setErrorFlag();
+                },
+                routine
+        );
+    }, routine);
+
+    routine->addStep([routine, cardIdToUpdatedLabels]() {
+        // 2. query card labels
+        Q_ASSERT(routine->transaction->canQuery());
+
+        routine->transaction->query(
+                QueryStatement {
+                    R"!(
+                        MATCH (c:Card)
+                        WHERE c.id IN $cardIds
+                        RETURN c.id AS id, labels(c) AS labels
+                    )!",
+                    QJsonObject {{"cardIds", toJsonArray(keySet(cardIdToUpdatedLabels))}}
+                },
+                // callback:
+                [routine, cardsCount=cardIdToUpdatedLabels.count()](
+                        bool ok, const QueryResponseSingleResult &queryResponse) {
+                    ContinuationContext context(routine);
+
+                    if (!ok || !queryResponse.getResult().has_value()) {
+                        context.setErrorFlag();
+                        return;
+                    }
+
+                    const auto queryResult = queryResponse.getResult().value();
+                    if (queryResult.rowCount() != cardsCount) {
+                        qWarning().noquote() << QString("not all cards are found");
+                        context.setErrorFlag();
+                        return;
+                    }
+
+                    for (int row = 0; row < queryResult.rowCount(); ++row) {
+                        const std::optional<int> cardId = queryResult.intValueAt(row, "id");
+                        const QJsonValue labelsValue = queryResult.valueAt(row, "labels");
+                        if (!cardId.has_value() || !labelsValue.isArray()) {
+                            qWarning().noquote()
+                                    << QString("\"id\" or \"labels\" value has unexpected type");
+                            context.setErrorFlag();
+                            return;
+                        }
+
+                        QSet<QString> &oldLabels = routine->cardIdToOldLabels[cardId.value()];
+                        const auto labels = toStringList(labelsValue.toArray(), "");
+                        for (const QString &label: labels) {
+                            if (label != NodeLabel::card && !label.isEmpty())
+                                oldLabels << label;
+                        }
+                    }
+                },
+                routine
+        );
+    }, routine);
+
+    routine->addStep([routine, cardIdToUpdatedLabels]() {
+        // 3. add/remove card labels, with one statement for each distinct change
+        using LabelsToAddAndRemove = std::pair<QStringList, QStringList>;
+        QMap<LabelsToAddAndRemove, QJsonArray> changeToCardIds;
+        for (auto it = cardIdToUpdatedLabels.constBegin();
+                it != cardIdToUpdatedLabels.constEnd(); ++it) {
+            const QSet<QString> oldLabels = routine->cardIdToOldLabels.value(it.key());
+            const QSet<QString> labelsToAdd = it.value() - oldLabels;
+            const QSet<QString> labelsToRemove = oldLabels - it.value();
+            if (labelsToAdd.isEmpty() && labelsToRemove.isEmpty())
+                continue;
+
+            QStringList labelsToAddList(labelsToAdd.cbegin(), labelsToAdd.cend());
+            QStringList labelsToRemoveList(labelsToRemove.cbegin(), labelsToRemove.cend());
+            labelsToAddList.sort();
+            labelsToRemoveList.sort();
+            changeToCardIds[{labelsToAddList, labelsToRemoveList}] << it.key();
+        }
+
+        if (changeToCardIds.isEmpty()) {
+            ContinuationContext context(routine);
+            return;
+        }
+
+        QVector<QueryStatement> statements;
+        for (auto it = changeToCardIds.constBegin(); it != changeToCardIds.constEnd(); ++it) {
+            const QStringList &labelsToAdd = it.key().first;
+            const QStringList &labelsToRemove = it.key().second;
+
+            const QString setLabelsClause = labelsToAdd.isEmpty()
+                    ? "" : QString("SET c:%1").arg(labelsToAdd.join(":"));
+            const QString removeLabelsClause = labelsToRemove.isEmpty()
+                    ? "" : QString("REMOVE c:%1").arg(labelsToRemove.join(":"));
+
+            statements << QueryStatement {
+                QString(R"!(
+                    MATCH (c:Card)
+                    WHERE c.id IN $cardIds
+                    #set-labels-clause#
+                    #remove-labels-clause#
+                    RETURN count(c) AS count
+                )!")
+                    .replace("#set-labels-clause#", setLabelsClause)
+                    .replace("#remove-labels-clause#", removeLabelsClause),
+                QJsonObject {{"cardIds", it.value()}}
+            };
+        }
+
+        routine->transaction->query(
+                statements,
+                // callback:
+                [routine](bool ok, const QueryResponse &/*queryResponse*/) {
+                    ContinuationContext context(routine);
+                    if (!ok)
+                        context.setErrorFlag();
+                },
+                routine
+        );
+    }, routine);
+
+    routine->addStep([routine]() {
+        // 4. commit transaction
+        routine->transaction->commit(
+                // callback:
+                [routine](bool ok) {
+                    ContinuationContext context(routine);
+                    if (!ok)
+                        context.setErrorFlag();
+                },
+                routine
+        );
+    }, routine);
+
+    routine->addStep([callback, routine]() {
+        // 5. (final step) call `callback` and clean up
+        ContinuationContext context(routine);
+        callback(!routine->errorFlag);
+        routine->transaction->deleteLater();
+    }, callbackContext);
+
+    routine->start();
+}
+
 void CardsDataAccess::createRelationship(
         const RelationshipId &id, std::function<void (bool ok, bool created)> callback,
         QPointer<QObject> callbackContext) {
@@ -767,7 +940,7 @@ void CardsDataAccess::createRelationship(
                         REMOVE r._is_created
                         RETURN isCreated
                     )!")
-                        .replace("#RelationshipType#", id.type),
+                        .replace("#RelationshipType#", id.type.toString()),
                 QJsonObject {
                         {"fromCardId", id.startCardId},
                         {"toCardId", id.endCardId}
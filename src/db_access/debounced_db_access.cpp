@@ -193,6 +193,35 @@ void DebouncedDbAccess::updateCardLabels(const int cardId, const QSet<QString> &
     );
 }
 
+void DebouncedDbAccess::updateCardsLabels(
+        const QHash<int, QSet<QString>> &cardIdToUpdatedLabels) {
+    closeDebounceSession();
+
+    cardsDataAccess->updateCardsLabels(
+            cardIdToUpdatedLabels,
+            // callback:
+            [=](bool ok) {
+                if (!ok) {
+                    QJsonObject labelsJson;
+                    for (auto it = cardIdToUpdatedLabels.constBegin();
+                            it != cardIdToUpdatedLabels.constEnd(); ++it) {
+                        labelsJson.insert(QString::number(it.key()), toJsonArray(it.value()));
+                    }
+
+                    const QString time = QDateTime::currentDateTime().toString(Qt::ISODate);
+                    const QString updateTitle = "updateCardsLabels";
+                    const QString updateDetails = printJson(QJsonObject {
+                        {"cardIdToUpdatedLabels", labelsJson}
+                    }, false);
+                    unsavedUpdateRecordsFile->append(time, updateTitle, updateDetails);
+
+                    showMsgOnDbWriteFailed("updated labels of cards");
+                }
+            },
+            this
+    );
+}
+
 void DebouncedDbAccess::createRelationship(const RelationshipId &id) {
     closeDebounceSession();
 
@@ -378,6 +407,13 @@ void DebouncedDbAccess::getBoardData(
     boardsDataAccess->getBoardData(boardId, callback, callbackContext);
 }
 
+void DebouncedDbAccess::getBoardSnapshot(
+        const int boardId, std::function<void (bool, std::optional<BoardSnapshot>)> callback,
+        QPointer<QObject> callbackContext) {
+    closeDebounceSession();
+    boardsDataAccess->getBoardSnapshot(boardId, callback, callbackContext);
+}
+
 void DebouncedDbAccess::requestNewBoardId(
         std::function<void (bool, int)> callback, QPointer<QObject> callbackContext) {
     closeDebounceSession();
@@ -547,6 +583,30 @@ void DebouncedDbAccess::removeBoard(const int boardId) {
     );
 }
 
+void DebouncedDbAccess::updateBoardItemsInBulk(
+        const int boardId, const BoardItemsBulkUpdate &update) {
+    closeDebounceSession();
+
+    boardsDataAccess->updateBoardItemsInBulk(
+            boardId, update,
+            // callback
+            [=](bool ok) {
+                if (!ok) {
+                    const QString time = QDateTime::currentDateTime().toString(Qt::ISODate);
+                    const QString updateTitle = "updateBoardItemsInBulk";
+                    const QString updateDetails = printJson(QJsonObject {
+                        {"boardId", boardId},
+                        {"update", update.toJson()}
+                    }, false);
+                    unsavedUpdateRecordsFile->append(time, updateTitle, updateDetails);
+
+                    showMsgOnDbWriteFailed("bulk update of board items");
+                }
+            },
+            this
+    );
+}
+
 void DebouncedDbAccess::updateNodeRectProperties(
         const int boardId, const int cardId, const NodeRectDataUpdate &update) {
     closeDebounceSession();
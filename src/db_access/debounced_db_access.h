@@ -112,6 +112,8 @@ public:
 
     void updateCardLabels(const int cardId, const QSet<QString> &updatedLabels);
 
+    void updateCardsLabels(const QHash<int, QSet<QString>> &cardIdToUpdatedLabels);
+
     void createRelationship(const RelationshipId &id);
 
     void updateUserRelationshipTypes(const QStringList &updatedRelTypes);
@@ -145,6 +147,11 @@ public:
             std::function<void (bool ok, std::optional<Board> board)> callback,
             QPointer<QObject> callbackContext);
 
+    void getBoardSnapshot(
+            const int boardId,
+            std::function<void (bool ok, std::optional<BoardSnapshot> snapshot)> callback,
+            QPointer<QObject> callbackContext);
+
     void requestNewBoardId(
             std::function<void (bool ok, int boardId)> callback,
             QPointer<QObject> callbackContext);
@@ -170,6 +177,8 @@ public:
 
     void removeBoard(const int boardId);
 
+    void updateBoardItemsInBulk(const int boardId, const BoardItemsBulkUpdate &update);
+
     void updateNodeRectProperties(
             const int boardId, const int cardId, const NodeRectDataUpdate &update);
 
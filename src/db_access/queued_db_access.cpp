@@ -15,7 +15,7 @@ void QueuedDbAccess::clearErrorFlag() {
 }
 
 bool QueuedDbAccess::hasUnfinishedOperation() const {
-    return isWaitingResponse;
+    return readsInFlight > 0 || writeInFlight;
 }
 
 void QueuedDbAccess::queryCards(
@@ -242,6 +242,26 @@ void QueuedDbAccess::updateCardLabels(
     addToQueue(func);
 }
 
+void QueuedDbAccess::updateCardsLabels(
+        const QHash<int, QSet<QString>> &cardIdToUpdatedLabels,
+        std::function<void (bool)> callback, QPointer<QObject> callbackContext) {
+    Q_ASSERT(callback);
+
+    auto func = createTask<
+                    false // is readonly?
+                    , Void // result type (`Void` if no result argument)
+                    , decltype(cardIdToUpdatedLabels) // input types
+                >(
+            [this](auto... args) {
+                cardsDataAccess->updateCardsLabels(args...); // method
+            },
+            cardIdToUpdatedLabels, // input parameters
+            callback, callbackContext
+    );
+
+    addToQueue(func);
+}
+
 void QueuedDbAccess::createRelationship(
         const RelationshipId &id, std::function<void (bool ok, bool created)> callback,
         QPointer<QObject> callbackContext) {
@@ -422,6 +442,26 @@ void QueuedDbAccess::getBoardData(
     addToQueue(func);
 }
 
+void QueuedDbAccess::getBoardSnapshot(
+        const int boardId, std::function<void (bool, std::optional<BoardSnapshot>)> callback,
+        QPointer<QObject> callbackContext) {
+    Q_ASSERT(callback);
+
+    auto func = createTask<
+                    true // is readonly?
+                    , std::optional<BoardSnapshot> // result type (`Void` if no result argument)
+                    , decltype(boardId) // input types
+                >(
+            [this](auto... args) {
+                boardsDataAccess->getBoardSnapshot(args...); // method
+            },
+            boardId, // input parameters
+            callback, callbackContext
+    );
+
+    addToQueue(func);
+}
+
 void QueuedDbAccess::createNewWorkspaceWithId(
         const int workspaceId, const Workspace &workspace,
         std::function<void (bool)> callback, QPointer<QObject> callbackContext) {
@@ -583,6 +623,26 @@ void QueuedDbAccess::removeBoard(
     addToQueue(func);
 }
 
+void QueuedDbAccess::updateBoardItemsInBulk(
+        const int boardId, const BoardItemsBulkUpdate &update,
+        std::function<void (bool)> callback, QPointer<QObject> callbackContext) {
+    Q_ASSERT(callback);
+
+    auto func = createTask<
+                    false // is readonly?
+                    , Void // result type (`Void` if no result argument)
+                    , decltype(boardId), decltype(update) // input types
+                >(
+            [this](auto... args) {
+                boardsDataAccess->updateBoardItemsInBulk(args...); // method
+            },
+            boardId, update, // input parameters
+            callback, callbackContext
+    );
+
+    addToQueue(func);
+}
+
 void QueuedDbAccess::updateNodeRectProperties(
         const int boardId, const int cardId, const NodeRectDataUpdate &update,
         std::function<void (bool)> callback, QPointer<QObject> callbackContext) {
@@ -886,17 +946,22 @@ void QueuedDbAccess::removeSettingBox(
     addToQueue(func);
 }
 
-void QueuedDbAccess::addToQueue(std::function<void (const bool)> func) {
-    const bool failDirectly = errorFlag;
-    queue << Task {func, failDirectly};
-
-    if (!isWaitingResponse) {
-        dequeueAndInvoke();
-        isWaitingResponse = true;
-    }
+void QueuedDbAccess::addToQueue(Task task) {
+    task.toFailDirectly = errorFlag;
+    queue << task;
+    dispatch();
 }
 
 void QueuedDbAccess::onResponse(const bool ok, const bool isReadOnlyAccess) {
+    if (isReadOnlyAccess) {
+        Q_ASSERT(readsInFlight > 0);
+        --readsInFlight;
+    }
+    else {
+        Q_ASSERT(writeInFlight);
+        writeInFlight = false;
+    }
+
     if (!isReadOnlyAccess && !ok) {
         if (!errorFlag) {
             errorFlag = true;
@@ -906,18 +971,25 @@ void QueuedDbAccess::onResponse(const bool ok, const bool isReadOnlyAccess) {
         }
     }
 
-    if (!queue.isEmpty())
-        dequeueAndInvoke();
-    else
-        isWaitingResponse = false;
+    dispatch();
 }
 
-void QueuedDbAccess::dequeueAndInvoke() {
-    Q_ASSERT(!queue.isEmpty());
-    auto task = queue.dequeue();
+void QueuedDbAccess::dispatch() {
+    while (!queue.isEmpty() && !writeInFlight) {
+        if (queue.head().isReadOnly) {
+            ++readsInFlight;
+        }
+        else {
+            if (readsInFlight > 0)
+                break;
+            writeInFlight = true;
+        }
+
+        const Task task = queue.dequeue();
 
-    // add `func` to the event queue (rather than call it directly) to prevent deep call stack
-    QTimer::singleShot(0, this, [task]() {
-        task.func(task.toFailDirectly);
-    });
+        // add `func` to the event queue (rather than call it directly) to prevent deep call stack
+        QTimer::singleShot(0, this, [task]() {
+            task.func(task.toFailDirectly);
+        });
+    }
 }
@@ -10,7 +10,9 @@
 
 //!
 //! A proxy of \c BoardsDataAccess & \c CardsDataAccess. The requests are queued and handled in
-//! sequence (sends next request only after current one gets response).
+//! order. Consecutive read-only requests are sent without waiting for each other's response
+//! (so their responses can arrive in any order), while a non-read-only request is sent only after
+//! all previous requests get response, and blocks all later requests until it gets response.
 //!
 //! When a non-read-only operation failed, all remaining requests in the queue will fail directly
 //! (without actually being performed). Before the error flag is cleared, any new request will also
@@ -85,6 +87,10 @@ public:
             const int cardId, const QSet<QString> &updatedLabels,
             std::function<void (bool ok)> callback, QPointer<QObject> callbackContext) override;
 
+    void updateCardsLabels(
+            const QHash<int, QSet<QString>> &cardIdToUpdatedLabels,
+            std::function<void (bool ok)> callback, QPointer<QObject> callbackContext) override;
+
     void createRelationship(
             const RelationshipId &id, std::function<void (bool ok, bool created)> callback,
             QPointer<QObject> callbackContext) override;
@@ -126,6 +132,11 @@ public:
                 std::function<void (bool ok, std::optional<Board> board)> callback,
                 QPointer<QObject> callbackContext) override;
 
+    void getBoardSnapshot(
+            const int boardId,
+            std::function<void (bool ok, std::optional<BoardSnapshot> snapshot)> callback,
+            QPointer<QObject> callbackContext) override;
+
     // write operations
 
     void createNewWorkspaceWithId(
@@ -160,6 +171,10 @@ public:
             const int boardId,
             std::function<void (bool ok)> callback, QPointer<QObject> callbackContext) override;
 
+    void updateBoardItemsInBulk(
+            const int boardId, const BoardItemsBulkUpdate &update,
+            std::function<void (bool ok)> callback, QPointer<QObject> callbackContext) override;
+
     void updateNodeRectProperties(
             const int boardId, const int cardId, const NodeRectDataUpdate &update,
             std::function<void (bool ok)> callback, QPointer<QObject> callbackContext) override;
@@ -230,16 +245,22 @@ private:
     struct Task
     {
         std::function<void (const bool failDirectly)> func;
-        bool toFailDirectly;
+        bool isReadOnly;
+        bool toFailDirectly {false};
     };
     QQueue<Task> queue;
 
-    bool isWaitingResponse {false};
+    int readsInFlight {0};
+    bool writeInFlight {false};
     bool errorFlag {false}; // set when a request failed, unset by clearErrorFlag()
 
-    void addToQueue(std::function<void (const bool failDirectly)> func);
-    void onResponse(const bool ok, const bool isReadOnlyAccess = false);
-    void dequeueAndInvoke();
+    void addToQueue(Task task);
+    void onResponse(const bool ok, const bool isReadOnlyAccess);
+
+    //!
+    //! Dequeues and invokes tasks as far as the read/write ordering allows.
+    //!
+    void dispatch();
 
     //
     struct Void {};
@@ -265,13 +286,13 @@ private:
     //! Type \e Result, if is not \c Void, must have default constructor.
     //!
     template <bool isReadOnly, typename Result, typename... InputArgs>
-    std::function<void (const bool failDirectly)> createTask(
+    Task createTask(
             typename FunctionTypeHelper<Result, InputArgs...>::Func func,
             InputArgs... inputValues,
             typename FunctionTypeHelper<Result, InputArgs...>::Callback callback,
             QPointer<QObject> callbackContext
     ) {
-        return [=, thisPtr=QPointer(this)](const bool failDirectly) {
+        auto taskFunc = [=, thisPtr=QPointer(this)](const bool failDirectly) {
             if (failDirectly) {
                 if constexpr (FunctionTypeHelper<Result, InputArgs...>::hasResultArg) {
                     invokeAction(callbackContext, [callback]() {
@@ -305,6 +326,7 @@ private:
                     thisPtr.data()
             );
         };
+        return Task {taskFunc, isReadOnly};
     };
 };
 
@@ -15,7 +15,8 @@
  *     "autoAdjustCardColorsForDarkTheme: false
  *   }
  *   "export": {
- *     "outputDir": "..."
+ *     "outputDir": "...",
+ *     "imageMemoryCapMb": 512
  *   }
  *   "mainWindow": {
  *     "size": [1000, 800],
@@ -57,6 +58,7 @@ constexpr char keyTopLeftPos[] = "topLeftPos";
 constexpr char keyIsDarkTheme[] = "isDarkTheme";
 constexpr char keyAutoAdjustCardColorsForDarkTheme[] = "autoAdjustCardColorsForDarkTheme";
 constexpr char keyOutputDir[] = "outputDir";
+constexpr char keyImageMemoryCapMb[] = "imageMemoryCapMb";
 
 LocalSettingsFile::LocalSettingsFile(const QString &appLocalDataDir)
         : filePath(QDir(appLocalDataDir).filePath(fileName)) {
@@ -166,6 +168,20 @@ std::pair<bool, std::optional<QString> > LocalSettingsFile::readExportOutputDire
     return {true, v.toString()};
 }
 
+std::pair<bool, std::optional<int> > LocalSettingsFile::readExportImageMemoryCapMb() {
+    const QJsonObject obj = read();
+    const QJsonValue v = JsonReader(obj)[sectionExport][keyImageMemoryCapMb].get();
+    if (v.isUndefined())
+        return {true, std::nullopt};
+
+    if (!v.isDouble()) {
+        qWarning().noquote() << QString("value of %1 is not a number").arg(keyImageMemoryCapMb);
+        return {false, std::nullopt};
+    }
+
+    return {true, v.toInt()};
+}
+
 bool LocalSettingsFile::writeIsDarkTheme(const bool isDarkTheme) {
     QJsonObject obj = read();
 
@@ -284,6 +300,20 @@ bool LocalSettingsFile::writeExportOutputDirectory(const QString &outputDir) {
     return ok;
 }
 
+bool LocalSettingsFile::writeExportImageMemoryCapMb(const int memoryCapMb) {
+    QJsonObject obj = read();
+
+    // set obj[sectionExport][keyImageMemoryCapMb] = memoryCapMb
+    QJsonObject exportObj = obj[sectionExport].toObject();
+    exportObj[keyImageMemoryCapMb] = memoryCapMb;
+
+    obj[sectionExport] = exportObj;
+
+    //
+    const bool ok = write(obj);
+    return ok;
+}
+
 QJsonObject LocalSettingsFile::read() {
     if (!QFileInfo::exists(filePath))
         return QJsonObject {};
@@ -24,6 +24,7 @@ public:
     std::pair<bool, std::optional<QPointF>> readTopLeftPosOfBoard(const int boardId);
     std::pair<bool, std::optional<QRect>> readMainWindowSizePos();
     std::pair<bool, std::optional<QString>> readExportOutputDirectory();
+    std::pair<bool, std::optional<int>> readExportImageMemoryCapMb();
 
     // ==== write operations ====
 
@@ -35,6 +36,7 @@ public:
     bool removeBoard(const int boardId);
     bool writeMainWindowSizePos(const QRect &rect);
     bool writeExportOutputDirectory(const QString &outputDir);
+    bool writeExportImageMemoryCapMb(const int memoryCapMb);
 
 private:
     QString filePath;
@@ -10,6 +10,7 @@
 #include "utilities/app_instances_shared_memory.h"
 #include "utilities/fonts_util.h"
 #include "utilities/logging.h"
+#include "utilities/trace_recorder.h"
 #include "widgets/main_window.h"
 
 namespace {
@@ -24,6 +25,13 @@ void messageHandlerWriteToLogFile(
 } // namespace
 
 int main(int argc, char *argv[]) {
+    // If the environment variable MANICARD_STARTUP_TRACE is set to a file path, the startup
+    // (until the first board is loaded) is traced and written to that file in Chrome trace-event
+    // format.
+    const QString startupTraceFilePath = qEnvironmentVariable("MANICARD_STARTUP_TRACE");
+    if (!startupTraceFilePath.isEmpty())
+        TraceRecorder::instance()->start(startupTraceFilePath);
+
     QApplication app(argc, argv);
     app.setApplicationName("ManiCard");
     app.setQuitOnLastWindowClosed(true);
@@ -108,8 +116,10 @@ int main(int argc, char *argv[]) {
         timerReadSharedMemActivateFlag->start(1000);
 
         // initialize services
+        int traceSpanId = TraceRecorder::instance()->beginSpan("Services::initialize", "startup");
         QString errorMsg;
         bool ok = Services::instance()->initialize(&errorMsg);
+        TraceRecorder::instance()->endSpan(traceSpanId);
         if (!ok)
         {
             QMessageBox::critical(nullptr, "Error", errorMsg);
@@ -118,7 +128,10 @@ int main(int argc, char *argv[]) {
         }
 
         //
+        traceSpanId = TraceRecorder::instance()->beginSpan("Application::initialize", "startup");
         application->initialize();
+        TraceRecorder::instance()->endSpan(traceSpanId);
+
         application->loadOnStart();
     });
 
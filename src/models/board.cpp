@@ -169,6 +169,57 @@ QSet<QString> BoardNodePropertiesUpdate::keys() const {
 
 //====
 
+bool BoardItemsBulkUpdate::isEmpty() const {
+    return cardIdToNodeRectUpdate.isEmpty()
+            && customDataQueryIdToDataViewBoxUpdate.isEmpty()
+            && groupBoxIdToUpdate.isEmpty()
+            && nodeRectsToRemove.isEmpty()
+            && dataViewBoxesToRemove.isEmpty()
+            && !relIdToJoints.has_value();
+}
+
+QJsonObject BoardItemsBulkUpdate::toJson() const {
+    QJsonObject obj;
+
+    if (!cardIdToNodeRectUpdate.isEmpty()) {
+        QJsonObject updates;
+        for (auto it = cardIdToNodeRectUpdate.constBegin();
+                it != cardIdToNodeRectUpdate.constEnd(); ++it) {
+            updates.insert(QString::number(it.key()), it.value().toJson());
+        }
+        obj.insert("cardIdToNodeRectUpdate", updates);
+    }
+
+    if (!customDataQueryIdToDataViewBoxUpdate.isEmpty()) {
+        QJsonObject updates;
+        for (auto it = customDataQueryIdToDataViewBoxUpdate.constBegin();
+                it != customDataQueryIdToDataViewBoxUpdate.constEnd(); ++it) {
+            updates.insert(QString::number(it.key()), it.value().toJson());
+        }
+        obj.insert("customDataQueryIdToDataViewBoxUpdate", updates);
+    }
+
+    if (!groupBoxIdToUpdate.isEmpty()) {
+        QJsonObject updates;
+        for (auto it = groupBoxIdToUpdate.constBegin(); it != groupBoxIdToUpdate.constEnd(); ++it)
+            updates.insert(QString::number(it.key()), it.value().toJson());
+        obj.insert("groupBoxIdToUpdate", updates);
+    }
+
+    if (!nodeRectsToRemove.isEmpty())
+        obj.insert("nodeRectsToRemove", toJsonArray(nodeRectsToRemove));
+
+    if (!dataViewBoxesToRemove.isEmpty())
+        obj.insert("dataViewBoxesToRemove", toJsonArray(dataViewBoxesToRemove));
+
+    if (relIdToJoints.has_value())
+        obj.insert("relIdToJoints", convertRelIdToJointsDataToJsonStr(relIdToJoints.value()));
+
+    return obj;
+}
+
+//====
+
 namespace {
 QString convertRelIdToJointsDataToJsonStr(
         const QHash<RelationshipId, QVector<QPointF>> &relIdToJoints) {
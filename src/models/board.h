@@ -65,4 +65,21 @@ struct BoardNodePropertiesUpdate
     QSet<QString> keys() const;
 };
 
+
+//!
+//! Updates and removals of multiple items of a board, to be persisted together.
+//!
+struct BoardItemsBulkUpdate
+{
+    QHash<int, NodeRectDataUpdate> cardIdToNodeRectUpdate;
+    QHash<int, DataViewBoxDataUpdate> customDataQueryIdToDataViewBoxUpdate;
+    QHash<int, GroupBoxNodePropertiesUpdate> groupBoxIdToUpdate;
+    QSet<int> nodeRectsToRemove; // (card IDs)
+    QSet<int> dataViewBoxesToRemove; // (custom data query IDs)
+    std::optional<QHash<RelationshipId, QVector<QPointF>>> relIdToJoints; // of the board
+
+    bool isEmpty() const;
+    QJsonObject toJson() const;
+};
+
 #endif // BOARD_H
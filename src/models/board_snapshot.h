@@ -0,0 +1,23 @@
+#ifndef BOARD_SNAPSHOT_H
+#define BOARD_SNAPSHOT_H
+
+#include <QHash>
+#include "models/board.h"
+#include "models/card.h"
+#include "models/custom_data_query.h"
+#include "models/relationship.h"
+
+//!
+//! All the data needed to show a board.
+//!
+struct BoardSnapshot
+{
+    Board board;
+            // including NodeRect's, DataViewBox's, group-boxes (with their child items) and
+            // setting-boxes
+    QHash<int, CardSnapshot> cards; // cards shown by the board's NodeRect's
+    QHash<RelationshipId, RelationshipProperties> relationships; // between cards in `cards`
+    QHash<int, CustomDataQuery> customDataQueries; // shown by the board's DataViewBox's
+};
+
+#endif // BOARD_SNAPSHOT_H
@@ -1,29 +1,36 @@
+#include <algorithm>
 #include "card.h"
 #include "node_labels.h"
 #include "utilities/json_util.h"
 #include "utilities/maps_util.h"
 
 Card &Card::addLabels(const QSet<QString> &labelsToAdd) {
-    labels += labelsToAdd;
-    labels -= NodeLabel::card;
+    for (const QString &label: labelsToAdd)
+        insertLabel(label);
     return *this;
 }
 
 Card &Card::addLabels(const QStringList &labelsToAdd) {
     for (const QString &label: labelsToAdd)
-        labels += label;
-    labels -= NodeLabel::card;
+        insertLabel(label);
     return *this;
 }
 
 Card &Card::setLabels(const QSet<QString> &labels_) {
-    labels = labels_;
-    labels -= NodeLabel::card;
-    return *this;
+    labels.clear();
+    return addLabels(labels_);
 }
 
 QSet<QString> Card::getLabels() const {
-    return labels;
+    QSet<QString> result;
+    result.reserve(labels.count());
+    for (const Symbol &label: labels)
+        result << label.toString();
+    return result;
+}
+
+QSet<Symbol> Card::getLabelSymbols() const {
+    return QSet<Symbol>(labels.constBegin(), labels.constEnd());
 }
 
 void Card::insertCustomProperty(const QString &name, const QJsonValue &value) {
@@ -37,22 +44,26 @@ void Card::insertCustomProperty(const QString &name, const QJsonValue &value) {
         Q_ASSERT(false);
         return;
     }
-    customProperties.insert(name, value);
+    customProperties.insert(Symbol(name), value);
 }
 
 void Card::removeCustomProperty(const QString &name) {
-    customProperties.remove(name);
+    customProperties.remove(Symbol(name));
 }
 
 QHash<QString, QJsonValue> Card::getCustomProperties() const {
-    return customProperties;
+    QHash<QString, QJsonValue> result;
+    result.reserve(customProperties.count());
+    for (const auto &[name, value]: customProperties)
+        result.insert(name.toString(), value);
+    return result;
 }
 
 QJsonObject Card::getPropertiesJson() const {
     QJsonObject obj;
 
-    for (auto it = customProperties.constBegin(); it != customProperties.constEnd(); ++it)
-        obj.insert(it.key(), it.value());
+    for (const auto &[name, value]: customProperties)
+        obj.insert(name.toString(), value);
 
     obj.insert("title", title);
     obj.insert("text", text);
@@ -76,7 +87,7 @@ Card &Card::updateProperties(const QJsonObject &obj, const bool ignoreId) {
         else if (name == "tags")
             tags = toStringList(value.toArray(), "");
         else
-            customProperties.insert(name, value);
+            customProperties.insert(Symbol(name), value);
     }
 
     return *this;
@@ -92,17 +103,27 @@ Card &Card::updateProperties(const CardPropertiesUpdate &propertiesUpdate) {
     UPDATE_PROPERTY(tags);
 #undef UPDATE_PROPERTY
 
-    const auto customPropUpdate = propertiesUpdate.getCustomProperties();
-    for (auto it = customPropUpdate.constBegin(); it != customPropUpdate.constEnd(); ++it) {
-        if (it.value().isUndefined())
-            customProperties.remove(it.key());
+    for (const auto &[name, value]: propertiesUpdate.customProperties) {
+        if (value.isUndefined())
+            customProperties.remove(name);
         else
-            customProperties.insert(it.key(), it.value());
+            customProperties.insert(name, value);
     }
 
     return *this;
 }
 
+void Card::insertLabel(const QString &label) {
+    if (label == NodeLabel::card)
+        return;
+
+    const Symbol symbol(label);
+    const auto it = std::lower_bound(labels.begin(), labels.end(), symbol);
+    if (it != labels.end() && *it == symbol)
+        return;
+    labels.insert(it, symbol);
+}
+
 //====
 
 void CardPropertiesUpdate::setCustomProperties(const QHash<QString, QJsonValue> &properties) {
@@ -115,12 +136,16 @@ void CardPropertiesUpdate::setCustomProperties(const QHash<QString, QJsonValue>
             Q_ASSERT(false);
             continue;
         }
-        customProperties.insert(name, it.value());
+        customProperties.insert(Symbol(name), it.value());
     }
 }
 
 QHash<QString, QJsonValue> CardPropertiesUpdate::getCustomProperties() const {
-    return customProperties;
+    QHash<QString, QJsonValue> result;
+    result.reserve(customProperties.count());
+    for (const auto &[name, value]: customProperties)
+        result.insert(name.toString(), value);
+    return result;
 }
 
 QJsonObject CardPropertiesUpdate::toJson(const UndefinedHandlingOption option) const {
@@ -128,7 +153,7 @@ QJsonObject CardPropertiesUpdate::toJson(const UndefinedHandlingOption option) c
 
     // custom properties
     for (auto it = customProperties.constBegin(); it != customProperties.constEnd(); ++it) {
-        QJsonValue value = it.value();
+        QJsonValue value = it->second;
         if (value.isUndefined()) {
             // handle Undefined value
             switch (option) {
@@ -145,7 +170,7 @@ QJsonObject CardPropertiesUpdate::toJson(const UndefinedHandlingOption option) c
                 value = QJsonValue::Null;
             }
         }
-        obj.insert(it.key(), value);
+        obj.insert(it->first.toString(), value);
     }
 
     //
@@ -172,8 +197,6 @@ void CardPropertiesUpdate::mergeWith(const CardPropertiesUpdate &other) {
 #undef UPDATE_ITEM
 
     //
-    for (auto it = other.customProperties.constBegin();
-            it != other.customProperties.constEnd(); ++it) {
-        customProperties.insert(it.key(), it.value());
-    }
+    for (const auto &[name, value]: other.customProperties)
+        customProperties.insert(name, value);
 }
@@ -1,6 +1,7 @@
 #ifndef CARD_H
 #define CARD_H
 
+#include <memory>
 #include <optional>
 #include <QHash>
 #include <QJsonObject>
@@ -8,6 +9,9 @@
 #include <QSet>
 #include <QString>
 #include <QStringList>
+#include <QVarLengthArray>
+#include "utilities/flat_map.h"
+#include "utilities/symbol.h"
 
 struct CardPropertiesUpdate;
 
@@ -24,6 +28,11 @@ struct Card
     //!
     QSet<QString> getLabels() const;
 
+    //!
+    //! \return labels other than "Card", interned
+    //!
+    QSet<Symbol> getLabelSymbols() const;
+
     // ==== properties ====
 
     QString title;
@@ -46,13 +55,24 @@ struct Card
     Card &updateProperties(const CardPropertiesUpdate &propertiesUpdate);
 
 private:
-    QSet<QString> labels; // not including "Card"
-    QHash<QString, QJsonValue> customProperties;
+    // Compact storage: a card usually has only a few labels and custom properties, for which
+    // hash containers would cost several heap blocks each.
+    QVarLengthArray<Symbol, 4> labels; // not including "Card"; sorted & unique
+    FlatMap<Symbol, QJsonValue> customProperties;
             // - keys are property names
             // - key cannot not be "title", "text", "tags", "id"
             // - value cannot be Undefined
+
+    void insertLabel(const QString &label);
 };
 
+//!
+//! Immutable snapshot of a card's data, shared by all holders (cache, query results, views).
+//! An update replaces the snapshot in the cache by a new one, so a holder of an old snapshot
+//! never sees it change.
+//!
+using CardSnapshot = std::shared_ptr<const Card>;
+
 struct CardPropertiesUpdate
 {
     std::optional<QString> title;
@@ -81,7 +101,9 @@ struct CardPropertiesUpdate
     void mergeWith(const CardPropertiesUpdate &other);
 
 private:
-    QHash<QString, QJsonValue> customProperties;
+    friend struct Card;
+
+    FlatMap<Symbol, QJsonValue> customProperties;
             // - keys are property names
             // - keys cannot contain "title", "text", "tags", "id"
             // - a key can have Undefined value, meaning the removal of the property
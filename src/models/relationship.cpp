@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <utility>
 #include <QRegularExpression>
 #include "relationship.h"
 
@@ -20,7 +22,7 @@ bool RelationshipId::operator ==(const RelationshipId &other) const {
 }
 
 QString RelationshipId::toStringRepr() const {
-    return QString("(%1)-[%2]->(%3)").arg(startCardId).arg(type).arg(endCardId);
+    return QString("(%1)-[%2]->(%3)").arg(startCardId).arg(type.toString()).arg(endCardId);
 }
 
 RelationshipId RelationshipId::fromStringRepr(const QString &s) {
@@ -57,7 +59,7 @@ QJsonObject RelationshipId::toJson() const {
     return {
         {"startCardId", startCardId},
         {"endCardId", endCardId},
-        {"type", type}
+        {"type", type.toString()}
     };
 }
 
@@ -80,3 +82,29 @@ QJsonObject RelationshipProperties::toJson() const {
     return obj;
 }
 
+QVector<RelationshipId> sortRelationshipIds(const QSet<RelationshipId> &relIds) {
+    // (the type strings are looked up once, rather than in each comparison)
+    QVector<std::pair<RelationshipId, QString>> relIdsAndTypes;
+    relIdsAndTypes.reserve(relIds.count());
+    for (const RelationshipId &relId: relIds)
+        relIdsAndTypes << std::make_pair(relId, relId.type.toString());
+
+    std::sort(
+            relIdsAndTypes.begin(), relIdsAndTypes.end(),
+            [](const auto &a, const auto &b) ->bool {
+                const RelationshipId &idA = a.first;
+                const RelationshipId &idB = b.first;
+                if (idA.startCardId != idB.startCardId)
+                    return idA.startCardId < idB.startCardId;
+                if (idA.endCardId != idB.endCardId)
+                    return idA.endCardId < idB.endCardId;
+                return a.second < b.second; // alphabetical order of types
+            }
+    );
+
+    QVector<RelationshipId> result;
+    result.reserve(relIdsAndTypes.count());
+    for (const auto &[relId, type]: qAsConst(relIdsAndTypes))
+        result << relId;
+    return result;
+}
@@ -2,8 +2,11 @@
 #define RELATIONSHIP_H
 
 #include <QJsonObject>
+#include <QSet>
 #include <QString>
+#include <QVector>
 #include "utilities/hash.h"
+#include "utilities/symbol.h"
 
 //!
 //! In Neo4j, for specific combination of (start-node, end-node, relationship-type), there can be
@@ -13,10 +16,12 @@ struct RelationshipId
 {
     RelationshipId(const int startCardId, const int endCardId, const QString &type)
         : startCardId(startCardId), endCardId(endCardId), type(type) {}
+    RelationshipId(const int startCardId, const int endCardId, const Symbol type)
+        : startCardId(startCardId), endCardId(endCardId), type(type) {}
 
     int startCardId;
     int endCardId;
-    QString type;
+    Symbol type; // use `type.toString()` for DB & UI
 
     //!
     //! \param cardId
@@ -42,6 +47,10 @@ inline uint qHash(const RelationshipId &id, uint seed) {
     return seed;
 }
 
+//!
+//! \return \e relIds sorted by start card ID, then end card ID, then type
+//!
+QVector<RelationshipId> sortRelationshipIds(const QSet<RelationshipId> &relIds);
 
 struct RelationshipProperties
 {
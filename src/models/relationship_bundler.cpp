@@ -0,0 +1,264 @@
+#include "group_box_tree.h"
+#include "relationship_bundler.h"
+#include "utilities/maps_util.h"
+
+RelationshipBundler::RelationshipBundler(
+        const GroupBoxTree *groupBoxTree, GetRelationshipsOfCard getRelationshipsOfCard)
+            : groupBoxTree(groupBoxTree)
+            , getRelationshipsOfCard(getRelationshipsOfCard) {
+    Q_ASSERT(groupBoxTree != nullptr);
+    Q_ASSERT(getRelationshipsOfCard);
+}
+
+void RelationshipBundler::markAllChanged() {
+    allChanged = true;
+}
+
+void RelationshipBundler::markCardChanged(const int cardId) {
+    const int parentGroupBoxId = groupBoxTree->getParentGroupBoxOfCard(cardId);
+    if (parentGroupBoxId != -1)
+        markGroupBoxAndAncestors(parentGroupBoxId);
+}
+
+void RelationshipBundler::markRelationshipsChanged(const QSet<RelationshipId> &relIds) {
+    QSet<int> cardIds;
+    for (const RelationshipId &relId: relIds)
+        cardIds << relId.startCardId << relId.endCardId;
+
+    for (const int cardId: qAsConst(cardIds))
+        markCardChanged(cardId);
+}
+
+void RelationshipBundler::markGroupBoxChanged(const int groupBoxId) {
+    if (groupBoxTree->getParentOfGroupBox(groupBoxId) == -1) // `groupBoxId` not found
+        return;
+
+    markGroupBoxAndAncestors(groupBoxId);
+    groupBoxesWithChangedAncestors << groupBoxId;
+}
+
+RelationshipBundler::Changes RelationshipBundler::update() {
+    UpdateState state;
+
+    // drop the results of removed group-boxes
+    for (auto it = groupBoxIdToResult.begin(); it != groupBoxIdToResult.end(); ) {
+        if (groupBoxTree->getParentOfGroupBox(it.key()) != -1) {
+            ++it;
+            continue;
+        }
+
+        addBundledRels(it.value().bundles, it.value().descendantCards, -1, &state);
+        state.changes.removedBundles += it.value().bundles;
+        it = groupBoxIdToResult.erase(it);
+    }
+
+    // recompute marked group-boxes, parents first
+    QVector<int> ancestors;
+    updateChildGroupBoxes(GroupBoxTree::rootId, ancestors, allChanged, &state);
+
+    // get net changes of bundled relationships
+    for (auto it = state.touchedRelToWasBundled.constBegin();
+            it != state.touchedRelToWasBundled.constEnd(); ++it) {
+        const bool wasBundled = it.value();
+        const bool isBundledNow = bundledRelToCount.contains(it.key());
+        if (wasBundled && !isBundledNow)
+            state.changes.unbundledRels << it.key();
+        else if (!wasBundled && isBundledNow)
+            state.changes.newlyBundledRels << it.key();
+    }
+
+    //
+    allChanged = false;
+    changedGroupBoxes.clear();
+    groupBoxesWithChangedAncestors.clear();
+
+    return state.changes;
+}
+
+QSet<RelationshipsBundle> RelationshipBundler::getBundlesOfGroupBox(const int groupBoxId) const {
+    return groupBoxIdToResult.value(groupBoxId).bundles;
+}
+
+QSet<RelationshipsBundle> RelationshipBundler::getAllBundles() const {
+    QSet<RelationshipsBundle> result;
+    for (auto it = groupBoxIdToResult.constBegin(); it != groupBoxIdToResult.constEnd(); ++it)
+        result += it.value().bundles;
+    return result;
+}
+
+bool RelationshipBundler::isBundled(const RelationshipId &relId) const {
+    return bundledRelToCount.contains(relId);
+}
+
+QSet<RelationshipId> RelationshipBundler::getBundledRelationships() const {
+    return keySet(bundledRelToCount);
+}
+
+void RelationshipBundler::markGroupBoxAndAncestors(const int groupBoxId) {
+    int id = groupBoxId;
+    while (id != GroupBoxTree::rootId && id != -1) {
+        changedGroupBoxes << id;
+        id = groupBoxTree->getParentOfGroupBox(id);
+    }
+}
+
+void RelationshipBundler::updateChildGroupBoxes(
+        const int parentId, QVector<int> &ancestors, const bool ancestorsBundlesChanged,
+        UpdateState *state) {
+    const QSet<int> childGroupBoxes = groupBoxTree->getChildGroupBoxes(parentId);
+    for (const int groupBoxId: childGroupBoxes) {
+        const bool ancestorsChanged
+                = ancestorsBundlesChanged || groupBoxesWithChangedAncestors.contains(groupBoxId);
+        if (!ancestorsChanged && !changedGroupBoxes.contains(groupBoxId))
+            continue;
+
+        const bool bundlesChanged = recomputeGroupBox(groupBoxId, ancestors, state);
+
+        ancestors << groupBoxId;
+        updateChildGroupBoxes(groupBoxId, ancestors, ancestorsChanged || bundlesChanged, state);
+        ancestors.removeLast();
+    }
+}
+
+bool RelationshipBundler::recomputeGroupBox(
+        const int groupBoxId, const QVector<int> &ancestors, UpdateState *state) {
+    const QSet<int> cards = groupBoxTree->getAllDescendants(groupBoxId).second;
+    const QSet<RelationshipsBundle> bundles = computeBundles(groupBoxId, cards, ancestors);
+
+    auto it = groupBoxIdToResult.find(groupBoxId);
+    if (it == groupBoxIdToResult.end()) {
+        if (bundles.isEmpty())
+            return false;
+
+        addBundledRels(bundles, cards, 1, state);
+        state->changes.addedBundles += bundles;
+        groupBoxIdToResult.insert(groupBoxId, GroupBoxResult {bundles, cards});
+        return true;
+    }
+
+    GroupBoxResult &result = it.value();
+    const bool bundlesChanged = (result.bundles != bundles);
+    if (!bundlesChanged && result.descendantCards == cards)
+        return false;
+
+    addBundledRels(result.bundles, result.descendantCards, -1, state);
+    addBundledRels(bundles, cards, 1, state);
+
+    state->changes.removedBundles += (result.bundles - bundles);
+    state->changes.addedBundles += (bundles - result.bundles);
+
+    if (bundles.isEmpty()) {
+        groupBoxIdToResult.erase(it);
+    }
+    else {
+        result.bundles = bundles;
+        result.descendantCards = cards;
+    }
+    return bundlesChanged;
+}
+
+QSet<RelationshipsBundle> RelationshipBundler::computeBundles(
+        const int groupBoxId, const QSet<int> &descendantCards,
+        const QVector<int> &ancestors) const {
+    // Find the possible bundles of the first card, as if the group contains only that card
+    // (not considering the relationships bundled by ancestors). Then keep only those that every
+    // other card also has.
+    QSet<RelationshipsBundle> bundles;
+    bool isFirstCard = true;
+
+    for (const int cardId: descendantCards) {
+        const QSet<RelationshipId> rels = getRelationshipsOfCard(cardId);
+
+        if (isFirstCard) {
+            isFirstCard = false;
+
+            for (const RelationshipId &rel: rels) {
+                int theOtherCard;
+                if (!rel.connectsCard(cardId, &theOtherCard))
+                    continue;
+                if (descendantCards.contains(theOtherCard)) // `theOtherCard` is not external card
+                    continue;
+
+                const auto direction = (cardId == rel.startCardId)
+                        ? RelationshipsBundle::Direction::OutFromGroup
+                        : RelationshipsBundle::Direction::IntoGroup;
+                if (isBundledByAncestors(ancestors, theOtherCard, rel.type, direction))
+                    continue;
+
+                RelationshipsBundle bundle;
+                {
+                    bundle.groupBoxId = groupBoxId;
+                    bundle.externalCardId = theOtherCard;
+                    bundle.relationshipType = rel.type;
+                    bundle.direction = direction;
+                }
+                bundles << bundle;
+            }
+        }
+        else {
+            for (auto it = bundles.begin(); it != bundles.end(); ) {
+                if (rels.contains(getBundledRelationship(*it, cardId)))
+                    ++it;
+                else
+                    it = bundles.erase(it);
+            }
+        }
+
+        if (bundles.isEmpty())
+            break;
+    }
+
+    return bundles;
+}
+
+bool RelationshipBundler::isBundledByAncestors(
+        const QVector<int> &ancestors, const int externalCardId, const Symbol &relType,
+        const RelationshipsBundle::Direction direction) const {
+    for (const int ancestorId: ancestors) {
+        auto it = groupBoxIdToResult.constFind(ancestorId);
+        if (it == groupBoxIdToResult.constEnd())
+            continue;
+
+        RelationshipsBundle bundle;
+        {
+            bundle.groupBoxId = ancestorId;
+            bundle.externalCardId = externalCardId;
+            bundle.relationshipType = relType;
+            bundle.direction = direction;
+        }
+        if (it.value().bundles.contains(bundle))
+            return true;
+    }
+    return false;
+}
+
+void RelationshipBundler::addBundledRels(
+        const QSet<RelationshipsBundle> &bundles, const QSet<int> &cards, const int delta,
+        UpdateState *state) {
+    for (const RelationshipsBundle &bundle: bundles) {
+        for (const int cardId: cards) {
+            const RelationshipId relId = getBundledRelationship(bundle, cardId);
+            if (!state->touchedRelToWasBundled.contains(relId))
+                state->touchedRelToWasBundled.insert(relId, bundledRelToCount.contains(relId));
+
+            auto it = bundledRelToCount.find(relId);
+            if (it == bundledRelToCount.end()) {
+                Q_ASSERT(delta > 0);
+                bundledRelToCount.insert(relId, delta);
+            }
+            else {
+                it.value() += delta;
+                if (it.value() <= 0)
+                    bundledRelToCount.erase(it);
+            }
+        }
+    }
+}
+
+RelationshipId RelationshipBundler::getBundledRelationship(
+        const RelationshipsBundle &bundle, const int cardInGroup) {
+    if (bundle.direction == RelationshipsBundle::Direction::IntoGroup)
+        return RelationshipId(bundle.externalCardId, cardInGroup, bundle.relationshipType);
+    else
+        return RelationshipId(cardInGroup, bundle.externalCardId, bundle.relationshipType);
+}
@@ -0,0 +1,134 @@
+#ifndef RELATIONSHIP_BUNDLER_H
+#define RELATIONSHIP_BUNDLER_H
+
+#include <functional>
+#include <QHash>
+#include <QSet>
+#include <QVector>
+#include "models/relationship.h"
+#include "models/relationships_bundle.h"
+
+class GroupBoxTree;
+
+//!
+//! Computes the relationship bundles of the group-boxes of a \c GroupBoxTree, and keeps them
+//! up to date incrementally.
+//!
+//! A bundle (g, x, type, direction) of group-box g exists if every descendant card of g has a
+//! relationship of \e type with the external card x (in \e direction), and the relationship is
+//! not already bundled by an ancestor group-box of g.
+//!
+//! The bundles of a group-box depend only on its descendant cards, their relationships, and the
+//! bundles of its ancestors. So after a change, only the group-boxes on the paths from the
+//! changed items to the root are recomputed, plus the subtrees under group-boxes whose bundles
+//! actually changed.
+//!
+//! Usage: call the \c mark...() methods to tell what has changed (as documented for each method),
+//! then call \c update().
+//!
+class RelationshipBundler
+{
+public:
+    using GetRelationshipsOfCard = std::function<QSet<RelationshipId> (const int cardId)>;
+
+    //!
+    //! \param groupBoxTree: must outlive this object
+    //! \param getRelationshipsOfCard: returns the relationships starting or ending at a card
+    //!
+    RelationshipBundler(
+            const GroupBoxTree *groupBoxTree, GetRelationshipsOfCard getRelationshipsOfCard);
+
+    //!
+    //! Lets the next \c update() recompute everything (e.g., after \c GroupBoxTree::set() or
+    //! \c GroupBoxTree::clear() ).
+    //!
+    void markAllChanged();
+
+    //!
+    //! Call this before and after \e cardId is added to, reparented in, or removed from the tree,
+    //! and after the relationships of \e cardId are changed.
+    //!
+    void markCardChanged(const int cardId);
+
+    //!
+    //! Calls \c markCardChanged() for the start & end cards of every relationship in \e relIds.
+    //!
+    void markRelationshipsChanged(const QSet<RelationshipId> &relIds);
+
+    //!
+    //! Call this before and after \e groupBoxId is reparented or removed. (For the removal,
+    //! call it also for the child group-boxes after the removal.)
+    //!
+    void markGroupBoxChanged(const int groupBoxId);
+
+    struct Changes
+    {
+        QSet<RelationshipsBundle> addedBundles;
+        QSet<RelationshipsBundle> removedBundles;
+        QSet<RelationshipId> newlyBundledRels;
+        QSet<RelationshipId> unbundledRels;
+    };
+
+    //!
+    //! Recomputes the bundles affected by the changes marked since last call.
+    //!
+    Changes update();
+
+    //
+    QSet<RelationshipsBundle> getBundlesOfGroupBox(const int groupBoxId) const;
+    QSet<RelationshipsBundle> getAllBundles() const;
+    bool isBundled(const RelationshipId &relId) const;
+    QSet<RelationshipId> getBundledRelationships() const;
+
+private:
+    const GroupBoxTree *const groupBoxTree;
+    const GetRelationshipsOfCard getRelationshipsOfCard;
+
+    struct GroupBoxResult
+    {
+        QSet<RelationshipsBundle> bundles; // not empty
+        QSet<int> descendantCards; // those when `bundles` was computed
+    };
+    QHash<int, GroupBoxResult> groupBoxIdToResult; // only group-boxes that have bundles
+    QHash<RelationshipId, int> bundledRelToCount; // number of bundles that include the relationship
+
+    // marked changes
+    bool allChanged {false};
+    QSet<int> changedGroupBoxes; // (closed under taking ancestor)
+    QSet<int> groupBoxesWithChangedAncestors; // their whole subtrees are to be recomputed
+
+    void markGroupBoxAndAncestors(const int groupBoxId);
+
+    struct UpdateState
+    {
+        Changes changes;
+        QHash<RelationshipId, bool> touchedRelToWasBundled;
+    };
+
+    void updateChildGroupBoxes(
+            const int parentId, QVector<int> &ancestors, const bool ancestorsBundlesChanged,
+            UpdateState *state);
+
+    //!
+    //! \return whether the set of bundles of \e groupBoxId changed
+    //!
+    bool recomputeGroupBox(
+            const int groupBoxId, const QVector<int> &ancestors, UpdateState *state);
+
+    QSet<RelationshipsBundle> computeBundles(
+            const int groupBoxId, const QSet<int> &descendantCards,
+            const QVector<int> &ancestors) const;
+
+    bool isBundledByAncestors(
+            const QVector<int> &ancestors, const int externalCardId, const Symbol &relType,
+            const RelationshipsBundle::Direction direction) const;
+
+    void addBundledRels(
+            const QSet<RelationshipsBundle> &bundles, const QSet<int> &cards, const int delta,
+            UpdateState *state);
+
+    static RelationshipId getBundledRelationship(
+            const RelationshipsBundle &bundle, const int cardInGroup);
+};
+
+#endif // RELATIONSHIP_BUNDLER_H
@@ -10,10 +10,10 @@ bool RelationshipsBundle::operator ==(const RelationshipsBundle &other) const {
 QString RelationshipsBundle::toString() const {
     if (direction == Direction::IntoGroup) {
         return QString("(group %1)<-[%2]--(card %3)")
-                .arg(groupBoxId).arg(relationshipType).arg(externalCardId);
+                .arg(groupBoxId).arg(relationshipType.toString()).arg(externalCardId);
     }
     else {
         return QString("(group %1)--[%2]->(card %3)")
-                .arg(groupBoxId).arg(relationshipType).arg(externalCardId);
+                .arg(groupBoxId).arg(relationshipType.toString()).arg(externalCardId);
     }
 }
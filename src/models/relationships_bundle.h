@@ -3,6 +3,7 @@
 
 #include <QString>
 #include "utilities/hash.h"
+#include "utilities/symbol.h"
 
 struct RelationshipsBundle
 {
@@ -10,7 +11,7 @@ struct RelationshipsBundle
 
     int groupBoxId {-1};
     int externalCardId {-1};
-    QString relationshipType;
+    Symbol relationshipType;
     Direction direction {Direction::IntoGroup};
 
     //
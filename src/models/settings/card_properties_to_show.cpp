@@ -55,6 +55,14 @@ QString ValueDisplayFormat::getValueDisplayText(const QJsonValue &value) const {
     return splitted.join("$");
 }
 
+bool ValueDisplayFormat::operator == (const ValueDisplayFormat &other) const {
+    return caseValueToString == other.caseValueToString
+            && defaultStringIfExists == other.defaultStringIfExists
+            && stringIfNotExists == other.stringIfNotExists
+            && hideLabel == other.hideLabel
+            && addQuotesForString == other.addQuotesForString;
+}
+
 QJsonObject ValueDisplayFormat::toJson() const {
     QJsonObject obj;
 
@@ -179,6 +187,13 @@ CardPropertiesToShow::PropertiesAndDisplayFormats CardPropertiesToShow::getPrope
         return cardLabelToSetting.value(*it);
 }
 
+CardPropertiesToShow::CompiledTable CardPropertiesToShow::compile() const {
+    QVector<std::pair<Symbol, PropertiesAndDisplayFormats>> rules;
+    for (const QString &label: cardLabelsOrdering)
+        rules << std::make_pair(Symbol(label), cardLabelToSetting.value(label));
+    return CompiledTable(rules);
+}
+
 void CardPropertiesToShow::updateWith(const CardPropertiesToShow &other) {
     const QHash<QString, PropertiesAndDisplayFormats> originalCardLabelToSetting
             = cardLabelToSetting;
@@ -3,6 +3,7 @@
 
 #include <optional>
 #include "models/settings/abstract_setting.h"
+#include "utilities/label_rules_table.h"
 
 struct ValueDisplayFormat
 {
@@ -22,6 +23,8 @@ struct ValueDisplayFormat
     //!
     QString getValueDisplayText(const QJsonValue &value) const;
 
+    bool operator == (const ValueDisplayFormat &other) const;
+
     //
     QJsonObject toJson() const;
     static std::optional<ValueDisplayFormat> fromJson(
@@ -41,6 +44,12 @@ public:
     //!
     PropertiesAndDisplayFormats getPropertiesToShow(const QSet<QString> &cardLabels) const;
 
+    //!
+    //! For evaluating the setting on many cards.
+    //!
+    using CompiledTable = LabelRulesTable<PropertiesAndDisplayFormats>;
+    CompiledTable compile() const;
+
     //
     void updateWith(const CardPropertiesToShow &other);
 
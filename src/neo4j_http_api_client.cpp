@@ -12,6 +12,7 @@
 #include "utilities/functor.h"
 #include "utilities/json_util.h"
 #include "utilities/numbers_util.h"
+#include "utilities/trace_recorder.h"
 
 namespace {
 
@@ -62,6 +63,21 @@ QByteArray prepareQueryRequestBody(const QVector<Neo4jHttpApiClient::QueryStatem
     return QJsonDocument(QJsonObject {{"statements", statementsArray}}).toJson();
 }
 
+//!
+//! \return the first non-empty line of the first statement, for naming trace spans
+//!
+QString getTraceSpanName(const QVector<Neo4jHttpApiClient::QueryStatement> &statements) {
+    if (statements.isEmpty())
+        return "(no statement)";
+    const auto lines = statements.first().cypher.split('\n', Qt::SkipEmptyParts);
+    for (const QString &line: lines) {
+        const QString trimmed = line.trimmed();
+        if (!trimmed.isEmpty())
+            return trimmed;
+    }
+    return "(empty statement)";
+}
+
 void logSslErrors(const QList<QSslError> &errors) {
     QString errMsg = "SSL error(s):";
     for (const QSslError &error: errors)
@@ -154,9 +170,15 @@ void Neo4jHttpApiClient::queryDb(const QVector<QueryStatement> &queryStatements,
 
     QNetworkRequest request;
     request.setUrl(QUrl(QString("%1/db/%2/tx/commit").arg(hostUrl, dbName)));
-    addCommonHeadersToRequest(request, getBasicAuthData(dbAuthFilePath));
+    addCommonHeadersToRequest(request, getCachedBasicAuthData());
 
     //
+    int traceSpanId = -1;
+    if (TraceRecorder::instance()->isRecording()) {
+        traceSpanId = TraceRecorder::instance()->beginSpan(
+                getTraceSpanName(queryStatements), "db");
+    }
+
     QNetworkReply *reply
             = networkAccessManager->post(request, prepareQueryRequestBody(queryStatements));
 
@@ -164,7 +186,10 @@ void Neo4jHttpApiClient::queryDb(const QVector<QueryStatement> &queryStatements,
         logSslErrors(errors);
     });
 
-    connect(reply, &QNetworkReply::finished, this, [reply, callback, callbackContext]() {
+    connect(reply, &QNetworkReply::finished,
+            this, [reply, callback, callbackContext, traceSpanId]() {
+        TraceRecorder::instance()->endSpan(traceSpanId);
+
         const QueryResponse queryResponse = handleApiResponse(reply);
         reply->deleteLater();
 
@@ -197,6 +222,16 @@ void Neo4jHttpApiClient::queryDb(
     );
 }
 
+QByteArray Neo4jHttpApiClient::getCachedBasicAuthData() {
+    if (basicAuthDataCache.has_value())
+        return basicAuthDataCache.value();
+
+    const QByteArray data = getBasicAuthData(dbAuthFilePath);
+    if (!data.isEmpty()) // (retry next time if the file could not be read)
+        basicAuthDataCache = data;
+    return data;
+}
+
 Neo4jTransaction *Neo4jHttpApiClient::getTransaction() {
     return new Neo4jTransaction(hostUrl, dbName, dbAuthFilePath, networkAccessManager, nullptr);
 }
@@ -166,6 +166,10 @@ private:
     const QString dbName;
     const QString dbAuthFilePath;
     QNetworkAccessManager *networkAccessManager;
+
+    std::optional<QByteArray> basicAuthDataCache; // read from `dbAuthFilePath` once
+
+    QByteArray getCachedBasicAuthData();
 };
 
 //!
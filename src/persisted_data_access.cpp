@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <QApplication>
 #include <QDateTime>
 #include <QReadLocker>
@@ -32,7 +33,7 @@ void PersistedDataAccess::clearCache() {
 
 void PersistedDataAccess::queryCards(
         const QSet<int> &cardIds,
-        std::function<void (bool, const QHash<int, Card> &)> callback,
+        std::function<void (bool, const QHash<int, CardSnapshot> &)> callback,
         QPointer<QObject> callbackContext) {
     Q_ASSERT(callback);
 
@@ -40,7 +41,7 @@ void PersistedDataAccess::queryCards(
     {
     public:
         // variables used by the steps of the routine:
-        QHash<int, Card> cardsResult;
+        QHash<int, CardSnapshot> cardsResult;
         bool dbQueryOk;
     };
     auto *routine = new AsyncRoutineWithVars;
@@ -48,8 +49,8 @@ void PersistedDataAccess::queryCards(
 
     // 1. get the parts that are already cached
     for (const int id: cardIds) {
-        if (cache.cards.contains(id))
-            routine->cardsResult.insert(id, cache.cards.value(id));
+        if (const auto it = cache.cards.constFind(id); it != cache.cards.constEnd())
+            routine->cardsResult.insert(id, it.value()); // shares the snapshot, no copy of data
     }
 
     // 2. query DB for the other parts
@@ -70,9 +71,14 @@ void PersistedDataAccess::queryCards(
                 [this, routine](bool queryOk, const QHash<int, Card> &cardsFromDb) {
                     routine->dbQueryOk = queryOk;
                     if (queryOk) {
-                        mergeWith(routine->cardsResult, cardsFromDb);
-                        // update cache
-                        mergeWith(cache.cards, cardsFromDb);
+                        // update cache (this is the only place where snapshots are built from
+                        // DB data)
+                        for (auto it = cardsFromDb.constBegin();
+                                it != cardsFromDb.constEnd(); ++it) {
+                            const auto snapshot = std::make_shared<const Card>(it.value());
+                            cache.cards.insert(it.key(), snapshot);
+                            routine->cardsResult.insert(it.key(), snapshot);
+                        }
                     }
                     routine->nextStep();
                 },
@@ -111,7 +117,7 @@ void PersistedDataAccess::queryRelationship(
             [=](bool ok, const std::optional<RelProperties> &propertiesOpt) {
                 // update cache
                 if (ok && propertiesOpt.has_value())
-                    cache.relationships.insert(relationshipId, propertiesOpt.value());
+                    cache.setRelationship(relationshipId, propertiesOpt.value());
 
                 //
                 invokeAction(callbackContext, [callback, ok, propertiesOpt]() {
@@ -140,7 +146,8 @@ void PersistedDataAccess::queryRelationshipsFromToCards(
                 }
 
                 // update cache
-                mergeWith(cache.relationships, rels);
+                for (auto it = rels.constBegin(); it != rels.constEnd(); ++it)
+                    cache.setRelationship(it.key(), it.value());
 
                 //
                 invokeAction(callbackContext, [callback, rels]() {
@@ -445,6 +452,221 @@ void PersistedDataAccess::getBoardData(
     routine->start();
 }
 
+void PersistedDataAccess::getBoardSnapshot(
+        const int boardId, std::function<void (bool, std::optional<BoardSnapshot>)> callback,
+        QPointer<QObject> callbackContext) {
+    Q_ASSERT(callback);
+
+    class AsyncRoutineWithVars : public AsyncRoutineWithErrorFlag
+    {
+    public:
+        bool boardNotFound {false};
+        QSet<int> cardsToQuery;
+        QSet<int> customDataQueriesToQuery;
+        QSet<int> cardsToQueryRelationships; // relationships from/to these cards
+
+        std::optional<BoardSnapshot> result;
+    };
+    auto *routine = new AsyncRoutineWithVars;
+    routine->setName("PersistedDataAccess::getBoardSnapshot");
+
+    // 1. if the board is not cached, query DB for it together with its cards, relationships and
+    //    custom-data-queries (in one request), and cache the parts that are not cached yet
+    routine->addStep([this, routine, boardId]() {
+        if (cache.boards.contains(boardId)) {
+            routine->nextStep();
+            return;
+        }
+
+        debouncedDbAccess->getBoardSnapshot(
+                boardId,
+                // callback
+                [this, routine, boardId](bool ok, std::optional<BoardSnapshot> snapshot) {
+                    ContinuationContext context(routine);
+
+                    if (!ok) {
+                        context.setErrorFlag();
+                        return;
+                    }
+                    if (!snapshot.has_value()) {
+                        routine->boardNotFound = true;
+                        return;
+                    }
+
+                    // get topLeftPos from local settings file
+                    const auto [readFileOk, topLeftPosOpt]
+                            = localSettingsFile->readTopLeftPosOfBoard(boardId);
+                    if (!readFileOk) {
+                        context.setErrorFlag();
+                        return;
+                    }
+
+                    Board board = snapshot.value().board;
+                    if (topLeftPosOpt.has_value())
+                        board.topLeftPos = topLeftPosOpt.value();
+                    cache.boards.insert(boardId, board);
+
+                    // (the cached parts take precedence, since they may have updates not yet
+                    // written to DB)
+                    const BoardSnapshot &data = snapshot.value();
+                    for (auto it = data.cards.constBegin(); it != data.cards.constEnd(); ++it) {
+                        if (!cache.cards.contains(it.key()))
+                            cache.cards.insert(it.key(), it.value());
+                    }
+                    for (auto it = data.relationships.constBegin();
+                            it != data.relationships.constEnd(); ++it) {
+                        if (!cache.relationships.contains(it.key()))
+                            cache.setRelationship(it.key(), it.value());
+                    }
+                    for (auto it = data.customDataQueries.constBegin();
+                            it != data.customDataQueries.constEnd(); ++it) {
+                        if (!cache.customDataQueries.contains(it.key()))
+                            cache.customDataQueries.insert(it.key(), it.value());
+                    }
+                    cache.boardIdToCardsWithRelationshipsCached.insert(
+                            boardId, keySet(data.cards));
+                },
+                this
+        );
+    }, this);
+
+    // 2. find the parts not cached
+    routine->addStep([this, routine, boardId]() {
+        ContinuationContext context(routine);
+        if (routine->boardNotFound)
+            return;
+
+        const Board &board = cache.boards.constFind(boardId).value();
+        const QSet<int> cardsWithRelsCached
+                = cache.boardIdToCardsWithRelationshipsCached.value(boardId);
+        for (auto it = board.cardIdToNodeRectData.constBegin();
+                it != board.cardIdToNodeRectData.constEnd(); ++it) {
+            const int cardId = it.key();
+            if (!cache.cards.contains(cardId))
+                routine->cardsToQuery << cardId;
+            if (!cardsWithRelsCached.contains(cardId))
+                routine->cardsToQueryRelationships << cardId;
+        }
+        for (auto it = board.customDataQueryIdToDataViewBoxData.constBegin();
+                it != board.customDataQueryIdToDataViewBoxData.constEnd(); ++it) {
+            if (!cache.customDataQueries.contains(it.key()))
+                routine->customDataQueriesToQuery << it.key();
+        }
+    }, this);
+
+    // 3. query DB for the parts not cached (these update the cache)
+    routine->addParallelSteps({
+        {[this, routine]() {
+            if (routine->cardsToQuery.isEmpty()) {
+                routine->nextStep();
+                return;
+            }
+            queryCards(
+                    routine->cardsToQuery,
+                    // callback
+                    [routine](bool ok, const QHash<int, CardSnapshot> &/*cards*/) {
+                        ContinuationContext context(routine);
+                        if (!ok)
+                            context.setErrorFlag();
+                    },
+                    this
+            );
+        }, this},
+        {[this, routine]() {
+            if (routine->customDataQueriesToQuery.isEmpty()) {
+                routine->nextStep();
+                return;
+            }
+            queryCustomDataQueries(
+                    routine->customDataQueriesToQuery,
+                    // callback
+                    [routine](bool ok, const QHash<int, CustomDataQuery> &/*dataQueries*/) {
+                        ContinuationContext context(routine);
+                        if (!ok)
+                            context.setErrorFlag();
+                    },
+                    this
+            );
+        }, this},
+        {[this, routine, boardId]() {
+            if (routine->cardsToQueryRelationships.isEmpty()) {
+                routine->nextStep();
+                return;
+            }
+            debouncedDbAccess->queryRelationshipsFromToCards(
+                    routine->cardsToQueryRelationships,
+                    // callback
+                    [this, routine, boardId](bool ok, const QHash<RelId, RelProperties> &rels) {
+                        ContinuationContext context(routine);
+                        if (!ok) {
+                            context.setErrorFlag();
+                            return;
+                        }
+
+                        // (the cached ones take precedence)
+                        for (auto it = rels.constBegin(); it != rels.constEnd(); ++it) {
+                            if (!cache.relationships.contains(it.key()))
+                                cache.setRelationship(it.key(), it.value());
+                        }
+                        cache.boardIdToCardsWithRelationshipsCached[boardId]
+                                += routine->cardsToQueryRelationships;
+                    },
+                    this
+            );
+        }, this}
+    });
+
+    // 4. set routine->result from cache, with the cards shown by the board's NodeRect's
+    routine->addStep([this, routine, boardId]() {
+        ContinuationContext context(routine);
+        if (routine->boardNotFound)
+            return;
+
+        routine->result = BoardSnapshot();
+        BoardSnapshot &result = routine->result.value();
+
+        result.board = cache.boards.value(boardId);
+
+        for (auto it = result.board.cardIdToNodeRectData.constBegin();
+                it != result.board.cardIdToNodeRectData.constEnd(); ++it) {
+            const auto cardIt = cache.cards.constFind(it.key());
+            if (cardIt != cache.cards.constEnd())
+                result.cards.insert(it.key(), cardIt.value());
+        }
+
+        for (auto it = result.board.customDataQueryIdToDataViewBoxData.constBegin();
+                it != result.board.customDataQueryIdToDataViewBoxData.constEnd(); ++it) {
+            const auto queryIt = cache.customDataQueries.constFind(it.key());
+            if (queryIt != cache.customDataQueries.constEnd())
+                result.customDataQueries.insert(it.key(), queryIt.value());
+        }
+
+        // (all relationships between the cards are cached at this point, so they are found via
+        // the index of the cached relationships by card)
+        for (auto it = result.cards.constBegin(); it != result.cards.constEnd(); ++it) {
+            const auto relsIt = cache.cardIdToRelationships.constFind(it.key());
+            if (relsIt == cache.cardIdToRelationships.constEnd())
+                continue;
+
+            for (const RelId &relId: relsIt.value()) {
+                if (result.cards.contains(relId.startCardId)
+                        && result.cards.contains(relId.endCardId)) {
+                    result.relationships.insert(relId, cache.relationships.value(relId));
+                }
+            }
+        }
+    }, this);
+
+    // 5. (final step)
+    routine->addStep([routine, callback]() {
+         ContinuationContext context(routine);
+         callback(!routine->errorFlag, routine->result);
+    }, callbackContext);
+
+    //
+    routine->start();
+}
+
 void PersistedDataAccess::requestNewBoardId(
         std::function<void (std::optional<int>)> callback,
         QPointer<QObject> callbackContext) {
@@ -581,6 +803,18 @@ QString PersistedDataAccess::getExportOutputDir() {
         return outputDirOpt.value();
 }
 
+int PersistedDataAccess::getExportImageMemoryCapMb() {
+    // (not cached) reads from file, falling back to the default if not set, and applies the
+    // lower bound
+    const auto [ok, memoryCapOpt] = localSettingsFile->readExportImageMemoryCapMb();
+
+    constexpr int defaultMemoryCapMb = 512;
+    constexpr int minMemoryCapMb = 64;
+    if (!ok || !memoryCapOpt.has_value())
+        return defaultMemoryCapMb;
+    return std::max(memoryCapOpt.value(), minMemoryCapMb);
+}
+
 void PersistedDataAccess::createNewCardWithId(const int cardId, const Card &card) {
     // 1. update cache synchronously
     if (cache.cards.contains(cardId)) {
@@ -588,7 +822,7 @@ void PersistedDataAccess::createNewCardWithId(const int cardId, const Card &card
                 << QString("card with ID %1 already exists in cache").arg(cardId);
         return;
     }
-    cache.cards.insert(cardId, card);
+    cache.cards.insert(cardId, std::make_shared<const Card>(card));
 
     // 2. write DB
     debouncedDbAccess->createNewCardWithId(cardId, card);
@@ -597,8 +831,12 @@ void PersistedDataAccess::createNewCardWithId(const int cardId, const Card &card
 void PersistedDataAccess::updateCardProperties(
         const int cardId, const CardPropertiesUpdate &cardPropertiesUpdate) {
     // 1. update cache synchronously
-    if (cache.cards.contains(cardId))
-        cache.cards[cardId].updateProperties(cardPropertiesUpdate);
+    if (cache.cards.contains(cardId)) {
+        // replace the snapshot, so that holders of the old one are not affected
+        Card card = *cache.cards.value(cardId);
+        card.updateProperties(cardPropertiesUpdate);
+        cache.cards.insert(cardId, std::make_shared<const Card>(std::move(card)));
+    }
 
     // 2. write DB
     debouncedDbAccess->updateCardProperties(cardId, cardPropertiesUpdate);
@@ -607,13 +845,33 @@ void PersistedDataAccess::updateCardProperties(
 void PersistedDataAccess::updateCardLabels(
         const int cardId, const QSet<QString> &updatedLabels) {
     // 1. update cache synchronously
-    if (cache.cards.contains(cardId))
-        cache.cards[cardId].setLabels(updatedLabels);
+    if (cache.cards.contains(cardId)) {
+        Card card = *cache.cards.value(cardId);
+        card.setLabels(updatedLabels);
+        cache.cards.insert(cardId, std::make_shared<const Card>(std::move(card)));
+    }
 
     // 2. write DB
     debouncedDbAccess->updateCardLabels(cardId, updatedLabels);
 }
 
+void PersistedDataAccess::updateCardsLabels(
+        const QHash<int, QSet<QString>> &cardIdToUpdatedLabels) {
+    // 1. update cache synchronously
+    for (auto it = cardIdToUpdatedLabels.constBegin();
+            it != cardIdToUpdatedLabels.constEnd(); ++it) {
+        const int cardId = it.key();
+        if (cache.cards.contains(cardId)) {
+            Card card = *cache.cards.value(cardId);
+            card.setLabels(it.value());
+            cache.cards.insert(cardId, std::make_shared<const Card>(std::move(card)));
+        }
+    }
+
+    // 2. write DB
+    debouncedDbAccess->updateCardsLabels(cardIdToUpdatedLabels);
+}
+
 void PersistedDataAccess::createNewCustomDataQueryWithId(
         const int customDataQueryId, const CustomDataQuery &customDataQuery) {
     // 1. update cache synchronously
@@ -644,7 +902,7 @@ void PersistedDataAccess::createRelationship(const RelationshipId &id) {
         return;
 
     // 1. update cache synchronously
-    cache.relationships.insert(id, RelationshipProperties {});
+    cache.setRelationship(id, RelationshipProperties {});
 
     // 2. write DB
     debouncedDbAccess->createRelationship(id);
@@ -834,6 +1092,41 @@ void PersistedDataAccess::removeBoard(const int boardId) {
     localSettingsFile->removeBoard(boardId);
 }
 
+void PersistedDataAccess::updateBoardItemsInBulk(
+        const int boardId, const BoardItemsBulkUpdate &update) {
+    // 1. update cache synchronously
+    if (cache.boards.contains(boardId)) {
+        Board &board = cache.boards[boardId];
+
+        for (auto it = update.cardIdToNodeRectUpdate.constBegin();
+                it != update.cardIdToNodeRectUpdate.constEnd(); ++it) {
+            if (board.cardIdToNodeRectData.contains(it.key()))
+                board.cardIdToNodeRectData[it.key()].update(it.value());
+        }
+        for (auto it = update.customDataQueryIdToDataViewBoxUpdate.constBegin();
+                it != update.customDataQueryIdToDataViewBoxUpdate.constEnd(); ++it) {
+            if (board.customDataQueryIdToDataViewBoxData.contains(it.key()))
+                board.customDataQueryIdToDataViewBoxData[it.key()].update(it.value());
+        }
+        for (auto it = update.groupBoxIdToUpdate.constBegin();
+                it != update.groupBoxIdToUpdate.constEnd(); ++it) {
+            if (board.groupBoxIdToData.contains(it.key()))
+                board.groupBoxIdToData[it.key()].updateNodeProperties(it.value());
+        }
+
+        for (const int cardId: update.nodeRectsToRemove)
+            board.cardIdToNodeRectData.remove(cardId);
+        for (const int customDataQueryId: update.dataViewBoxesToRemove)
+            board.customDataQueryIdToDataViewBoxData.remove(customDataQueryId);
+
+        if (update.relIdToJoints.has_value())
+            board.relIdToJoints = update.relIdToJoints.value();
+    }
+
+    // 2. write DB
+    debouncedDbAccess->updateBoardItemsInBulk(boardId, update);
+}
+
 void PersistedDataAccess::updateNodeRectProperties(
         const int boardId, const int cardId, const NodeRectDataUpdate &update) {
     // 1. update cache synchronously
@@ -1206,6 +1499,21 @@ void PersistedDataAccess::saveExportOutputDir(const QString &outputDir) {
     }
 }
 
+void PersistedDataAccess::saveExportImageMemoryCapMb(const int memoryCapMb) {
+    // (not cached) write file
+    const bool ok = localSettingsFile->writeExportImageMemoryCapMb(memoryCapMb);
+    if (!ok) {
+        const QString time = QDateTime::currentDateTime().toString(Qt::ISODate);
+        const QString updateTitle = "saveExportImageMemoryCapMb";
+        const QString updateDetails = printJson(QJsonObject {
+            {"memoryCapMb", memoryCapMb},
+        }, false);
+        unsavedUpdateRecordsFile->append(time, updateTitle, updateDetails);
+
+        showMsgOnFailedToSaveToFile("export option");
+    }
+}
+
 void PersistedDataAccess::showMsgOnFailedToSaveToFile(const QString &dataName) {
     const auto msg
             = QString("Could not save %1 to file.\n\nThere is unsaved update. See %2")
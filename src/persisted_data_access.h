@@ -6,6 +6,7 @@
 #include <QReadWriteLock>
 #include "app_event_source.h"
 #include "models/board.h"
+#include "models/board_snapshot.h"
 #include "models/card.h"
 #include "models/custom_data_query.h"
 #include "models/setting_box_data.h"
@@ -44,7 +45,7 @@ public:
 
     void queryCards(
             const QSet<int> &cardIds,
-            std::function<void (bool, const QHash<int, Card> &)> callback,
+            std::function<void (bool, const QHash<int, CardSnapshot> &)> callback,
             QPointer<QObject> callbackContext);
 
     using RelId = RelationshipId;
@@ -86,6 +87,16 @@ public:
             std::function<void (bool ok, std::optional<Board> board)> callback,
             QPointer<QObject> callbackContext);
 
+    //!
+    //! Gets all the data needed to show the board. If the board is cached, only the parts not
+    //! cached are queried from DB. Otherwise, DB is queried in one request, and the cached parts
+    //! take precedence over those from DB. The cards are those shown by the board's NodeRect's.
+    //!
+    void getBoardSnapshot(
+            const int boardId,
+            std::function<void (bool ok, std::optional<BoardSnapshot> snapshot)> callback,
+            QPointer<QObject> callbackContext);
+
     void requestNewBoardId(
             std::function<void (std::optional<int> boardId)> callback,
             QPointer<QObject> callbackContext);
@@ -108,6 +119,8 @@ public:
 
     QString getExportOutputDir();
 
+    int getExportImageMemoryCapMb();
+
     // ==== write ====
 
     // A write operation fails if data cannot be saved to DB or file. In this case, a record of
@@ -120,6 +133,8 @@ public:
 
     void updateCardLabels(const int cardId, const QSet<QString> &updatedLabels);
 
+    void updateCardsLabels(const QHash<int, QSet<QString>> &cardIdToUpdatedLabels);
+
     void createNewCustomDataQueryWithId(
             const int customDataQueryId, const CustomDataQuery &customDataQuery);
 
@@ -163,6 +178,8 @@ public:
 
     void removeBoard(const int boardId);
 
+    void updateBoardItemsInBulk(const int boardId, const BoardItemsBulkUpdate &update);
+
     void updateNodeRectProperties(
             const int boardId, const int cardId, const NodeRectDataUpdate &update);
 
@@ -218,6 +235,8 @@ public:
 
     void saveExportOutputDir(const QString &outputDir);
 
+    void saveExportImageMemoryCapMb(const int memoryCapMb);
+
 private:
     DebouncedDbAccess *debouncedDbAccess;
     std::shared_ptr<LocalSettingsFile> localSettingsFile;
@@ -229,9 +248,13 @@ private:
         // Note. Remember to modify clear() after adding items here.
         std::optional<QHash<int, Workspace>> allWorkspaces;
         QHash<int, Board> boards;
-        QHash<int, Card> cards;
-        QHash<RelationshipId, RelationshipProperties> relationships;
+        QHash<int, CardSnapshot> cards;
+        QHash<RelationshipId, RelationshipProperties> relationships; // (see setRelationship())
+        QHash<int, QSet<RelationshipId>> cardIdToRelationships;
+                // index of `relationships` by their start & end cards
         QHash<int, CustomDataQuery> customDataQueries;
+        QHash<int, QSet<int>> boardIdToCardsWithRelationshipsCached;
+                // (for each board) the cards among which all relationships are in `relationships`
 
         std::optional<QStringList> userLabelsList;
         std::optional<QStringList> userRelTypesList;
@@ -245,7 +268,9 @@ private:
             boards.clear();
             cards.clear();
             relationships.clear();
+            cardIdToRelationships.clear();
             customDataQueries.clear();
+            boardIdToCardsWithRelationshipsCached.clear();
 
             userLabelsList.reset();
             userRelTypesList.reset();
@@ -253,6 +278,16 @@ private:
             isDarkTheme.reset();
             autoAdjustCardColorsForDarkTheme.reset();
         }
+
+        //!
+        //! Inserts or overwrites a relationship, and updates `cardIdToRelationships`. Use this
+        //! instead of inserting into `relationships` directly.
+        //!
+        void setRelationship(const RelationshipId &id, const RelationshipProperties &properties) {
+            relationships.insert(id, properties);
+            cardIdToRelationships[id.startCardId] << id;
+            cardIdToRelationships[id.endCardId] << id;
+        }
     };
     Cache cache;
 
@@ -57,6 +57,16 @@ bool Services::initialize(QString *errorMsg) {
                     QString("error in reading config: %1").arg(e.what()).toStdString());
         }
 
+        // (optional)
+        if (const QJsonValue v = JsonReader(config)["resident_boards"]["max_items"].get();
+                v.isDouble()) {
+            residentBoardsLimit.maxItemsCount = v.toInt();
+        }
+        if (const QJsonValue v = JsonReader(config)["resident_boards"]["max_estimated_mb"].get();
+                v.isDouble()) {
+            residentBoardsLimit.maxEstimatedBytes = qint64(v.toDouble() * 1024 * 1024);
+        }
+
         boardsDataAccess = std::make_shared<BoardsDataAccess>(neo4jHttpApiClient);
 
         cardsDataAccess = std::make_shared<CardsDataAccess>(neo4jHttpApiClient);
@@ -102,6 +112,10 @@ AppDataReadonly *Services::getAppDataReadonly() const {
     return appData;
 }
 
+ResidentBoardsLimit Services::getResidentBoardsLimit() const {
+    return residentBoardsLimit;
+}
+
 void Services::clearPersistedDataAccessCache(){
     Q_ASSERT(persistedDataAccess != nullptr);
     persistedDataAccess->clearCache();
@@ -15,6 +15,17 @@ class PersistedDataAccess;
 class QueuedDbAccess;
 class UnsavedUpdateRecordsFile;
 
+//!
+//! Limits on the boards kept loaded but hidden (for fast switching between board tabs) in a
+//! workspace. Least recently shown boards are unloaded when either limit is exceeded. The board
+//! currently shown is not counted.
+//!
+struct ResidentBoardsLimit
+{
+    int maxItemsCount {20000}; // NodeRect's, EdgeArrow's, etc.
+    qint64 maxEstimatedBytes {256LL * 1024 * 1024};
+};
+
 class Services
 {
 private:
@@ -35,6 +46,8 @@ public:
     AppData *getAppData() const;
     AppDataReadonly *getAppDataReadonly() const;
 
+    ResidentBoardsLimit getResidentBoardsLimit() const;
+
     //
     void clearPersistedDataAccessCache();
 
@@ -56,6 +69,7 @@ private:
     AppData *appData {nullptr};
 
     QString unsavedUpdateFilePath;
+    ResidentBoardsLimit residentBoardsLimit;
 };
 
 #endif // SERVICES_H
@@ -3,6 +3,7 @@
 #include <QTimer>
 #include "async_routine.h"
 #include "global_constants.h"
+#include "trace_recorder.h"
 
 namespace {
 constexpr bool logVerboseDebugMsg = false;
@@ -22,7 +23,27 @@ AsyncRoutine &AsyncRoutine::addStep(std::function<void ()> func, QPointer<QObjec
     Q_ASSERT(func);
     Q_ASSERT(!context.isNull());
 
-    steps.push_back(Step {func, context});
+    steps.push_back(Step {{Task {func, context}}});
+
+    if constexpr (!buildInReleaseMode) {
+        QTimer::singleShot(0, this, [this]() {
+            if (!isStarted)
+                qWarning().noquote() << QString("Did you forget to call AsyncRoutine::start()?");
+        });
+    }
+
+    return *this;
+}
+
+AsyncRoutine &AsyncRoutine::addParallelSteps(const std::vector<Task> &tasks) {
+    Q_ASSERT(!isStarted);
+    Q_ASSERT(!tasks.empty());
+    for (const Task &task: tasks) {
+        Q_ASSERT(task.func);
+        Q_ASSERT(!task.context.isNull());
+    }
+
+    steps.push_back(Step {tasks});
 
     if constexpr (!buildInReleaseMode) {
         QTimer::singleShot(0, this, [this]() {
@@ -60,6 +81,21 @@ void AsyncRoutine::nextStep() {
         if (isFinished)
             return;
 
+        if (!onTaskCompleted(false))
+            return;
+        TraceRecorder::instance()->endSpan(traceSpanId);
+
+        if (skipToFinalStepWhenJoined) {
+            if (currentStep == steps.size() - 1) {
+                finish();
+            }
+            else {
+                currentStep = steps.size() - 1;
+                invokeStep(currentStep);
+            }
+            return;
+        }
+
         if (currentStep == steps.size() - 1) {
             finish();
         }
@@ -78,6 +114,10 @@ void AsyncRoutine::skipToFinalStep() {
         if (isFinished)
             return;
 
+        if (!onTaskCompleted(true))
+            return;
+        TraceRecorder::instance()->endSpan(traceSpanId);
+
         if (currentStep == steps.size() - 1) {
             finish();
         }
@@ -91,18 +131,46 @@ void AsyncRoutine::skipToFinalStep() {
 void AsyncRoutine::invokeStep(const size_t i) {
     Q_ASSERT(i < steps.size());
 
-    if (!steps.at(i).func) {
+    pendingTasks = steps.at(i).tasks.size();
+    skipToFinalStepWhenJoined = false;
+
+    if (!name.isEmpty() && TraceRecorder::instance()->isRecording()) {
+        traceSpanId = TraceRecorder::instance()->beginSpan(
+                QString("%1 #%2").arg(name).arg(i), "routine");
+    }
+
+    for (const Task &task: steps.at(i).tasks)
+        invokeTask(task);
+}
+
+void AsyncRoutine::invokeTask(const Task &task) {
+    if (!task.func) {
         qWarning().noquote() << "routine step not defined";
         nextStep();
         return;
     }
-    if (steps.at(i).context.isNull()) {
-        qWarning().noquote() << QString("context of step %1 has been destroyed").arg(i);
+    if (task.context.isNull()) {
+        qWarning().noquote() << QString("context of step %1 has been destroyed").arg(currentStep);
         nextStep();
         return;
     }
 
-    QMetaObject::invokeMethod(steps.at(i).context, steps.at(i).func, Qt::AutoConnection);
+    QMetaObject::invokeMethod(task.context, task.func, Qt::AutoConnection);
+}
+
+bool AsyncRoutine::onTaskCompleted(const bool skipToFinal) {
+    if (skipToFinal)
+        skipToFinalStepWhenJoined = true;
+
+    if (pendingTasks == 0) {
+        qWarning().noquote()
+                << QString("step %1 of routine continued more times than it has tasks")
+                   .arg(currentStep);
+        return false;
+    }
+
+    --pendingTasks;
+    return pendingTasks == 0;
 }
 
 void AsyncRoutine::finish() {
@@ -110,6 +178,9 @@ void AsyncRoutine::finish() {
         isFinished = true;
         this->deleteLater();
 
+        TraceRecorder::instance()->endSpan(traceSpanId);
+        traceSpanId = -1;
+
         --startedInstances;
         if constexpr (!buildInReleaseMode) {
             if constexpr (logVerboseDebugMsg){
@@ -12,8 +12,13 @@
 //! When a task is completed, call \c nextStep() or \c skipToFinalStep() to let the routine continue
 //! to the next (or last) step in the sequence, or finish if there's no step remaining.
 //!
+//! A step can also be a group of tasks that run in parallel (see \c addParallelSteps()).
+//!
 //! Instance of this class auto-deletes itself when finished.
 //!
+//! If the routine has a name and \c TraceRecorder is recording, each step is recorded as a span
+//! named "<routine name> #<step index>".
+//!
 class AsyncRoutine : public QObject
 {
     Q_OBJECT
@@ -29,6 +34,23 @@ public:
     //!
     AsyncRoutine &addStep(std::function<void ()> func, QPointer<QObject> context);
 
+    struct Task
+    {
+        std::function<void ()> func;
+        QPointer<QObject> context;
+    };
+
+    //!
+    //! Adds a step that starts all of \e tasks at once. Each task is invoked in the same way as
+    //! the \e func of \c addStep(), and must call \c nextStep() or \c skipToFinalStep() at its
+    //! very end, exactly once. The routine continues when all the tasks are completed: to the
+    //! last step if any of the tasks called \c skipToFinalStep(), otherwise to the next step.
+    //!
+    //! The tasks can complete in any order. Vars of the routine that they write should be
+    //! distinct, or be written only in the thread of the routine.
+    //!
+    AsyncRoutine &addParallelSteps(const std::vector<Task> &tasks);
+
     //!
     //! Schedules the first step, or finishes the routine if it is empty.
     //!
@@ -37,12 +59,15 @@ public:
     //!
     //! Schedules the next step, or finishes the routine if no step remaining.
     //! This method is thread-safe, and can only be called at the very end of a step.
+    //! In a step of parallel tasks, this marks the calling task as completed.
     //!
     void nextStep();
 
     //!
     //! Schedules the last step, or finishes the routine if no step remaining.
     //! This method is thread-safe, and can only be called at the very end of a step.
+    //! In a step of parallel tasks, this marks the calling task as completed, and the routine
+    //! will skip to the last step when all the tasks are completed.
     //!
     void skipToFinalStep();
 
@@ -51,8 +76,7 @@ private:
 
     struct Step
     {
-        std::function<void ()> func;
-        QPointer<QObject> context;
+        std::vector<Task> tasks; // has 1 element unless the step is added by addParallelSteps()
     };
 
     QString name;
@@ -61,7 +85,20 @@ private:
     bool isStarted {false};
     bool isFinished {false};
 
+    // for the current step
+    size_t pendingTasks {0};
+    bool skipToFinalStepWhenJoined {false};
+    int traceSpanId {-1};
+
     void invokeStep(const size_t i);
+    void invokeTask(const Task &task);
+
+    //!
+    //! Called (in the thread of this object) when a task of the current step calls nextStep()
+    //! or skipToFinalStep().
+    //! \return true if all tasks of the current step are completed
+    //!
+    bool onTaskCompleted(const bool skipToFinal);
 
     void finish();
 };
@@ -0,0 +1,48 @@
+#include <QThread>
+#include "background_job.h"
+
+FunctionRunnable::FunctionRunnable(std::function<void ()> function)
+        : function(std::move(function)) {
+}
+
+void FunctionRunnable::run() {
+    function();
+}
+
+//====
+
+BackgroundJob::~BackgroundJob() {
+    cancel();
+    if (!thread.isNull()) {
+        thread->wait();
+        delete thread;
+    }
+}
+
+void BackgroundJob::start(
+        Function function, std::function<void ()> onFinished, QObject *context) {
+    Q_ASSERT(function);
+    Q_ASSERT(!onFinished || context != nullptr);
+    Q_ASSERT(!isRunning());
+
+    canceled = false;
+    thread = QThread::create([this, function]() {
+        function(canceled);
+    });
+    QObject::connect(thread, &QThread::finished, thread, &QObject::deleteLater);
+    if (onFinished)
+        QObject::connect(thread, &QThread::finished, context, onFinished);
+    thread->start();
+}
+
+void BackgroundJob::cancel() {
+    canceled = true;
+}
+
+bool BackgroundJob::isCanceled() const {
+    return canceled;
+}
+
+bool BackgroundJob::isRunning() const {
+    return !thread.isNull() && thread->isRunning();
+}
@@ -0,0 +1,62 @@
+#ifndef BACKGROUND_JOB_H
+#define BACKGROUND_JOB_H
+
+#include <atomic>
+#include <functional>
+#include <QPointer>
+#include <QRunnable>
+
+class QThread;
+
+//!
+//! A \c QRunnable that calls a function. (\c QThreadPool deletes it after it has run.)
+//!
+class FunctionRunnable : public QRunnable
+{
+public:
+    explicit FunctionRunnable(std::function<void ()> function);
+    void run() override;
+
+private:
+    const std::function<void ()> function;
+};
+
+//!
+//! Runs a function on a background thread, with a flag for canceling it.
+//!
+//! Declare it as the \e last data member of its owner. It is then destroyed first, so its
+//! destructor cancels the function and waits for the thread before the data used by the
+//! function are destroyed.
+//!
+class BackgroundJob
+{
+public:
+    //!
+    //! \e canceled is set by \c cancel(). The function should check it regularly and return
+    //! early when it is set.
+    //!
+    using Function = std::function<void (const std::atomic<bool> &canceled)>;
+
+    BackgroundJob() = default;
+    ~BackgroundJob(); // cancels the function and waits for the thread
+    Q_DISABLE_COPY(BackgroundJob)
+
+    //!
+    //! Runs \e function on a new thread. Must not be called while \c isRunning().
+    //! \param onFinished: (can be null) called in the thread of \e context after \e function
+    //!                    returns, unless \e context has been destroyed
+    //!
+    void start(
+            Function function,
+            std::function<void ()> onFinished = nullptr, QObject *context = nullptr);
+
+    void cancel(); // can be called from any thread
+    bool isCanceled() const; // can be called from any thread
+    bool isRunning() const;
+
+private:
+    QPointer<QThread> thread; // (deleted after it finishes)
+    std::atomic<bool> canceled {false};
+};
+
+#endif // BACKGROUND_JOB_H
@@ -0,0 +1,385 @@
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <queue>
+#include <vector>
+#include <QDebug>
+#include <QMarginsF>
+#include <QSet>
+#include <QThread>
+#include <QThreadPool>
+#include "edge_router.h"
+#include "rect_tree.h"
+
+namespace {
+//!
+//! \return whether segment \e p0-p1 passes through the interior of \e rect
+//!
+bool segmentCrossesRect(const QPointF &p0, const QPointF &p1, const QRectF &rect) {
+    // Liang–Barsky clipping against the open rect
+    double t0 = 0.0;
+    double t1 = 1.0;
+    const QPointF d = p1 - p0;
+    const double p[4] {-d.x(), d.x(), -d.y(), d.y()};
+    const double q[4] {
+        p0.x() - rect.left(), rect.right() - p0.x(), p0.y() - rect.top(), rect.bottom() - p0.y()
+    };
+    for (int k = 0; k < 4; ++k) {
+        if (p[k] == 0) {
+            if (q[k] <= 0)
+                return false;
+            continue;
+        }
+        const double t = q[k] / p[k];
+        if (p[k] < 0)
+            t0 = std::max(t0, t);
+        else
+            t1 = std::min(t1, t);
+        if (t0 >= t1)
+            return false;
+    }
+    return true;
+}
+
+QVector<double> sortedUnique(QVector<double> values) {
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    return values;
+}
+
+//!
+//! Orthogonal visibility graph on the grid formed by lines x = xs[i] and y = ys[j]. A node is
+//! a grid point, and an edge connects adjacent grid points.
+//!
+class Grid
+{
+public:
+    Grid(const QVector<double> &xs, const QVector<double> &ys)
+            : xs(xs), ys(ys), nx(xs.count()), ny(ys.count())
+            , nodeBlocked(nx * ny, 0)
+            , hEdgeBlocked(nx * ny, 0) // hEdgeBlocked[node(i, j)]: between (i, j) & (i + 1, j)
+            , vEdgeBlocked(nx * ny, 0) {} // vEdgeBlocked[node(i, j)]: between (i, j) & (i, j + 1)
+
+    //!
+    //! Blocks the nodes & edges in the interior of \e rect, except those on the lines
+    //! x = \e exceptX and y = \e exceptY (if given).
+    //!
+    void block(
+            const QRectF &rect,
+            const double exceptX = std::numeric_limits<double>::quiet_NaN(),
+            const double exceptY = std::numeric_limits<double>::quiet_NaN());
+
+    int node(const int i, const int j) const { return j * nx + i; }
+
+    //!
+    //! A* search with a penalty for each bend.
+    //! \return the nodes of the path from \e source to \e target, or an empty vector if not found
+    //!
+    QVector<int> findPath(const int source, const int target, const double bendPenalty) const;
+
+    const QVector<double> xs;
+    const QVector<double> ys;
+    const int nx;
+    const int ny;
+
+private:
+    std::vector<char> nodeBlocked;
+    std::vector<char> hEdgeBlocked;
+    std::vector<char> vEdgeBlocked;
+
+    static std::pair<int, int> indexRangeStrictlyInside(
+            const QVector<double> &values, const double low, const double high);
+};
+
+void Grid::block(const QRectF &rect, const double exceptX, const double exceptY) {
+    const auto [iBegin, iEnd] = indexRangeStrictlyInside(xs, rect.left(), rect.right());
+    const auto [jBegin, jEnd] = indexRangeStrictlyInside(ys, rect.top(), rect.bottom());
+
+    // nodes, & edges along x = xs[i] (vertical edges) with an end strictly inside
+    for (int i = iBegin; i < iEnd; ++i) {
+        if (xs.at(i) == exceptX)
+            continue;
+        for (int j = jBegin; j < jEnd; ++j) {
+            if (ys.at(j) != exceptY)
+                nodeBlocked[node(i, j)] = 1;
+        }
+        for (int j = std::max(jBegin - 1, 0); j < std::min(jEnd, ny - 1); ++j)
+            vEdgeBlocked[node(i, j)] = 1;
+    }
+
+    // edges along y = ys[j] (horizontal edges) with an end strictly inside
+    for (int j = jBegin; j < jEnd; ++j) {
+        if (ys.at(j) == exceptY)
+            continue;
+        for (int i = std::max(iBegin - 1, 0); i < std::min(iEnd, nx - 1); ++i)
+            hEdgeBlocked[node(i, j)] = 1;
+    }
+}
+
+QVector<int> Grid::findPath(const int source, const int target, const double bendPenalty) const {
+    // states: (node, direction of arrival), direction 0: horizontal, 1: vertical
+    const int statesCount = 2 * nx * ny;
+    std::vector<double> costs(statesCount, std::numeric_limits<double>::infinity());
+    std::vector<int> previous(statesCount, -1);
+
+    const double targetX = xs.at(target % nx);
+    const double targetY = ys.at(target / nx);
+    auto heuristic = [&](const int n) {
+        return std::abs(xs.at(n % nx) - targetX) + std::abs(ys.at(n / nx) - targetY);
+    };
+
+    using Entry = std::pair<double, int>; // (estimated total cost, state)
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+    for (int direction = 0; direction < 2; ++direction) {
+        const int state = 2 * source + direction;
+        costs[state] = 0.0;
+        queue.push({heuristic(source), state});
+    }
+
+    int reachedState = -1;
+    while (!queue.empty()) {
+        const auto [estimate, state] = queue.top();
+        queue.pop();
+
+        const int n = state / 2;
+        const int direction = state % 2;
+        const double cost = costs[state];
+        if (estimate > cost + heuristic(n) + 1e-9)
+            continue; // (outdated entry)
+        if (n == target) {
+            reachedState = state;
+            break;
+        }
+
+        const int i = n % nx;
+        const int j = n / nx;
+        auto relax = [&](const int neighbor, const int neighborDirection, const double length) {
+            if (nodeBlocked[neighbor] && neighbor != target)
+                return;
+            const double newCost
+                    = cost + length + ((neighborDirection != direction) ? bendPenalty : 0.0);
+            const int neighborState = 2 * neighbor + neighborDirection;
+            if (newCost < costs[neighborState]) {
+                costs[neighborState] = newCost;
+                previous[neighborState] = state;
+                queue.push({newCost + heuristic(neighbor), neighborState});
+            }
+        };
+
+        if (i + 1 < nx && !hEdgeBlocked[node(i, j)])
+            relax(node(i + 1, j), 0, xs.at(i + 1) - xs.at(i));
+        if (i > 0 && !hEdgeBlocked[node(i - 1, j)])
+            relax(node(i - 1, j), 0, xs.at(i) - xs.at(i - 1));
+        if (j + 1 < ny && !vEdgeBlocked[node(i, j)])
+            relax(node(i, j + 1), 1, ys.at(j + 1) - ys.at(j));
+        if (j > 0 && !vEdgeBlocked[node(i, j - 1)])
+            relax(node(i, j - 1), 1, ys.at(j) - ys.at(j - 1));
+    }
+
+    if (reachedState == -1)
+        return {};
+
+    QVector<int> path;
+    for (int state = reachedState; state != -1; state = previous[state])
+        path << state / 2;
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+std::pair<int, int> Grid::indexRangeStrictlyInside(
+        const QVector<double> &values, const double low, const double high) {
+    const int begin = int(std::upper_bound(values.begin(), values.end(), low) - values.begin());
+    const int end = int(std::lower_bound(values.begin(), values.end(), high) - values.begin());
+    return {begin, std::max(begin, end)};
+}
+
+//!
+//! \return the joints, or \c nullopt if no route is found in \e searchRegion
+//!
+std::optional<QVector<QPointF>> computeRouteInRegion(
+        const RectTree &obstaclesIndex, const QSet<int> &ignoredObstacles,
+        const QRectF &startRect, const QRectF &endRect, const QRectF &searchRegion,
+        const EdgeRouter::Parameters &parameters) {
+    const QPointF startCenter = startRect.center();
+    const QPointF endCenter = endRect.center();
+    const double m = parameters.obstacleMargin;
+    const QMarginsF margins(m, m, m, m);
+
+    // lines
+    QVector<QRectF> obstacles; // inflated
+    QVector<double> xs {
+        startCenter.x(), endCenter.x(), searchRegion.left(), searchRegion.right(),
+        startRect.left() - m, startRect.right() + m, endRect.left() - m, endRect.right() + m
+    };
+    QVector<double> ys {
+        startCenter.y(), endCenter.y(), searchRegion.top(), searchRegion.bottom(),
+        startRect.top() - m, startRect.bottom() + m, endRect.top() - m, endRect.bottom() + m
+    };
+    const QSet<int> obstacleIds = obstaclesIndex.queryIntersecting(searchRegion);
+    for (const int id: obstacleIds) {
+        if (ignoredObstacles.contains(id))
+            continue;
+        const QRectF rect = obstaclesIndex.getRect(id).marginsAdded(margins);
+        obstacles << rect;
+        xs << rect.left() << rect.right();
+        ys << rect.top() << rect.bottom();
+    }
+
+    auto isInRange = [](const double v, const double low, const double high) {
+        return low <= v && v <= high;
+    };
+    xs.erase(std::remove_if(xs.begin(), xs.end(), [&](const double x) {
+        return !isInRange(x, searchRegion.left(), searchRegion.right());
+    }), xs.end());
+    ys.erase(std::remove_if(ys.begin(), ys.end(), [&](const double y) {
+        return !isInRange(y, searchRegion.top(), searchRegion.bottom());
+    }), ys.end());
+    xs = sortedUnique(xs);
+    ys = sortedUnique(ys);
+
+    if (qint64(xs.count()) * ys.count() > parameters.maxGraphNodesCount)
+        return QVector<QPointF> {}; // (give up routing)
+
+    // graph
+    Grid grid(xs, ys);
+    for (const QRectF &rect: qAsConst(obstacles))
+        grid.block(rect);
+    grid.block(startRect, startCenter.x(), startCenter.y());
+    grid.block(endRect, endCenter.x(), endCenter.y());
+
+    auto indexOf = [](const QVector<double> &values, const double v) {
+        return int(std::lower_bound(values.begin(), values.end(), v) - values.begin());
+    };
+    const int source = grid.node(indexOf(xs, startCenter.x()), indexOf(ys, startCenter.y()));
+    const int target = grid.node(indexOf(xs, endCenter.x()), indexOf(ys, endCenter.y()));
+
+    const QVector<int> path = grid.findPath(source, target, parameters.bendPenalty);
+    if (path.isEmpty())
+        return std::nullopt;
+
+    // joints: where the path bends
+    auto pointOf = [&grid](const int n) {
+        return QPointF(grid.xs.at(n % grid.nx), grid.ys.at(n / grid.nx));
+    };
+    QVector<QPointF> joints;
+    for (int k = 1; k + 1 < path.count(); ++k) {
+        const QPointF p0 = pointOf(path.at(k - 1));
+        const QPointF p1 = pointOf(path.at(k));
+        const QPointF p2 = pointOf(path.at(k + 1));
+        const bool isHorizontal1 = (p0.y() == p1.y());
+        const bool isHorizontal2 = (p1.y() == p2.y());
+        if (isHorizontal1 != isHorizontal2)
+            joints << p1;
+    }
+    return joints;
+}
+} // namespace
+
+QVector<QPointF> EdgeRouter::computeRoute(
+        const RectTree &obstaclesIndex, const QRectF &startRect, const QRectF &endRect,
+        const Parameters &parameters) {
+    const QPointF startCenter = startRect.center();
+    const QPointF endCenter = endRect.center();
+
+    // obstacles intersecting the start or end rect are ignored
+    const QSet<int> ignoredObstacles
+            = obstaclesIndex.queryIntersecting(startRect)
+              + obstaclesIndex.queryIntersecting(endRect);
+
+    // does the straight line cross any obstacle?
+    {
+        const QRectF lineBoundingRect = QRectF(startCenter, endCenter).normalized();
+        const QSet<int> ids = obstaclesIndex.queryIntersecting(
+                lineBoundingRect.marginsAdded(QMarginsF(1, 1, 1, 1)));
+        bool crosses = false;
+        for (const int id: ids) {
+            if (ignoredObstacles.contains(id))
+                continue;
+            if (segmentCrossesRect(startCenter, endCenter, obstaclesIndex.getRect(id))) {
+                crosses = true;
+                break;
+            }
+        }
+        if (!crosses)
+            return {};
+    }
+
+    //
+    double margin = parameters.searchMargin;
+    for (int retry = 0; retry <= parameters.maxRetries; ++retry) {
+        const QRectF searchRegion = startRect.united(endRect)
+                .marginsAdded(QMarginsF(margin, margin, margin, margin));
+        const auto jointsOpt = computeRouteInRegion(
+                obstaclesIndex, ignoredObstacles, startRect, endRect, searchRegion, parameters);
+        if (jointsOpt.has_value())
+            return jointsOpt.value();
+
+        margin *= 2;
+    }
+    return {};
+}
+
+EdgeRouter::EdgeRouter(
+        const QVector<QRectF> &obstacles, const QVector<Request> &requests,
+        const Parameters &parameters, QObject *parent)
+            : QObject(parent)
+            , obstacles(obstacles)
+            , requests(requests)
+            , parameters(parameters) {
+}
+
+void EdgeRouter::start() {
+    if (job.isRunning()) {
+        qWarning().noquote() << "routing already started";
+        return;
+    }
+
+    job.start([this](const std::atomic<bool> &canceled) {
+        run(canceled);
+    });
+}
+
+void EdgeRouter::cancel() {
+    job.cancel();
+}
+
+QVector<QVector<QPointF>> EdgeRouter::getResult() const {
+    return result;
+}
+
+const QVector<EdgeRouter::Request> &EdgeRouter::getRequests() const {
+    return requests;
+}
+
+void EdgeRouter::run(const std::atomic<bool> &canceled) {
+    RectTree obstaclesIndex;
+    for (int i = 0; i < obstacles.count(); ++i)
+        obstaclesIndex.set(i, obstacles.at(i));
+
+    QVector<QVector<QPointF>> routes(requests.count());
+
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(std::max(QThread::idealThreadCount(), 1));
+
+    constexpr int chunkSize = 16;
+    for (int begin = 0; begin < requests.count(); begin += chunkSize) {
+        const int end = std::min(begin + chunkSize, requests.count());
+        auto routeChunk = [this, &canceled, &obstaclesIndex, &routes, begin, end]() {
+            for (int i = begin; i < end; ++i) {
+                if (canceled)
+                    return;
+                const Request &request = requests.at(i);
+                routes[i] = computeRoute(
+                        obstaclesIndex, request.startRect, request.endRect, parameters);
+            }
+        };
+        threadPool.start(new FunctionRunnable(routeChunk));
+    }
+    threadPool.waitForDone();
+
+    if (!canceled)
+        result = routes;
+    emit finished(!canceled);
+}
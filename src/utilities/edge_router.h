@@ -0,0 +1,85 @@
+#ifndef EDGE_ROUTER_H
+#define EDGE_ROUTER_H
+
+#include <atomic>
+#include <QObject>
+#include <QPointF>
+#include <QRectF>
+#include <QVector>
+#include "utilities/background_job.h"
+
+class RectTree;
+
+//!
+//! Orthogonal routing of arrows around rectangular obstacles (NodeRect's and group-boxes),
+//! computed on a background thread. A route is given as the joints (bend points) of a polyline
+//! from the center of the start rect to that of the end rect.
+//!
+//! A route is searched (A*, with a penalty for each bend) in the orthogonal visibility graph
+//! formed by the center lines of the start & end rects and the boundaries of the (inflated)
+//! obstacles near them, which are found with a spatial index (\c RectTree). The search region
+//! is enlarged if no route is found. Obstacles intersecting the start or end rect (including
+//! the group-boxes containing them) are ignored. A route leaves the start rect and enters the
+//! end rect along their center lines.
+//!
+//! The routes are computed in parallel by a thread pool. The input is a snapshot, so the
+//! computation does not touch any live object.
+//!
+class EdgeRouter : public QObject
+{
+    Q_OBJECT
+public:
+    struct Parameters
+    {
+        double obstacleMargin {16.0}; // clearance between routes and obstacles
+        double bendPenalty {80.0}; // in units of length
+        double searchMargin {240.0}; // around the start & end rects, doubled on each retry
+        int maxRetries {3};
+        int maxGraphNodesCount {250000}; // a route needing a larger graph is not computed
+    };
+
+    struct Request
+    {
+        int routeId;
+        QRectF startRect;
+        QRectF endRect;
+    };
+
+    //!
+    //! \param obstaclesIndex: rects of all obstacles
+    //! \return joints of the route. Returns an empty vector if the straight line between the
+    //!         centers crosses no obstacle, or if no route is found.
+    //!
+    static QVector<QPointF> computeRoute(
+            const RectTree &obstaclesIndex, const QRectF &startRect, const QRectF &endRect,
+            const Parameters &parameters);
+
+    explicit EdgeRouter(
+            const QVector<QRectF> &obstacles, const QVector<Request> &requests,
+            const Parameters &parameters, QObject *parent = nullptr);
+    void start();
+    void cancel(); // can be called from any thread
+
+    //!
+    //! Valid after \c finished() is emitted with \e ok = true.
+    //! \return the joints of each request, in the order of the requests
+    //!
+    QVector<QVector<QPointF>> getResult() const;
+
+    const QVector<Request> &getRequests() const;
+
+signals:
+    void finished(const bool ok); // `ok` is false if canceled
+
+private:
+    const QVector<QRectF> obstacles;
+    const QVector<Request> requests;
+    const Parameters parameters;
+
+    QVector<QVector<QPointF>> result; // written by `job` before `finished()` is emitted
+    BackgroundJob job; // (last member, so that it's destroyed first)
+
+    void run(const std::atomic<bool> &canceled); // runs in `job`
+};
+
+#endif // EDGE_ROUTER_H
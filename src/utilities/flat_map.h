@@ -0,0 +1,100 @@
+#ifndef FLAT_MAP_H
+#define FLAT_MAP_H
+
+#include <algorithm>
+#include <utility>
+#include <QVector>
+
+//!
+//! A map stored as a vector of (key, value) pairs sorted by key. It occupies a single heap block
+//! (none when empty), so it is much more compact than \c QHash or \c QMap for small maps.
+//! Lookup is a binary search; insertion and removal are linear.
+//!
+//! Type \e K must have operator < implemented.
+//!
+template <class K, class V>
+class FlatMap
+{
+public:
+    using value_type = std::pair<K, V>;
+    using const_iterator = typename QVector<value_type>::const_iterator;
+
+    bool isEmpty() const {
+        return items.isEmpty();
+    }
+
+    int count() const {
+        return items.count();
+    }
+
+    bool contains(const K &key) const {
+        const int i = lowerBoundIndex(key);
+        return i < items.count() && !(key < items.at(i).first);
+    }
+
+    V value(const K &key, const V &defaultValue = V()) const {
+        const int i = lowerBoundIndex(key);
+        if (i < items.count() && !(key < items.at(i).first))
+            return items.at(i).second;
+        return defaultValue;
+    }
+
+    //!
+    //! Replaces the value if \e key already exists.
+    //!
+    void insert(const K &key, const V &value) {
+        const int i = lowerBoundIndex(key);
+        if (i < items.count() && !(key < items.at(i).first))
+            items[i].second = value;
+        else
+            items.insert(i, value_type {key, value});
+    }
+
+    //!
+    //! \return true if \e key existed
+    //!
+    bool remove(const K &key) {
+        const int i = lowerBoundIndex(key);
+        if (i < items.count() && !(key < items.at(i).first)) {
+            items.remove(i);
+            return true;
+        }
+        return false;
+    }
+
+    void clear() {
+        items.clear();
+    }
+
+    void reserve(const int size) {
+        items.reserve(size);
+    }
+
+    void squeeze() {
+        items.squeeze();
+    }
+
+    const_iterator constBegin() const { return items.constBegin(); }
+    const_iterator constEnd() const { return items.constEnd(); }
+    const_iterator begin() const { return items.constBegin(); }
+    const_iterator end() const { return items.constEnd(); }
+
+    bool operator == (const FlatMap<K, V> &other) const {
+        return items == other.items;
+    }
+
+private:
+    QVector<value_type> items; // sorted by key, keys unique
+
+    int lowerBoundIndex(const K &key) const {
+        const auto it = std::lower_bound(
+                items.constBegin(), items.constEnd(), key,
+                [](const value_type &item, const K &k) {
+                    return item.first < k;
+                }
+        );
+        return static_cast<int>(it - items.constBegin());
+    }
+};
+
+#endif // FLAT_MAP_H
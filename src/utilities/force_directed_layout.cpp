@@ -0,0 +1,605 @@
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <vector>
+#include <QDebug>
+#include <QHash>
+#include <QThread>
+#include <QThreadPool>
+#include "force_directed_layout.h"
+
+namespace {
+double vectorLength(const QPointF &v) {
+    return std::sqrt(QPointF::dotProduct(v, v));
+}
+
+//!
+//! Barnes–Hut quadtree of points of unit mass. The nodes are stored in a single vector.
+//!
+class QuadTree
+{
+public:
+    explicit QuadTree(const QVector<QPointF> &points);
+
+    //!
+    //! \return the Fruchterman–Reingold repulsion (magnitude k^2/d) on point \e pointIndex by
+    //!         the other points, where a cell seen at an angle smaller than about \e theta is
+    //!         approximated by its center of mass
+    //!
+    QPointF computeRepulsion(const int pointIndex, const double k2, const double theta) const;
+
+private:
+    struct Node
+    {
+        QPointF center; // of the square cell
+        double halfSize {0.0};
+        double mass {0.0};
+        QPointF massCenter;
+        int firstChild {-1}; // the 4 children are consecutive; -1: leaf
+        int point {-1}; // the only point in a leaf (-1: none, or several coincident points)
+    };
+    static constexpr int maxDepth {24}; // (points closer than this resolution share a leaf)
+
+    const QVector<QPointF> &points;
+    QVector<Node> nodes;
+
+    void insert(const int pointIndex);
+    void subdivide(const int nodeIndex);
+    static int childOffset(const Node &node, const QPointF &p);
+};
+
+QuadTree::QuadTree(const QVector<QPointF> &points)
+        : points(points) {
+    if (points.isEmpty())
+        return;
+
+    double left = points.first().x();
+    double right = left;
+    double top = points.first().y();
+    double bottom = top;
+    for (const QPointF &p: points) {
+        left = std::min(left, p.x());
+        right = std::max(right, p.x());
+        top = std::min(top, p.y());
+        bottom = std::max(bottom, p.y());
+    }
+
+    Node root;
+    root.center = QPointF((left + right) / 2, (top + bottom) / 2);
+    root.halfSize = std::max(right - left, bottom - top) / 2 + 1.0;
+
+    nodes.reserve(points.count() * 2 + 1);
+    nodes << root;
+    for (int i = 0; i < points.count(); ++i)
+        insert(i);
+}
+
+QPointF QuadTree::computeRepulsion(
+        const int pointIndex, const double k2, const double theta) const {
+    if (nodes.isEmpty())
+        return {0, 0};
+
+    const QPointF &p = points.at(pointIndex);
+    const double theta2 = theta * theta;
+    constexpr double minDistance2 = 1e-6;
+
+    QPointF force(0, 0);
+    std::vector<int> stack {0};
+    while (!stack.empty()) {
+        const Node &node = nodes.at(stack.back());
+        stack.pop_back();
+
+        if (node.mass == 0.0 || node.point == pointIndex)
+            continue;
+
+        const QPointF d = p - node.massCenter;
+        const double distance2 = QPointF::dotProduct(d, d);
+        const double cellSize = 2 * node.halfSize;
+        if (node.firstChild == -1 || cellSize * cellSize < theta2 * distance2) {
+            if (distance2 < minDistance2)
+                continue; // (includes the leaf of coincident points containing `p`)
+            force += d * (node.mass * k2 / distance2);
+        }
+        else {
+            for (int i = 0; i < 4; ++i)
+                stack.push_back(node.firstChild + i);
+        }
+    }
+    return force;
+}
+
+void QuadTree::insert(const int pointIndex) {
+    const QPointF &p = points.at(pointIndex);
+    int nodeIndex = 0;
+    for (int depth = 0; ; ++depth) {
+        if (nodes.at(nodeIndex).firstChild == -1) {
+            Node &leaf = nodes[nodeIndex];
+            if (leaf.mass == 0.0) {
+                leaf.point = pointIndex;
+                leaf.mass = 1.0;
+                leaf.massCenter = p;
+                return;
+            }
+            if (depth >= maxDepth) {
+                leaf.massCenter = (leaf.massCenter * leaf.mass + p) / (leaf.mass + 1.0);
+                leaf.mass += 1.0;
+                leaf.point = -1;
+                return;
+            }
+
+            // move the point of the leaf to a child
+            const int existingPoint = leaf.point;
+            subdivide(nodeIndex); // (invalidates `leaf`)
+
+            const Node &node = nodes.at(nodeIndex);
+            Node &child = nodes[node.firstChild + childOffset(node, points.at(existingPoint))];
+            child.point = existingPoint;
+            child.mass = 1.0;
+            child.massCenter = points.at(existingPoint);
+            nodes[nodeIndex].point = -1;
+        }
+
+        Node &node = nodes[nodeIndex];
+        node.massCenter = (node.massCenter * node.mass + p) / (node.mass + 1.0);
+        node.mass += 1.0;
+        nodeIndex = node.firstChild + childOffset(node, p);
+    }
+}
+
+void QuadTree::subdivide(const int nodeIndex) {
+    const QPointF center = nodes.at(nodeIndex).center;
+    const double h = nodes.at(nodeIndex).halfSize / 2;
+
+    nodes[nodeIndex].firstChild = nodes.count();
+    for (int i = 0; i < 4; ++i) {
+        Node child;
+        child.center = center + QPointF((i & 1) ? h : -h, (i & 2) ? h : -h);
+        child.halfSize = h;
+        nodes << child;
+    }
+}
+
+int QuadTree::childOffset(const Node &node, const QPointF &p) {
+    return (p.x() >= node.center.x() ? 1 : 0) | (p.y() >= node.center.y() ? 2 : 0);
+}
+
+//!
+//! Lists of integers stored contiguously (compressed sparse rows).
+//!
+struct IntLists
+{
+    QVector<int> offsets {0}; // list `i` is values[offsets[i], offsets[i + 1])
+    QVector<int> values;
+
+    static IntLists fromPairs(const int listsCount, const QVector<std::pair<int, int>> &pairs) {
+        // `pairs`: (list index, value)
+        IntLists lists;
+        lists.offsets.fill(0, listsCount + 1);
+        for (const auto &[listIndex, value]: pairs)
+            ++lists.offsets[listIndex + 1];
+        for (int i = 0; i < listsCount; ++i)
+            lists.offsets[i + 1] += lists.offsets[i];
+
+        lists.values.resize(pairs.count());
+        QVector<int> nextPos = lists.offsets;
+        for (const auto &[listIndex, value]: pairs)
+            lists.values[nextPos[listIndex]++] = value;
+        return lists;
+    }
+
+    const int *begin(const int i) const { return values.constData() + offsets.at(i); }
+    const int *end(const int i) const { return values.constData() + offsets.at(i + 1); }
+};
+
+//!
+//! Pushes overlapping boxes apart (along the axis of smaller overlap) until no two boxes are
+//! closer than \e gap, or the passes run out.
+//!
+void removeOverlaps(
+        QVector<QPointF> *centers, const QVector<QSizeF> &sizes, const double gap,
+        const std::atomic<bool> *canceled) {
+    constexpr int maxPassesCount = 100;
+    const int n = centers->count();
+
+    QVector<int> order(n);
+    for (int i = 0; i < n; ++i)
+        order[i] = i;
+
+    auto left = [&](const int i) { return centers->at(i).x() - sizes.at(i).width() / 2; };
+    auto right = [&](const int i) { return centers->at(i).x() + sizes.at(i).width() / 2; };
+    auto top = [&](const int i) { return centers->at(i).y() - sizes.at(i).height() / 2; };
+    auto bottom = [&](const int i) { return centers->at(i).y() + sizes.at(i).height() / 2; };
+
+    for (int pass = 0; pass < maxPassesCount; ++pass) {
+        if (canceled != nullptr && canceled->load())
+            return;
+
+        std::sort(order.begin(), order.end(), [&](const int i, const int j) {
+            return left(i) < left(j);
+        });
+
+        bool moved = false;
+        for (int a = 0; a < n; ++a) {
+            const int i = order.at(a);
+            for (int b = a + 1; b < n; ++b) {
+                const int j = order.at(b);
+                if (left(j) >= right(i) + gap)
+                    break;
+
+                const double overlapX
+                        = std::min(right(i), right(j)) - std::max(left(i), left(j)) + gap;
+                const double overlapY
+                        = std::min(bottom(i), bottom(j)) - std::max(top(i), top(j)) + gap;
+                if (overlapX <= 0 || overlapY <= 0)
+                    continue;
+
+                QPointF &ci = (*centers)[i];
+                QPointF &cj = (*centers)[j];
+                if (overlapX < overlapY) {
+                    const double dx = (cj.x() >= ci.x()) ? overlapX / 2 : -overlapX / 2;
+                    ci.rx() -= dx;
+                    cj.rx() += dx;
+                }
+                else {
+                    const double dy = (cj.y() >= ci.y()) ? overlapY / 2 : -overlapY / 2;
+                    ci.ry() -= dy;
+                    cj.ry() += dy;
+                }
+                moved = true;
+            }
+        }
+        if (!moved)
+            return;
+    }
+}
+
+//!
+//! Lays out the items of one level (moves \e centers), and removes overlaps between them.
+//! \return false if canceled
+//!
+bool layOutLevel(
+        QVector<QPointF> *centers, const QVector<QSizeF> &sizes,
+        const QVector<std::pair<int, int>> &edges,
+        const ForceDirectedLayout::Parameters &parameters, QThreadPool *threadPool,
+        const std::atomic<bool> *canceled) {
+    auto isCanceled = [canceled]() {
+        return canceled != nullptr && canceled->load();
+    };
+
+    const int n = centers->count();
+    if (n <= 1)
+        return !isCanceled();
+
+    QVector<QPointF> &positions = *centers;
+    double sumOfDiagonals = 0.0;
+    for (int i = 0; i < n; ++i) {
+        sumOfDiagonals += std::hypot(sizes.at(i).width(), sizes.at(i).height());
+
+        // (a small deterministic jitter separates coincident items)
+        constexpr double goldenAngle = 2.39996;
+        positions[i] += QPointF(std::cos(i * goldenAngle), std::sin(i * goldenAngle));
+    }
+
+    const double k = (parameters.idealEdgeLength > 0)
+            ? parameters.idealEdgeLength : sumOfDiagonals / n;
+
+    // adjacency lists
+    IntLists neighbors;
+    {
+        QVector<std::pair<int, int>> pairs;
+        for (const auto &[a, b]: edges) {
+            if (a != b)
+                pairs << std::make_pair(a, b) << std::make_pair(b, a);
+        }
+        neighbors = IntLists::fromPairs(n, pairs);
+    }
+
+    // forces, computed in parallel
+    QPointF centroid;
+    QVector<QPointF> forces(n);
+    auto computeForces = [&](const QuadTree &tree, const int begin, const int end) {
+        for (int i = begin; i < end; ++i) {
+            const QPointF &p = positions.at(i);
+            QPointF force = tree.computeRepulsion(i, k * k, parameters.theta);
+
+            for (const int *j = neighbors.begin(i); j != neighbors.end(i); ++j) {
+                const QPointF d = positions.at(*j) - p;
+                force += d * (vectorLength(d) / k);
+            }
+
+            // (keeps disconnected components from drifting apart)
+            const QPointF toCentroid = centroid - p;
+            force += toCentroid * (parameters.gravity * vectorLength(toCentroid) / k);
+
+            forces[i] = force;
+        }
+    };
+
+    const int threadCount = (threadPool != nullptr) ? threadPool->maxThreadCount() : 1;
+    const int chunkSize = std::max(64, (n + 4 * threadCount - 1) / (4 * threadCount));
+
+    //
+    const double initialTemperature = 2 * k;
+    const double finalTemperature = 0.01 * k;
+    const int iterationsCount = std::max(parameters.iterationsCount, 1);
+
+    for (int iteration = 0; iteration < iterationsCount; ++iteration) {
+        if (isCanceled())
+            return false;
+
+        const double temperature = finalTemperature
+                + (initialTemperature - finalTemperature)
+                  * (1.0 - double(iteration) / iterationsCount);
+
+        // forces
+        centroid = QPointF(0, 0);
+        for (const QPointF &p: qAsConst(positions))
+            centroid += p;
+        centroid = centroid / n;
+
+        const QuadTree tree(positions);
+        if (threadPool == nullptr || n <= chunkSize) {
+            computeForces(tree, 0, n);
+        }
+        else {
+            for (int begin = 0; begin < n; begin += chunkSize) {
+                const int end = std::min(begin + chunkSize, n);
+                threadPool->start(new FunctionRunnable([&computeForces, &tree, begin, end]() {
+                    computeForces(tree, begin, end);
+                }));
+            }
+            threadPool->waitForDone();
+        }
+
+        // move, by at most `temperature`
+        for (int i = 0; i < n; ++i) {
+            const double magnitude = vectorLength(forces.at(i));
+            if (magnitude > 0)
+                positions[i] += forces.at(i) * (std::min(magnitude, temperature) / magnitude);
+        }
+    }
+
+    //
+    removeOverlaps(centers, sizes, parameters.minGap, canceled);
+    return !isCanceled();
+}
+
+//!
+//! An item in a level: a box (index >= 0) or a group (index -1 - g).
+//!
+int boxItem(const int boxIndex) {
+    return boxIndex;
+}
+
+int groupItem(const int groupIndex) {
+    return -1 - groupIndex;
+}
+} // namespace
+
+ForceDirectedLayout::Result ForceDirectedLayout::compute(
+        const Input &input, const Parameters &parameters, QThreadPool *threadPool,
+        const std::atomic<bool> *canceled) {
+    const int boxesCount = input.boxRects.count();
+    const int groupsCount = input.groupParents.count();
+    Q_ASSERT(input.boxParentGroups.count() == boxesCount);
+    Q_ASSERT(input.groupRects.count() == groupsCount);
+
+    // containers: the groups, and the top level (index `groupsCount`)
+    const int topLevel = groupsCount;
+    auto containerOfGroup = [&](const int g) {
+        const int parent = input.groupParents.at(g);
+        return (parent == -1) ? topLevel : parent;
+    };
+    auto containerOfBox = [&](const int i) {
+        const int parent = input.boxParentGroups.at(i);
+        return (parent == -1) ? topLevel : parent;
+    };
+
+    IntLists containerChildBoxes;
+    IntLists containerChildGroups;
+    {
+        QVector<std::pair<int, int>> pairs;
+        for (int i = 0; i < boxesCount; ++i)
+            pairs << std::make_pair(containerOfBox(i), i);
+        containerChildBoxes = IntLists::fromPairs(groupsCount + 1, pairs);
+
+        pairs.clear();
+        for (int g = 0; g < groupsCount; ++g)
+            pairs << std::make_pair(containerOfGroup(g), g);
+        containerChildGroups = IntLists::fromPairs(groupsCount + 1, pairs);
+    }
+
+    // containers in post-order (children before parents)
+    QVector<int> containersInPostOrder;
+    {
+        QVector<std::pair<int, bool>> stack {{topLevel, false}}; // (container, expanded?)
+        while (!stack.isEmpty()) {
+            const auto [container, expanded] = stack.takeLast();
+            if (expanded) {
+                containersInPostOrder << container;
+                continue;
+            }
+            stack << std::make_pair(container, true);
+            for (const int *g = containerChildGroups.begin(container);
+                    g != containerChildGroups.end(container); ++g) {
+                stack << std::make_pair(*g, false);
+            }
+        }
+    }
+
+    // assign each edge to the lowest container having both ends, as an edge between the child
+    // items of the container that contain the ends
+    QVector<QVector<std::pair<int, int>>> containerEdges(groupsCount + 1); // (item, item)
+    {
+        // the items containing box `i`, from the box itself up to a top-level item
+        auto getItemsChain = [&](const int i) {
+            QVector<int> chain {boxItem(i)};
+            int g = input.boxParentGroups.at(i);
+            for (int depth = 0; g != -1 && depth < groupsCount; ++depth) {
+                chain << groupItem(g);
+                g = input.groupParents.at(g);
+            }
+            return chain;
+        };
+        auto containerOfItem = [&](const int item) {
+            return (item >= 0) ? containerOfBox(item) : containerOfGroup(-1 - item);
+        };
+
+        for (const auto &[a, b]: input.edges) {
+            if (a == b || a < 0 || b < 0 || a >= boxesCount || b >= boxesCount)
+                continue;
+
+            const QVector<int> chainA = getItemsChain(a);
+            const QVector<int> chainB = getItemsChain(b);
+
+            // (compare from the top level down, until the chains diverge)
+            int ia = chainA.count() - 1;
+            int ib = chainB.count() - 1;
+            while (ia > 0 && ib > 0 && chainA.at(ia) == chainB.at(ib)) {
+                --ia;
+                --ib;
+            }
+            const int itemA = chainA.at(ia);
+            const int itemB = chainB.at(ib);
+            if (itemA == itemB || containerOfItem(itemA) != containerOfItem(itemB))
+                continue;
+            containerEdges[containerOfItem(itemA)] << std::make_pair(itemA, itemB);
+        }
+    }
+
+    //
+    Result result {input.boxRects, input.groupRects};
+
+    std::function<void (const int, const QPointF &)> translateGroup;
+    translateGroup = [&](const int g, const QPointF &displacement) {
+        result.groupRects[g].translate(displacement);
+        for (const int *i = containerChildBoxes.begin(g); i != containerChildBoxes.end(g); ++i)
+            result.boxRects[*i].translate(displacement);
+        for (const int *h = containerChildGroups.begin(g); h != containerChildGroups.end(g); ++h)
+            translateGroup(*h, displacement);
+    };
+
+    for (const int container: qAsConst(containersInPostOrder)) {
+        // items
+        QVector<int> items;
+        QHash<int, int> itemToLocalIndex;
+        QVector<QPointF> centers;
+        QVector<QSizeF> sizes;
+        {
+            auto addItem = [&](const int item, const QRectF &rect) {
+                itemToLocalIndex.insert(item, items.count());
+                items << item;
+                centers << rect.center();
+                sizes << rect.size();
+            };
+            for (const int *i = containerChildBoxes.begin(container);
+                    i != containerChildBoxes.end(container); ++i) {
+                addItem(boxItem(*i), result.boxRects.at(*i));
+            }
+            for (const int *g = containerChildGroups.begin(container);
+                    g != containerChildGroups.end(container); ++g) {
+                addItem(groupItem(*g), result.groupRects.at(*g));
+            }
+        }
+
+        if (items.isEmpty())
+            continue; // (an empty group keeps its rect)
+
+        QVector<std::pair<int, int>> edges;
+        for (const auto &[itemA, itemB]: qAsConst(containerEdges[container]))
+            edges << std::make_pair(itemToLocalIndex.value(itemA), itemToLocalIndex.value(itemB));
+
+        // lay out
+        const QVector<QPointF> oldCenters = centers;
+        if (!layOutLevel(&centers, sizes, edges, parameters, threadPool, canceled))
+            return {};
+
+        QVector<QRectF> itemRects;
+        for (int index = 0; index < items.count(); ++index) {
+            const int item = items.at(index);
+            const QPointF displacement = centers.at(index) - oldCenters.at(index);
+            if (item >= 0) {
+                result.boxRects[item].translate(displacement);
+                itemRects << result.boxRects.at(item);
+            }
+            else {
+                translateGroup(-1 - item, displacement);
+                itemRects << result.groupRects.at(-1 - item);
+            }
+        }
+
+        // fit the group to its contents
+        if (container != topLevel) {
+            double left = itemRects.first().left();
+            double top = itemRects.first().top();
+            double right = itemRects.first().right();
+            double bottom = itemRects.first().bottom();
+            for (const QRectF &rect: qAsConst(itemRects)) {
+                left = std::min(left, rect.left());
+                top = std::min(top, rect.top());
+                right = std::max(right, rect.right());
+                bottom = std::max(bottom, rect.bottom());
+            }
+            result.groupRects[container] = QRectF(left, top, right - left, bottom - top)
+                    .marginsAdded(parameters.groupMargins);
+        }
+    }
+
+    // keep the top-left corner of the bounding rect
+    const QVector<QRectF> oldRects = input.boxRects + input.groupRects;
+    const QVector<QRectF> newRects = result.boxRects + result.groupRects;
+    if (!oldRects.isEmpty()) {
+        QPointF oldTopLeft = oldRects.first().topLeft();
+        QPointF newTopLeft = newRects.first().topLeft();
+        for (int i = 1; i < oldRects.count(); ++i) {
+            oldTopLeft = QPointF(
+                    std::min(oldTopLeft.x(), oldRects.at(i).left()),
+                    std::min(oldTopLeft.y(), oldRects.at(i).top()));
+            newTopLeft = QPointF(
+                    std::min(newTopLeft.x(), newRects.at(i).left()),
+                    std::min(newTopLeft.y(), newRects.at(i).top()));
+        }
+
+        const QPointF offset = oldTopLeft - newTopLeft;
+        for (QRectF &rect: result.boxRects)
+            rect.translate(offset);
+        for (QRectF &rect: result.groupRects)
+            rect.translate(offset);
+    }
+
+    return result;
+}
+
+ForceDirectedLayout::ForceDirectedLayout(
+        const Input &input, const Parameters &parameters, QObject *parent)
+            : QObject(parent)
+            , input(input)
+            , parameters(parameters) {
+}
+
+void ForceDirectedLayout::start() {
+    if (job.isRunning()) {
+        qWarning().noquote() << "layout already started";
+        return;
+    }
+
+    job.start([this](const std::atomic<bool> &canceled) {
+        run(canceled);
+    });
+}
+
+void ForceDirectedLayout::cancel() {
+    job.cancel();
+}
+
+ForceDirectedLayout::Result ForceDirectedLayout::getResult() const {
+    return result;
+}
+
+void ForceDirectedLayout::run(const std::atomic<bool> &canceled) {
+    QThreadPool forcesThreadPool;
+    forcesThreadPool.setMaxThreadCount(std::max(QThread::idealThreadCount(), 1));
+
+    result = compute(input, parameters, &forcesThreadPool, &canceled);
+    emit finished(!canceled);
+}
@@ -0,0 +1,92 @@
+#ifndef FORCE_DIRECTED_LAYOUT_H
+#define FORCE_DIRECTED_LAYOUT_H
+
+#include <atomic>
+#include <QMarginsF>
+#include <QObject>
+#include <QRectF>
+#include <QVector>
+#include "utilities/background_job.h"
+
+class QThreadPool;
+
+//!
+//! Force-directed layout (Fruchterman–Reingold) of boxes connected by edges and nested in
+//! groups, computed on a background thread.
+//!
+//! The layout is hierarchical: the contents of each group are laid out first, then the group
+//! takes part in the layout of its parent (or of the top level) as a single box fitting its
+//! contents, so the containment of groups is kept. An edge takes part at the lowest level
+//! containing both of its ends, between the boxes/groups that contain the ends at that level.
+//!
+//! At each level, items repel each other, with the repulsion approximated by a Barnes–Hut
+//! quadtree, edges pull their items together, and a gravity towards the centroid keeps
+//! disconnected items together. The forces are computed in parallel by a thread pool. Finally,
+//! overlaps between the items are removed.
+//!
+//! The input is a compact snapshot (indices instead of IDs), so the computation does not touch
+//! any live object.
+//!
+class ForceDirectedLayout : public QObject
+{
+    Q_OBJECT
+public:
+    struct Input
+    {
+        QVector<QRectF> boxRects;
+        QVector<std::pair<int, int>> edges; // (box index, box index)
+        QVector<int> boxParentGroups; // for each box, the index of its innermost group, or -1
+        QVector<int> groupParents; // for each group, the index of its parent group, or -1
+        QVector<QRectF> groupRects; // (groups having no box or group in them keep their rects)
+    };
+
+    struct Parameters
+    {
+        int iterationsCount {300}; // per level
+        double idealEdgeLength {0.0}; // <= 0: determined from the sizes of the items at each level
+        double theta {0.8}; // Barnes–Hut opening criterion (0: no approximation)
+        double gravity {1.0}; // pull towards the centroid, relative to the attraction of an edge
+        QMarginsF groupMargins {24, 24, 24, 24}; // between a group's boundary and its contents
+        double minGap {24.0}; // between items after overlap removal
+    };
+
+    struct Result
+    {
+        QVector<QRectF> boxRects; // sizes unchanged
+        QVector<QRectF> groupRects; // fitting their contents
+    };
+
+    //!
+    //! Computes the layout in the calling thread (except that the forces are computed by
+    //! \e threadPool).
+    //! \return the new rects, translated so that the bounding rect of all boxes and groups keeps
+    //!         its top-left corner. Returns an empty result if canceled.
+    //!
+    static Result compute(
+            const Input &input, const Parameters &parameters, QThreadPool *threadPool,
+            const std::atomic<bool> *canceled = nullptr);
+
+    explicit ForceDirectedLayout(
+            const Input &input, const Parameters &parameters, QObject *parent = nullptr);
+    void start();
+    void cancel(); // can be called from any thread
+
+    //!
+    //! Valid after \c finished() is emitted with \e ok = true.
+    //!
+    Result getResult() const;
+
+signals:
+    void finished(const bool ok); // `ok` is false if canceled
+
+private:
+    const Input input;
+    const Parameters parameters;
+
+    Result result; // written by `job` before `finished()` is emitted
+    BackgroundJob job; // (last member, so that it's destroyed first)
+
+    void run(const std::atomic<bool> &canceled); // runs in `job`
+};
+
+#endif // FORCE_DIRECTED_LAYOUT_H
@@ -1,5 +1,6 @@
 #include <QVector>
 #include "geometry_util.h"
+#include "numbers_util.h"
 
 bool rectEdgeIntersectsWithLine(
         const QRectF &rect, const QLineF &line, QPointF *intersectionPoint) {
@@ -96,3 +97,59 @@ QPointF getProjectionOnLine(
     }
     return line.pointAt(t);
 }
+
+QPointF computeLineEndOnRectEdge(const QRectF &rect, const QPointF &point) {
+    QPointF intersectionPoint;
+    const bool intersects
+            = rectEdgeIntersectsWithLine(rect, QLineF(rect.center(), point), &intersectionPoint);
+    return intersects ? intersectionPoint : rect.center();
+}
+
+QLineF computeArrowLineConnectingRects(
+        const QRectF &fromRect, const QRectF &toRect,
+        const int parallelIndex, const int parallelCount) {
+    // Compute the vector for translating the center-to-center line. The result must be invariant
+    // if `fromRect` and `toRect` are swapped.
+    QPointF vecTranslation;
+    {
+        constexpr double spacing = 22;
+        const double shiftDistance = (parallelIndex - (parallelCount - 1.0) / 2.0) * spacing;
+
+        //
+        QPointF p1 = fromRect.center();
+        QPointF p2 = toRect.center();
+
+        const int x1 = nearestInteger(p1.x() * 100);
+        const int x2 = nearestInteger(p2.x() * 100);
+        if (x1 > x2) {
+            std::swap(p1, p2);
+        }
+        else if (x1 == x2) {
+            const int y1 = nearestInteger(p1.y() * 100);
+            const int y2 = nearestInteger(p2.y() * 100);
+            if (y1 > y2)
+                std::swap(p1, p2);
+        }
+
+        const QLineF lineNormal = QLineF(p1, p2).normalVector().unitVector();
+        const QPointF vecNormal(lineNormal.dx(), lineNormal.dy());
+        vecTranslation = vecNormal * shiftDistance;
+    }
+
+    //
+    const QLineF lineC2CTranslated
+            = QLineF(fromRect.center(), toRect.center())
+              .translated(vecTranslation);
+
+    //
+    bool intersect;
+    QPointF intersectionPoint;
+
+    intersect = rectEdgeIntersectsWithLine(fromRect, lineC2CTranslated, &intersectionPoint);
+    const QPointF startPoint = intersect ?  intersectionPoint : fromRect.center();
+
+    intersect = rectEdgeIntersectsWithLine(toRect, lineC2CTranslated, &intersectionPoint);
+    const QPointF endPoint = intersect ? intersectionPoint : toRect.center();
+
+    return {startPoint, endPoint};
+}
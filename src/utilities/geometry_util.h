@@ -40,5 +40,20 @@ QPainterPath tiltedRect(const QLineF &line, const double lineThickness);
 QPointF getProjectionOnLine(
         const QPointF &point, const QLineF &line, const bool limitToLineSegment);
 
+//!
+//! \return the point where the line from the center of \e rect to \e point leaves \e rect, or
+//!         the center of \e rect if \e point is inside \e rect
+//!
+QPointF computeLineEndOnRectEdge(const QRectF &rect, const QPointF &point);
+
+//!
+//! Computes the line of an arrow going from \e fromRect to \e toRect. The center-to-center line
+//! is translated sideways according to \e parallelIndex, so that the \e parallelCount arrows
+//! connecting the same pair of rects don't overlap, and is then cut at the edges of the rects.
+//!
+QLineF computeArrowLineConnectingRects(
+        const QRectF &fromRect, const QRectF &toRect,
+        const int parallelIndex, const int parallelCount);
+
 
 #endif // GEOMETRY_UTIL_H
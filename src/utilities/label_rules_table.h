@@ -0,0 +1,80 @@
+#ifndef LABEL_RULES_TABLE_H
+#define LABEL_RULES_TABLE_H
+
+#include <utility>
+#include <QHash>
+#include <QSet>
+#include <QVector>
+#include "utilities/symbol.h"
+
+//!
+//! Compiled form of an ordered list of (label, value) rules, where the value for a card is that
+//! of the first rule whose label the card has. Each label is mapped to the index of its first
+//! rule, so a lookup costs one hash lookup per label of the card (rather than a scan over the
+//! rules).
+//!
+//! Type \e V must have operator == implemented.
+//!
+template <class V>
+class LabelRulesTable
+{
+public:
+    LabelRulesTable() {}
+
+    //!
+    //! \param rules: in order of precedence. Rules of a label after its first one are ignored.
+    //!
+    explicit LabelRulesTable(const QVector<std::pair<Symbol, V>> &rules) {
+        for (const auto &[label, value]: rules) {
+            if (labelToRuleIndex.contains(label))
+                continue;
+            labelToRuleIndex.insert(label, values.count());
+            values << value;
+        }
+    }
+
+    bool isEmpty() const {
+        return values.isEmpty();
+    }
+
+    //!
+    //! \return nullptr if no rule applies to \e labels
+    //!
+    const V *lookUp(const QSet<Symbol> &labels) const {
+        const int index = lookUpRuleIndex(labels);
+        return (index == -1) ? nullptr : &values.at(index);
+    }
+
+    V value(const QSet<Symbol> &labels, const V &defaultValue = V()) const {
+        const V *v = lookUp(labels);
+        return (v == nullptr) ? defaultValue : *v;
+    }
+
+    //!
+    //! \return whether this table and \e other give the same result for \e labels (i.e., whether
+    //!         a card with \e labels is unaffected when the rules change from one to the other)
+    //!
+    bool givesSameResult(const LabelRulesTable &other, const QSet<Symbol> &labels) const {
+        const V *v1 = lookUp(labels);
+        const V *v2 = other.lookUp(labels);
+        if (v1 == nullptr || v2 == nullptr)
+            return v1 == v2;
+        return *v1 == *v2;
+    }
+
+private:
+    QHash<Symbol, int> labelToRuleIndex;
+    QVector<V> values;
+
+    int lookUpRuleIndex(const QSet<Symbol> &labels) const {
+        int minIndex = -1;
+        for (const Symbol &label: labels) {
+            const int index = labelToRuleIndex.value(label, -1);
+            if (index != -1 && (minIndex == -1 || index < minIndex))
+                minIndex = index;
+        }
+        return minIndex;
+    }
+};
+
+#endif // LABEL_RULES_TABLE_H
@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <QMutexLocker>
+#include <QTextDocument>
+#include <QThread>
+#include "background_job.h"
+#include "markdown_render_cache.h"
+
+namespace {
+int computeCost(const QString &markdown) {
+    return std::max(1, int(markdown.length()));
+}
+} // namespace
+
+MarkdownRenderCache::MarkdownRenderCache(
+        const Formatter &formatter, const int maxCachedCharacters, QObject *parent)
+            : QObject(parent)
+            , formatter(formatter)
+            , cache(maxCachedCharacters) {
+    // (leave a core for the GUI thread)
+    threadPool.setMaxThreadCount(std::max(1, QThread::idealThreadCount() - 1));
+}
+
+MarkdownRenderCache::~MarkdownRenderCache() {
+    {
+        QMutexLocker locker(&mutex);
+        isStopping = true;
+    }
+    threadPool.waitForDone();
+
+    for (const auto &[markdown, document]: qAsConst(renderedDocuments))
+        delete document;
+}
+
+const QTextDocument *MarkdownRenderCache::get(const QString &markdown) {
+    return cache.object(markdown);
+}
+
+const QTextDocument *MarkdownRenderCache::renderNow(const QString &markdown) {
+    if (const QTextDocument *document = cache.object(markdown); document != nullptr)
+        return document;
+
+    const int cost = computeCost(markdown);
+    if (cost > cache.maxCost())
+        return nullptr;
+
+    QTextDocument *document = render(markdown, formatter);
+    cache.insert(markdown, document, cost);
+    return document;
+}
+
+void MarkdownRenderCache::requestRendering(
+        const QString &markdown, const Priority priority,
+        std::function<void (const QTextDocument *)> callback,
+        QPointer<QObject> callbackContext) {
+    if (const QTextDocument *document = cache.object(markdown); document != nullptr) {
+        if (callback && !callbackContext.isNull())
+            callback(document);
+        return;
+    }
+
+    //
+    auto it = pendingTextToCallbacks.find(markdown);
+    const bool isPending = (it != pendingTextToCallbacks.end());
+    if (!isPending)
+        it = pendingTextToCallbacks.insert(markdown, {});
+    if (callback)
+        it.value() << std::make_pair(callback, callbackContext);
+
+    //
+    QMutexLocker locker(&mutex);
+    if (!isPending) {
+        if (priority == Priority::Visible)
+            visibleQueue << markdown;
+        else
+            backgroundQueue << markdown;
+        startWorkerIfNeeded();
+    }
+    else if (priority == Priority::Visible) {
+        // (does nothing if `markdown` is being rendered)
+        if (backgroundQueue.removeOne(markdown))
+            visibleQueue << markdown;
+    }
+}
+
+int MarkdownRenderCache::getCachedCount() const {
+    return cache.count();
+}
+
+void MarkdownRenderCache::startWorkerIfNeeded() {
+    const int queuedCount = visibleQueue.count() + backgroundQueue.count();
+    if (runningWorkersCount >= std::min(queuedCount, threadPool.maxThreadCount()))
+        return;
+
+    ++runningWorkersCount;
+    threadPool.start(new FunctionRunnable([this]() {
+        runWorker();
+    }));
+}
+
+void MarkdownRenderCache::runWorker() {
+    while (true) {
+        QString markdown;
+        {
+            QMutexLocker locker(&mutex);
+            if (isStopping || (visibleQueue.isEmpty() && backgroundQueue.isEmpty())) {
+                --runningWorkersCount;
+                return;
+            }
+            markdown = !visibleQueue.isEmpty()
+                    ? visibleQueue.takeFirst() : backgroundQueue.takeFirst();
+        }
+
+        QTextDocument *document = render(markdown, formatter);
+        document->moveToThread(thread());
+        {
+            QMutexLocker locker(&mutex);
+            renderedDocuments << std::make_pair(markdown, document);
+        }
+        QMetaObject::invokeMethod(
+                this, &MarkdownRenderCache::onDocumentsRendered, Qt::QueuedConnection);
+    }
+}
+
+void MarkdownRenderCache::onDocumentsRendered() {
+    QVector<std::pair<QString, QTextDocument *>> documents;
+    {
+        QMutexLocker locker(&mutex);
+        documents.swap(renderedDocuments);
+    }
+
+    for (const auto &[markdown, document]: qAsConst(documents)) {
+        const auto callbacks = pendingTextToCallbacks.take(markdown);
+        for (const auto &[callback, callbackContext]: callbacks) {
+            if (!callbackContext.isNull())
+                callback(document);
+        }
+
+        cache.insert(markdown, document, computeCost(markdown)); // (deletes `document` if too long)
+    }
+}
+
+QTextDocument *MarkdownRenderCache::render(const QString &markdown, const Formatter &formatter) {
+    auto *document = new QTextDocument;
+    document->setMarkdown(markdown);
+    if (formatter)
+        formatter(document);
+    return document;
+}
@@ -0,0 +1,94 @@
+#ifndef MARKDOWN_RENDER_CACHE_H
+#define MARKDOWN_RENDER_CACHE_H
+
+#include <functional>
+#include <QCache>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QPointer>
+#include <QStringList>
+#include <QThreadPool>
+#include <QVector>
+
+class QTextDocument;
+
+//!
+//! Caches markdown texts parsed into \c QTextDocument's, keyed by the text (so that a text is
+//! parsed again only when it has changed). Texts not cached are parsed on worker threads, where
+//! the requests for visible items go before those for background prefetching.
+//!
+//! The cached documents are to be copied (\c QTextDocument::clone()) to where they are shown.
+//! Use this object in the GUI thread only.
+//!
+class MarkdownRenderCache : public QObject
+{
+    Q_OBJECT
+public:
+    //!
+    //! Applied to each document after the markdown is parsed, in a worker thread (so it must
+    //! only touch the document).
+    //!
+    using Formatter = std::function<void (QTextDocument *document)>;
+
+    //!
+    //! \param maxCachedCharacters: the cache evicts least recently used documents when the total
+    //!                             length of cached texts exceeds this
+    //!
+    explicit MarkdownRenderCache(
+            const Formatter &formatter, const int maxCachedCharacters,
+            QObject *parent = nullptr);
+    ~MarkdownRenderCache();
+
+    enum class Priority {Background, Visible};
+
+    //!
+    //! \return nullptr if \e markdown is not cached
+    //!
+    const QTextDocument *get(const QString &markdown);
+
+    //!
+    //! Parses \e markdown in the calling thread if it is not cached.
+    //! \return nullptr if \e markdown is too long to be cached
+    //!
+    const QTextDocument *renderNow(const QString &markdown);
+
+    //!
+    //! Parses \e markdown in a worker thread if it is not cached or being parsed. If already
+    //! requested, the request is raised to \e priority if that is higher.
+    //! \param callback: (can be empty) called in the GUI thread when \e markdown is cached
+    //!                  (immediately if it is already cached). \e document is valid only during
+    //!                  the call.
+    //!
+    void requestRendering(
+            const QString &markdown, const Priority priority,
+            std::function<void (const QTextDocument *document)> callback,
+            QPointer<QObject> callbackContext);
+
+    int getCachedCount() const;
+
+private:
+    const Formatter formatter;
+    QCache<QString, QTextDocument> cache;
+
+    using Callback = std::function<void (const QTextDocument *document)>;
+    QHash<QString, QVector<std::pair<Callback, QPointer<QObject>>>> pendingTextToCallbacks;
+
+    // shared with worker threads (guarded by `mutex`)
+    QMutex mutex;
+    QStringList visibleQueue;
+    QStringList backgroundQueue;
+    QVector<std::pair<QString, QTextDocument *>> renderedDocuments;
+    int runningWorkersCount {0};
+    bool isStopping {false};
+
+    QThreadPool threadPool;
+
+    void startWorkerIfNeeded(); // call with `mutex` locked
+    void runWorker(); // runs in a worker thread
+    void onDocumentsRendered();
+
+    static QTextDocument *render(const QString &markdown, const Formatter &formatter);
+};
+
+#endif // MARKDOWN_RENDER_CACHE_H
@@ -0,0 +1,298 @@
+#include <algorithm>
+#include <cmath>
+#include <QMarginsF>
+#include <QPainter>
+#include <QTimer>
+#include "minimap_renderer.h"
+
+bool MinimapRenderer::Item::operator == (const Item &other) const {
+    return rect == other.rect
+            && fillColor == other.fillColor
+            && borderColor == other.borderColor;
+}
+
+MinimapRenderer::MinimapRenderer(const QSize &imageSize, QObject *parent)
+        : QObject(parent)
+        , imageSize(imageSize)
+        , image(imageSize, QImage::Format_ARGB32_Premultiplied)
+        , timer(new QTimer(this)) {
+    image.fill(backgroundColor);
+
+    timer->setSingleShot(true);
+    timer->setInterval(delayMsec);
+    connect(timer, &QTimer::timeout, this, [this]() {
+        startRenderPass();
+    });
+}
+
+void MinimapRenderer::setImageSize(const QSize &size) {
+    if (size == imageSize)
+        return;
+    imageSize = size;
+    image = QImage(imageSize, QImage::Format_ARGB32_Premultiplied);
+    invalidateAll();
+}
+
+void MinimapRenderer::setBackgroundColor(const QColor &color) {
+    if (color == backgroundColor)
+        return;
+    backgroundColor = color;
+    invalidateAll();
+}
+
+void MinimapRenderer::setPaused(const bool paused_) {
+    paused = paused_;
+    if (!paused)
+        schedule();
+}
+
+void MinimapRenderer::setItem(const ItemKey &key, const Item &item) {
+    int itemId = keyToItemId.value(key, -1);
+    if (itemId != -1) {
+        const Item oldItem = items.value(itemId).second;
+        if (oldItem == item)
+            return;
+        markSceneRectDirty(oldItem.rect);
+    }
+    else {
+        itemId = nextItemId++;
+        keyToItemId.insert(key, itemId);
+    }
+
+    items.insert(itemId, {key, item});
+    itemsIndex.set(itemId, item.rect);
+
+    if (isSceneRectFitting())
+        markSceneRectDirty(item.rect);
+    else
+        invalidateAll();
+}
+
+void MinimapRenderer::removeItem(const ItemKey &key) {
+    const int itemId = keyToItemId.value(key, -1);
+    if (itemId == -1)
+        return;
+
+    markSceneRectDirty(items.value(itemId).second.rect);
+
+    keyToItemId.remove(key);
+    items.remove(itemId);
+    itemsIndex.remove(itemId);
+
+    if (!isSceneRectFitting())
+        invalidateAll();
+}
+
+void MinimapRenderer::clear() {
+    keyToItemId.clear();
+    items.clear();
+    itemsIndex.clear();
+    invalidateAll();
+}
+
+QImage MinimapRenderer::getImage() const {
+    return image;
+}
+
+QRectF MinimapRenderer::getSceneRect() const {
+    return sceneRect;
+}
+
+QPointF MinimapRenderer::mapToScene(const QPointF &imagePos) const {
+    return sceneRect.topLeft() + imagePos / scale;
+}
+
+QRectF MinimapRenderer::mapFromScene(const QRectF &rect) const {
+    return {(rect.topLeft() - sceneRect.topLeft()) * scale, rect.size() * scale};
+}
+
+int MinimapRenderer::getRenderedTilesCount() const {
+    return renderedTilesCount;
+}
+
+bool MinimapRenderer::isSceneRectFitting() const {
+    const QRectF itemsBoundingRect = itemsIndex.boundingRect();
+    if (itemsBoundingRect.isNull())
+        return sceneRect.isNull();
+    if (sceneRect.isNull() || !sceneRect.contains(itemsBoundingRect))
+        return false;
+
+    // (re-fit when the items have shrunk a lot, so that they don't look too small)
+    constexpr double minSizeFraction = 0.25;
+    return itemsBoundingRect.width() >= sceneRect.width() * minSizeFraction
+            || itemsBoundingRect.height() >= sceneRect.height() * minSizeFraction;
+}
+
+void MinimapRenderer::markSceneRectDirty(const QRectF &rect) {
+    if (sceneRect.isNull() || image.isNull())
+        return;
+
+    // (with 2 pixels of margin for antialiasing)
+    const QRectF pixelRect = mapFromScene(rect).marginsAdded(QMarginsF(2, 2, 2, 2));
+    const int columnsCount = getColumnsCount();
+    const int rowsCount = getRowsCount();
+
+    const int col0 = std::max(int(std::floor(pixelRect.left() / tileSize)), 0);
+    const int col1 = std::min(int(std::floor(pixelRect.right() / tileSize)), columnsCount - 1);
+    const int row0 = std::max(int(std::floor(pixelRect.top() / tileSize)), 0);
+    const int row1 = std::min(int(std::floor(pixelRect.bottom() / tileSize)), rowsCount - 1);
+    for (int row = row0; row <= row1; ++row) {
+        for (int col = col0; col <= col1; ++col)
+            dirtyTiles << (row * columnsCount + col);
+    }
+
+    if (!dirtyTiles.isEmpty())
+        schedule();
+}
+
+void MinimapRenderer::invalidateAll() {
+    ++generation;
+    renderJob.cancel(); // (the render pass in progress, if any, is of the old generation)
+
+    fitSceneRect();
+    image.fill(backgroundColor);
+
+    dirtyTiles.clear();
+    if (sceneRect.isNull() || image.isNull()) {
+        emit imageUpdated();
+        return;
+    }
+
+    const int tilesCount = getColumnsCount() * getRowsCount();
+    for (int i = 0; i < tilesCount; ++i)
+        dirtyTiles << i;
+    schedule();
+}
+
+void MinimapRenderer::fitSceneRect() {
+    const QRectF itemsBoundingRect = itemsIndex.boundingRect();
+    if (itemsBoundingRect.isNull() || imageSize.isEmpty()) {
+        sceneRect = QRectF();
+        scale = 1.0;
+        return;
+    }
+
+    const double marginX = std::max(itemsBoundingRect.width() * sceneMarginFraction, 1.0);
+    const double marginY = std::max(itemsBoundingRect.height() * sceneMarginFraction, 1.0);
+    const QRectF region
+            = itemsBoundingRect.marginsAdded(QMarginsF(marginX, marginY, marginX, marginY));
+
+    scale = std::min(imageSize.width() / region.width(), imageSize.height() / region.height());
+
+    sceneRect = QRectF(QPointF(0, 0), QSizeF(imageSize) / scale);
+    sceneRect.moveCenter(region.center());
+}
+
+int MinimapRenderer::getColumnsCount() const {
+    return (imageSize.width() + tileSize - 1) / tileSize;
+}
+
+int MinimapRenderer::getRowsCount() const {
+    return (imageSize.height() + tileSize - 1) / tileSize;
+}
+
+void MinimapRenderer::schedule() {
+    // (Each change restarts the timer, so that the changes made in a row are rendered together.)
+    if (!paused)
+        timer->start();
+}
+
+void MinimapRenderer::startRenderPass() {
+    if (paused || renderJob.isRunning() || dirtyTiles.isEmpty())
+        return; // (if `renderJob` is running, will be started again when it finishes)
+
+    // snapshot of the items intersecting the dirty tiles
+    auto pass = std::make_shared<RenderPass>();
+    pass->generation = generation;
+    pass->backgroundColor = backgroundColor;
+    pass->sceneRect = sceneRect;
+    pass->scale = scale;
+
+    const int columnsCount = getColumnsCount();
+    const QRect imageRect(QPoint(0, 0), imageSize);
+    const double pixelInScene = 1.0 / scale;
+    for (const int tileIndex: qAsConst(dirtyTiles)) {
+        Tile tile;
+        tile.pixelRect = QRect(
+                (tileIndex % columnsCount) * tileSize, (tileIndex / columnsCount) * tileSize,
+                tileSize, tileSize) & imageRect;
+
+        const QRectF tileSceneRect = QRectF(
+                mapToScene(tile.pixelRect.topLeft()), QSizeF(tile.pixelRect.size()) / scale)
+                .marginsAdded(QMarginsF(pixelInScene, pixelInScene, pixelInScene, pixelInScene));
+        const QSet<int> itemIds = itemsIndex.queryIntersecting(tileSceneRect);
+
+        QVector<const std::pair<ItemKey, Item> *> tileItems;
+        for (const int itemId: itemIds)
+            tileItems << &items.find(itemId).value();
+        std::sort(tileItems.begin(), tileItems.end(), [](auto *a, auto *b) {
+            return a->first < b->first;
+        });
+        for (const auto *keyAndItem: qAsConst(tileItems))
+            tile.items << keyAndItem->second;
+
+        pass->tiles << tile;
+    }
+    dirtyTiles.clear();
+
+    //
+    renderPass = pass;
+    renderJob.start(
+            [pass](const std::atomic<bool> &canceled) {
+                render(pass.get(), canceled);
+            },
+            // onFinished
+            [this]() {
+                onRenderPassFinished();
+            },
+            this
+    );
+}
+
+void MinimapRenderer::onRenderPassFinished() {
+    const std::shared_ptr<RenderPass> pass = std::move(renderPass);
+
+    if (pass->generation == generation) {
+        QPainter painter(&image);
+        painter.setCompositionMode(QPainter::CompositionMode_Source);
+        for (const Tile &tile: qAsConst(pass->tiles))
+            painter.drawImage(tile.pixelRect.topLeft(), tile.image);
+        painter.end();
+
+        renderedTilesCount += pass->tiles.count();
+        emit imageUpdated();
+    }
+
+    // changes made while rendering
+    startRenderPass();
+}
+
+void MinimapRenderer::render(RenderPass *pass, const std::atomic<bool> &canceled) {
+    for (Tile &tile: pass->tiles) {
+        if (canceled)
+            return;
+
+        tile.image = QImage(tile.pixelRect.size(), QImage::Format_ARGB32_Premultiplied);
+        tile.image.fill(pass->backgroundColor);
+
+        QPainter painter(&tile.image);
+        painter.setRenderHint(QPainter::Antialiasing, true);
+        painter.translate(-tile.pixelRect.topLeft());
+        painter.scale(pass->scale, pass->scale);
+        painter.translate(-pass->sceneRect.topLeft());
+
+        for (const Item &item: qAsConst(tile.items)) {
+            if (item.borderColor.isValid())
+                painter.setPen(QPen(item.borderColor, 0)); // (cosmetic pen of 1 pixel)
+            else
+                painter.setPen(Qt::NoPen);
+
+            if (item.fillColor.isValid())
+                painter.setBrush(item.fillColor);
+            else
+                painter.setBrush(Qt::NoBrush);
+
+            painter.drawRect(item.rect);
+        }
+    }
+}
@@ -0,0 +1,127 @@
+#ifndef MINIMAP_RENDERER_H
+#define MINIMAP_RENDERER_H
+
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <QColor>
+#include <QHash>
+#include <QImage>
+#include <QObject>
+#include <QRectF>
+#include <QSet>
+#include <QSize>
+#include <QVector>
+#include "utilities/background_job.h"
+#include "utilities/rect_tree.h"
+
+class QTimer;
+
+//!
+//! Keeps a low-resolution render (a \c QImage) of a set of rectangular items, fitting the
+//! bounding rect of the items (plus a margin) into the image.
+//!
+//! The image is divided into tiles. A change of an item marks the tiles covering its old & new
+//! rects dirty, and only the dirty tiles are re-rendered, on a background thread, from a
+//! snapshot of the items intersecting them (found with a spatial index). All the tiles are
+//! re-rendered only when the image size or the background color changes, or when the items
+//! grow out of the region shown (the region is enlarged with a margin, so that this is rare).
+//! Nothing is done when nothing changes.
+//!
+//! Changes made within \c delayMsec are rendered together. Rendering is suspended while paused.
+//!
+class MinimapRenderer : public QObject
+{
+    Q_OBJECT
+public:
+    using ItemKey = std::pair<int, int>; // (layer, ID in the layer)
+
+    struct Item
+    {
+        QRectF rect;
+        QColor fillColor; // invalid: not filled
+        QColor borderColor; // invalid: no border
+
+        bool operator == (const Item &other) const;
+    };
+
+    explicit MinimapRenderer(const QSize &imageSize, QObject *parent = nullptr);
+
+    void setImageSize(const QSize &size);
+    void setBackgroundColor(const QColor &color);
+    void setPaused(const bool paused);
+
+    //!
+    //! Items of lower layers are drawn first.
+    //!
+    void setItem(const ItemKey &key, const Item &item);
+    void removeItem(const ItemKey &key); // does nothing if \e key is not found
+    void clear(); // removes all items
+
+    //
+    QImage getImage() const;
+    QRectF getSceneRect() const; // the region shown by the image (null if there's no item)
+    QPointF mapToScene(const QPointF &imagePos) const;
+    QRectF mapFromScene(const QRectF &sceneRect) const; // to image coordinates
+
+    int getRenderedTilesCount() const; // total, since construction
+
+    //
+    constexpr static int tileSize {32}; // in pixels
+    constexpr static int delayMsec {50};
+    constexpr static double sceneMarginFraction {0.25}; // of the size of the items' bounding rect
+
+signals:
+    void imageUpdated();
+
+private:
+    struct Tile
+    {
+        QRect pixelRect; // in the image
+        QVector<Item> items; // in the order of drawing
+        QImage image; // output
+    };
+    struct RenderPass
+    {
+        int generation;
+        QColor backgroundColor;
+        QRectF sceneRect;
+        double scale;
+        QVector<Tile> tiles;
+    };
+
+    QSize imageSize;
+    QColor backgroundColor {Qt::white};
+    bool paused {false};
+
+    QHash<ItemKey, int> keyToItemId;
+    QHash<int, std::pair<ItemKey, Item>> items;
+    RectTree itemsIndex;
+    int nextItemId {0};
+
+    QImage image;
+    QRectF sceneRect; // null if there's no item
+    double scale {1.0}; // image pixels per scene unit
+    int generation {0}; // incremented whenever all tiles are invalidated
+    QSet<int> dirtyTiles; // (tile index := row * columns count + column)
+    int renderedTilesCount {0};
+
+    QTimer *timer;
+    std::shared_ptr<RenderPass> renderPass; // the render pass in progress
+
+    bool isSceneRectFitting() const; // whether `sceneRect` still fits the items
+    void markSceneRectDirty(const QRectF &rect);
+    void invalidateAll(); // re-fits `sceneRect` & marks all tiles dirty
+    void fitSceneRect(); // sets `sceneRect` & `scale` to fit the items' bounding rect
+    int getColumnsCount() const;
+    int getRowsCount() const;
+    void schedule();
+    void startRenderPass();
+    void onRenderPassFinished();
+
+    static void render(RenderPass *pass, const std::atomic<bool> &canceled); // thread-safe
+
+    BackgroundJob renderJob; // (last member, so that it's destroyed first)
+};
+
+#endif // MINIMAP_RENDERER_H
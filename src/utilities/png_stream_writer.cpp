@@ -0,0 +1,256 @@
+#include <cstdlib>
+#include <zlib.h>
+#include <QtEndian>
+#include "png_stream_writer.h"
+
+namespace {
+constexpr int bytesPerPixel = 4;
+constexpr int idatChunkSize = 256 * 1024;
+constexpr int deflateOutputBufferSize = 64 * 1024;
+
+QByteArray bigEndianBytes(const quint32 value) {
+    QByteArray bytes(4, '\0');
+    qToBigEndian(value, bytes.data());
+    return bytes;
+}
+
+int paethPredictor(const int a, const int b, const int c) {
+    const int p = a + b - c;
+    const int pa = std::abs(p - a);
+    const int pb = std::abs(p - b);
+    const int pc = std::abs(p - c);
+    if (pa <= pb && pa <= pc)
+        return a;
+    if (pb <= pc)
+        return b;
+    return c;
+}
+} // namespace
+
+PngStreamWriter::~PngStreamWriter() {
+    endCompression();
+    if (file.isOpen())
+        file.close();
+}
+
+bool PngStreamWriter::open(const QString &filePath, const QSize &imageSize_) {
+    imageSize = imageSize_;
+    rowsWritten = 0;
+    if (imageSize.isEmpty()) {
+        errorMsg = "image is empty";
+        return false;
+    }
+
+    file.setFileName(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        errorMsg = file.errorString();
+        return false;
+    }
+
+    endCompression();
+    zStream = std::make_unique<z_stream>();
+    if (deflateInit(zStream.get(), Z_DEFAULT_COMPRESSION) != Z_OK) {
+        errorMsg = "could not initialize zlib";
+        zStream.reset();
+        file.close();
+        return false;
+    }
+    compressedData.clear();
+    deflateOutputBuffer = QByteArray(deflateOutputBufferSize, '\0');
+
+    const int rowSize = imageSize.width() * bytesPerPixel;
+    previousRow = QByteArray(rowSize, '\0');
+    currentRow = QByteArray(rowSize, '\0');
+    filteredRow = QByteArray(rowSize + 1, '\0');
+
+    // signature
+    static const char signature[8] {'\x89', 'P', 'N', 'G', '\r', '\n', '\x1A', '\n'};
+    if (file.write(signature, 8) != 8) {
+        errorMsg = file.errorString();
+        return false;
+    }
+
+    // IHDR
+    QByteArray header;
+    header.append(bigEndianBytes(quint32(imageSize.width())));
+    header.append(bigEndianBytes(quint32(imageSize.height())));
+    header.append(char(8)); // bit depth
+    header.append(char(6)); // color type: RGBA
+    header.append(char(0)); // compression method
+    header.append(char(0)); // filter method
+    header.append(char(0)); // interlace method: none
+    return writeChunk("IHDR", header);
+}
+
+bool PngStreamWriter::appendRows(const QImage &rows) {
+    Q_ASSERT(rows.format() == QImage::Format_ARGB32
+             || rows.format() == QImage::Format_ARGB32_Premultiplied);
+    if (!file.isOpen()) {
+        errorMsg = "file is not opened";
+        return false;
+    }
+    if (rows.width() != imageSize.width() || rowsWritten + rows.height() > imageSize.height()) {
+        errorMsg = "size of rows mismatches the image";
+        return false;
+    }
+
+    for (int y = 0; y < rows.height(); ++y) {
+        convertRowToRgba(rows, y, &currentRow);
+        filterRow(currentRow, previousRow, &filteredRow);
+        if (!compress(filteredRow.constData(), filteredRow.size(), Z_NO_FLUSH))
+            return false;
+        previousRow.swap(currentRow);
+    }
+    rowsWritten += rows.height();
+    return true;
+}
+
+bool PngStreamWriter::finish() {
+    if (!file.isOpen()) {
+        errorMsg = "file is not opened";
+        return false;
+    }
+    if (rowsWritten != imageSize.height()) {
+        errorMsg = "not all rows are written";
+        return false;
+    }
+
+    if (!compress(nullptr, 0, Z_FINISH))
+        return false;
+    endCompression();
+    if (!writeChunk("IEND", QByteArray()))
+        return false;
+
+    file.close();
+    return true;
+}
+
+void PngStreamWriter::abort() {
+    endCompression();
+    if (file.isOpen())
+        file.close();
+    file.remove();
+}
+
+QString PngStreamWriter::errorString() const {
+    return errorMsg;
+}
+
+void PngStreamWriter::convertRowToRgba(
+        const QImage &image, const int y, QByteArray *rgba) const {
+    const bool isPremultiplied = (image.format() == QImage::Format_ARGB32_Premultiplied);
+    const auto *pixels = reinterpret_cast<const QRgb *>(image.constScanLine(y));
+    char *out = rgba->data();
+
+    for (int x = 0; x < image.width(); ++x) {
+        const QRgb pixel = isPremultiplied ? qUnpremultiply(pixels[x]) : pixels[x];
+        out[0] = char(qRed(pixel));
+        out[1] = char(qGreen(pixel));
+        out[2] = char(qBlue(pixel));
+        out[3] = char(qAlpha(pixel));
+        out += bytesPerPixel;
+    }
+}
+
+void PngStreamWriter::filterRow(
+        const QByteArray &row, const QByteArray &prior, QByteArray *filtered) const {
+    const int n = row.size();
+    const auto *x = reinterpret_cast<const quint8 *>(row.constData());
+    const auto *b = reinterpret_cast<const quint8 *>(prior.constData());
+    // (`prior` is all zeros for the first row, as required)
+
+    auto filteredByte = [x, b](const int filterType, const int i) -> quint8 {
+        const int a = (i >= bytesPerPixel) ? x[i - bytesPerPixel] : 0;
+        const int c = (i >= bytesPerPixel) ? b[i - bytesPerPixel] : 0;
+        switch (filterType) {
+        case 1: return quint8(x[i] - a); // Sub
+        case 2: return quint8(x[i] - b[i]); // Up
+        case 4: return quint8(x[i] - paethPredictor(a, b[i], c)); // Paeth
+        default: return x[i]; // None
+        }
+    };
+
+    // choose filter type
+    int bestFilterType = 0;
+    qint64 bestSum = -1;
+    for (const int filterType: {0, 1, 2, 4}) {
+        qint64 sum = 0;
+        for (int i = 0; i < n; ++i)
+            sum += std::abs(int(qint8(filteredByte(filterType, i))));
+
+        if (bestSum < 0 || sum < bestSum) {
+            bestSum = sum;
+            bestFilterType = filterType;
+        }
+    }
+
+    //
+    auto *out = reinterpret_cast<quint8 *>(filtered->data());
+    out[0] = quint8(bestFilterType);
+    for (int i = 0; i < n; ++i)
+        out[i + 1] = filteredByte(bestFilterType, i);
+}
+
+bool PngStreamWriter::compress(const char *data, const int size, const int flush) {
+    if (!zStream) {
+        errorMsg = "compression is not started";
+        return false;
+    }
+
+    zStream->next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+    zStream->avail_in = uInt(size);
+
+    int result = Z_OK;
+    do {
+        zStream->next_out = reinterpret_cast<Bytef *>(deflateOutputBuffer.data());
+        zStream->avail_out = uInt(deflateOutputBuffer.size());
+
+        result = deflate(zStream.get(), flush);
+        if (result == Z_STREAM_ERROR) {
+            errorMsg = "zlib compression failed";
+            return false;
+        }
+        const int outputSize = deflateOutputBuffer.size() - int(zStream->avail_out);
+        compressedData.append(deflateOutputBuffer.constData(), outputSize);
+
+        if (compressedData.size() >= idatChunkSize) {
+            if (!writeChunk("IDAT", compressedData))
+                return false;
+            compressedData.clear();
+        }
+    } while (zStream->avail_out == 0 || (flush == Z_FINISH && result != Z_STREAM_END));
+    // (deflate() has consumed all input when it leaves some output space unused)
+
+    if (flush == Z_FINISH && !compressedData.isEmpty()) {
+        if (!writeChunk("IDAT", compressedData))
+            return false;
+        compressedData.clear();
+    }
+    return true;
+}
+
+void PngStreamWriter::endCompression() {
+    if (zStream) {
+        deflateEnd(zStream.get());
+        zStream.reset();
+    }
+}
+
+bool PngStreamWriter::writeChunk(const char *type, const QByteArray &data) {
+    uLong crc = crc32(0L, Z_NULL, 0);
+    crc = crc32(crc, reinterpret_cast<const Bytef *>(type), 4);
+    crc = crc32(crc, reinterpret_cast<const Bytef *>(data.constData()), uInt(data.size()));
+
+    QByteArray chunk;
+    chunk.reserve(data.size() + 12);
+    chunk.append(bigEndianBytes(quint32(data.size())));
+    chunk.append(type, 4);
+    chunk.append(data);
+    chunk.append(bigEndianBytes(quint32(crc)));
+
+    if (file.write(chunk) != chunk.size()) {
+        errorMsg = file.errorString();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,82 @@
+#ifndef PNG_STREAM_WRITER_H
+#define PNG_STREAM_WRITER_H
+
+#include <memory>
+#include <QByteArray>
+#include <QFile>
+#include <QImage>
+#include <QSize>
+#include <QString>
+
+struct z_stream_s;
+
+//!
+//! Writes a PNG file (8-bit RGBA, non-interlaced) whose rows are given in consecutive pieces,
+//! so that the whole image never needs to be in memory. The image data are compressed with
+//! zlib's streaming \c deflate().
+//!
+//! Usage: \c open(), then \c appendRows() until all rows are given, then \c finish(). Call
+//! \c abort() to discard the file written so far.
+//!
+class PngStreamWriter
+{
+public:
+    explicit PngStreamWriter() {}
+    ~PngStreamWriter();
+
+    //!
+    //! Creates (or truncates) the file and writes the PNG header.
+    //!
+    bool open(const QString &filePath, const QSize &imageSize);
+
+    //!
+    //! \param rows: the next rows of the image. Its width must equal that of the image, and its
+    //!              format must be \c Format_ARGB32 or \c Format_ARGB32_Premultiplied.
+    //!
+    bool appendRows(const QImage &rows);
+
+    //!
+    //! All rows must have been appended.
+    //!
+    bool finish();
+
+    //!
+    //! Closes and removes the file.
+    //!
+    void abort();
+
+    QString errorString() const;
+
+private:
+    QFile file;
+    QSize imageSize;
+    int rowsWritten {0};
+    QString errorMsg;
+
+    std::unique_ptr<z_stream_s> zStream; // (null if not initialized)
+    QByteArray deflateOutputBuffer;
+    QByteArray compressedData; // not written to an IDAT chunk yet
+    QByteArray previousRow; // (unfiltered, RGBA)
+    QByteArray currentRow;
+    QByteArray filteredRow;
+
+    void convertRowToRgba(const QImage &image, const int y, QByteArray *rgba) const;
+
+    //!
+    //! Chooses among the filter types None, Sub, Up & Paeth the one giving the smallest sum of
+    //! absolute values (a heuristic recommended by the PNG specification).
+    //!
+    void filterRow(const QByteArray &row, const QByteArray &prior, QByteArray *filtered) const;
+
+    //!
+    //! Compresses \e size bytes at \e data with \e flush (\c Z_NO_FLUSH or \c Z_FINISH), and
+    //! writes the compressed data in IDAT chunks of about \c idatChunkSize. With \c Z_FINISH,
+    //! all the remaining compressed data are written.
+    //!
+    bool compress(const char *data, const int size, const int flush);
+    void endCompression();
+
+    bool writeChunk(const char *type, const QByteArray &data);
+};
+
+#endif // PNG_STREAM_WRITER_H
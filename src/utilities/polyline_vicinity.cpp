@@ -0,0 +1,109 @@
+#include <algorithm>
+#include <cmath>
+#include "geometry_util.h"
+#include "margins_util.h"
+#include "polyline_vicinity.h"
+
+PolylineVicinity::PolylineVicinity(const double radius)
+        : radius(radius) {
+}
+
+void PolylineVicinity::setPoints(const QVector<QPointF> &points_) {
+    points = points_;
+    cachedPath = std::nullopt;
+
+    //
+    if (points.count() < 2) {
+        cachedBoundingRect = QRectF();
+        return;
+    }
+
+    double left = points.first().x();
+    double right = left;
+    double top = points.first().y();
+    double bottom = top;
+    for (const QPointF &p: qAsConst(points)) {
+        left = std::min(left, p.x());
+        right = std::max(right, p.x());
+        top = std::min(top, p.y());
+        bottom = std::max(bottom, p.y());
+    }
+    cachedBoundingRect
+            = QRectF(QPointF(left, top), QPointF(right, bottom))
+              .marginsAdded(uniformMarginsF(radius));
+}
+
+QRectF PolylineVicinity::boundingRect() const {
+    return cachedBoundingRect;
+}
+
+bool PolylineVicinity::contains(const QPointF &point) const {
+    if (!cachedBoundingRect.contains(point))
+        return false;
+    return findJointAt(point) != -1 || findSegmentAt(point) != -1;
+}
+
+int PolylineVicinity::findJointAt(const QPointF &point) const {
+    const int jointsCount = std::max(points.count() - 2, 0);
+    for (int i = 0; i < jointsCount; ++i) {
+        if (jointVicinityContains(i, point))
+            return i;
+    }
+    return -1;
+}
+
+int PolylineVicinity::findSegmentAt(const QPointF &point) const {
+    for (int i = 0; i < points.count() - 1; ++i) {
+        if (segmentVicinityContains(i, point))
+            return i;
+    }
+    return -1;
+}
+
+QPainterPath PolylineVicinity::path() const {
+    if (cachedPath.has_value())
+        return cachedPath.value();
+
+    QPainterPath path;
+    path.setFillRule(Qt::WindingFill);
+
+    for (int i = 0; i < points.count() - 1; ++i)
+        path.addPath(tiltedRect(QLineF(points.at(i), points.at(i + 1)), radius * 2.0));
+
+    for (int i = 1; i < points.count() - 1; ++i)
+        path.addRect(squareCenteredAt(points.at(i), radius * 2.0));
+
+    cachedPath = path;
+    return path;
+}
+
+bool PolylineVicinity::segmentVicinityContains(
+        const int segmentIndex, const QPointF &point) const {
+    const QPointF &p1 = points.at(segmentIndex);
+    const QPointF &p2 = points.at(segmentIndex + 1);
+
+    if (p1 == p2) // (the vicinity is empty, as in `tiltedRect()`)
+        return false;
+
+    const double dx = p2.x() - p1.x();
+    const double dy = p2.y() - p1.y();
+    const double lengthSquared = dx * dx + dy * dy;
+
+    const double px = point.x() - p1.x();
+    const double py = point.y() - p1.y();
+
+    // projection onto the segment must be within the segment
+    const double t = (px * dx + py * dy) / lengthSquared;
+    if (t < 0.0 || t > 1.0)
+        return false;
+
+    // distance from the line
+    const double crossProduct = dx * py - dy * px;
+    return crossProduct * crossProduct <= radius * radius * lengthSquared;
+}
+
+bool PolylineVicinity::jointVicinityContains(const int jointIndex, const QPointF &point) const {
+    const QPointF &joint = points.at(jointIndex + 1);
+    return std::fabs(point.x() - joint.x()) <= radius
+            && std::fabs(point.y() - joint.y()) <= radius;
+}
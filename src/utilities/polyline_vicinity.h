@@ -0,0 +1,62 @@
+#ifndef POLYLINE_VICINITY_H
+#define POLYLINE_VICINITY_H
+
+#include <optional>
+#include <QPainterPath>
+#include <QPointF>
+#include <QRectF>
+#include <QVector>
+
+//!
+//! The vicinity of a polyline (start point, joints, end point), which consists of
+//!   - for each segment, a rectangle of half-width \e radius along the segment (see
+//!     \c tiltedRect()), and
+//!   - for each joint, a square of half-side \e radius centered at the joint.
+//!
+//! Hit-testing is done analytically, and the bounding rect is computed when the points are set.
+//! The \c QPainterPath of the vicinity is built only when \c path() is called.
+//!
+class PolylineVicinity
+{
+public:
+    explicit PolylineVicinity(const double radius);
+
+    //!
+    //! \param points: start point, joints..., end point
+    //!
+    void setPoints(const QVector<QPointF> &points);
+
+    //!
+    //! \return a rect enclosing the vicinity, or QRectF() if there're less than 2 points
+    //!
+    QRectF boundingRect() const;
+
+    bool contains(const QPointF &point) const;
+
+    //!
+    //! \return index (among the joints) of the first joint whose vicinity contains \e point, or
+    //!         -1 if not found
+    //!
+    int findJointAt(const QPointF &point) const;
+
+    //!
+    //! \return index of the first segment whose vicinity contains \e point, or -1 if not found
+    //!
+    int findSegmentAt(const QPointF &point) const;
+
+    //!
+    //! The path is cached until the points are set again.
+    //!
+    QPainterPath path() const;
+
+private:
+    double radius;
+    QVector<QPointF> points;
+    QRectF cachedBoundingRect;
+    mutable std::optional<QPainterPath> cachedPath;
+
+    bool segmentVicinityContains(const int segmentIndex, const QPointF &point) const;
+    bool jointVicinityContains(const int jointIndex, const QPointF &point) const;
+};
+
+#endif // POLYLINE_VICINITY_H
@@ -0,0 +1,395 @@
+#include <algorithm>
+#include <QVarLengthArray>
+#include "rect_tree.h"
+
+void RectTree::set(const int id, const QRectF &rect_) {
+    const QRectF rect = rect_.normalized();
+
+    auto it = idToLeaf.constFind(id);
+    if (it != idToLeaf.constEnd()) {
+        if (idToRect.value(id) == rect)
+            return;
+
+        const int leaf = it.value();
+        removeLeaf(leaf);
+        nodes[leaf].box = Box::fromRect(rect);
+        insertLeaf(leaf);
+    }
+    else {
+        const int leaf = allocateNode();
+        nodes[leaf].box = Box::fromRect(rect);
+        nodes[leaf].id = id;
+        insertLeaf(leaf);
+        idToLeaf.insert(id, leaf);
+    }
+    idToRect.insert(id, rect);
+}
+
+void RectTree::remove(const int id) {
+    auto it = idToLeaf.find(id);
+    if (it == idToLeaf.end())
+        return;
+
+    const int leaf = it.value();
+    removeLeaf(leaf);
+    freeNode(leaf);
+
+    idToLeaf.erase(it);
+    idToRect.remove(id);
+}
+
+void RectTree::clear() {
+    nodes.clear();
+    root = nullNode;
+    freeList = nullNode;
+    idToLeaf.clear();
+    idToRect.clear();
+}
+
+bool RectTree::contains(const int id) const {
+    return idToLeaf.contains(id);
+}
+
+int RectTree::count() const {
+    return idToLeaf.count();
+}
+
+QRectF RectTree::getRect(const int id) const {
+    return idToRect.value(id);
+}
+
+QSet<int> RectTree::queryIntersecting(const QRectF &rect_) const {
+    const QRectF rect = rect_.normalized();
+    const Box box = Box::fromRect(rect);
+    return query(
+        [&box](const Box &nodeBox) {
+            return nodeBox.overlapsOrTouches(box);
+        },
+        [this, &rect](const int id) {
+            return idToRect.value(id).intersects(rect);
+        }
+    );
+}
+
+QSet<int> RectTree::queryContaining(const QRectF &rect_) const {
+    const QRectF rect = rect_.normalized();
+    const Box box = Box::fromRect(rect);
+    return query(
+        [&box](const Box &nodeBox) {
+            return nodeBox.encloses(box);
+        },
+        [this, &rect](const int id) {
+            return idToRect.value(id).contains(rect);
+        }
+    );
+}
+
+QSet<int> RectTree::queryContainedIn(const QRectF &rect_) const {
+    const QRectF rect = rect_.normalized();
+    const Box box = Box::fromRect(rect);
+    return query(
+        [&box](const Box &nodeBox) {
+            return nodeBox.overlapsOrTouches(box);
+        },
+        [this, &rect](const int id) {
+            return rect.contains(idToRect.value(id));
+        }
+    );
+}
+
+QRectF RectTree::boundingRect() const {
+    if (root == nullNode)
+        return QRectF();
+    return nodes[root].box.toRect();
+}
+
+int RectTree::height() const {
+    if (root == nullNode)
+        return 0;
+    return nodes[root].height + 1;
+}
+
+int RectTree::allocateNode() {
+    int index;
+    if (freeList != nullNode) {
+        index = freeList;
+        freeList = nodes[index].parent;
+    }
+    else {
+        index = static_cast<int>(nodes.size());
+        nodes.emplace_back();
+    }
+
+    nodes[index] = Node();
+    return index;
+}
+
+void RectTree::freeNode(const int index) {
+    nodes[index].height = -1;
+    nodes[index].parent = freeList;
+    freeList = index;
+}
+
+void RectTree::insertLeaf(const int leaf) {
+    nodes[leaf].parent = nullNode;
+
+    if (root == nullNode) {
+        root = leaf;
+        return;
+    }
+
+    // find the best sibling for `leaf`, by the surface area heuristic (with perimeter in place of
+    // area)
+    const Box leafBox = nodes[leaf].box;
+    int index = root;
+    while (!nodes[index].isLeaf()) {
+        const Node &node = nodes[index];
+
+        const double perimeter = node.box.perimeter();
+        const double combinedPerimeter = node.box.united(leafBox).perimeter();
+
+        // cost of creating a new parent for `node` and `leaf`
+        const double cost = 2 * combinedPerimeter;
+
+        // minimum cost of pushing `leaf` further down the tree
+        const double inheritanceCost = 2 * (combinedPerimeter - perimeter);
+
+        auto costOfDescending = [&](const int child) {
+            const Box &childBox = nodes[child].box;
+            const double p = childBox.united(leafBox).perimeter();
+            return nodes[child].isLeaf()
+                    ? p + inheritanceCost
+                    : (p - childBox.perimeter()) + inheritanceCost;
+        };
+        const double cost1 = costOfDescending(node.child1);
+        const double cost2 = costOfDescending(node.child2);
+
+        if (cost < cost1 && cost < cost2)
+            break;
+        index = (cost1 < cost2) ? node.child1 : node.child2;
+    }
+    const int sibling = index;
+
+    // create a new parent
+    const int newParent = allocateNode(); // (can invalidate references to `nodes` elements)
+    const int oldParent = nodes[sibling].parent;
+    nodes[newParent].parent = oldParent;
+    nodes[newParent].box = nodes[sibling].box.united(leafBox);
+    nodes[newParent].height = nodes[sibling].height + 1;
+    nodes[newParent].child1 = sibling;
+    nodes[newParent].child2 = leaf;
+    nodes[sibling].parent = newParent;
+    nodes[leaf].parent = newParent;
+
+    if (oldParent != nullNode) {
+        if (nodes[oldParent].child1 == sibling)
+            nodes[oldParent].child1 = newParent;
+        else
+            nodes[oldParent].child2 = newParent;
+    }
+    else {
+        root = newParent;
+    }
+
+    //
+    refitUpward(nodes[leaf].parent);
+}
+
+void RectTree::removeLeaf(const int leaf) {
+    if (leaf == root) {
+        root = nullNode;
+        return;
+    }
+
+    const int parent = nodes[leaf].parent;
+    const int grandParent = nodes[parent].parent;
+    const int sibling = (nodes[parent].child1 == leaf) ? nodes[parent].child2 : nodes[parent].child1;
+
+    if (grandParent != nullNode) {
+        // replace `parent` by `sibling`
+        if (nodes[grandParent].child1 == parent)
+            nodes[grandParent].child1 = sibling;
+        else
+            nodes[grandParent].child2 = sibling;
+        nodes[sibling].parent = grandParent;
+        freeNode(parent);
+
+        refitUpward(grandParent);
+    }
+    else {
+        root = sibling;
+        nodes[sibling].parent = nullNode;
+        freeNode(parent);
+    }
+
+    nodes[leaf].parent = nullNode;
+}
+
+void RectTree::refitUpward(int index) {
+    while (index != nullNode) {
+        index = balance(index);
+
+        Node &node = nodes[index];
+        const Node &child1 = nodes[node.child1];
+        const Node &child2 = nodes[node.child2];
+        node.height = 1 + std::max(child1.height, child2.height);
+        node.box = child1.box.united(child2.box);
+
+        index = node.parent;
+    }
+}
+
+int RectTree::balance(const int iA) {
+    Node &A = nodes[iA];
+    if (A.isLeaf() || A.height < 2)
+        return iA;
+
+    const int iB = A.child1;
+    const int iC = A.child2;
+    Node &B = nodes[iB];
+    Node &C = nodes[iC];
+
+    const int balanceFactor = C.height - B.height;
+
+    if (balanceFactor > 1) { // rotate C up
+        const int iF = C.child1;
+        const int iG = C.child2;
+        Node &F = nodes[iF];
+        Node &G = nodes[iG];
+
+        C.child1 = iA;
+        C.parent = A.parent;
+        A.parent = iC;
+
+        if (C.parent != nullNode) {
+            if (nodes[C.parent].child1 == iA)
+                nodes[C.parent].child1 = iC;
+            else
+                nodes[C.parent].child2 = iC;
+        }
+        else {
+            root = iC;
+        }
+
+        if (F.height > G.height) {
+            C.child2 = iF;
+            A.child2 = iG;
+            G.parent = iA;
+            A.box = B.box.united(G.box);
+            C.box = A.box.united(F.box);
+            A.height = 1 + std::max(B.height, G.height);
+            C.height = 1 + std::max(A.height, F.height);
+        }
+        else {
+            C.child2 = iG;
+            A.child2 = iF;
+            F.parent = iA;
+            A.box = B.box.united(F.box);
+            C.box = A.box.united(G.box);
+            A.height = 1 + std::max(B.height, F.height);
+            C.height = 1 + std::max(A.height, G.height);
+        }
+        return iC;
+    }
+
+    if (balanceFactor < -1) { // rotate B up
+        const int iD = B.child1;
+        const int iE = B.child2;
+        Node &D = nodes[iD];
+        Node &E = nodes[iE];
+
+        B.child1 = iA;
+        B.parent = A.parent;
+        A.parent = iB;
+
+        if (B.parent != nullNode) {
+            if (nodes[B.parent].child1 == iA)
+                nodes[B.parent].child1 = iB;
+            else
+                nodes[B.parent].child2 = iB;
+        }
+        else {
+            root = iB;
+        }
+
+        if (D.height > E.height) {
+            B.child2 = iD;
+            A.child1 = iE;
+            E.parent = iA;
+            A.box = C.box.united(E.box);
+            B.box = A.box.united(D.box);
+            A.height = 1 + std::max(C.height, E.height);
+            B.height = 1 + std::max(A.height, D.height);
+        }
+        else {
+            B.child2 = iE;
+            A.child1 = iD;
+            D.parent = iA;
+            A.box = C.box.united(D.box);
+            B.box = A.box.united(E.box);
+            A.height = 1 + std::max(C.height, D.height);
+            B.height = 1 + std::max(A.height, E.height);
+        }
+        return iB;
+    }
+
+    return iA;
+}
+
+template <typename MaySubtreeMatch, typename LeafMatches>
+QSet<int> RectTree::query(MaySubtreeMatch maySubtreeMatch, LeafMatches leafMatches) const {
+    QSet<int> result;
+    if (root == nullNode)
+        return result;
+
+    QVarLengthArray<int, 64> stack;
+    stack << root;
+    while (!stack.isEmpty()) {
+        const int index = stack.last();
+        stack.removeLast();
+
+        const Node &node = nodes[index];
+        if (!maySubtreeMatch(node.box))
+            continue;
+
+        if (node.isLeaf()) {
+            if (leafMatches(node.id))
+                result << node.id;
+        }
+        else {
+            stack << node.child1 << node.child2;
+        }
+    }
+    return result;
+}
+
+//====
+
+RectTree::Box RectTree::Box::fromRect(const QRectF &rect) {
+    return Box {rect.left(), rect.top(), rect.right(), rect.bottom()};
+}
+
+QRectF RectTree::Box::toRect() const {
+    return QRectF(QPointF(left, top), QPointF(right, bottom));
+}
+
+RectTree::Box RectTree::Box::united(const Box &other) const {
+    return Box {
+        std::min(left, other.left), std::min(top, other.top),
+        std::max(right, other.right), std::max(bottom, other.bottom)
+    };
+}
+
+double RectTree::Box::perimeter() const {
+    return 2 * ((right - left) + (bottom - top));
+}
+
+bool RectTree::Box::overlapsOrTouches(const Box &other) const {
+    return left <= other.right && other.left <= right
+            && top <= other.bottom && other.top <= bottom;
+}
+
+bool RectTree::Box::encloses(const Box &other) const {
+    return left <= other.left && other.right <= right
+            && top <= other.top && other.bottom <= bottom;
+}
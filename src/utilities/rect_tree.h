@@ -0,0 +1,126 @@
+#ifndef RECT_TREE_H
+#define RECT_TREE_H
+
+#include <vector>
+#include <QHash>
+#include <QRectF>
+#include <QSet>
+
+//!
+//! A dynamic spatial index of rectangles identified by \c int IDs. It is a bounding-volume
+//! hierarchy (an R-tree with 2 entries per node) that keeps itself balanced by tree rotations,
+//! so that inserting, updating & removing a rectangle take O(log n) time, and querying the
+//! rectangles intersecting/containing/contained in a given rectangle typically takes
+//! O(log n + k) time, where k is the number of results.
+//!
+//! The rectangles are normalized when set. Results of the queries are determined by
+//! \c QRectF::intersects() and \c QRectF::contains(), so rectangles of zero width or height are
+//! never found by the queries.
+//!
+class RectTree
+{
+public:
+    explicit RectTree() {}
+
+    //!
+    //! Inserts or updates the rectangle of \e id.
+    //!
+    void set(const int id, const QRectF &rect);
+
+    //!
+    //! Does nothing if \e id is not found.
+    //!
+    void remove(const int id);
+
+    void clear();
+
+    bool contains(const int id) const;
+    int count() const;
+    QRectF getRect(const int id) const; // returns QRectF() if \e id is not found
+
+    //!
+    //! \return IDs of the rectangles that intersect with \e rect
+    //!
+    QSet<int> queryIntersecting(const QRectF &rect) const;
+
+    //!
+    //! \return IDs of the rectangles that contain \e rect
+    //!
+    QSet<int> queryContaining(const QRectF &rect) const;
+
+    //!
+    //! \return IDs of the rectangles that are contained in \e rect
+    //!
+    QSet<int> queryContainedIn(const QRectF &rect) const;
+
+    //!
+    //! \return the bounding rectangle of all rectangles, or QRectF() if there's none. This takes
+    //!         O(1) time.
+    //!
+    QRectF boundingRect() const;
+
+    //!
+    //! \return height of the tree (0 if empty, 1 if there's only one rectangle)
+    //!
+    int height() const;
+
+private:
+    static constexpr int nullNode {-1};
+
+    // The box of an internal node is the bounding box of its children's boxes. A leaf holds a
+    // rectangle.
+    struct Box
+    {
+        double left {0};
+        double top {0};
+        double right {0};
+        double bottom {0};
+
+        static Box fromRect(const QRectF &rect);
+        QRectF toRect() const;
+        Box united(const Box &other) const;
+        double perimeter() const;
+        bool overlapsOrTouches(const Box &other) const;
+        bool encloses(const Box &other) const;
+    };
+
+    struct Node
+    {
+        Box box;
+        int parent {nullNode};
+        int child1 {nullNode};
+        int child2 {nullNode};
+        int height {0}; // 0 for leaf, -1 for freed node
+        int id {-1}; // for leaf
+
+        bool isLeaf() const { return child1 == nullNode; }
+    };
+
+    std::vector<Node> nodes;
+    int root {nullNode};
+    int freeList {nullNode}; // freed nodes linked by `Node::parent`
+    QHash<int, int> idToLeaf;
+    QHash<int, QRectF> idToRect;
+
+    int allocateNode();
+    void freeNode(const int index);
+
+    void insertLeaf(const int leaf);
+    void removeLeaf(const int leaf);
+
+    //!
+    //! Updates boxes & heights of \e index and its ancestors, rebalancing on the way up.
+    //!
+    void refitUpward(int index);
+
+    //!
+    //! Performs a left or right rotation if node \e iA is imbalanced.
+    //! \return index of the node that takes the position of \e iA
+    //!
+    int balance(const int iA);
+
+    template <typename MaySubtreeMatch, typename LeafMatches>
+    QSet<int> query(MaySubtreeMatch maySubtreeMatch, LeafMatches leafMatches) const;
+};
+
+#endif // RECT_TREE_H
@@ -0,0 +1,85 @@
+#include <QHash>
+#include <QReadLocker>
+#include <QReadWriteLock>
+#include <QVector>
+#include <QWriteLocker>
+#include "symbol.h"
+
+namespace {
+class SymbolTable
+{
+public:
+    static SymbolTable *instance() {
+        static SymbolTable table;
+        return &table;
+    }
+
+    int intern(const QString &s) {
+        {
+            QReadLocker locker(&lock);
+            if (const auto it = stringToId.constFind(s); it != stringToId.constEnd())
+                return it.value();
+        }
+
+        QWriteLocker locker(&lock);
+        if (const auto it = stringToId.constFind(s); it != stringToId.constEnd())
+            return it.value(); // interned by another thread in the meantime
+
+        const int id = idToString.count();
+        idToString << s;
+        stringToId.insert(s, id);
+        return id;
+    }
+
+    QString getString(const int id) {
+        QReadLocker locker(&lock);
+        Q_ASSERT(id >= 0 && id < idToString.count());
+        return idToString.at(id);
+    }
+
+private:
+    SymbolTable() {
+        // ID 0 is for empty string
+        idToString << QString();
+        stringToId.insert(QString(), 0);
+    }
+
+    QReadWriteLock lock;
+    QVector<QString> idToString;
+    QHash<QString, int> stringToId;
+};
+} // namespace
+
+Symbol::Symbol(const QString &s)
+        : id(s.isEmpty() ? 0 : SymbolTable::instance()->intern(s)) {
+}
+
+QString Symbol::toString() const {
+    if (id == 0)
+        return "";
+    return SymbolTable::instance()->getString(id);
+}
+
+QSet<Symbol> toSymbolSet(const QSet<QString> &strings) {
+    QSet<Symbol> result;
+    result.reserve(strings.count());
+    for (const QString &s: strings)
+        result << Symbol(s);
+    return result;
+}
+
+QSet<Symbol> toSymbolSet(const QStringList &strings) {
+    QSet<Symbol> result;
+    result.reserve(strings.count());
+    for (const QString &s: strings)
+        result << Symbol(s);
+    return result;
+}
+
+QSet<QString> toStringSet(const QSet<Symbol> &symbols) {
+    QSet<QString> result;
+    result.reserve(symbols.count());
+    for (const Symbol &symbol: symbols)
+        result << symbol.toString();
+    return result;
+}
@@ -0,0 +1,51 @@
+#ifndef SYMBOL_H
+#define SYMBOL_H
+
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+//!
+//! An interned string. Every distinct string is assigned a small integer ID (in a global table)
+//! the first time it is interned, and the ID stays valid for the lifetime of the program. Thus
+//! comparing and hashing symbols are integer operations.
+//!
+//! Use this for strings that repeat a lot and are used as keys, such as card labels and
+//! relationship types. Convert back to \c QString only at the boundaries (DB, UI).
+//!
+//! Interning and \c toString() are thread-safe.
+//!
+class Symbol
+{
+public:
+    Symbol() {} // the symbol of empty string
+    explicit Symbol(const QString &s);
+
+    QString toString() const;
+
+    int getId() const { return id; }
+    bool isEmpty() const { return id == 0; }
+
+    bool operator == (const Symbol &other) const { return id == other.id; }
+    bool operator != (const Symbol &other) const { return id != other.id; }
+
+    //!
+    //! Orders by ID (i.e., by the order of interning), not alphabetically.
+    //!
+    bool operator < (const Symbol &other) const { return id < other.id; }
+
+private:
+    int id {0};
+};
+
+Q_DECLARE_TYPEINFO(Symbol, Q_MOVABLE_TYPE);
+
+inline uint qHash(const Symbol &symbol, uint seed = 0) {
+    return qHash(symbol.getId(), seed);
+}
+
+QSet<Symbol> toSymbolSet(const QSet<QString> &strings);
+QSet<Symbol> toSymbolSet(const QStringList &strings);
+QSet<QString> toStringSet(const QSet<Symbol> &symbols);
+
+#endif // SYMBOL_H
@@ -0,0 +1,186 @@
+#include <algorithm>
+#include <cstring>
+#include <QDebug>
+#include <QImage>
+#include <QPainter>
+#include <QPicture>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
+#include "png_stream_writer.h"
+#include "tiled_png_export.h"
+
+namespace {
+//!
+//! Renders a tile of a band into the band's pixel buffer.
+//!
+class TileRenderer : public QRunnable
+{
+public:
+    TileRenderer(
+            const QByteArray &bandRecording, const QRect &tileRect,
+            uchar *bandBits, const int bandBytesPerLine, const std::atomic<bool> *canceled)
+        : bandRecording(bandRecording)
+        , tileRect(tileRect)
+        , bandBits(bandBits)
+        , bandBytesPerLine(bandBytesPerLine)
+        , canceled(canceled) {
+    }
+
+    void run() override {
+        if (canceled->load())
+            return;
+
+        // (`QPicture` is not safe to be played in multiple threads at the same time, even with
+        // implicitly shared copies, so each tile makes its own from the recorded data)
+        QPicture picture;
+        picture.setData(bandRecording.constData(), uint(bandRecording.size()));
+
+        QImage tile(tileRect.size(), QImage::Format_ARGB32_Premultiplied);
+        tile.fill(Qt::transparent);
+        {
+            QPainter painter(&tile);
+            painter.setRenderHint(QPainter::Antialiasing, true);
+            painter.translate(-tileRect.topLeft());
+            painter.drawPicture(0, 0, picture);
+        }
+
+        // copy to band (tiles of a band don't overlap)
+        const int rowBytes = tileRect.width() * 4;
+        for (int y = 0; y < tileRect.height(); ++y) {
+            uchar *dest = bandBits + (tileRect.top() + y) * bandBytesPerLine + tileRect.left() * 4;
+            std::memcpy(dest, tile.constScanLine(y), size_t(rowBytes));
+        }
+    }
+
+private:
+    const QByteArray bandRecording;
+    const QRect tileRect;
+    uchar *const bandBits;
+    const int bandBytesPerLine;
+    const std::atomic<bool> *const canceled;
+};
+} // namespace
+
+int TiledPngExport::computeBandHeight(const int imageWidth, const qint64 memoryCapBytes) {
+    // Per row of a band:
+    //   - 2 band buffers (one being rendered, one being encoded),
+    //   - a tile buffer for each rendering thread.
+    const qint64 bytesPerBandRow
+            = 4 * (2 * qint64(imageWidth) + qint64(renderingThreadCount()) * tileWidth);
+
+    // PNG encoder (row buffers & compressor) and a margin for the rest
+    const qint64 fixedBytes = 3 * (4 * qint64(imageWidth) + 1) + 4 * 1024 * 1024;
+
+    if (memoryCapBytes <= fixedBytes)
+        return 0;
+
+    const qint64 bandHeight = (memoryCapBytes - fixedBytes) / bytesPerBandRow;
+    if (bandHeight < minBandHeight)
+        return 0;
+    return int(std::min<qint64>(bandHeight, maxBandHeight));
+}
+
+TiledPngExport::TiledPngExport(
+        const Source &source, const QString &filePath, QObject *parent)
+            : QObject(parent)
+            , source(source)
+            , filePath(filePath) {
+}
+
+void TiledPngExport::start() {
+    if (job.isRunning()) {
+        qWarning().noquote() << "export already started";
+        return;
+    }
+
+    job.start([this](const std::atomic<bool> &canceled) {
+        run(canceled);
+    });
+}
+
+void TiledPngExport::cancel() {
+    job.cancel();
+}
+
+int TiledPngExport::renderingThreadCount() {
+    return std::max(QThread::idealThreadCount(), 1);
+}
+
+void TiledPngExport::run(const std::atomic<bool> &canceled) {
+    const int imageWidth = source.imageSize.width();
+    const int imageHeight = source.imageSize.height();
+    const int bandsCount = source.bandRecordings.count();
+    if (source.bandHeight <= 0
+            || bandsCount != (imageHeight + source.bandHeight - 1) / source.bandHeight) {
+        emit finished(false, false, "invalid source of image export");
+        return;
+    }
+
+    //
+    PngStreamWriter writer;
+    if (!writer.open(filePath, source.imageSize)) {
+        emit finished(
+                false, false,
+                QString("Could not write file %1: %2").arg(filePath, writer.errorString()));
+        return;
+    }
+
+    QThreadPool tilesThreadPool;
+    tilesThreadPool.setMaxThreadCount(renderingThreadCount());
+
+    QImage bandImages[2]; // band `i` is rendered into `bandImages[i % 2]`
+
+    auto startRenderingBand = [&](const int bandIndex) {
+        const int height
+                = std::min(source.bandHeight, imageHeight - bandIndex * source.bandHeight);
+        QImage &bandImage = bandImages[bandIndex % 2];
+        if (bandImage.height() != height)
+            bandImage = QImage(imageWidth, height, QImage::Format_ARGB32_Premultiplied);
+
+        uchar *bits = bandImage.bits();
+        const int bytesPerLine = bandImage.bytesPerLine();
+        for (int left = 0; left < imageWidth; left += tileWidth) {
+            const QRect tileRect(left, 0, std::min(tileWidth, imageWidth - left), height);
+            tilesThreadPool.start(new TileRenderer(
+                    source.bandRecordings.at(bandIndex), tileRect, bits, bytesPerLine, &canceled));
+        }
+    };
+
+    startRenderingBand(0);
+    for (int i = 0; i < bandsCount; ++i) {
+        tilesThreadPool.waitForDone(); // (band `i` is rendered)
+
+        if (canceled) {
+            writer.abort();
+            emit finished(false, true, "");
+            return;
+        }
+
+        // render next band while encoding this one
+        if (i + 1 < bandsCount)
+            startRenderingBand(i + 1);
+
+        if (!writer.appendRows(bandImages[i % 2])) {
+            cancel(); // (stops the rendering)
+            tilesThreadPool.waitForDone();
+            writer.abort();
+            emit finished(
+                    false, false,
+                    QString("Could not write file %1: %2").arg(filePath, writer.errorString()));
+            return;
+        }
+
+        emit progressUpdated(i + 1, bandsCount);
+    }
+
+    //
+    if (!writer.finish()) {
+        writer.abort();
+        emit finished(
+                false, false,
+                QString("Could not write file %1: %2").arg(filePath, writer.errorString()));
+        return;
+    }
+    emit finished(true, false, "");
+}
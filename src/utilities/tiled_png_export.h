@@ -0,0 +1,75 @@
+#ifndef TILED_PNG_EXPORT_H
+#define TILED_PNG_EXPORT_H
+
+#include <atomic>
+#include <QByteArray>
+#include <QObject>
+#include <QSize>
+#include <QVector>
+#include "utilities/background_job.h"
+
+//!
+//! Renders a recorded image into a PNG file with bounded memory.
+//!
+//! The image is given as a list of horizontal bands, each a recording (serialized \c QPicture)
+//! made on the GUI thread beforehand, so the export does not touch any live object (e.g., a
+//! graphics scene). The bands are rendered in order on a background thread. Each band is split
+//! into tiles that are rendered in parallel by a thread pool, and the rendered band is then
+//! streamed into a \c PngStreamWriter while the next band is being rendered.
+//!
+//! The pixel buffers in use take at most about the memory cap given to \c computeBandHeight().
+//! The recordings themselves are not counted, since their sizes are proportional to the
+//! numbers of items drawn rather than to the image area.
+//!
+class TiledPngExport : public QObject
+{
+    Q_OBJECT
+public:
+    struct Source
+    {
+        QSize imageSize;
+        int bandHeight {0};
+
+        //!
+        //! \c QPicture::data() of each band, from top to bottom. Band \c i covers the rows
+        //! <tt>[i * bandHeight, (i + 1) * bandHeight)</tt> of the image (the last band can be
+        //! shorter), and is recorded in the coordinates of that band.
+        //!
+        QVector<QByteArray> bandRecordings;
+    };
+
+    //!
+    //! \return the largest band height such that the pixel buffers fit in \e memoryCapBytes,
+    //!         or 0 if even the minimum band height doesn't fit
+    //!
+    static int computeBandHeight(const int imageWidth, const qint64 memoryCapBytes);
+
+    explicit TiledPngExport(
+            const Source &source, const QString &filePath, QObject *parent = nullptr);
+    void start();
+
+    //!
+    //! The partially written file will be removed. Can be called from any thread.
+    //!
+    void cancel();
+
+signals:
+    void progressUpdated(const int finishedBandsCount, const int bandsCount);
+    void finished(const bool ok, const bool canceled, const QString &errorMsg);
+
+private:
+    static constexpr int tileWidth {512};
+    static constexpr int minBandHeight {16};
+    static constexpr int maxBandHeight {1024};
+
+    const Source source;
+    const QString filePath;
+
+    BackgroundJob job; // (last member, so that it's destroyed first)
+
+    static int renderingThreadCount();
+
+    void run(const std::atomic<bool> &canceled); // runs in `job`
+};
+
+#endif // TILED_PNG_EXPORT_H
@@ -0,0 +1,61 @@
+#include <memory>
+#include <QElapsedTimer>
+#include <QTimer>
+#include "time_slicing.h"
+
+namespace {
+struct TimeSlicedProcess
+{
+    std::function<bool ()> processNext;
+    int sliceMsec;
+    std::function<void ()> onSliceFinished;
+    std::function<void ()> onFinished;
+    QPointer<QObject> context;
+};
+
+void runSlice(std::shared_ptr<TimeSlicedProcess> process);
+}
+
+void runInTimeSlices(
+        std::function<bool ()> processNext, const int sliceMsec,
+        std::function<void ()> onSliceFinished, std::function<void ()> onFinished,
+        QPointer<QObject> context) {
+    Q_ASSERT(processNext);
+    Q_ASSERT(!context.isNull());
+
+    auto process = std::make_shared<TimeSlicedProcess>(
+            TimeSlicedProcess {processNext, sliceMsec, onSliceFinished, onFinished, context});
+    runSlice(process);
+}
+
+//====
+
+namespace {
+void runSlice(std::shared_ptr<TimeSlicedProcess> process) {
+    if (process->context.isNull())
+        return;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    bool hasMore = true;
+    while (hasMore) {
+        hasMore = process->processNext();
+        if (timer.elapsed() >= process->sliceMsec)
+            break;
+    }
+
+    if (process->onSliceFinished)
+        process->onSliceFinished();
+
+    if (!hasMore) {
+        if (process->onFinished)
+            process->onFinished();
+        return;
+    }
+
+    QTimer::singleShot(0, process->context, [process]() {
+        runSlice(process);
+    });
+}
+} // namespace
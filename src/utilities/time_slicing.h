@@ -0,0 +1,23 @@
+#ifndef TIME_SLICING_H
+#define TIME_SLICING_H
+
+#include <functional>
+#include <QPointer>
+
+//!
+//! Calls \e processNext repeatedly in the thread of \e context, until it returns false (meaning
+//! nothing is left to process). The calls are grouped into time slices of about \e sliceMsec,
+//! and the control returns to the event loop between slices, so that the UI stays responsive
+//! (and gets repainted) during a long process.
+//!
+//! The first slice is run immediately. \e onSliceFinished (can be null) is called at the end of
+//! each slice, and \e onFinished (can be null) is called after the last slice.
+//!
+//! If \e context is destroyed, the process stops, and \e onFinished will not be called.
+//!
+void runInTimeSlices(
+        std::function<bool ()> processNext, const int sliceMsec,
+        std::function<void ()> onSliceFinished, std::function<void ()> onFinished,
+        QPointer<QObject> context);
+
+#endif // TIME_SLICING_H
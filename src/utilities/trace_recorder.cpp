@@ -0,0 +1,125 @@
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QMutexLocker>
+#include "trace_recorder.h"
+
+TraceRecorder *TraceRecorder::instance() {
+    static TraceRecorder obj;
+    return &obj;
+}
+
+void TraceRecorder::start(const QString &outputFilePath_) {
+    QMutexLocker locker(&mutex);
+
+    outputFilePath = outputFilePath_;
+    events.clear();
+    openSpans.clear();
+    nextSpanId = 0;
+    elapsedTimer.start();
+    recording = true;
+}
+
+bool TraceRecorder::isRecording() const {
+    return recording;
+}
+
+int TraceRecorder::beginSpan(const QString &name, const QString &category) {
+    if (!recording)
+        return -1;
+
+    QMutexLocker locker(&mutex);
+    const int spanId = nextSpanId++;
+    openSpans.insert(spanId, {name, category});
+    events << Event {'b', name, category, elapsedTimer.nsecsElapsed() / 1000, spanId};
+    return spanId;
+}
+
+void TraceRecorder::endSpan(const int spanId) {
+    if (!recording || spanId == -1)
+        return;
+
+    QMutexLocker locker(&mutex);
+    if (!openSpans.contains(spanId))
+        return;
+    const auto [name, category] = openSpans.take(spanId);
+    events << Event {'e', name, category, elapsedTimer.nsecsElapsed() / 1000, spanId};
+}
+
+void TraceRecorder::addInstantEvent(const QString &name, const QString &category) {
+    if (!recording)
+        return;
+
+    QMutexLocker locker(&mutex);
+    events << Event {'i', name, category, elapsedTimer.nsecsElapsed() / 1000, -1};
+}
+
+void TraceRecorder::addCounterEvent(
+        const QString &name, const QString &category,
+        const QVector<std::pair<QString, double>> &values) {
+    if (!recording)
+        return;
+
+    QMutexLocker locker(&mutex);
+    events << Event {'C', name, category, elapsedTimer.nsecsElapsed() / 1000, -1, values};
+}
+
+bool TraceRecorder::finish() {
+    if (!recording)
+        return false;
+
+    const QJsonObject traceJson = toJson();
+    QString filePath;
+    {
+        QMutexLocker locker(&mutex);
+        recording = false;
+        filePath = outputFilePath;
+        events.clear();
+        openSpans.clear();
+    }
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+    file.write(QJsonDocument(traceJson).toJson(QJsonDocument::Compact));
+    return true;
+}
+
+QJsonObject TraceRecorder::toJson() const {
+    QMutexLocker locker(&mutex);
+
+    QJsonArray traceEvents;
+    for (const Event &event: events) {
+        // drop the beginnings of spans not ended
+        if (event.phase == 'b' && openSpans.contains(event.spanId))
+            continue;
+
+        QJsonObject obj {
+            {"name", event.name},
+            {"cat", event.category},
+            {"ph", QString(QChar(event.phase))},
+            {"ts", event.timestampUsec},
+            {"pid", 1},
+            {"tid", 1}
+        };
+        if (event.phase == 'i') {
+            obj.insert("s", "g"); // global scope
+        }
+        else if (event.phase == 'C') {
+            QJsonObject args;
+            for (const auto &[series, value]: event.counterValues)
+                args.insert(series, value);
+            obj.insert("args", args);
+        }
+        else {
+            obj.insert("id", event.spanId);
+        }
+
+        traceEvents << obj;
+    }
+
+    return QJsonObject {
+        {"traceEvents", traceEvents},
+        {"displayTimeUnit", "ms"}
+    };
+}
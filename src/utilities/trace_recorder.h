@@ -0,0 +1,90 @@
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <atomic>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonObject>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+
+//!
+//! Records time spans and instant events, and writes them to a file in the Chrome trace-event
+//! JSON format (which can be opened in chrome://tracing or https://ui.perfetto.dev).
+//!
+//! Recording is off until \c start() is called. When it is off, the methods return immediately,
+//! so it is cheap to leave the calls in the code.
+//!
+//! Spans are written as async events, so they can overlap arbitrarily (e.g., concurrent DB
+//! queries). This class is thread-safe.
+//!
+class TraceRecorder
+{
+public:
+    static TraceRecorder *instance();
+
+    TraceRecorder(const TraceRecorder &) = delete;
+    TraceRecorder &operator =(const TraceRecorder &) = delete;
+
+    //!
+    //! Clears recorded events and starts recording. Timestamps are relative to this call.
+    //! \param outputFilePath: the file written by \c finish()
+    //!
+    void start(const QString &outputFilePath);
+
+    bool isRecording() const;
+
+    //!
+    //! \return ID of the span, or -1 if not recording
+    //!
+    int beginSpan(const QString &name, const QString &category);
+
+    //!
+    //! Does nothing if \e spanId is -1 or the span has already ended.
+    //!
+    void endSpan(const int spanId);
+
+    void addInstantEvent(const QString &name, const QString &category);
+
+    //!
+    //! Records the values of a counter (shown as a stacked chart of the series in \e values).
+    //!
+    void addCounterEvent(
+            const QString &name, const QString &category,
+            const QVector<std::pair<QString, double>> &values);
+
+    //!
+    //! Stops recording and writes the recorded events (spans not ended are dropped).
+    //! \return false if not recording or the file could not be written
+    //!
+    bool finish();
+
+    //!
+    //! \return the trace-event JSON of the events recorded so far
+    //!
+    QJsonObject toJson() const;
+
+private:
+    TraceRecorder() {}
+
+    struct Event
+    {
+        char phase; // 'b' (span begins), 'e' (span ends), 'i' (instant), or 'C' (counter)
+        QString name;
+        QString category;
+        qint64 timestampUsec;
+        int spanId;
+        QVector<std::pair<QString, double>> counterValues {}; // for 'C'
+    };
+
+    std::atomic<bool> recording {false};
+    mutable QMutex mutex;
+    QString outputFilePath;
+    QElapsedTimer elapsedTimer;
+    QVector<Event> events;
+    int nextSpanId {0};
+    QHash<int, std::pair<QString, QString>> openSpans; // span ID -> (name, category)
+};
+
+#endif // TRACE_RECORDER_H
@@ -0,0 +1,441 @@
+#include <algorithm>
+#include <cmath>
+#include <QIODevice>
+#include <QPainter>
+#include <QXmlStreamWriter>
+#include "vector_drawing.h"
+
+namespace {
+QString svgNumber(const double x) {
+    QString s = QString::number(x, 'f', 2);
+    while (s.endsWith('0'))
+        s.chop(1);
+    if (s.endsWith('.'))
+        s.chop(1);
+    return (s == "-0") ? "0" : s;
+}
+
+QString svgPoints(const QVector<QPointF> &points) {
+    QStringList list;
+    list.reserve(points.count());
+    for (const QPointF &p: points)
+        list << (svgNumber(p.x()) + "," + svgNumber(p.y()));
+    return list.join(' ');
+}
+
+void writeSvgColorAttributes(
+        QXmlStreamWriter &xml, const QString &attribute, const QColor &color) {
+    xml.writeAttribute(attribute, color.name(QColor::HexRgb));
+    if (color.alpha() != 255)
+        xml.writeAttribute(attribute + "-opacity", svgNumber(color.alphaF()));
+}
+
+void writeSvgRectAttributes(QXmlStreamWriter &xml, const QRectF &rect, const double cornerRadius) {
+    xml.writeAttribute("x", svgNumber(rect.x()));
+    xml.writeAttribute("y", svgNumber(rect.y()));
+    xml.writeAttribute("width", svgNumber(rect.width()));
+    xml.writeAttribute("height", svgNumber(rect.height()));
+    if (cornerRadius > 0) {
+        xml.writeAttribute("rx", svgNumber(cornerRadius));
+        xml.writeAttribute("ry", svgNumber(cornerRadius));
+    }
+}
+
+QFont toQFont(const VectorDrawing::Font &font) {
+    QFont qFont(font.family);
+    qFont.setPixelSize(std::max(1, int(std::lround(font.pixelSize))));
+    qFont.setBold(font.bold);
+    return qFont;
+}
+
+QString removeTrailingSpaces(QString s) {
+    while (s.endsWith(' '))
+        s.chop(1);
+    return s;
+}
+
+double charWidthInEm(const QChar c) {
+    // (rough average widths of a sans-serif font such as Arial)
+    static const QString narrowChars = " .,:;'|!ijlftI()[]";
+    if (narrowChars.contains(c))
+        return 0.3;
+    if (c == 'm' || c == 'w' || c == 'M' || c == 'W')
+        return 0.85;
+    if (c.isUpper())
+        return 0.68;
+    if (c.unicode() >= 0x2E80) // CJK & other full-width characters
+        return 1.0;
+    return 0.56;
+}
+} // namespace
+
+VectorDrawing::VectorDrawing(const QRectF &rect)
+        : rect(rect) {
+}
+
+void VectorDrawing::setRect(const QRectF &rect_) {
+    rect = rect_;
+}
+
+void VectorDrawing::setBackgroundColor(const QColor &color) {
+    backgroundColor = color;
+}
+
+void VectorDrawing::addFilledRect(
+        const QRectF &rect, const double cornerRadius, const QColor &fillColor) {
+    Operation op {Operation::Type::FilledRect};
+    op.rect = rect;
+    op.cornerRadius = cornerRadius;
+    op.color = fillColor;
+    operations << op;
+}
+
+void VectorDrawing::addRectOutline(
+        const QRectF &rect, const double cornerRadius,
+        const QColor &lineColor, const double lineWidth, const LineStyle lineStyle) {
+    Operation op {Operation::Type::RectOutline};
+    op.rect = rect;
+    op.cornerRadius = cornerRadius;
+    op.color = lineColor;
+    op.lineWidth = lineWidth;
+    op.lineStyle = lineStyle;
+    operations << op;
+}
+
+void VectorDrawing::addPolyline(
+        const QVector<QPointF> &points, const QColor &lineColor, const double lineWidth) {
+    if (points.count() < 2)
+        return;
+
+    Operation op {Operation::Type::Polyline};
+    op.points = points;
+    op.color = lineColor;
+    op.lineWidth = lineWidth;
+    operations << op;
+}
+
+void VectorDrawing::addFilledPolygon(const QPolygonF &polygon, const QColor &fillColor) {
+    if (polygon.count() < 3)
+        return;
+
+    Operation op {Operation::Type::FilledPolygon};
+    op.points = polygon;
+    op.color = fillColor;
+    operations << op;
+}
+
+void VectorDrawing::addText(
+        const QPointF &topLeft, const QString &text, const Font &font, const QColor &color,
+        const double rotationClockwise) {
+    if (text.isEmpty())
+        return;
+
+    Operation op {Operation::Type::Text};
+    op.textTopLeft = topLeft;
+    op.text = text;
+    op.font = font;
+    op.color = color;
+    op.rotation = rotationClockwise;
+    operations << op;
+}
+
+double VectorDrawing::addWrappedText(
+        const QRectF &rect, const QString &text, const Font &font, const QColor &color) {
+    const double h = lineHeight(font);
+    const int maxLinesCount = std::max(0, int(std::floor(rect.height() / h)));
+    const QStringList lines = wrapText(text, font, rect.width(), maxLinesCount);
+
+    double y = rect.top();
+    for (const QString &line: lines) {
+        addText(QPointF(rect.left(), y), line, font, color);
+        y += h;
+    }
+    return y - rect.top();
+}
+
+void VectorDrawing::beginClip(const QRectF &rect) {
+    Operation op {Operation::Type::BeginClip};
+    op.rect = rect;
+    operations << op;
+    ++openClipsCount;
+}
+
+void VectorDrawing::endClip() {
+    if (openClipsCount == 0) {
+        Q_ASSERT(false); // no matching beginClip()
+        return;
+    }
+    operations << Operation {Operation::Type::EndClip};
+    --openClipsCount;
+}
+
+QRectF VectorDrawing::getRect() const {
+    return rect;
+}
+
+int VectorDrawing::getOperationsCount() const {
+    return operations.count();
+}
+
+bool VectorDrawing::writeSvg(QIODevice *device, QString *errorMsg) const {
+    Q_ASSERT(openClipsCount == 0);
+
+    QXmlStreamWriter xml(device);
+    xml.setAutoFormatting(true);
+    xml.setAutoFormattingIndent(0);
+
+    xml.writeStartDocument();
+    xml.writeStartElement("svg");
+    xml.writeDefaultNamespace("http://www.w3.org/2000/svg");
+    xml.writeAttribute("version", "1.1");
+    xml.writeAttribute("width", svgNumber(rect.width()));
+    xml.writeAttribute("height", svgNumber(rect.height()));
+    xml.writeAttribute(
+            "viewBox",
+            QString("%1 %2 %3 %4").arg(
+                svgNumber(rect.x()), svgNumber(rect.y()),
+                svgNumber(rect.width()), svgNumber(rect.height())));
+
+    if (backgroundColor.isValid()) {
+        xml.writeEmptyElement("rect");
+        writeSvgRectAttributes(xml, rect, 0);
+        writeSvgColorAttributes(xml, "fill", backgroundColor);
+    }
+
+    int clipsCount = 0;
+    for (const Operation &op: operations) {
+        switch (op.type) {
+        case Operation::Type::FilledRect:
+            xml.writeEmptyElement("rect");
+            writeSvgRectAttributes(xml, op.rect, op.cornerRadius);
+            writeSvgColorAttributes(xml, "fill", op.color);
+            break;
+
+        case Operation::Type::RectOutline:
+            xml.writeEmptyElement("rect");
+            writeSvgRectAttributes(xml, op.rect, op.cornerRadius);
+            xml.writeAttribute("fill", "none");
+            writeSvgColorAttributes(xml, "stroke", op.color);
+            xml.writeAttribute("stroke-width", svgNumber(op.lineWidth));
+            if (op.lineStyle == LineStyle::Dotted) {
+                // (same pattern as Qt::DotLine)
+                xml.writeAttribute(
+                        "stroke-dasharray",
+                        svgNumber(op.lineWidth) + " " + svgNumber(op.lineWidth * 2));
+            }
+            break;
+
+        case Operation::Type::Polyline:
+            xml.writeEmptyElement("polyline");
+            xml.writeAttribute("points", svgPoints(op.points));
+            xml.writeAttribute("fill", "none");
+            writeSvgColorAttributes(xml, "stroke", op.color);
+            xml.writeAttribute("stroke-width", svgNumber(op.lineWidth));
+            xml.writeAttribute("stroke-linecap", "square");
+            xml.writeAttribute("stroke-linejoin", "bevel");
+            break;
+
+        case Operation::Type::FilledPolygon:
+            xml.writeEmptyElement("polygon");
+            xml.writeAttribute("points", svgPoints(op.points));
+            writeSvgColorAttributes(xml, "fill", op.color);
+            break;
+
+        case Operation::Type::Text:
+        {
+            const QPointF baselineLeft = op.textTopLeft + QPointF(0, ascent(op.font));
+            xml.writeStartElement("text");
+            xml.writeAttribute("xml:space", "preserve");
+            xml.writeAttribute("x", svgNumber(baselineLeft.x()));
+            xml.writeAttribute("y", svgNumber(baselineLeft.y()));
+            if (op.rotation != 0) {
+                xml.writeAttribute(
+                        "transform",
+                        QString("rotate(%1 %2 %3)").arg(
+                            svgNumber(op.rotation),
+                            svgNumber(op.textTopLeft.x()), svgNumber(op.textTopLeft.y())));
+            }
+            xml.writeAttribute("font-family", op.font.family);
+            xml.writeAttribute("font-size", svgNumber(op.font.pixelSize));
+            if (op.font.bold)
+                xml.writeAttribute("font-weight", "bold");
+            writeSvgColorAttributes(xml, "fill", op.color);
+            xml.writeCharacters(op.text);
+            xml.writeEndElement();
+            break;
+        }
+        case Operation::Type::BeginClip:
+        {
+            ++clipsCount;
+            const QString clipId = QString("clip%1").arg(clipsCount);
+
+            xml.writeStartElement("clipPath");
+            xml.writeAttribute("id", clipId);
+            xml.writeEmptyElement("rect");
+            writeSvgRectAttributes(xml, op.rect, 0);
+            xml.writeEndElement();
+
+            xml.writeStartElement("g");
+            xml.writeAttribute("clip-path", QString("url(#%1)").arg(clipId));
+            break;
+        }
+        case Operation::Type::EndClip:
+            xml.writeEndElement(); // </g>
+            break;
+        }
+    }
+
+    xml.writeEndElement(); // </svg>
+    xml.writeEndDocument();
+
+    if (xml.hasError()) {
+        if (errorMsg != nullptr)
+            *errorMsg = device->errorString();
+        return false;
+    }
+    return true;
+}
+
+void VectorDrawing::paint(QPainter *painter) const {
+    Q_ASSERT(openClipsCount == 0);
+
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing, true);
+    painter->setRenderHint(QPainter::TextAntialiasing, true);
+
+    if (backgroundColor.isValid())
+        painter->fillRect(rect, backgroundColor);
+
+    for (const Operation &op: operations) {
+        switch (op.type) {
+        case Operation::Type::FilledRect:
+            painter->setPen(Qt::NoPen);
+            painter->setBrush(op.color);
+            painter->drawRoundedRect(op.rect, op.cornerRadius, op.cornerRadius);
+            break;
+
+        case Operation::Type::RectOutline:
+            painter->setPen(QPen(
+                    QBrush(op.color), op.lineWidth,
+                    (op.lineStyle == LineStyle::Dotted) ? Qt::DotLine : Qt::SolidLine));
+            painter->setBrush(Qt::NoBrush);
+            painter->drawRoundedRect(op.rect, op.cornerRadius, op.cornerRadius);
+            break;
+
+        case Operation::Type::Polyline:
+            painter->setPen(QPen(
+                    QBrush(op.color), op.lineWidth, Qt::SolidLine, Qt::SquareCap, Qt::BevelJoin));
+            painter->setBrush(Qt::NoBrush);
+            painter->drawPolyline(op.points.constData(), op.points.count());
+            break;
+
+        case Operation::Type::FilledPolygon:
+            painter->setPen(Qt::NoPen);
+            painter->setBrush(op.color);
+            painter->drawPolygon(op.points.constData(), op.points.count());
+            break;
+
+        case Operation::Type::Text:
+            painter->save();
+            painter->translate(op.textTopLeft);
+            painter->rotate(op.rotation);
+            painter->setFont(toQFont(op.font));
+            painter->setPen(op.color);
+            painter->drawText(QPointF(0, ascent(op.font)), op.text);
+            painter->restore();
+            break;
+
+        case Operation::Type::BeginClip:
+            painter->save();
+            painter->setClipRect(op.rect, Qt::IntersectClip);
+            break;
+
+        case Operation::Type::EndClip:
+            painter->restore();
+            break;
+        }
+    }
+
+    painter->restore();
+}
+
+double VectorDrawing::estimateTextWidth(const QString &text, const Font &font) {
+    double widthInEm = 0;
+    for (const QChar c: text)
+        widthInEm += charWidthInEm(c);
+    return widthInEm * font.pixelSize * (font.bold ? 1.08 : 1.0);
+}
+
+double VectorDrawing::lineHeight(const Font &font) {
+    return font.pixelSize * 1.15;
+}
+
+double VectorDrawing::ascent(const Font &font) {
+    return font.pixelSize * 0.9;
+}
+
+QStringList VectorDrawing::wrapText(
+        const QString &text, const Font &font, const double width, const int maxLinesCount) {
+    QStringList lines;
+    auto isFull = [&lines, maxLinesCount]() {
+        return maxLinesCount >= 0 && lines.count() >= maxLinesCount;
+    };
+
+    const QStringList paragraphs = text.split('\n');
+    for (const QString &paragraph: paragraphs) {
+        if (isFull())
+            break;
+
+        QString line;
+        double lineWidth = 0;
+        int i = 0;
+        while (i < paragraph.length()) {
+            // next word, including its trailing spaces
+            int j = i;
+            while (j < paragraph.length() && paragraph.at(j) != ' ')
+                ++j;
+            while (j < paragraph.length() && paragraph.at(j) == ' ')
+                ++j;
+            const QString word = paragraph.mid(i, j - i);
+            const double wordWidth = estimateTextWidth(removeTrailingSpaces(word), font);
+
+            if (lineWidth + wordWidth <= width) {
+                line += word;
+                lineWidth += estimateTextWidth(word, font);
+                i = j;
+                continue;
+            }
+
+            if (!line.isEmpty()) { // start a new line with the word
+                lines << removeTrailingSpaces(line);
+                if (isFull())
+                    return lines;
+                line.clear();
+                lineWidth = 0;
+                continue;
+            }
+
+            // the word alone is too wide: break it (at least 1 character per line)
+            int k = i;
+            double w = 0;
+            while (k < j) {
+                const double charWidth = estimateTextWidth(paragraph.at(k), font);
+                if (k > i && w + charWidth > width)
+                    break;
+                w += charWidth;
+                ++k;
+            }
+            lines << removeTrailingSpaces(paragraph.mid(i, k - i));
+            if (isFull())
+                return lines;
+            i = k;
+        }
+
+        if (!line.isEmpty() || paragraph.isEmpty())
+            lines << removeTrailingSpaces(line);
+    }
+
+    if (maxLinesCount >= 0 && lines.count() > maxLinesCount)
+        lines.erase(lines.begin() + maxLinesCount, lines.end());
+    return lines;
+}
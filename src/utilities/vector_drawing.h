@@ -0,0 +1,132 @@
+#ifndef VECTOR_DRAWING_H
+#define VECTOR_DRAWING_H
+
+#include <QColor>
+#include <QPointF>
+#include <QPolygonF>
+#include <QRectF>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class QIODevice;
+class QPainter;
+
+//!
+//! A list of vector drawing operations (in the order of drawing), which can be written as an SVG
+//! document or played on a \c QPainter (e.g., one on a \c QPdfWriter).
+//!
+//! The size of the list, and of the SVG written, is proportional to the number of operations
+//! rather than to the area drawn.
+//!
+//! Texts are laid out without a font database: their widths are estimated from the font pixel
+//! size (see \c estimateTextWidth()), so that a drawing can be made without a GUI application.
+//!
+class VectorDrawing
+{
+public:
+    struct Font
+    {
+        QString family {"Arial"};
+        double pixelSize {13};
+        bool bold {false};
+    };
+
+    enum class LineStyle {Solid, Dotted};
+
+    //!
+    //! \param rect: the region of the drawing to be output
+    //!
+    explicit VectorDrawing(const QRectF &rect = QRectF());
+
+    void setRect(const QRectF &rect);
+    void setBackgroundColor(const QColor &color); // invalid color: no background
+
+    //
+    void addFilledRect(const QRectF &rect, const double cornerRadius, const QColor &fillColor);
+    void addRectOutline(
+            const QRectF &rect, const double cornerRadius,
+            const QColor &lineColor, const double lineWidth, const LineStyle lineStyle);
+    void addPolyline(
+            const QVector<QPointF> &points, const QColor &lineColor, const double lineWidth);
+    void addFilledPolygon(const QPolygonF &polygon, const QColor &fillColor);
+
+    //!
+    //! Adds a single line of text.
+    //! \param topLeft: top-left corner of the line box
+    //! \param rotationClockwise: in degrees, about \e topLeft
+    //!
+    void addText(
+            const QPointF &topLeft, const QString &text, const Font &font, const QColor &color,
+            const double rotationClockwise = 0);
+
+    //!
+    //! Adds \e text word-wrapped to the width of \e rect. Lines below \e rect are dropped.
+    //! \return the height taken
+    //!
+    double addWrappedText(
+            const QRectF &rect, const QString &text, const Font &font, const QColor &color);
+
+    //!
+    //! Operations added between \c beginClip() and the matching \c endClip() are clipped to
+    //! \e rect. Can be nested.
+    //!
+    void beginClip(const QRectF &rect);
+    void endClip();
+
+    //
+    QRectF getRect() const;
+    int getOperationsCount() const;
+
+    //!
+    //! Writes an SVG document whose user units are the coordinates of the drawing.
+    //!
+    bool writeSvg(QIODevice *device, QString *errorMsg) const;
+
+    //!
+    //! Plays the operations on \e painter, in the coordinates of the drawing.
+    //!
+    void paint(QPainter *painter) const;
+
+    //
+    static double estimateTextWidth(const QString &text, const Font &font);
+    static double lineHeight(const Font &font);
+    static double ascent(const Font &font);
+
+    //!
+    //! Breaks \e text into lines not wider than \e width (as estimated by \c estimateTextWidth()),
+    //! preferably at spaces. Line breaks in \e text are kept.
+    //! \param maxLinesCount: stops after this number of lines (-1: no limit)
+    //!
+    static QStringList wrapText(
+            const QString &text, const Font &font, const double width,
+            const int maxLinesCount = -1);
+
+private:
+    struct Operation
+    {
+        enum class Type {
+            FilledRect, RectOutline, Polyline, FilledPolygon, Text, BeginClip, EndClip
+        };
+        Type type;
+
+        QRectF rect; // FilledRect, RectOutline, BeginClip
+        double cornerRadius {0};
+        QVector<QPointF> points; // Polyline, FilledPolygon
+        QColor color;
+        double lineWidth {0};
+        LineStyle lineStyle {LineStyle::Solid};
+
+        QPointF textTopLeft; // Text
+        QString text;
+        Font font;
+        double rotation {0};
+    };
+
+    QRectF rect;
+    QColor backgroundColor;
+    QVector<Operation> operations;
+    int openClipsCount {0};
+};
+
+#endif // VECTOR_DRAWING_H
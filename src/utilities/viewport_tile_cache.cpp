@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <QPainter>
+#include "viewport_tile_cache.h"
+
+void ViewportTileCache::capture(
+        const QImage &image, const QPointF &viewTopLeft, const double viewScale) {
+    Q_ASSERT(viewScale > 0);
+
+    tiles.clear();
+    capturedViewTopLeft = viewTopLeft;
+    capturedViewScale = viewScale;
+
+    const double dpr = image.devicePixelRatio();
+    viewSize = QSize(qRound(image.width() / dpr), qRound(image.height() / dpr));
+
+    const QRect imageRect = image.rect();
+    for (int top = 0; top < viewSize.height(); top += tileSize) {
+        for (int left = 0; left < viewSize.width(); left += tileSize) {
+            Tile tile;
+            tile.rect = QRect(left, top, tileSize, tileSize) & QRect(QPoint(0, 0), viewSize);
+
+            const QRect pixelRect = QRect(
+                    qRound(tile.rect.left() * dpr), qRound(tile.rect.top() * dpr),
+                    qRound(tile.rect.width() * dpr), qRound(tile.rect.height() * dpr))
+                    & imageRect;
+            if (pixelRect.isEmpty())
+                continue;
+            tile.image = image.copy(pixelRect);
+            tiles << tile;
+        }
+    }
+}
+
+void ViewportTileCache::clear() {
+    tiles.clear();
+    viewSize = QSize();
+}
+
+bool ViewportTileCache::isEmpty() const {
+    return tiles.isEmpty();
+}
+
+int ViewportTileCache::getTilesCount() const {
+    return tiles.count();
+}
+
+QSize ViewportTileCache::getViewSize() const {
+    return viewSize;
+}
+
+int ViewportTileCache::draw(
+        QPainter *painter, const QSize &viewSize_, const QPointF &viewTopLeft,
+        const double viewScale, const QColor &backgroundColor) const {
+    Q_ASSERT(painter != nullptr);
+
+    const QRectF viewRect(QPointF(0, 0), QSizeF(viewSize_));
+    painter->fillRect(viewRect, backgroundColor);
+
+    const double ratio = viewScale / capturedViewScale;
+    int drawnCount = 0;
+    for (const Tile &tile: tiles) {
+        const QRectF targetRect(
+                mapToView(tile.rect.topLeft(), viewTopLeft, viewScale),
+                QSizeF(tile.rect.size()) * ratio);
+        if (!targetRect.intersects(viewRect))
+            continue;
+        painter->drawImage(targetRect, tile.image);
+        ++drawnCount;
+    }
+    return drawnCount;
+}
+
+QPointF ViewportTileCache::mapToView(
+        const QPointF &capturedViewPos,
+        const QPointF &viewTopLeft, const double viewScale) const {
+    const QPointF pos = capturedViewTopLeft + capturedViewPos / capturedViewScale;
+    return (pos - viewTopLeft) * viewScale;
+}
+
+QVector<QRect> ViewportTileCache::computeTilesByDistance(
+        const QSize &viewSize, const QPointF &center) {
+    QVector<QRect> result;
+    for (int top = 0; top < viewSize.height(); top += tileSize) {
+        for (int left = 0; left < viewSize.width(); left += tileSize)
+            result << (QRect(left, top, tileSize, tileSize) & QRect(QPoint(0, 0), viewSize));
+    }
+
+    const auto squaredDistance = [center](const QRect &rect) {
+        const QPointF d = QRectF(rect).center() - center;
+        return d.x() * d.x() + d.y() * d.y();
+    };
+    std::stable_sort(result.begin(), result.end(), [&](const QRect &a, const QRect &b) {
+        return squaredDistance(a) < squaredDistance(b);
+    });
+    return result;
+}
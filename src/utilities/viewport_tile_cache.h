@@ -0,0 +1,76 @@
+#ifndef VIEWPORT_TILE_CACHE_H
+#define VIEWPORT_TILE_CACHE_H
+
+#include <QColor>
+#include <QImage>
+#include <QPointF>
+#include <QRect>
+#include <QSize>
+#include <QVector>
+
+class QPainter;
+
+//!
+//! Keeps a captured image of a viewport, divided into tiles, together with the view it was
+//! captured from (the position of the view's top-left corner, and the view's scale, i.e.,
+//! pixels per unit of the viewed coordinates). The tiles can then be drawn as seen from another
+//! view, e.g., to preview a zoom without re-rendering the contents.
+//!
+class ViewportTileCache
+{
+public:
+    ViewportTileCache() = default;
+
+    //!
+    //! \param image: its device pixel ratio is taken into account
+    //! \param viewTopLeft: the position of the captured view's top-left corner
+    //! \param viewScale: the captured view's scale (> 0)
+    //!
+    void capture(const QImage &image, const QPointF &viewTopLeft, const double viewScale);
+    void clear();
+
+    bool isEmpty() const;
+    int getTilesCount() const;
+    QSize getViewSize() const; // size of the captured view, in device-independent pixels
+
+    //!
+    //! Draws the tiles as seen from a view of \e viewSize, having top-left corner at
+    //! \e viewTopLeft and scale \e viewScale. The area not covered by the tiles is filled with
+    //! \e backgroundColor. Tiles outside the view are skipped.
+    //! \return the number of tiles drawn
+    //!
+    int draw(
+            QPainter *painter, const QSize &viewSize, const QPointF &viewTopLeft,
+            const double viewScale, const QColor &backgroundColor) const;
+
+    //!
+    //! Maps a position in the captured view (in pixels) to the view having top-left corner at
+    //! \e viewTopLeft and scale \e viewScale.
+    //!
+    QPointF mapToView(
+            const QPointF &capturedViewPos,
+            const QPointF &viewTopLeft, const double viewScale) const;
+
+    //!
+    //! \return the tiles of a grid covering a view of \e viewSize, sorted by the distance of
+    //!         their centers from \e center (nearest first)
+    //!
+    static QVector<QRect> computeTilesByDistance(const QSize &viewSize, const QPointF &center);
+
+    //
+    constexpr static int tileSize {128}; // in device-independent pixels
+
+private:
+    struct Tile
+    {
+        QRect rect; // in the captured view, in device-independent pixels
+        QImage image;
+    };
+
+    QVector<Tile> tiles;
+    QSize viewSize;
+    QPointF capturedViewTopLeft;
+    double capturedViewScale {1.0};
+};
+
+#endif // VIEWPORT_TILE_CACHE_H
@@ -0,0 +1,482 @@
+#include <QDebug>
+#include <QFile>
+#include <QPageSize>
+#include <QPainter>
+#include <QPdfWriter>
+#include "models/group_box_tree.h"
+#include "models/relationship_bundler.h"
+#include "models/settings/settings.h"
+#include "utilities/geometry_util.h"
+#include "utilities/lists_vectors_util.h"
+#include "utilities/margins_util.h"
+#include "widgets/board_view.h"
+#include "widgets/components/board_box_item.h"
+#include "widgets/components/edge_arrow.h"
+#include "widgets/components/node_rect.h"
+#include "board_vector_export.h"
+
+namespace {
+// (same as BoardBoxItem's defaults)
+constexpr double boxBorderWidth = 5.0;
+constexpr double captionBarPadding = 2.0;
+const VectorDrawing::Font captionBarFont {"Arial", 13, true};
+
+constexpr double contentsPadding = 3.0;
+constexpr double boardMargin = 40.0;
+
+constexpr double bundleArrowLineWidth = 4.0;
+
+// PDF viewers generally don't support pages larger than 200 inches
+constexpr double maxPdfPageSizeInPoints = 14400;
+} // namespace
+
+BoardVectorExport::BoardVectorExport(const BoardSnapshot &snapshot, const Style &style)
+        : style(style) {
+    drawBoard(snapshot);
+}
+
+QRectF BoardVectorExport::getBoardRect() const {
+    return drawing.getRect();
+}
+
+int BoardVectorExport::getItemsCount() const {
+    return itemsCount;
+}
+
+bool BoardVectorExport::writeFile(
+        const QString &filePath, const FileFormat format, QString *errorMsg) const {
+    switch (format) {
+    case FileFormat::Svg:
+        return writeSvg(filePath, errorMsg);
+    case FileFormat::Pdf:
+        return writePdf(filePath, errorMsg);
+    }
+    Q_ASSERT(false); // case not implemented
+    return false;
+}
+
+QString BoardVectorExport::getFileExtension(const FileFormat format) {
+    switch (format) {
+    case FileFormat::Svg:
+        return "svg";
+    case FileFormat::Pdf:
+        return "pdf";
+    }
+    Q_ASSERT(false); // case not implemented
+    return "";
+}
+
+bool BoardVectorExport::writeSvg(const QString &filePath, QString *errorMsg) const {
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        *errorMsg = QString("Could not write file %1: %2").arg(filePath, file.errorString());
+        return false;
+    }
+
+    QString writeErrorMsg;
+    if (!drawing.writeSvg(&file, &writeErrorMsg)) {
+        file.close();
+        file.remove();
+        *errorMsg = QString("Could not write file %1: %2").arg(filePath, writeErrorMsg);
+        return false;
+    }
+    return true;
+}
+
+bool BoardVectorExport::writePdf(const QString &filePath, QString *errorMsg) const {
+    const QRectF rect = drawing.getRect();
+    if (rect.isEmpty()) {
+        *errorMsg = "The board is empty.";
+        return false;
+    }
+
+    const double scale = std::min(
+            1.0, maxPdfPageSizeInPoints / std::max(rect.width(), rect.height()));
+
+    QPdfWriter pdfWriter(filePath);
+    pdfWriter.setResolution(72); // (1 device pixel = 1 point)
+    pdfWriter.setPageMargins(QMarginsF(0, 0, 0, 0));
+    pdfWriter.setPageSize(
+            QPageSize(rect.size() * scale, QPageSize::Point, "", QPageSize::ExactMatch));
+
+    QPainter painter;
+    if (!painter.begin(&pdfWriter)) {
+        *errorMsg = QString("Could not write file %1").arg(filePath);
+        return false;
+    }
+    painter.scale(scale, scale);
+    painter.translate(-rect.topLeft());
+    drawing.paint(&painter);
+
+    if (!painter.end()) {
+        *errorMsg = QString("Could not write file %1").arg(filePath);
+        return false;
+    }
+    return true;
+}
+
+void BoardVectorExport::drawBoard(const BoardSnapshot &snapshot) {
+    const Board &board = snapshot.board;
+
+    // relationships to show (those whose both cards have NodeRect's)
+    QSet<RelationshipId> relIds;
+    QHash<int, QSet<RelationshipId>> cardIdToRels;
+    for (auto it = snapshot.relationships.constBegin();
+            it != snapshot.relationships.constEnd(); ++it) {
+        const RelationshipId &relId = it.key();
+        if (!board.cardIdToNodeRectData.contains(relId.startCardId)
+                || !board.cardIdToNodeRectData.contains(relId.endCardId)) {
+            continue;
+        }
+        relIds << relId;
+        cardIdToRels[relId.startCardId] << relId;
+        cardIdToRels[relId.endCardId] << relId;
+    }
+
+    // group-box tree & relationship bundles
+    GroupBoxTree groupBoxTree;
+    {
+        QHash<int, GroupBoxTree::ChildGroupBoxesAndCards> groupBoxIdToChildItems;
+        for (auto it = board.groupBoxIdToData.constBegin();
+                it != board.groupBoxIdToData.constEnd(); ++it) {
+            groupBoxIdToChildItems.insert(
+                    it.key(), {it.value().childGroupBoxes, it.value().childCards});
+        }
+
+        QString errorMsg;
+        if (!groupBoxTree.set(groupBoxIdToChildItems, &errorMsg)) {
+            qWarning().noquote() << "could not set up group-box tree:" << errorMsg;
+            groupBoxTree.clear();
+        }
+    }
+
+    RelationshipBundler bundler(&groupBoxTree, [&cardIdToRels](const int cardId) {
+        return cardIdToRels.value(cardId);
+    });
+    bundler.markAllChanged();
+    bundler.update();
+
+    // drawing rect
+    {
+        QVector<QRectF> rects {BoardView::computeBoundingRectOfBoxes(board)};
+        for (const RelationshipId &relId: qAsConst(relIds)) {
+            const QVector<QPointF> joints = board.relIdToJoints.value(relId);
+            if (!joints.isEmpty())
+                rects << QPolygonF(joints).boundingRect();
+        }
+
+        const QRectF boardRect = boundingRectOfRects(rects);
+        drawing.setRect(
+                boardRect.isNull()
+                ? QRectF()
+                : boardRect.marginsAdded(uniformMarginsF(boardMargin)));
+        drawing.setBackgroundColor(BoardView::getSceneBackgroundColor(style.isDarkTheme));
+    }
+
+    // group-boxes (parents first, so that they don't cover their children)
+    {
+        QVector<int> groupBoxIdsFromDepthFirstTraversal;
+        groupBoxTree.getDescendantCardsOfEveryGroupBox(&groupBoxIdsFromDepthFirstTraversal);
+        for (const int groupBoxId: qAsConst(groupBoxIdsFromDepthFirstTraversal)) {
+            const auto it = board.groupBoxIdToData.constFind(groupBoxId);
+            if (it != board.groupBoxIdToData.constEnd())
+                drawGroupBox(groupBoxId, it.value());
+        }
+    }
+
+    // NodeRect's
+    {
+        CardPropertiesToShow effectiveCardPropertiesToShow = style.cardPropertiesToShow;
+        effectiveCardPropertiesToShow.updateWith(board.cardPropertiesToShow);
+        const CardPropertiesToShow::CompiledTable cardPropertiesToShowTable
+                = effectiveCardPropertiesToShow.compile();
+
+        QVector<std::pair<Symbol, QColor>> labelSymbolsAndColors;
+        const auto &labelsAndColors = style.cardLabelToColorMapping.cardLabelsAndAssociatedColors;
+        for (const auto &[label, color]: labelsAndColors)
+            labelSymbolsAndColors << std::make_pair(Symbol(label), color);
+        const LabelRulesTable<QColor> cardLabelColorsTable(labelSymbolsAndColors);
+
+        for (auto it = board.cardIdToNodeRectData.constBegin();
+                it != board.cardIdToNodeRectData.constEnd(); ++it) {
+            const CardSnapshot card = snapshot.cards.value(it.key());
+            if (card == nullptr)
+                continue;
+            drawNodeRect(
+                    it.key(), it.value(), *card,
+                    cardPropertiesToShowTable, cardLabelColorsTable);
+        }
+    }
+
+    // DataViewBox's
+    for (auto it = board.customDataQueryIdToDataViewBoxData.constBegin();
+            it != board.customDataQueryIdToDataViewBoxData.constEnd(); ++it) {
+        drawDataViewBox(it.key(), it.value(), snapshot.customDataQueries.value(it.key()));
+    }
+
+    // setting-boxes
+    for (const SettingBoxData &settingBoxData: board.settingBoxesData)
+        drawSettingBox(settingBoxData);
+
+    // arrows of relationships not bundled
+    {
+        QHash<QSet<int>, QSet<RelationshipId>> cardIdPairToParallelRels;
+        for (const RelationshipId &relId: qAsConst(relIds)) {
+            if (!bundler.isBundled(relId))
+                cardIdPairToParallelRels[QSet<int> {relId.startCardId, relId.endCardId}] << relId;
+        }
+
+        for (const QSet<RelationshipId> &parallelRels: qAsConst(cardIdPairToParallelRels)) {
+            QSet<RelationshipId> parallelRelsWithoutJoint;
+            for (const RelationshipId &relId: parallelRels) {
+                if (!board.relIdToJoints.contains(relId))
+                    parallelRelsWithoutJoint << relId;
+            }
+            const QVector<RelationshipId> sortedParallelRelsWithoutJoint
+                    = sortRelationshipIds(parallelRelsWithoutJoint);
+
+            for (const RelationshipId &relId: parallelRels) {
+                const QRectF startRect = board.cardIdToNodeRectData.value(relId.startCardId).rect;
+                const QRectF endRect = board.cardIdToNodeRectData.value(relId.endCardId).rect;
+                const QVector<QPointF> joints = board.relIdToJoints.value(relId);
+
+                QVector<QPointF> points;
+                if (joints.isEmpty()) {
+                    const QLineF line = computeArrowLineConnectingRects(
+                            startRect, endRect,
+                            sortedParallelRelsWithoutJoint.indexOf(relId),
+                            sortedParallelRelsWithoutJoint.count());
+                    points << line.p1() << line.p2();
+                }
+                else {
+                    points << computeLineEndOnRectEdge(startRect, joints.first())
+                           << joints
+                           << computeLineEndOnRectEdge(endRect, joints.last());
+                }
+                drawArrow(points, BoardView::defaultEdgeArrowLineWidth, relId.type.toString());
+            }
+        }
+    }
+
+    // arrows of relationship bundles
+    {
+        using GroupBoxAndCard = std::pair<int, int>;
+        QHash<GroupBoxAndCard, QSet<RelationshipsBundle>> groupBoxAndCardToBundles;
+        const QSet<RelationshipsBundle> bundles = bundler.getAllBundles();
+        for (const RelationshipsBundle &bundle: bundles)
+            groupBoxAndCardToBundles[{bundle.groupBoxId, bundle.externalCardId}] << bundle;
+
+        for (auto it = groupBoxAndCardToBundles.constBegin();
+                it != groupBoxAndCardToBundles.constEnd(); ++it) {
+            const QRectF groupBoxRect = board.groupBoxIdToData.value(it.key().first).rect;
+            const QRectF nodeRectRect = board.cardIdToNodeRectData.value(it.key().second).rect;
+
+            int parallelIndex = 0;
+            for (const RelationshipsBundle &bundle: it.value()) {
+                const bool isIntoGroup
+                        = (bundle.direction == RelationshipsBundle::Direction::IntoGroup);
+                const QLineF line = computeArrowLineConnectingRects(
+                        isIntoGroup ? nodeRectRect : groupBoxRect,
+                        isIntoGroup ? groupBoxRect : nodeRectRect,
+                        parallelIndex, it.value().count());
+                drawArrow(
+                        {line.p1(), line.p2()}, bundleArrowLineWidth,
+                        bundle.relationshipType.toString());
+                ++parallelIndex;
+            }
+        }
+    }
+}
+
+QRectF BoardVectorExport::drawBoxFrame(
+        const QRectF &rect, const QColor &color, const bool isOpaque, const bool isDashed,
+        const QString &captionLeftText, const QString &captionRightText) {
+    ++itemsCount;
+
+    // border
+    drawing.addRectOutline(
+            rect.marginsRemoved(uniformMarginsF(boxBorderWidth / 2.0)), boxBorderWidth,
+            color, boxBorderWidth,
+            isDashed ? VectorDrawing::LineStyle::Dotted : VectorDrawing::LineStyle::Solid);
+
+    // caption bar
+    const QRectF borderInnerRect = rect.marginsRemoved(uniformMarginsF(boxBorderWidth));
+    const QRectF captionBarRect(
+            borderInnerRect.topLeft(),
+            QSizeF(borderInnerRect.width(),
+                   VectorDrawing::lineHeight(captionBarFont) + captionBarPadding * 2));
+    drawing.addFilledRect(captionBarRect.marginsAdded(QMarginsF(1, 1, 1, 0)), 0, color);
+
+    const QColor captionBarTextColor = BoardBoxItem::getCaptionBarTextColor(style.isDarkTheme);
+    drawing.beginClip(captionBarRect);
+    {
+        const QPointF textPos
+                = captionBarRect.topLeft() + QPointF(captionBarPadding, captionBarPadding);
+        drawing.addText(textPos, captionLeftText, captionBarFont, captionBarTextColor);
+
+        VectorDrawing::Font rightTextFont = captionBarFont;
+        rightTextFont.bold = false;
+        const double rightTextWidth
+                = VectorDrawing::estimateTextWidth(captionRightText, rightTextFont);
+        drawing.addText(
+                QPointF(captionBarRect.right() - captionBarPadding - rightTextWidth, textPos.y()),
+                captionRightText, rightTextFont, captionBarTextColor);
+    }
+    drawing.endClip();
+
+    // contents background
+    const QRectF contentsRect
+            = borderInnerRect.marginsRemoved({0.0, captionBarRect.height(), 0.0, 0.0});
+    if (isOpaque) {
+        const QBrush brush = BoardBoxItem::getContentsRectItemBrush(
+                BoardBoxItem::ContentsBackgroundType::Opaque, style.isDarkTheme);
+        drawing.addFilledRect(contentsRect, 0, brush.color());
+    }
+
+    return contentsRect;
+}
+
+void BoardVectorExport::drawNodeRect(
+        const int cardId, const NodeRectData &nodeRectData, const Card &card,
+        const CardPropertiesToShow::CompiledTable &cardPropertiesToShowTable,
+        const LabelRulesTable<QColor> &cardLabelColorsTable) {
+    const QColor color = BoardView::computeNodeRectDisplayColor(
+            nodeRectData.ownColor, card.getLabelSymbols(), cardLabelColorsTable,
+            style.cardLabelToColorMapping.defaultNodeRectColor,
+            style.autoAdjustCardColorsForDarkTheme && style.isDarkTheme);
+
+    const QVector<QString> labels
+            = sortByOrdering(card.getLabels(), style.userLabelsList, false);
+    const QRectF contentsRect = drawBoxFrame(
+            nodeRectData.rect, color, true, false,
+            NodeRect::getNodeLabelsString(QStringList(labels.cbegin(), labels.cend())),
+            QString("Card %1").arg(cardId));
+
+    //
+    const QColor normalTextColor = NodeRect::getNormalTextColor(style.isDarkTheme);
+    const QColor dimTextColor = NodeRect::getDimTextColor(style.isDarkTheme);
+    const QRectF textRect = contentsRect.marginsRemoved(uniformMarginsF(contentsPadding));
+
+    drawing.beginClip(contentsRect);
+    {
+        double y = textRect.top();
+
+        // title
+        const VectorDrawing::Font titleFont {"Arial", 20, true};
+        y += std::max(
+                drawing.addWrappedText(
+                    QRectF(textRect.left(), y, textRect.width(), textRect.bottom() - y),
+                    card.title, titleFont, normalTextColor),
+                VectorDrawing::lineHeight(titleFont));
+        y += contentsPadding;
+
+        // properties
+        const QString propertiesDisplay = BoardView::computeCardPropertiesDisplay(
+                cardPropertiesToShowTable, card.getLabelSymbols(), card.getCustomProperties());
+        if (!propertiesDisplay.isEmpty()) {
+            const VectorDrawing::Font propertiesFont {"Arial", 14, true};
+            y += drawing.addWrappedText(
+                    QRectF(textRect.left(), y, textRect.width(), textRect.bottom() - y),
+                    propertiesDisplay, propertiesFont, dimTextColor);
+            y += contentsPadding;
+        }
+
+        // text
+        const VectorDrawing::Font textFont {"Arial", 16, false};
+        drawing.addWrappedText(
+                QRectF(textRect.left(), y, textRect.width(), textRect.bottom() - y),
+                card.text, textFont, normalTextColor);
+    }
+    drawing.endClip();
+}
+
+void BoardVectorExport::drawGroupBox(const int groupBoxId, const GroupBoxData &groupBoxData) {
+    drawBoxFrame(
+            groupBoxData.rect, BoardView::computeGroupBoxColor(style.isDarkTheme), false, true,
+            groupBoxData.title, QString("Group %1").arg(groupBoxId));
+}
+
+void BoardVectorExport::drawDataViewBox(
+        const int customDataQueryId, const DataViewBoxData &dataViewBoxData,
+        const CustomDataQuery &customDataQuery) {
+    const QColor color = BoardView::computeDataViewBoxDisplayColor(
+            dataViewBoxData.ownColor, QColor());
+    const QRectF contentsRect = drawBoxFrame(
+            dataViewBoxData.rect, color, true, false,
+            "", QString("Data Query %1").arg(customDataQueryId));
+
+    //
+    const QColor textColor = NodeRect::getNormalTextColor(style.isDarkTheme);
+    const QRectF textRect = contentsRect.marginsRemoved(uniformMarginsF(contentsPadding));
+
+    drawing.beginClip(contentsRect);
+    {
+        double y = textRect.top();
+
+        const VectorDrawing::Font titleFont {"Arial", 20, true};
+        y += drawing.addWrappedText(
+                QRectF(textRect.left(), y, textRect.width(), textRect.bottom() - y),
+                customDataQuery.title, titleFont, textColor);
+        y += contentsPadding;
+
+        const VectorDrawing::Font labelFont {"Arial", 13, true};
+        drawing.addText(QPointF(textRect.left(), y), "Cypher:", labelFont, QColor(127, 127, 127));
+        y += VectorDrawing::lineHeight(labelFont);
+
+        const VectorDrawing::Font cypherFont {"Courier New", 16, false};
+        drawing.addWrappedText(
+                QRectF(textRect.left(), y, textRect.width(), textRect.bottom() - y),
+                customDataQuery.queryCypher, cypherFont, textColor);
+    }
+    drawing.endClip();
+}
+
+void BoardVectorExport::drawSettingBox(const SettingBoxData &settingBoxData) {
+    const QColor color = BoardView::computeSettingBoxDisplayColor(
+            BoardView::defaultNewSettingBoxColor,
+            style.autoAdjustCardColorsForDarkTheme && style.isDarkTheme);
+    const QRectF contentsRect = drawBoxFrame(
+            settingBoxData.rect, color, true, false, "Setting", "");
+
+    //
+    const QString title
+            = QString("%1 Setting: %2")
+              .arg(getDisplayNameOfTargetType(settingBoxData.targetType),
+                   getDisplayNameOfCategory(settingBoxData.category));
+    const QRectF textRect = contentsRect.marginsRemoved(uniformMarginsF(contentsPadding));
+
+    drawing.beginClip(contentsRect);
+    drawing.addWrappedText(
+            textRect, title, VectorDrawing::Font {"Arial", 18, true},
+            NodeRect::getNormalTextColor(style.isDarkTheme));
+    drawing.endClip();
+}
+
+void BoardVectorExport::drawArrow(
+        const QVector<QPointF> &points, const double lineWidth, const QString &label) {
+    Q_ASSERT(points.count() >= 2);
+    ++itemsCount;
+
+    const QColor lineColor = BoardView::computeEdgeArrowLineColor(style.isDarkTheme);
+    drawing.addPolyline(points, lineColor, lineWidth);
+
+    // arrow head
+    const QLineF lastSegment(points.at(points.count() - 2), points.last());
+    drawing.addFilledPolygon(
+            EdgeArrow::computeArrowHeadPolygon(
+                lastSegment, EdgeArrow::computeArrowHeadSize(lineWidth)),
+            lineColor);
+
+    // label (beside the first segment)
+    const VectorDrawing::Font labelFont {"Arial", EdgeArrow::labelFontPixelSize, false};
+    const QSizeF labelSize(
+            VectorDrawing::estimateTextWidth(label, labelFont),
+            VectorDrawing::lineHeight(labelFont));
+    constexpr bool textIsAbove = true;
+    const auto [textPos, textRotationClockwise] = EdgeArrow::computeLabelPositionAndRotation(
+            QLineF(points.at(0), points.at(1)), labelSize,
+            EdgeArrow::labelAndLineSpacing, textIsAbove);
+    drawing.addText(
+            textPos, label, labelFont, BoardView::computeEdgeArrowLabelColor(style.isDarkTheme),
+            textRotationClockwise);
+}
@@ -0,0 +1,77 @@
+#ifndef BOARD_VECTOR_EXPORT_H
+#define BOARD_VECTOR_EXPORT_H
+
+#include <QStringList>
+#include "models/board_snapshot.h"
+#include "models/settings/card_label_color_mapping.h"
+#include "models/settings/card_properties_to_show.h"
+#include "utilities/vector_drawing.h"
+
+//!
+//! Draws a board as vector graphics (SVG or PDF), directly from its \c BoardSnapshot.
+//!
+//! No graphics scene or \c BoardView is involved, so any board can be exported, opened or not.
+//! The board is drawn like in a \c BoardView at full level of detail (without the highlights
+//! and the text editors' scroll bars): group-boxes (parents first), then NodeRect's,
+//! DataViewBox's & setting-boxes, then the arrows of relationships and relationship bundles.
+//! The output size is proportional to the number of items, not to the area of the board.
+//!
+class BoardVectorExport
+{
+public:
+    struct Style
+    {
+        bool isDarkTheme {false};
+        bool autoAdjustCardColorsForDarkTheme {false};
+        CardLabelToColorMapping cardLabelToColorMapping; // of the workspace
+        CardPropertiesToShow cardPropertiesToShow; // of the workspace
+        QStringList userLabelsList; // for the order of labels shown
+    };
+
+    enum class FileFormat {Svg, Pdf};
+
+    explicit BoardVectorExport(const BoardSnapshot &snapshot, const Style &style);
+
+    QRectF getBoardRect() const; // in canvas coordinates, including margins
+    int getItemsCount() const;
+
+    bool writeFile(const QString &filePath, const FileFormat format, QString *errorMsg) const;
+    static QString getFileExtension(const FileFormat format);
+
+    bool writeSvg(const QString &filePath, QString *errorMsg) const;
+
+    //!
+    //! Writes a single-page PDF. The board is scaled down if necessary to fit the largest page
+    //! size that PDF viewers generally support.
+    //!
+    bool writePdf(const QString &filePath, QString *errorMsg) const;
+
+private:
+    const Style style;
+    VectorDrawing drawing;
+    int itemsCount {0};
+
+    void drawBoard(const BoardSnapshot &snapshot);
+
+    //!
+    //! Draws the border & caption bar, and returns the contents rect.
+    //!
+    QRectF drawBoxFrame(
+            const QRectF &rect, const QColor &color, const bool isOpaque, const bool isDashed,
+            const QString &captionLeftText, const QString &captionRightText);
+
+    void drawNodeRect(
+            const int cardId, const NodeRectData &nodeRectData, const Card &card,
+            const CardPropertiesToShow::CompiledTable &cardPropertiesToShowTable,
+            const LabelRulesTable<QColor> &cardLabelColorsTable);
+    void drawGroupBox(const int groupBoxId, const GroupBoxData &groupBoxData);
+    void drawDataViewBox(
+            const int customDataQueryId, const DataViewBoxData &dataViewBoxData,
+            const CustomDataQuery &customDataQuery);
+    void drawSettingBox(const SettingBoxData &settingBoxData);
+
+    void drawArrow(
+            const QVector<QPointF> &points, const double lineWidth, const QString &label);
+};
+
+#endif // BOARD_VECTOR_EXPORT_H
@@ -1,9 +1,21 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <utility>
+#include <QColorDialog>
 #include <QDebug>
 #include <QGraphicsView>
 #include <QInputDialog>
 #include <QMessageBox>
+#include <QPainter>
+#include <QPicture>
+#include <QPixmap>
+#include <QProgressBar>
 #include <QResizeEvent>
+#include <QScrollBar>
+#include <QShowEvent>
+#include <QTimer>
+#include <QVariantAnimation>
 #include <QVBoxLayout>
 #include "app_data.h"
 #include "board_view.h"
@@ -20,19 +32,25 @@
 #include "utilities/lists_vectors_util.h"
 #include "utilities/maps_util.h"
 #include "utilities/margins_util.h"
+#include "utilities/markdown_render_cache.h"
 #include "utilities/message_box.h"
 #include "utilities/numbers_util.h"
 #include "utilities/periodic_checker.h"
 #include "utilities/strings_util.h"
+#include "utilities/time_slicing.h"
 #include "widgets/board_view_toolbar.h"
+#include "widgets/components/board_minimap.h"
 #include "widgets/components/data_view_box.h"
 #include "widgets/components/edge_arrow.h"
 #include "widgets/components/graphics_scene.h"
 #include "widgets/components/group_box.h"
 #include "widgets/components/node_rect.h"
+#include "widgets/components/rendering_profiler_overlay.h"
 #include "widgets/components/setting_box.h"
+#include "widgets/components/zoom_preview_overlay.h"
 #include "widgets/dialogs/dialog_create_relationship.h"
 #include "widgets/dialogs/dialog_set_labels.h"
+#include "widgets/rendering_profiler.h"
 #include "widgets/widgets_constants.h"
 
 using ContinuationContext = AsyncRoutineWithErrorFlag::ContinuationContext;
@@ -42,6 +60,12 @@ BoardView::BoardView(QWidget *parent)
     handleSettingsEditedDebouncer = new ActionDebouncer(
             1000, ActionDebouncer::Option::Delay,
             [this]() { settingBoxesCollection.handleEditedSettings(); }, this);
+    updateContentsMaterializationDebouncer = new ActionDebouncer(
+            100, ActionDebouncer::Option::Delay,
+            [this]() { updateContentsMaterialization(); }, this);
+
+    markdownRenderCache = new MarkdownRenderCache(
+            NodeRect::formatPreviewDocument, maxCachedMarkdownCharacters, this);
 
     //
     setUpWidgets();
@@ -81,188 +105,86 @@ void BoardView::loadBoard(
     public:
         QStringList userLabelsList;
         Board board;
-        QHash<int, Card> cardsData;
+        QHash<int, CardSnapshot> cardsData;
         QHash<RelationshipId, RelationshipProperties> relationshipsData;
         QHash<int, CustomDataQuery> customDataQueriesData;
+
+        // for creating the items progressively
+        struct BoxToCreate
+        {
+            bool isDataViewBox; // false: NodeRect
+            int id; // card ID or custom-data-query ID
+        };
+        QVector<BoxToCreate> boxesToCreate; // nearest to the viewport first
+        QVector<RelationshipId> relIdsToCreate; // nearest to the viewport first
+        int createdBoxesCount {0};
+        int createdEdgeArrowsCount {0};
+        int bundledEdgeArrowsCount {0}; // those already fed to the relationship bundler
     };
     auto *routine = new AsyncRoutineWithVars;
     routine->setName("BoardView::loadBoard");
 
     boardId = boardIdToLoad; // will be set to -1 (in final step) if failed to load
 
-    routine->addStep([this, routine]() {
-        // 0. get the list of user-defined labels
-        using StringListPair = std::pair<QStringList, QStringList>;
-        Services::instance()->getAppDataReadonly()->getUserLabelsAndRelationshipTypes(
-                // callback
-                [routine](bool ok, const StringListPair &labelsAndRelTypes) {
-                    ContinuationContext context(routine);
-                    if (ok)
-                        routine->userLabelsList = labelsAndRelTypes.first;
-                },
-                this
-        );
-    }, this);
-
-    routine->addStep([this, routine, boardIdToLoad]() {
-        // 1. get board data
-        Services::instance()->getAppDataReadonly()->getBoardData(
-                boardIdToLoad,
-                // callback
-                [routine](bool ok, std::optional<Board> board) {
-                    ContinuationContext context(routine);
-
-                    if (!ok || !board.has_value())
-                        context.setErrorFlag();
-                    else
-                        routine->board = board.value();
-                },
-                this
-        );
-    }, this);
-
-    routine->addStep([this, routine, boardIdToLoad]() {
-        // 2. get cards data
-        const QSet<int> cardIds = keySet(routine->board.cardIdToNodeRectData);
-        Services::instance()->getAppDataReadonly()->queryCards(
-                cardIds,
-                // callback
-                [routine, cardIds, boardIdToLoad](bool ok, const QHash<int, Card> &cards) {
-                    ContinuationContext context(routine);
-
-                    if (!ok) {
-                        context.setErrorFlag();
-                        return;
-                    }
-
-                    if (keySet(cards) != cardIds) {
-                        qWarning().noquote()
-                                << QString("not all cards exist for board %1").arg(boardIdToLoad);
-                    }
-                    routine->cardsData = cards;
-                },
-                this
-        );
-    }, this);
-
-    routine->addStep([this, routine]() {
-        // 3. get relationships data
-        using RelId = RelationshipId;
-        using RelProperties = RelationshipProperties;
-
-        Services::instance()->getAppDataReadonly()->queryRelationshipsFromToCards(
-                keySet(routine->cardsData),
-                // callback
-                [routine](bool ok, const QHash<RelId, RelProperties> &rels) {
-                    ContinuationContext context(routine);
-
-                    if (!ok) {
-                        context.setErrorFlag();
-                        return;
-                    }
+    // (if `loadGeneration` changes, i.e., the view is closed or another board is loaded before
+    // this loading finishes, the remaining steps are skipped)
+    const int generation = ++loadGeneration;
+
+    routine->addParallelSteps({
+        {[this, routine]() {
+            // 1a. get the list of user-defined labels
+            using StringListPair = std::pair<QStringList, QStringList>;
+            Services::instance()->getAppDataReadonly()->getUserLabelsAndRelationshipTypes(
+                    // callback
+                    [routine](bool ok, const StringListPair &labelsAndRelTypes) {
+                        ContinuationContext context(routine);
+                        if (ok)
+                            routine->userLabelsList = labelsAndRelTypes.first;
+                    },
+                    this
+            );
+        }, this},
+        {[this, routine, boardIdToLoad]() {
+            // 1b. get board data, together with the cards, relationships and
+            //     custom-data-queries shown on the board (in one DB request)
+            Services::instance()->getAppDataReadonly()->getBoardSnapshot(
+                    boardIdToLoad,
+                    // callback
+                    [routine](bool ok, std::optional<BoardSnapshot> snapshot) {
+                        ContinuationContext context(routine);
 
-                    for (auto it = rels.constBegin(); it != rels.constEnd(); ++it) {
-                        const RelId &relId = it.key();
-                        if (!routine->cardsData.contains(relId.startCardId)
-                                || !routine->cardsData.contains(relId.endCardId)) {
-                            continue;
+                        if (!ok || !snapshot.has_value()) {
+                            context.setErrorFlag();
+                            return;
                         }
-                        routine->relationshipsData.insert(relId, it.value());
-                    }
-                },
-                this
-        );
-    }, this);
-
-    routine->addStep([this, routine]() {
-        // 4. get custom-data-queries data
-        const QSet<int> customDataQueryIds
-                = keySet(routine->board.customDataQueryIdToDataViewBoxData);
-
-        Services::instance()->getAppDataReadonly()->queryCustomDataQueries(
-                customDataQueryIds,
-                // callback
-                [routine](bool ok, const QHash<int, CustomDataQuery> &customDataQueries) {
-                    ContinuationContext context(routine);
 
-                    if (!ok) {
-                        context.setErrorFlag();
-                        return;
-                    }
-                    routine->customDataQueriesData = customDataQueries;
-                },
-                this
-        );
-    }, this);
+                        routine->board = snapshot.value().board;
+                        routine->cardsData = snapshot.value().cards;
+                        routine->relationshipsData = snapshot.value().relationships;
+                        routine->customDataQueriesData = snapshot.value().customDataQueries;
+                    },
+                    this
+            );
+        }, this}
+    });
 
-    routine->addStep([this, routine]() {
-        // 5. create NodeRect's, EdgeArrow's, DataViewBox's, GroupBox's, RelationshipsBundle's
+    routine->addStep([this, routine, generation]() {
+        // 2. set zoom ratio & view position, create GroupBox's, and sort the other items by
+        //    distance from the viewport
         ContinuationContext context(routine);
-
-        const bool isDarkTheme = Services::instance()->getAppDataReadonly()->getIsDarkTheme();
-        const bool autoAdjustCardColorsForDarkTheme
-                = Services::instance()->getAppDataReadonly()->getAutoAdjustCardColorsForDarkTheme();
-
-        // NodeRect's
-        CardPropertiesToShow effectiveCardPropertiesToShow
-                = cardPropertiesToShowSettings.onWorkspace;
-        effectiveCardPropertiesToShow.updateWith(routine->board.cardPropertiesToShow);
-
-        for (auto it = routine->cardsData.constBegin();
-                it != routine->cardsData.constEnd(); ++it) {
-            const int &cardId = it.key();
-            const Card &cardData = it.value();
-
-            const NodeRectData nodeRectData = routine->board.cardIdToNodeRectData.value(cardId);
-
-            const QColor displayColor = computeNodeRectDisplayColor(
-                    nodeRectData.ownColor, cardData.getLabels(),
-                    cardLabelsAndAssociatedColors, defaultNodeRectColor,
-                    autoAdjustCardColorsForDarkTheme && isDarkTheme);
-
-            const QString propertiesDisplay = computeCardPropertiesDisplay(
-                    effectiveCardPropertiesToShow,
-                    cardData.getLabels(), cardData.getCustomProperties());
-
-            NodeRect *nodeRect = nodeRectsCollection.createNodeRect(
-                    cardId, cardData, nodeRectData.rect,
-                    displayColor, nodeRectData.ownColor,
-                    routine->userLabelsList, propertiesDisplay);
-            nodeRect->setEditable(true);
-        }
-
-        // EdgeArrow's
-        EdgeArrowData edgeArrowData;
-        {
-            edgeArrowData.lineColor = getEdgeArrowLineColor();
-            edgeArrowData.lineWidth = defaultEdgeArrowLineWidth;
-            edgeArrowData.labelColor = getEdgeArrowLabelColor();
-
-        }
-
-        const auto relIds = keySet(routine->relationshipsData);
-        for (const auto &relId: relIds) {
-            edgeArrowData.joints = routine->board.relIdToJoints.value(relId);
-            relationshipsCollection.createEdgeArrow(relId, edgeArrowData);
+        if (loadGeneration != generation) {
+            context.setErrorFlag();
+            return;
         }
 
-        // DataViewBox's
-        for (auto it = routine->customDataQueriesData.constBegin();
-                it != routine->customDataQueriesData.constEnd(); ++it) {
-            const int &customDataQueryId = it.key();
-            const CustomDataQuery customDataQuery = it.value();
-
-            const DataViewBoxData dataViewBoxData
-                    = routine->board.customDataQueryIdToDataViewBoxData.value(customDataQueryId);
-
-            const QColor displayColor = computeDataViewBoxDisplayColor(
-                    dataViewBoxData.ownColor, QColor());
+        cardPropertiesToShowSettings.onBoard = routine->board.cardPropertiesToShow;
+        cardPropertiesToShowTable = compileCardPropertiesToShowSettings();
 
-            auto *box = dataViewBoxesCollection.createDataViewBox(
-                    customDataQueryId, customDataQuery, dataViewBoxData.rect,
-                    displayColor, dataViewBoxData.ownColor);
-            box->setEditable(true);
-        }
+        zoomScale = routine->board.zoomRatio;
+        canvas->setScale(zoomScale * graphicsGeometryScaleFactor); // (1)
+        updateLevelOfDetail();
+        adjustSceneRect(computeBoundingRectOfBoxes(routine->board)); // (2)
+        setViewTopLeftPos(routine->board.topLeftPos); // (3)
 
         // GroupBox's
         const QHash<int, GroupBoxData> &groupBoxIdToData = routine->board.groupBoxIdToData;
@@ -314,14 +236,221 @@ void BoardView::loadBoard(
         if (!ok) {
             qWarning().noquote() << "Could not create group-boxes tree:" << errorMsg;
             context.setErrorFlag();
+            return;
         }
+        relationshipBundlesCollection.markAllChanged(); // (bundles are updated in step 4)
 
-        // RelationshipsBundle's
-        updateRelationshipBundles();
+        // sort NodeRect's & DataViewBox's by distance from the view center
+        const QPointF viewCenter = canvas->mapFromScene(getViewCenterInScene());
+        auto squaredDistanceFromView = [viewCenter](const QRectF &rect) {
+            const QPointF d = rect.center() - viewCenter;
+            return QPointF::dotProduct(d, d);
+        };
+
+        using BoxToCreate = AsyncRoutineWithVars::BoxToCreate;
+        QVector<std::pair<double, BoxToCreate>> boxes;
+        QHash<int, double> cardIdToDistance;
+
+        for (auto it = routine->cardsData.constBegin(); it != routine->cardsData.constEnd(); ++it) {
+            const int cardId = it.key();
+            const double distance = squaredDistanceFromView(
+                    routine->board.cardIdToNodeRectData.value(cardId).rect);
+            boxes << std::make_pair(distance, BoxToCreate {false, cardId});
+            cardIdToDistance.insert(cardId, distance);
+        }
+        for (auto it = routine->customDataQueriesData.constBegin();
+                it != routine->customDataQueriesData.constEnd(); ++it) {
+            const int customDataQueryId = it.key();
+            const double distance = squaredDistanceFromView(
+                    routine->board.customDataQueryIdToDataViewBoxData
+                        .value(customDataQueryId).rect);
+            boxes << std::make_pair(distance, BoxToCreate {true, customDataQueryId});
+        }
+
+        std::stable_sort(
+                boxes.begin(), boxes.end(),
+                [](const auto &a, const auto &b) { return a.first < b.first; });
+        routine->boxesToCreate.reserve(boxes.count());
+        for (const auto &[distance, box]: qAsConst(boxes))
+            routine->boxesToCreate << box;
+
+        // sort EdgeArrow's by distance (of the nearer end) from the view center
+        QVector<std::pair<double, RelationshipId>> rels;
+        for (auto it = routine->relationshipsData.constBegin();
+                it != routine->relationshipsData.constEnd(); ++it) {
+            const RelationshipId &relId = it.key();
+            const double distance = std::min(
+                    cardIdToDistance.value(relId.startCardId),
+                    cardIdToDistance.value(relId.endCardId));
+            rels << std::make_pair(distance, relId);
+        }
+
+        std::stable_sort(
+                rels.begin(), rels.end(),
+                [](const auto &a, const auto &b) { return a.first < b.first; });
+        routine->relIdsToCreate.reserve(rels.count());
+        for (const auto &[distance, relId]: qAsConst(rels))
+            routine->relIdsToCreate << relId;
+
+        //
+        loadingProgressBar->setRange(
+                0, routine->boxesToCreate.count() + routine->relIdsToCreate.count());
+        loadingProgressBar->setValue(0);
+        loadingProgressBar->setVisible(true);
+
+        graphicsView->setInteractive(false); // until all items are created
+    }, this);
+
+    routine->addStep([this, routine, generation]() {
+        // 3. create NodeRect's & DataViewBox's, in time slices
+        const bool isDarkTheme = Services::instance()->getAppDataReadonly()->getIsDarkTheme();
+        const bool autoAdjustCardColorsForDarkTheme
+                = Services::instance()->getAppDataReadonly()->getAutoAdjustCardColorsForDarkTheme();
+
+        runInTimeSlices(
+                // processNext
+                [this, routine, generation, isDarkTheme, autoAdjustCardColorsForDarkTheme]() {
+                    if (loadGeneration != generation) {
+                        routine->errorFlag = true;
+                        return false;
+                    }
+                    if (routine->createdBoxesCount >= routine->boxesToCreate.count())
+                        return false;
+
+                    const auto &box = routine->boxesToCreate.at(routine->createdBoxesCount);
+                    ++routine->createdBoxesCount;
+
+                    if (!box.isDataViewBox) {
+                        // NodeRect
+                        const int cardId = box.id;
+                        const Card &cardData = *routine->cardsData.value(cardId);
+                        const NodeRectData nodeRectData
+                                = routine->board.cardIdToNodeRectData.value(cardId);
+
+                        const QColor displayColor = computeNodeRectDisplayColor(
+                                nodeRectData.ownColor, cardData.getLabelSymbols(),
+                                cardLabelColorsTable, defaultNodeRectColor,
+                                autoAdjustCardColorsForDarkTheme && isDarkTheme);
+
+                        const QString propertiesDisplay = computeCardPropertiesDisplay(
+                                cardPropertiesToShowTable,
+                                cardData.getLabelSymbols(), cardData.getCustomProperties());
+
+                        NodeRect *nodeRect = nodeRectsCollection.createNodeRect(
+                                cardId, cardData, nodeRectData.rect,
+                                displayColor, nodeRectData.ownColor,
+                                routine->userLabelsList, propertiesDisplay);
+                        nodeRect->setEditable(true);
+                    }
+                    else {
+                        // DataViewBox
+                        const int customDataQueryId = box.id;
+                        const CustomDataQuery customDataQuery
+                                = routine->customDataQueriesData.value(customDataQueryId);
+                        const DataViewBoxData dataViewBoxData
+                                = routine->board.customDataQueryIdToDataViewBoxData
+                                  .value(customDataQueryId);
+
+                        const QColor displayColor = computeDataViewBoxDisplayColor(
+                                dataViewBoxData.ownColor, QColor());
+
+                        auto *dataViewBox = dataViewBoxesCollection.createDataViewBox(
+                                customDataQueryId, customDataQuery, dataViewBoxData.rect,
+                                displayColor, dataViewBoxData.ownColor);
+                        dataViewBox->setEditable(true);
+                    }
+
+                    return routine->createdBoxesCount < routine->boxesToCreate.count();
+                },
+                loadingTimeSliceMsec,
+                // onSliceFinished
+                [this, routine]() {
+                    loadingProgressBar->setValue(routine->createdBoxesCount);
+                },
+                // onFinished
+                [routine]() {
+                    ContinuationContext context(routine);
+                },
+                this
+        );
+    }, this);
+
+    routine->addStep([this, routine, generation]() {
+        // 4. create EdgeArrow's, in time slices, and update the RelationshipsBundle's with the
+        //    EdgeArrow's created in each slice
+        EdgeArrowData edgeArrowData;
+        {
+            edgeArrowData.lineColor = getEdgeArrowLineColor();
+            edgeArrowData.lineWidth = defaultEdgeArrowLineWidth;
+            edgeArrowData.labelColor = getEdgeArrowLabelColor();
+        }
+
+        runInTimeSlices(
+                // processNext
+                [this, routine, generation, edgeArrowData]() mutable {
+                    if (loadGeneration != generation) {
+                        routine->errorFlag = true;
+                        return false;
+                    }
+                    if (routine->createdEdgeArrowsCount >= routine->relIdsToCreate.count())
+                        return false;
+
+                    const RelationshipId relId
+                            = routine->relIdsToCreate.at(routine->createdEdgeArrowsCount);
+                    ++routine->createdEdgeArrowsCount;
+
+                    edgeArrowData.joints = routine->board.relIdToJoints.value(relId);
+                    relationshipsCollection.createEdgeArrow(relId, edgeArrowData);
+
+                    return routine->createdEdgeArrowsCount < routine->relIdsToCreate.count();
+                },
+                loadingTimeSliceMsec,
+                // onSliceFinished
+                [this, routine, generation]() {
+                    if (loadGeneration != generation)
+                        return;
+
+                    QSet<RelationshipId> createdRelIds;
+                    for (int i = routine->bundledEdgeArrowsCount;
+                            i < routine->createdEdgeArrowsCount; ++i) {
+                        createdRelIds << routine->relIdsToCreate.at(i);
+                    }
+                    routine->bundledEdgeArrowsCount = routine->createdEdgeArrowsCount;
+
+                    relationshipBundlesCollection.markRelationshipsChanged(createdRelIds);
+                    updateRelationshipBundles();
+
+                    loadingProgressBar->setValue(
+                            routine->createdBoxesCount + routine->createdEdgeArrowsCount);
+                },
+                // onFinished
+                [routine]() {
+                    ContinuationContext context(routine);
+                },
+                this
+        );
+    }, this);
+
+    routine->addStep([this, routine, generation]() {
+        // 5. end of creating the items
+        ContinuationContext context(routine);
+        if (loadGeneration != generation) {
+            context.setErrorFlag();
+            return;
+        }
+
+        loadingProgressBar->setVisible(false);
+        graphicsView->setInteractive(true);
     }, this);
 
-    routine->addStep([this, routine, callback]() {
+    routine->addStep([this, routine, generation]() {
         // 6. create SettingBox's
+        if (loadGeneration != generation) {
+            routine->errorFlag = true;
+            routine->skipToFinalStep();
+            return;
+        }
+
         const bool isDarkTheme = Services::instance()->getAppDataReadonly()->getIsDarkTheme();
         const bool autoAdjustCardColorsForDarkTheme
                 = Services::instance()->getAppDataReadonly()->getAutoAdjustCardColorsForDarkTheme();
@@ -354,32 +483,43 @@ void BoardView::loadBoard(
         innerRoutine->start();
     }, this);
 
-    routine->addStep([this, routine, callback]() {
+    routine->addStep([this, routine, generation]() {
+        // 7. fit scene rect to the created items, keeping the view position (which the user may
+        //    have changed during the loading)
         ContinuationContext context(routine);
+        if (loadGeneration != generation) {
+            context.setErrorFlag();
+            return;
+        }
 
-        cardPropertiesToShowSettings.onBoard = routine->board.cardPropertiesToShow;
+        const QPointF viewTopLeftPos = getViewTopLeftPos();
+        adjustSceneRect();
+        setViewTopLeftPos(viewTopLeftPos);
 
-        zoomScale = routine->board.zoomRatio;
-        canvas->setScale(zoomScale * graphicsGeometryScaleFactor); // (1)
-        adjustSceneRect(); // (2)
-        setViewTopLeftPos(routine->board.topLeftPos); // (3)
+        updateContentsMaterializationDebouncer->actNow();
     }, this);
 
-    routine->addStep([this, routine, callback, highlightedCardIdChanged]() {
+    routine->addStep([this, routine, callback, highlightedCardIdChanged, generation]() {
         // final step
         ContinuationContext context(routine);
 
         bool highlightedCardIdChanged1 = highlightedCardIdChanged;
-        if (routine->errorFlag) {
+        const bool superseded = (loadGeneration != generation);
+                // (if so, the view has been closed already and is left as is, and the loading
+                // is not considered a failure)
+        if (routine->errorFlag && !superseded) {
             boardId = -1;
 
+            loadingProgressBar->setVisible(false);
+            graphicsView->setInteractive(true);
+
             bool highlightedCardIdChanged2;
             closeAll(&highlightedCardIdChanged2);
 
             highlightedCardIdChanged1 |= highlightedCardIdChanged2;
         }
 
-        callback(!routine->errorFlag, highlightedCardIdChanged1);
+        callback(!routine->errorFlag || superseded, highlightedCardIdChanged1);
     }, this);
 
     routine->start();
@@ -402,19 +542,52 @@ void BoardView::toggleCardPreview() {
     nodeRectsCollection.get(singleHighlightedCardId)->togglePreview();
 }
 
+void BoardView::toggleMinimap() {
+    const bool show = !minimap->isVisible();
+    minimap->setVisible(show); // (also resumes/pauses its rendering)
+    if (show) {
+        minimap->raise();
+        updateMinimapViewport();
+    }
+}
+
+void BoardView::toggleRenderingProfiler() {
+    // (the profiler is shared by all BoardView's, so its state is toggled rather than that of
+    // this view's overlay)
+    setRenderingProfilerShown(!RenderingProfiler::instance()->isEnabled());
+}
+
 void BoardView::setColorsAssociatedWithLabels(
         const QVector<LabelAndColor> &cardLabelsAndAssociatedColors,
         const QColor &defaultNodeRectColor) {
+    const LabelRulesTable<QColor> previousTable = cardLabelColorsTable;
+    const QColor previousDefaultNodeRectColor = this->defaultNodeRectColor;
+
     this->cardLabelsAndAssociatedColors = cardLabelsAndAssociatedColors;
     this->defaultNodeRectColor = defaultNodeRectColor;
 
-    nodeRectsCollection.updateAllNodeRectColors();
+    QVector<std::pair<Symbol, QColor>> rules;
+    for (const auto &[label, color]: cardLabelsAndAssociatedColors)
+        rules << std::make_pair(Symbol(label), color);
+    cardLabelColorsTable = LabelRulesTable<QColor>(rules);
+
+    // update the colors of only the NodeRect's affected
+    if (defaultNodeRectColor != previousDefaultNodeRectColor) {
+        nodeRectsCollection.updateAllNodeRectColors();
+    }
+    else {
+        const QSet<int> affectedCardIds = nodeRectsCollection.getCardIdsByLabels(
+                [this, &previousTable](const QSet<Symbol> &cardLabels) {
+            return !cardLabelColorsTable.givesSameResult(previousTable, cardLabels);
+        });
+        nodeRectsCollection.updateNodeRectColors(affectedCardIds);
+    }
 }
 
 void BoardView::cardPropertiesToShowSettingOnWorkspaceUpdated(
         const CardPropertiesToShow &workspaceSettingOfCardPropertiesToShow) {
     cardPropertiesToShowSettings.onWorkspace = workspaceSettingOfCardPropertiesToShow;
-    updatePropertiesDisplayOfAllCards();
+    onCardPropertiesToShowSettingsUpdated();
 }
 
 void BoardView::updateSettingBoxOnWorkspaceSetting(
@@ -428,6 +601,9 @@ int BoardView::getBoardId() const {
 }
 
 QPointF BoardView::getViewTopLeftPos() const {
+    if (zoomPreview->isPreviewing())
+        return zoomPreview->getViewTopLeft();
+
     const auto topLeftPosInScene = graphicsView->mapToScene(0, 0);
     return canvas->mapFromScene(topLeftPosInScene);
 }
@@ -436,18 +612,72 @@ double BoardView::getZoomRatio() const {
     return zoomScale;
 }
 
+double BoardView::getGraphicsGeometryScaleFactor() const {
+    return graphicsGeometryScaleFactor;
+}
+
+void BoardView::setGraphicsGeometryScaleFactor(const double factor) {
+    if (std::fabs(factor - graphicsGeometryScaleFactor) < 1e-3)
+        return;
+
+    graphicsGeometryScaleFactor = factor;
+    updateCanvasScale(zoomScale * graphicsGeometryScaleFactor, getViewCenterInScene());
+}
+
 bool BoardView::canClose() const {
     return true;
 }
 
-QImage BoardView::renderAsImage() {
+void BoardView::clearHighlights(bool *highlightedCardIdChanged) {
+    const QSet<int> highlightedCards = nodeRectsCollection.addToHighlightedCards({});
+    *highlightedCardIdChanged = !highlightedCards.isEmpty();
+
+    selection = Selection();
+    nodeRectsCollection.setHighlightedCardIds({});
+    groupBoxesCollection.setHighlightedGroupBoxes({});
+    dataViewBoxesCollection.setHighlightedDataViewBoxes({});
+}
+
+int BoardView::getItemsCount() const {
+    return nodeRectsCollection.getCount()
+            + relationshipsCollection.getCount()
+            + dataViewBoxesCollection.getAllCustomDataQueryIds().count()
+            + groupBoxesCollection.getAllGroupBoxIds().count()
+            + settingBoxesCollection.getAllSettingBoxes().count();
+}
+
+qint64 BoardView::getEstimatedMemoryUsage() const {
+    // rough sizes (bytes) of items, including their child items & text documents
+    constexpr qint64 nodeRectSize = 8 * 1024;
+    constexpr qint64 materializedContentsSize = 48 * 1024; // text editor & its proxy widget
+    constexpr qint64 edgeArrowSize = 1024;
+    constexpr qint64 dataViewBoxSize = 64 * 1024;
+    constexpr qint64 groupBoxSize = 2 * 1024;
+    constexpr qint64 settingBoxSize = 64 * 1024;
+
+    return nodeRectSize * nodeRectsCollection.getCount()
+            + materializedContentsSize * nodeRectsCollection.getCountOfMaterialized()
+            + edgeArrowSize * relationshipsCollection.getCount()
+            + dataViewBoxSize * dataViewBoxesCollection.getAllCustomDataQueryIds().count()
+            + groupBoxSize * groupBoxesCollection.getAllGroupBoxIds().count()
+            + settingBoxSize * settingBoxesCollection.getAllSettingBoxes().count();
+}
+
+bool BoardView::recordForImageExport(
+        const qint64 memoryCapBytes, TiledPngExport::Source *source, QString *errorMsg) {
+    Q_ASSERT(source != nullptr);
+    Q_ASSERT(errorMsg != nullptr);
+
+    commitZoomPreview();
+
     constexpr double margin = 20;
     const QRectF contentsRectInCanvas
             = getContentsRectInCanvasCoordinates().marginsAdded(uniformMarginsF(margin));
 
-    // set canvas scale to 1.0
+    // set canvas scale to 1.0, with full detail
     const double originalScale = canvas->scale();
     canvas->setScale(1.0);
+    updateLevelOfDetail();
 
     //
     const QPointF topLeftInScene = canvas->mapToScene(contentsRectInCanvas.topLeft());
@@ -458,26 +688,72 @@ QImage BoardView::renderAsImage() {
             QPointF(nearestInteger(bottomRightInScene.x()), nearestInteger(bottomRightInScene.y()))
     );
 
-    QImage image(
+    const QSize imageSize(
             nearestInteger(contentsRectInScene.width()),
-            nearestInteger(contentsRectInScene.height()),
-            QImage::Format_ARGB32);
-
-    QPainter painter(&image);
-    painter.setRenderHint(QPainter::Antialiasing, true);
-    graphicsScene->render(&painter, QRectF(), contentsRectInScene);
+            nearestInteger(contentsRectInScene.height()));
+    const int bandHeight = TiledPngExport::computeBandHeight(imageSize.width(), memoryCapBytes);
+
+    bool ok = true;
+    if (bandHeight == 0) {
+        *errorMsg = QString(
+                "The board is too wide (%1 pixels) to be exported within the memory limit of "
+                "%2 MB. The limit can be raised in Options.")
+                .arg(imageSize.width()).arg(memoryCapBytes / (1024 * 1024));
+        ok = false;
+    }
+    else {
+        // record each band (only the items intersecting a band are recorded into it)
+        source->imageSize = imageSize;
+        source->bandHeight = bandHeight;
+        source->bandRecordings.clear();
+        for (int top = 0; top < imageSize.height(); top += bandHeight) {
+            const int height = std::min(bandHeight, imageSize.height() - top);
+
+            QPicture picture;
+            {
+                QPainter painter(&picture);
+                painter.setRenderHint(QPainter::Antialiasing, true);
+                graphicsScene->render(
+                        &painter,
+                        QRectF(0, 0, imageSize.width(), height),
+                        QRectF(contentsRectInScene.left(), contentsRectInScene.top() + top,
+                               imageSize.width(), height));
+            }
+            source->bandRecordings << QByteArray(picture.data(), int(picture.size()));
+        }
+    }
 
     // resume to original canvas scale
     canvas->setScale(originalScale);
+    updateLevelOfDetail();
 
     //
-    return image;
+    return ok;
+}
+
+void BoardView::showEvent(QShowEvent *event) {
+    QFrame::showEvent(event);
+
+    // the profiler may have been toggled in another BoardView while this was hidden
+    const bool profilerEnabled = RenderingProfiler::instance()->isEnabled();
+    if (renderingProfilerOverlay->isVisibleTo(graphicsView) != profilerEnabled)
+        setRenderingProfilerShown(profilerEnabled);
 }
 
 bool BoardView::eventFilter(QObject *watched, QEvent *event) {
     if (watched == graphicsView) {
-        if (event->type() == QEvent::Resize)
+        if (event->type() == QEvent::Resize) {
+            commitZoomPreview();
+            cancelZoomPreview(); // (the overlay no longer fits the viewport)
             adjustSceneRect();
+            updateContentsMaterializationDebouncer->tryAct();
+            adjustMinimapPosition();
+            updateMinimapViewport();
+        }
+    }
+    else if (watched == graphicsView->viewport()) {
+        if (event->type() == QEvent::MouseButtonPress)
+            commitZoomPreview(); // (so that the press is handled by the re-scaled scene)
     }
     return false;
 }
@@ -506,6 +782,18 @@ void BoardView::setUpWidgets() {
     canvas->setFlag(QGraphicsItem::ItemHasNoContents, true);
     graphicsScene->addItem(canvas);
 
+    rubberBandItem = new QGraphicsRectItem;
+    {
+        const QColor color(36, 128, 220);
+        QColor fillColor = color;
+        fillColor.setAlpha(40);
+        rubberBandItem->setPen(QPen(color, 0)); // (cosmetic pen of 1 pixel)
+        rubberBandItem->setBrush(fillColor);
+    }
+    rubberBandItem->setZValue(std::numeric_limits<double>::max());
+    rubberBandItem->setVisible(false);
+    graphicsScene->addItem(rubberBandItem);
+
     // set up `graphicsView`
     graphicsView->setScene(graphicsScene);
 
@@ -516,6 +804,31 @@ void BoardView::setUpWidgets() {
     graphicsView->setFrameShape(QFrame::NoFrame);
     graphicsView->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
     graphicsView->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+
+    // set up `loadingProgressBar` (floating at the top-left corner of `graphicsView`)
+    loadingProgressBar = new QProgressBar(graphicsView);
+    loadingProgressBar->setTextVisible(false);
+    loadingProgressBar->setFixedSize(160, 6);
+    loadingProgressBar->move(8, 8);
+    loadingProgressBar->setVisible(false);
+
+    // set up `renderingProfilerOverlay` (floating at the top-left corner of `graphicsView`, below
+    // `loadingProgressBar`)
+    renderingProfilerOverlay = new RenderingProfilerOverlay(graphicsScene, graphicsView);
+    renderingProfilerOverlay->move(8, 20);
+
+    // set up `minimap` (floating at the bottom-right corner of `graphicsView`)
+    minimap = new BoardMinimap(graphicsView);
+    minimap->resize(220, 160);
+    minimap->setBackgroundColor(getSceneBackgroundColor(isDarkTheme));
+    adjustMinimapPosition();
+
+    // set up `zoomPreview` (covering the viewport while shown)
+    zoomPreview = new ZoomPreviewOverlay(graphicsView->viewport());
+
+    zoomSettleTimer = new QTimer(this);
+    zoomSettleTimer->setSingleShot(true);
+    zoomSettleTimer->setInterval(zoomSettleDelayMsec);
 }
 
 void BoardView::setUpConnections() {
@@ -527,6 +840,7 @@ void BoardView::setUpConnections() {
             this, [this](const QPointF &scenePos) {
         contextMenu.requestScenePos = scenePos;
         contextMenu.setActionIcons();
+        contextMenu.setSelectionActionsEnabled(!selection.isEmpty());
         contextMenu.menu->popup(getScreenPosFromScenePos(scenePos));
     });
 
@@ -534,6 +848,33 @@ void BoardView::setUpConnections() {
         onBackgroundClicked();
     });
 
+    connect(graphicsScene, &GraphicsScene::rubberBandChanged,
+            this, [this](const QRectF &sceneRect) {
+        onRubberBandChanged(sceneRect);
+    });
+
+    connect(graphicsScene, &GraphicsScene::rubberBandFinished,
+            this, [this](const QRectF &sceneRect) {
+        onRubberBandFinished(sceneRect);
+    });
+
+    connect(graphicsScene, &GraphicsScene::rubberBandCanceled, this, [this]() {
+        rubberBandItem->setVisible(false);
+    });
+
+    // (the scroll bars are hidden but still track the view position)
+    connect(graphicsView->horizontalScrollBar(), &QScrollBar::valueChanged, this, [this]() {
+        onViewScrolled();
+    });
+
+    connect(graphicsView->verticalScrollBar(), &QScrollBar::valueChanged, this, [this]() {
+        onViewScrolled();
+    });
+
+    connect(minimap, &BoardMinimap::userToCenterViewOn, this, [this](const QPointF &canvasPos) {
+        graphicsView->centerOn(canvas->mapToScene(canvasPos));
+    });
+
     connect(graphicsScene, &GraphicsScene::userToZoomInOut,
             this, [this](bool zoomIn, const QPointF &anchorScenePos) {
         doApplyZoomAction(
@@ -541,6 +882,10 @@ void BoardView::setUpConnections() {
                 anchorScenePos);
     });
 
+    connect(zoomSettleTimer, &QTimer::timeout, this, [this]() {
+        commitZoomPreview();
+    });
+
     connect(graphicsScene, &GraphicsScene::viewScrollingStarted, this, [this]() {
         nodeRectsCollection.setAllNodeRectsTextEditorIgnoreWheelEvent(true);
         dataViewBoxesCollection.setAllDataViewBoxesTextEditorIgnoreWheelEvent(true);
@@ -568,7 +913,8 @@ void BoardView::setUpConnections() {
         Services::instance()->getAppDataReadonly()->queryCards(
                 {cardId},
                 // callback
-                [this, cardId, cardPropertiesUpdate](bool ok, const QHash<int, Card> &cards) {
+                [this, cardId, cardPropertiesUpdate](
+                        bool ok, const QHash<int, CardSnapshot> &cards) {
                     if (!ok) {
                         qWarning().noquote() << "could not get card data";
                         return;
@@ -577,38 +923,142 @@ void BoardView::setUpConnections() {
                         return;
 
                     //
-                    Card cardData = cards.value(cardId);
+                    const Card &cardData = *cards.value(cardId);
 
                     if (!cardPropertiesUpdate.getCustomProperties().isEmpty()) {
                         // card's custom properties updated
-                        CardPropertiesToShow effectiveSetting
-                                = cardPropertiesToShowSettings.onWorkspace;
-                        effectiveSetting.updateWith(cardPropertiesToShowSettings.onBoard);
-
                         nodeRectsCollection.updateNodeRectPropertiesDisplay(
-                                cardId, cardData.getLabels(), cardData.getCustomProperties(),
-                                effectiveSetting);
+                                cardId, cardData.getLabelSymbols(),
+                                cardData.getCustomProperties(), cardPropertiesToShowTable);
                     }
 
                     if (cardPropertiesUpdate.title.has_value()
                             || cardPropertiesUpdate.text.has_value()) {
-                        Q_ASSERT(false); // card's title and text should be editable only via BoardView
+                        // (edited in another BoardView, which shows the same card)
+                        NodeRect *nodeRect = nodeRectsCollection.get(cardId);
+                        if (cardPropertiesUpdate.title.has_value())
+                            nodeRect->setTitle(cardData.title);
+                        if (cardPropertiesUpdate.text.has_value())
+                            nodeRect->setText(cardData.text);
                     }
                 },
                 this
         );
     });
 
+    connect(Services::instance()->getAppDataReadonly(), &AppDataReadonly::cardLabelsUpdated,
+            this,
+            [this](EventSource eventSrc, const int cardId, const QSet<QString> &updatedLabels) {
+        if (eventSrc.sourceWidget == this)
+            return;
+        if (!nodeRectsCollection.contains(cardId))
+            return;
+
+        // (updated in another BoardView, which shows the same card)
+        using StringListPair = std::pair<QStringList, QStringList>;
+        Services::instance()->getAppDataReadonly()->getUserLabelsAndRelationshipTypes(
+                // callback
+                [this, cardId, updatedLabels](bool ok, const StringListPair &labelsAndRelTypes) {
+                    if (!nodeRectsCollection.contains(cardId))
+                        return;
+
+                    const QStringList userLabelsList
+                            = ok ? labelsAndRelTypes.first : QStringList {};
+                    const QVector<QString> nodeLabelsVec
+                            = sortByOrdering(updatedLabels, userLabelsList, false);
+
+                    const bool isDarkTheme
+                            = Services::instance()->getAppDataReadonly()->getIsDarkTheme();
+                    const bool autoAdjustCardColorsForDarkTheme
+                            = Services::instance()->getAppDataReadonly()
+                              ->getAutoAdjustCardColorsForDarkTheme();
+                    const QColor nodeRectColor = computeNodeRectDisplayColor(
+                            nodeRectsCollection.getNodeRectOwnColor(cardId),
+                            toSymbolSet(updatedLabels),
+                            cardLabelColorsTable, defaultNodeRectColor,
+                            autoAdjustCardColorsForDarkTheme && isDarkTheme);
+
+                    NodeRect *nodeRect = nodeRectsCollection.get(cardId);
+                    nodeRect->setNodeLabels(
+                            QStringList(nodeLabelsVec.cbegin(), nodeLabelsVec.cend()));
+                    nodeRect->setColor(nodeRectColor);
+                    updateMinimapNodeRect(cardId);
+                },
+                this
+        );
+
+        Services::instance()->getAppDataReadonly()->queryCards(
+                {cardId},
+                // callback
+                [this, cardId, updatedLabels](bool ok, const QHash<int, CardSnapshot> &cards) {
+                    if (!ok || !cards.contains(cardId))
+                        return;
+
+                    nodeRectsCollection.updateNodeRectPropertiesDisplay(
+                            cardId, toSymbolSet(updatedLabels),
+                            cards.value(cardId)->getCustomProperties(), cardPropertiesToShowTable);
+                },
+                this
+        );
+    });
+
+    connect(Services::instance()->getAppDataReadonly(), &AppDataReadonly::relationshipCreated,
+            this, [this](EventSource eventSrc, const RelationshipId &relId) {
+        if (eventSrc.sourceWidget == this)
+            return;
+        if (!nodeRectsCollection.contains(relId.startCardId)
+                || !nodeRectsCollection.contains(relId.endCardId)) {
+            return;
+        }
+        if (relationshipsCollection.contains(relId))
+            return;
+
+        EdgeArrowData edgeArrowData;
+        {
+            edgeArrowData.lineColor = getEdgeArrowLineColor();
+            edgeArrowData.lineWidth = defaultEdgeArrowLineWidth;
+            edgeArrowData.labelColor = getEdgeArrowLabelColor();
+        }
+        relationshipsCollection.createEdgeArrow(relId, edgeArrowData);
+
+        relationshipBundlesCollection.markRelationshipsChanged({relId});
+        updateRelationshipBundles();
+    });
+
+    connect(Services::instance()->getAppDataReadonly(), &AppDataReadonly::customDataQueryUpdated,
+            this,
+            [this](EventSource eventSrc, const int customDataQueryId,
+                    const CustomDataQueryUpdate &/*update*/) {
+        if (eventSrc.sourceWidget == this)
+            return;
+        if (!dataViewBoxesCollection.contains(customDataQueryId))
+            return;
+
+        Services::instance()->getAppDataReadonly()->queryCustomDataQueries(
+                {customDataQueryId},
+                // callback
+                [this, customDataQueryId](
+                        bool ok, const QHash<int, CustomDataQuery> &dataQueries) {
+                    if (!ok) {
+                        qWarning().noquote() << "could not get custom data query";
+                        return;
+                    }
+                    if (!dataQueries.contains(customDataQueryId))
+                        return;
+
+                    dataViewBoxesCollection.updateDataViewBox(
+                            customDataQueryId, dataQueries.value(customDataQueryId));
+                },
+                this
+        );
+    });
+
     connect(Services::instance()->getAppDataReadonly(),
             &AppDataReadonly::fontSizeScaleFactorChanged,
             this, [this](const QWidget *window, const double factor) {
         if (this->window() != window)
             return;
-        if (std::fabs(factor - graphicsGeometryScaleFactor) < 1e-3)
-            return;
-
-        graphicsGeometryScaleFactor = factor;
-        updateCanvasScale(zoomScale * graphicsGeometryScaleFactor, getViewCenterInScene());
+        setGraphicsGeometryScaleFactor(factor);
     });
 
     connect(Services::instance()->getAppDataReadonly(), &AppDataReadonly::isDarkThemeUpdated,
@@ -616,6 +1066,7 @@ void BoardView::setUpConnections() {
 
         //
         graphicsScene->setBackgroundBrush(getSceneBackgroundColor(isDarkTheme));
+        minimap->setBackgroundColor(getSceneBackgroundColor(isDarkTheme));
 
         //
         nodeRectsCollection.updateAllNodeRectColors();
@@ -646,6 +1097,7 @@ void BoardView::setUpConnections() {
 
 void BoardView::installEventFiltersOnComponents() {
     graphicsView->installEventFilter(this);
+    graphicsView->viewport()->installEventFilter(this);
 }
 
 void BoardView::onUserToOpenExistingCard(const QPointF &scenePos) {
@@ -696,7 +1148,7 @@ void BoardView::onUserToOpenExistingCard(const QPointF &scenePos) {
         Services::instance()->getAppData()->queryCards(
                 {cardId},
                 // callback
-                [=](bool ok, const QHash<int, Card> &cards) {
+                [=](bool ok, const QHash<int, CardSnapshot> &cards) {
                     ContinuationContext context(routine);
 
                     if (!ok) {
@@ -711,7 +1163,7 @@ void BoardView::onUserToOpenExistingCard(const QPointF &scenePos) {
                         return;
                     }
 
-                    routine->cardData = cards.value(cardId);;
+                    routine->cardData = *cards.value(cardId);
                 },
                 this
         );
@@ -725,10 +1177,6 @@ void BoardView::onUserToOpenExistingCard(const QPointF &scenePos) {
         const bool autoAdjustCardColorsForDarkTheme
                 = Services::instance()->getAppDataReadonly()->getAutoAdjustCardColorsForDarkTheme();
 
-        CardPropertiesToShow effectiveCardPropertiesToShow
-                = cardPropertiesToShowSettings.onWorkspace;
-        effectiveCardPropertiesToShow.updateWith(cardPropertiesToShowSettings.onBoard);
-
         //
         routine->nodeRectData.rect = QRectF(
                 quantize(canvas->mapFromScene(scenePos), boardSnapGridSize),
@@ -737,13 +1185,13 @@ void BoardView::onUserToOpenExistingCard(const QPointF &scenePos) {
         routine->nodeRectData.ownColor = QColor();
 
         const QColor displayColor = computeNodeRectDisplayColor(
-                routine->nodeRectData.ownColor, routine->cardData.getLabels(),
-                cardLabelsAndAssociatedColors, defaultNodeRectColor,
+                routine->nodeRectData.ownColor, routine->cardData.getLabelSymbols(),
+                cardLabelColorsTable, defaultNodeRectColor,
                 autoAdjustCardColorsForDarkTheme && isDarkTheme);
 
         const QString propertiesDisplay = computeCardPropertiesDisplay(
-                effectiveCardPropertiesToShow,
-                routine->cardData.getLabels(), routine->cardData.getCustomProperties());
+                cardPropertiesToShowTable,
+                routine->cardData.getLabelSymbols(), routine->cardData.getCustomProperties());
 
         auto *nodeRect = nodeRectsCollection.createNodeRect(
                 cardId, routine->cardData, routine->nodeRectData.rect,
@@ -801,6 +1249,8 @@ void BoardView::onUserToOpenExistingCard(const QPointF &scenePos) {
         }
 
         //
+        relationshipBundlesCollection.markRelationshipsChanged(
+                relationshipsCollection.getRelationshipsConnectingCard(cardId));
         updateRelationshipBundles();
     }, this);
 
@@ -880,10 +1330,6 @@ void BoardView::onUserToCreateNewCard(const QPointF &scenePos) {
         const bool autoAdjustCardColorsForDarkTheme
                 = Services::instance()->getAppDataReadonly()->getAutoAdjustCardColorsForDarkTheme();
 
-        CardPropertiesToShow effectiveCardPropertiesToShow
-                = cardPropertiesToShowSettings.onWorkspace;
-        effectiveCardPropertiesToShow.updateWith(cardPropertiesToShowSettings.onBoard);
-
         //
         routine->nodeRectData.rect = QRectF(
                 quantize(canvas->mapFromScene(scenePos), boardSnapGridSize),
@@ -892,12 +1338,13 @@ void BoardView::onUserToCreateNewCard(const QPointF &scenePos) {
         routine->nodeRectData.ownColor = QColor();
 
         const QColor displayColor = computeNodeRectDisplayColor(
-                routine->nodeRectData.ownColor, cardLabels, cardLabelsAndAssociatedColors,
+                routine->nodeRectData.ownColor, toSymbolSet(cardLabels),
+                cardLabelColorsTable,
                 defaultNodeRectColor, autoAdjustCardColorsForDarkTheme && isDarkTheme);
 
         const QString propertiesDisplay = computeCardPropertiesDisplay(
-                effectiveCardPropertiesToShow,
-                routine->card.getLabels(), routine->card.getCustomProperties());
+                cardPropertiesToShowTable,
+                routine->card.getLabelSymbols(), routine->card.getCustomProperties());
 
         NodeRect *nodeRect = nodeRectsCollection.createNodeRect(
                 routine->newCardId, routine->card, routine->nodeRectData.rect,
@@ -962,11 +1409,11 @@ void BoardView::onUserToDuplicateCard(const QPointF &scenePos) {
         Services::instance()->getAppData()->queryCards(
                 QSet<int> {cardIdToDuplicate},
                 // callback
-                [routine, cardIdToDuplicate](bool ok, const QHash<int, Card> &cards) {
+                [routine, cardIdToDuplicate](bool ok, const QHash<int, CardSnapshot> &cards) {
                     ContinuationContext context(routine);
                     if (ok) {
                         if (cards.contains(cardIdToDuplicate)) {
-                            routine->cardData = cards.value(cardIdToDuplicate);
+                            routine->cardData = *cards.value(cardIdToDuplicate);
                         }
                         else {
                             context.setErrorFlag();
@@ -1024,10 +1471,6 @@ void BoardView::onUserToDuplicateCard(const QPointF &scenePos) {
         const bool autoAdjustCardColorsForDarkTheme
                 = Services::instance()->getAppDataReadonly()->getAutoAdjustCardColorsForDarkTheme();
 
-        CardPropertiesToShow effectiveCardPropertiesToShow
-                = cardPropertiesToShowSettings.onWorkspace;
-        effectiveCardPropertiesToShow.updateWith(cardPropertiesToShowSettings.onBoard);
-
         //
         QSizeF newNodeRectSize = nodeRectsCollection.contains(cardIdToDuplicate)
                 ? nodeRectsCollection.getNodeRectRect(cardIdToDuplicate).value().size()
@@ -1039,13 +1482,13 @@ void BoardView::onUserToDuplicateCard(const QPointF &scenePos) {
         routine->nodeRectData.ownColor = QColor();
 
         const QColor displayColor = computeNodeRectDisplayColor(
-                routine->nodeRectData.ownColor, routine->cardData.getLabels(),
-                cardLabelsAndAssociatedColors, defaultNodeRectColor,
+                routine->nodeRectData.ownColor, routine->cardData.getLabelSymbols(),
+                cardLabelColorsTable, defaultNodeRectColor,
                 autoAdjustCardColorsForDarkTheme && isDarkTheme);
 
         const QString propertiesDisplay = computeCardPropertiesDisplay(
-                effectiveCardPropertiesToShow,
-                routine->cardData.getLabels(), routine->cardData.getCustomProperties());
+                cardPropertiesToShowTable,
+                routine->cardData.getLabelSymbols(), routine->cardData.getCustomProperties());
 
         NodeRect *nodeRect = nodeRectsCollection.createNodeRect(
                 routine->newCardId, routine->cardData, routine->nodeRectData.rect,
@@ -1382,12 +1825,13 @@ void BoardView::onUserToSetLabels(const int cardId) {
 
         const QColor nodeRectColor = computeNodeRectDisplayColor(
                 nodeRectsCollection.getNodeRectOwnColor(cardId),
-                QSet<QString>(updatedLabels.cbegin(), updatedLabels.cend()),
-                cardLabelsAndAssociatedColors, defaultNodeRectColor,
+                toSymbolSet(updatedLabels),
+                cardLabelColorsTable, defaultNodeRectColor,
                 autoAdjustCardColorsForDarkTheme && isDarkTheme);
 
         nodeRect->setNodeLabels(updatedLabels);
         nodeRect->setColor(nodeRectColor);
+        updateMinimapNodeRect(cardId);
     }, this);
 
     routine->addStep([this, routine, cardId]() {
@@ -1395,7 +1839,7 @@ void BoardView::onUserToSetLabels(const int cardId) {
         Services::instance()->getAppDataReadonly()->queryCards(
                 {cardId},
                 // callback
-                [this, routine, cardId](bool ok, const QHash<int, Card> &cards) {
+                [this, routine, cardId](bool ok, const QHash<int, CardSnapshot> &cards) {
                     ContinuationContext context(routine);
 
                     if (!ok) {
@@ -1411,14 +1855,11 @@ void BoardView::onUserToSetLabels(const int cardId) {
                             routine->updatedLabels.value().constBegin(),
                             routine->updatedLabels.value().constEnd());
 
-                    const auto customProperties = cards.value(cardId).getCustomProperties();
-
-                    CardPropertiesToShow effectiveSetting
-                            = cardPropertiesToShowSettings.onWorkspace;
-                    effectiveSetting.updateWith(cardPropertiesToShowSettings.onBoard);
+                    const auto customProperties = cards.value(cardId)->getCustomProperties();
 
                     nodeRectsCollection.updateNodeRectPropertiesDisplay(
-                            cardId, updatedLabels, customProperties, effectiveSetting);
+                            cardId, toSymbolSet(updatedLabels), customProperties,
+                            cardPropertiesToShowTable);
                 },
                 this
         );
@@ -1509,7 +1950,7 @@ void BoardView::onUserToCreateRelationship(const int cardId) {
         Services::instance()->getAppData()->queryCards(
                 startEndCards,
                 // callback
-                [routine, startEndCards](bool ok, QHash<int, Card> cards) {
+                [routine, startEndCards](bool ok, const QHash<int, CardSnapshot> &cards) {
                     ContinuationContext context(routine);
 
                     if (!ok) {
@@ -1581,6 +2022,7 @@ void BoardView::onUserToCreateRelationship(const int cardId) {
         relationshipsCollection.createEdgeArrow(routine->relIdToCreate, edgeArrowData);
 
         //
+        relationshipBundlesCollection.markRelationshipsChanged({routine->relIdToCreate});
         updateRelationshipBundles();
     }, this);
 
@@ -1607,6 +2049,11 @@ void BoardView::onUserToCloseNodeRect(const int cardId) {
 
     std::optional<int> updatedHighlightedCardId;
     {
+        // (mark before the card's relationships & its place in `groupBoxTree` are removed)
+        relationshipBundlesCollection.markRelationshipsChanged(
+                relationshipsCollection.getRelationshipsConnectingCard(cardId));
+        relationshipBundlesCollection.markCardChanged(cardId);
+
         bool highlightedCardIdChanged;
         constexpr bool removeConnectedEdgeArrows = true;
         nodeRectsCollection.closeNodeRect(
@@ -1670,8 +2117,14 @@ void BoardView::onUserToRemoveGroupBox(const int groupBoxId) {
     adjustSceneRect();
 
     //
+    relationshipBundlesCollection.markGroupBoxChanged(groupBoxId);
+    const QSet<int> childGroupBoxes = groupBoxTree.getChildGroupBoxes(groupBoxId);
+
     groupBoxTree.removeGroupBox(groupBoxId, GroupBoxTree::RemoveOption::ReparentChildren);
 
+    for (const int childGroupBoxId: childGroupBoxes)
+        relationshipBundlesCollection.markGroupBoxChanged(childGroupBoxId);
+
     //
     updateRelationshipBundles();
 
@@ -1680,9 +2133,358 @@ void BoardView::onUserToRemoveGroupBox(const int groupBoxId) {
             ->removeGroupBoxAndReparentChildItems(EventSource(this), groupBoxId);
 }
 
+void BoardView::onUserToToggleAutoEdgeRouting(const bool enable) {
+    autoEdgeRouting.setEnabled(enable);
+}
+
+void BoardView::onUserToAutoLayOutCards() {
+    if (boardId == -1 || autoLayout != nullptr || autoLayoutAnimation != nullptr)
+        return;
+
+    // snapshot of the NodeRect's, relationships & group-boxes, with IDs replaced by indices
+    ForceDirectedLayout::Input input;
+
+    const QVector<int> cardIds = nodeRectsCollection.getAllCardIds().values().toVector();
+    QHash<int, int> cardIdToIndex;
+    for (const int cardId: cardIds) {
+        cardIdToIndex.insert(cardId, input.boxRects.count());
+        input.boxRects << nodeRectsCollection.getNodeRectRect(cardId).value_or(QRectF());
+    }
+    if (cardIds.isEmpty())
+        return;
+
+    const QVector<int> groupBoxIds = groupBoxesCollection.getAllGroupBoxIds().values().toVector();
+    QHash<int, int> groupBoxIdToIndex;
+    for (const int groupBoxId: groupBoxIds) {
+        groupBoxIdToIndex.insert(groupBoxId, input.groupRects.count());
+        GroupBox *groupBox = groupBoxesCollection.get(groupBoxId);
+        input.groupRects << ((groupBox != nullptr) ? groupBox->getRect() : QRectF());
+    }
+
+    for (const int cardId: cardIds) {
+        const int parentGroupBox = groupBoxTree.getParentGroupBoxOfCard(cardId); // can be -1
+        input.boxParentGroups << groupBoxIdToIndex.value(parentGroupBox, -1);
+    }
+    for (const int groupBoxId: groupBoxIds) {
+        const int parent = groupBoxTree.getParentOfGroupBox(groupBoxId); // can be rootId
+        input.groupParents << groupBoxIdToIndex.value(parent, -1);
+    }
+
+    const QSet<RelationshipId> relIds = relationshipsCollection.getAllRelationshipIds();
+    for (const auto &relId: relIds) {
+        if (cardIdToIndex.contains(relId.startCardId) && cardIdToIndex.contains(relId.endCardId)) {
+            input.edges << std::make_pair(
+                    cardIdToIndex.value(relId.startCardId), cardIdToIndex.value(relId.endCardId));
+        }
+    }
+
+    //
+    ForceDirectedLayout::Parameters parameters;
+    if (!groupBoxIds.isEmpty()) {
+        // (all group-boxes have the same margins between their rects and contents rects)
+        GroupBox *groupBox = groupBoxesCollection.get(groupBoxIds.first());
+        if (groupBox != nullptr) {
+            parameters.groupMargins
+                    = diffMargins(groupBox->getRect(), groupBox->getContentsRect())
+                      + uniformMarginsF(autoLayoutGroupBoxPadding);
+        }
+    }
+
+    // compute in background
+    graphicsView->setInteractive(false); // until the result is animated & saved
+
+    autoLayout = new ForceDirectedLayout(input, parameters, this);
+    connect(autoLayout, &ForceDirectedLayout::finished,
+            this, [this, layout=QPointer(autoLayout), cardIds, groupBoxIds](const bool ok) {
+        if (!layout || layout != autoLayout)
+            return; // (canceled & deleted)
+
+        const ForceDirectedLayout::Result result = layout->getResult();
+        autoLayout = nullptr;
+        layout->deleteLater();
+
+        if (!ok || result.boxRects.count() != cardIds.count()) {
+            graphicsView->setInteractive(true);
+            return;
+        }
+        animateAutoLayoutResult(cardIds, groupBoxIds, result);
+    });
+    autoLayout->start();
+}
+
+void BoardView::onUserToCloseSelectedItems() {
+    const QSet<int> cardIds = selection.cardIds;
+    const QSet<int> customDataQueryIds = selection.customDataQueryIds;
+    if (cardIds.isEmpty() && customDataQueryIds.isEmpty())
+        return;
+
+    {
+        QString msg = QString("Close the %1 selected item(s)?")
+                .arg(cardIds.count() + customDataQueryIds.count());
+        if (!selection.groupBoxIds.isEmpty())
+            msg += " (Group boxes will not be removed.)";
+        const auto r = QMessageBox::question(this, " ", msg);
+        if (r != QMessageBox::Yes)
+            return;
+    }
+
+    // close all the items, then update what depends on them once
+    bool highlightedCardIdChanged = false;
+    {
+        // (mark before the cards' relationships & their places in `groupBoxTree` are removed)
+        for (const int cardId: cardIds) {
+            relationshipBundlesCollection.markRelationshipsChanged(
+                    relationshipsCollection.getRelationshipsConnectingCard(cardId));
+            relationshipBundlesCollection.markCardChanged(cardId);
+        }
+
+        for (const int cardId: cardIds) {
+            bool highlightedCardIdChangedByThis;
+            constexpr bool removeConnectedEdgeArrows = true;
+            nodeRectsCollection.closeNodeRect(
+                    cardId, removeConnectedEdgeArrows, &highlightedCardIdChangedByThis);
+            if (highlightedCardIdChangedByThis)
+                highlightedCardIdChanged = true;
+
+            groupBoxTree.removeCardIfExists(cardId);
+        }
+
+        for (const int customDataQueryId: customDataQueryIds)
+            dataViewBoxesCollection.closeDataViewBox(customDataQueryId);
+
+        adjustSceneRect();
+        updateRelationshipBundles();
+    }
+
+    selection.cardIds.clear();
+    selection.customDataQueryIds.clear();
+
+    // call AppData
+    // -- highlighted card
+    if (highlightedCardIdChanged)
+        Services::instance()->getAppData()->setSingleHighlightedCardId(EventSource(this), -1);
+
+    // -- remove NodeRect's & DataViewBox'es, and update joints of EdgeArrow's
+    BoardItemsBulkUpdate update;
+    update.nodeRectsToRemove = cardIds;
+    update.dataViewBoxesToRemove = customDataQueryIds;
+    if (!cardIds.isEmpty())
+        update.relIdToJoints = relationshipsCollection.getRelIdToJoints();
+
+    Services::instance()->getAppData()->updateBoardItemsInBulk(EventSource(this), boardId, update);
+}
+
+void BoardView::onUserToSetColorOfSelectedItems() {
+    if (selection.cardIds.isEmpty() && selection.customDataQueryIds.isEmpty())
+        return;
+
+    QColor initialColor;
+    if (!selection.cardIds.isEmpty())
+        initialColor = nodeRectsCollection.getNodeRectOwnColor(*selection.cardIds.constBegin());
+    const QColor color = QColorDialog::getColor(
+            initialColor.isValid() ? initialColor : QColor(Qt::white),
+            this, "Set Color of Selected Items");
+    if (!color.isValid())
+        return; // (canceled)
+
+    //
+    BoardItemsBulkUpdate update;
+
+    QSet<int> cardIds;
+    for (const int cardId: qAsConst(selection.cardIds)) {
+        if (!nodeRectsCollection.contains(cardId))
+            continue;
+        nodeRectsCollection.setNodeRectOwnColor(cardId, color);
+        cardIds << cardId;
+
+        NodeRectDataUpdate nodeRectUpdate;
+        nodeRectUpdate.ownColor = color;
+        update.cardIdToNodeRectUpdate.insert(cardId, nodeRectUpdate);
+    }
+    nodeRectsCollection.updateNodeRectColors(cardIds);
+
+    for (const int customDataQueryId: qAsConst(selection.customDataQueryIds)) {
+        if (!dataViewBoxesCollection.contains(customDataQueryId))
+            continue;
+        dataViewBoxesCollection.setDataViewBoxOwnColor(customDataQueryId, color);
+
+        DataViewBoxDataUpdate dataViewBoxUpdate;
+        dataViewBoxUpdate.ownColor = color;
+        update.customDataQueryIdToDataViewBoxUpdate.insert(customDataQueryId, dataViewBoxUpdate);
+    }
+
+    // call AppData
+    Services::instance()->getAppData()->updateBoardItemsInBulk(EventSource(this), boardId, update);
+}
+
+void BoardView::onUserToAddOrRemoveLabelOfSelectedCards(const bool toAdd) {
+    if (selection.cardIds.isEmpty())
+        return;
+    using StringListPair = std::pair<QStringList, QStringList>;
+
+    class AsyncRoutineWithVars : public AsyncRoutineWithErrorFlag
+    {
+    public:
+        QStringList userCardLabelsList;
+        QString label;
+        QHash<int, QSet<QString>> cardIdToUpdatedLabels; // (only the cards whose labels change)
+    };
+    auto *routine = new AsyncRoutineWithVars;
+
+    //
+    routine->addStep([this, routine]() {
+        // get user-defined labels list
+        Services::instance()->getAppData()->getUserLabelsAndRelationshipTypes(
+                // callback
+                [routine](bool ok, const StringListPair &labelsAndRelTypes) {
+                    ContinuationContext context(routine);
+                    if (ok)
+                        routine->userCardLabelsList = labelsAndRelTypes.first;
+                },
+                this
+        );
+    }, this);
+
+    routine->addStep([this, routine, toAdd]() {
+        // let user select the label
+        ContinuationContext context(routine);
+
+        QStringList labels;
+        if (toAdd) {
+            labels = routine->userCardLabelsList;
+        }
+        else {
+            QSet<QString> labelsOfSelectedCards;
+            for (const int cardId: qAsConst(selection.cardIds)) {
+                if (NodeRect *nodeRect = nodeRectsCollection.get(cardId); nodeRect != nullptr)
+                    labelsOfSelectedCards += nodeRect->getNodeLabels();
+            }
+            const QVector<QString> labelsVec = sortByOrdering(
+                    labelsOfSelectedCards, routine->userCardLabelsList, false);
+            labels = QStringList(labelsVec.cbegin(), labelsVec.cend());
+        }
+
+        if (labels.isEmpty()) {
+            showInformationMessageBox(
+                    this, " ",
+                    toAdd ? "No label is defined." : "The selected cards have no label.");
+            context.setErrorFlag();
+            return;
+        }
+
+        bool ok;
+        routine->label = QInputDialog::getItem(
+                this,
+                toAdd ? "Add Label to Selected Cards" : "Remove Label from Selected Cards",
+                "Label:",
+                labels,
+                0, // initial index
+                false, // editable
+                &ok);
+        if (!ok || routine->label.isEmpty())
+            context.setErrorFlag();
+    }, this);
+
+    routine->addStep([this, routine, toAdd]() {
+        // update labels and colors of NodeRect's
+        ContinuationContext context(routine);
+
+        for (const int cardId: qAsConst(selection.cardIds)) {
+            NodeRect *nodeRect = nodeRectsCollection.get(cardId);
+            if (nodeRect == nullptr)
+                continue;
+
+            QSet<QString> labels = nodeRect->getNodeLabels();
+            if (labels.contains(routine->label) == toAdd)
+                continue; // (unchanged)
+
+            if (toAdd)
+                labels << routine->label;
+            else
+                labels.remove(routine->label);
+
+            const QVector<QString> labelsVec
+                    = sortByOrdering(labels, routine->userCardLabelsList, false);
+            nodeRect->setNodeLabels(QStringList(labelsVec.cbegin(), labelsVec.cend()));
+            routine->cardIdToUpdatedLabels.insert(cardId, labels);
+        }
+
+        nodeRectsCollection.updateNodeRectColors(keySet(routine->cardIdToUpdatedLabels));
+
+        if (routine->cardIdToUpdatedLabels.isEmpty())
+            context.setErrorFlag(); // (nothing to update)
+    }, this);
+
+    routine->addStep([this, routine]() {
+        // update properties display
+        Services::instance()->getAppDataReadonly()->queryCards(
+                keySet(routine->cardIdToUpdatedLabels),
+                // callback
+                [this, routine](bool ok, const QHash<int, CardSnapshot> &cards) {
+                    ContinuationContext context(routine);
+
+                    if (!ok) {
+                        qWarning().noquote() << "could not get card data";
+                        return;
+                    }
+
+                    for (auto it = routine->cardIdToUpdatedLabels.constBegin();
+                            it != routine->cardIdToUpdatedLabels.constEnd(); ++it) {
+                        const int cardId = it.key();
+                        if (!cards.contains(cardId))
+                            continue;
+
+                        nodeRectsCollection.updateNodeRectPropertiesDisplay(
+                                cardId, toSymbolSet(it.value()),
+                                cards.value(cardId)->getCustomProperties(),
+                                cardPropertiesToShowTable);
+                    }
+                },
+                this
+        );
+    }, this);
+
+    routine->addStep([this, routine]() {
+        // call AppData
+        ContinuationContext context(routine);
+        Services::instance()->getAppData()->updateCardsLabels(
+                EventSource(this), routine->cardIdToUpdatedLabels);
+    }, this);
+
+    routine->addStep([routine]() {
+        // final step
+        ContinuationContext context(routine);
+    }, this);
+
+    //
+    routine->start();
+}
+
+void BoardView::onRubberBandChanged(const QRectF &sceneRect) {
+    rubberBandItem->setRect(sceneRect);
+    rubberBandItem->setVisible(true);
+}
+
+void BoardView::onRubberBandFinished(const QRectF &sceneRect) {
+    rubberBandItem->setVisible(false);
+    if (boardId == -1)
+        return;
+
+    // select the items contained in the rubber band (found with the spatial indices)
+    const QRectF rect = canvas->mapRectFromScene(sceneRect);
+
+    Selection newSelection;
+    newSelection.cardIds = nodeRectsCollection.getCardIdsInRect(rect);
+    newSelection.groupBoxIds = groupBoxesCollection.getGroupBoxIdsInRect(rect);
+    newSelection.customDataQueryIds = dataViewBoxesCollection.getCustomDataQueryIdsInRect(rect);
+    setSelection(newSelection);
+}
+
 void BoardView::onBackgroundClicked() {
+    selection = Selection();
     nodeRectsCollection.setHighlightedCardIds({});
     groupBoxesCollection.setHighlightedGroupBoxes({});
+    dataViewBoxesCollection.setHighlightedDataViewBoxes({});
 
     // call AppData
     constexpr int highlightedCardId = -1;
@@ -1693,6 +2495,8 @@ void BoardView::onBackgroundClicked() {
 void BoardView::reparentNodeRectInGroupBoxTree(const int cardId, const int newParentGroupBox) {
     const int originalParentGroupBox = groupBoxTree.getParentGroupBoxOfCard(cardId); // can be -1
     if (originalParentGroupBox != newParentGroupBox) {
+        relationshipBundlesCollection.markCardChanged(cardId);
+
         if (newParentGroupBox == -1) {
             groupBoxTree.removeCard(cardId);
 
@@ -1705,6 +2509,8 @@ void BoardView::reparentNodeRectInGroupBoxTree(const int cardId, const int newPa
             Services::instance()->getAppData()->addOrReparentNodeRectToGroupBox(
                     EventSource(this), cardId, newParentGroupBox);
         }
+
+        relationshipBundlesCollection.markCardChanged(cardId);
     }
 
     //
@@ -1721,7 +2527,9 @@ void BoardView::reparentGroupBoxInGroupBoxTree(const int groupBoxId, const int n
     if (originalParentGroupBox != newParentGroupBox) {
         const int newParentId
                 = (newParentGroupBox != -1) ? newParentGroupBox : GroupBoxTree::rootId;
+        relationshipBundlesCollection.markGroupBoxChanged(groupBoxId);
         groupBoxTree.reparentExistingGroupBox(groupBoxId, newParentId);
+        relationshipBundlesCollection.markGroupBoxChanged(groupBoxId);
 
         Services::instance()->getAppData()->reparentGroupBox(
                 EventSource(this), groupBoxId, newParentGroupBox);
@@ -1734,6 +2542,19 @@ void BoardView::reparentGroupBoxInGroupBoxTree(const int groupBoxId, const int n
 void BoardView::closeAll(bool *highlightedCardIdChanged_) {
     *highlightedCardIdChanged_ = false;
 
+    stopAutoLayout();
+    cancelZoomPreview();
+
+    // stop the loading in progress, if any (see loadBoard())
+    ++loadGeneration;
+    loadingProgressBar->setVisible(false);
+    graphicsView->setInteractive(true);
+
+    frameUpdateScheduler.cancel();
+    autoEdgeRouting.clear();
+    selection = Selection();
+    rubberBandItem->setVisible(false);
+
     const QSet<int> cardIds = nodeRectsCollection.getAllCardIds();
     for (const int &cardId: cardIds) {
         bool highlightedCardIdChanged;
@@ -1766,16 +2587,20 @@ void BoardView::closeAll(bool *highlightedCardIdChanged_) {
 
     //
     groupBoxTree.clear();
+    relationshipBundlesCollection.markAllChanged();
     updateRelationshipBundles();
 }
 
-void BoardView::adjustSceneRect() {
+void BoardView::adjustSceneRect(const QRectF &extraContentsRect) {
+    RenderingProfiler::ScopedOperation scopedOperation(
+            RenderingProfiler::Operation::AdjustSceneRect);
+
     QGraphicsScene *scene = graphicsView->scene();
     if (scene == nullptr)
         return;
 
-    const QRectF contentsRectInCanvas
-            = getContentsRectInCanvasCoordinates(); // in canvas coordinates
+    const QRectF contentsRectInCanvas = boundingRectOfRects(
+            {getContentsRectInCanvasCoordinates(), extraContentsRect}); // in canvas coordinates
     const QRectF contentsRectInScene = contentsRectInCanvas.isNull()
             ? QRectF(0, 0, 10, 10)
             : QRectF(
@@ -1799,7 +2624,7 @@ void BoardView::doApplyZoomAction(const ZoomAction zoomAction, const QPointF &an
     }
     else {
         const QVector<double> scaleFactors {
-            0.5, 0.67, 0.75, 0.8, 0.9, 1.0, 1.1, 1.25, 1.5, 1.75, 2.0
+            0.25, 0.33, 0.4, 0.5, 0.67, 0.75, 0.8, 0.9, 1.0, 1.1, 1.25, 1.5, 1.75, 2.0
         }; // must be non-empty & strictly increasing
 
         const double oldScale = zoomScale;
@@ -1810,10 +2635,63 @@ void BoardView::doApplyZoomAction(const ZoomAction zoomAction, const QPointF &an
         zoomScale = scaleFactors.at(zoomLevel);
     }
 
-    updateCanvasScale(zoomScale * graphicsGeometryScaleFactor, anchorScenePos);
+    // preview the zoom with a cached image of the viewport
+    const double scale = zoomScale * graphicsGeometryScaleFactor;
+    if (!zoomPreview->isPreviewing()) {
+        if (std::fabs(scale - canvas->scale()) < 1e-6)
+            return;
+
+        const QPixmap viewportPixmap = graphicsView->viewport()->grab();
+        zoomPreview->start(
+                viewportPixmap.toImage(), getViewTopLeftPos(), canvas->scale(),
+                graphicsScene->backgroundBrush().color());
+        zoomPreviewScrollPos = getScrollBarsValues();
+    }
+
+    zoomPreviewAnchorPos = graphicsView->viewportTransform().map(anchorScenePos);
+    zoomPreview->zoomTo(scale, zoomPreviewAnchorPos);
+    updateMinimapViewport();
+
+    zoomSettleTimer->start(); // (restarted by each zoom step)
+}
+
+void BoardView::commitZoomPreview() {
+    if (!zoomPreview->isPreviewing())
+        return;
+    zoomSettleTimer->stop();
+
+    RenderingProfiler::ScopedOperation scopedOperation(
+            RenderingProfiler::Operation::UpdateCanvasScale);
+
+    const QPointF viewTopLeft = zoomPreview->getViewTopLeft();
+    const double scale = zoomPreview->getViewScale();
+    zoomPreview->startRevealing(zoomPreviewAnchorPos);
+
+    canvas->setScale(scale);
+    adjustSceneRect();
+    setViewTopLeftPos(viewTopLeft);
+
+    // (the scrolling above must not pan the overlay)
+    zoomPreview->setView(viewTopLeft, scale);
+    zoomPreviewScrollPos = getScrollBarsValues();
+
+    //
+    updateLevelOfDetail();
+    updateContentsMaterializationDebouncer->tryAct();
+    updateMinimapViewport();
+}
+
+void BoardView::cancelZoomPreview() {
+    zoomSettleTimer->stop();
+    zoomPreview->cancel();
 }
 
 void BoardView::updateCanvasScale(const double scale, const QPointF &anchorScenePos) {
+    commitZoomPreview();
+
+    RenderingProfiler::ScopedOperation scopedOperation(
+            RenderingProfiler::Operation::UpdateCanvasScale);
+
     const QPointF anchorPosInCanvas = canvas->mapFromScene(anchorScenePos);
     canvas->setScale(scale);
 
@@ -1825,21 +2703,62 @@ void BoardView::updateCanvasScale(const double scale, const QPointF &anchorScene
 
     //
     adjustSceneRect();
+    updateLevelOfDetail();
+    updateContentsMaterializationDebouncer->tryAct();
+    updateMinimapViewport();
 }
 
-void BoardView::updatePropertiesDisplayOfAllCards() {
-    // merge (cascade) workspace's setting with board's setting
-    CardPropertiesToShow effectiveSetting = cardPropertiesToShowSettings.onWorkspace;
-    effectiveSetting.updateWith(cardPropertiesToShowSettings.onBoard);
+void BoardView::updateLevelOfDetail() {
+    const LevelOfDetail lod = computeLevelOfDetail(canvas->scale());
+    if (lod == levelOfDetail)
+        return;
 
-    //
-    const QSet<int> cardIds = nodeRectsCollection.getAllCardIds();
+    levelOfDetail = lod;
+    nodeRectsCollection.setLevelOfDetailOfAll(levelOfDetail);
+    relationshipsCollection.setLevelOfDetailOfAll(levelOfDetail);
+    dataViewBoxesCollection.setLevelOfDetailOfAll(levelOfDetail);
+    groupBoxesCollection.setLevelOfDetailOfAll(levelOfDetail);
+    relationshipBundlesCollection.setLevelOfDetailOfAll(levelOfDetail);
+}
+
+LevelOfDetail BoardView::computeLevelOfDetail(const double canvasScale) {
+    if (canvasScale >= minCanvasScaleForFullDetail)
+        return LevelOfDetail::Full;
+    if (canvasScale >= minCanvasScaleForTitles)
+        return LevelOfDetail::TitleOnly;
+    return LevelOfDetail::BoxOnly;
+}
+
+void BoardView::updateContentsMaterialization() {
+    if (levelOfDetail != LevelOfDetail::Full) {
+        // card texts are not shown, so release all text editors
+        nodeRectsCollection.updateContentsMaterialization(QRectF(), QRectF());
+        return;
+    }
+
+    nodeRectsCollection.updateContentsMaterialization(
+            getViewportRectInCanvas(contentsMaterializeMarginFraction),
+            getViewportRectInCanvas(contentsKeepMarginFraction));
+}
+
+void BoardView::onCardPropertiesToShowSettingsUpdated() {
+    const CardPropertiesToShow::CompiledTable previousTable = cardPropertiesToShowTable;
+    cardPropertiesToShowTable = compileCardPropertiesToShowSettings();
+
+    // only the cards for which the properties to show change need to be updated
+    const CardPropertiesToShow::CompiledTable table = cardPropertiesToShowTable;
+    const QSet<int> cardIds = nodeRectsCollection.getCardIdsByLabels(
+            [&table, &previousTable](const QSet<Symbol> &cardLabels) {
+        return !table.givesSameResult(previousTable, cardLabels);
+    });
+    if (cardIds.isEmpty())
+        return;
 
     //
     class AsyncRoutineWithVars : public AsyncRoutineWithErrorFlag
     {
     public:
-        QHash<int, Card> cards;
+        QHash<int, CardSnapshot> cards;
         QString errorMsg;
     };
     auto *routine = new AsyncRoutineWithVars;
@@ -1849,7 +2768,7 @@ void BoardView::updatePropertiesDisplayOfAllCards() {
         Services::instance()->getAppDataReadonly()->queryCards(
                 cardIds,
                 // callback
-                [routine](bool ok, const QHash<int, Card> &cards) {
+                [routine](bool ok, const QHash<int, CardSnapshot> &cards) {
                     ContinuationContext context(routine);
                     if (!ok) {
                         context.setErrorFlag();
@@ -1861,15 +2780,15 @@ void BoardView::updatePropertiesDisplayOfAllCards() {
                 this);
     }, this);
 
-    routine->addStep([this, routine, effectiveSetting]() {
-        // apply `effectiveSetting` on every card
+    routine->addStep([this, routine, table]() {
+        // apply `table` on the cards, in a batch
         ContinuationContext context(routine);
 
         for (auto it = routine->cards.constBegin(); it != routine->cards.constEnd(); ++it) {
             const int &cardId = it.key();
-            const Card &cardData = it.value();
+            const Card &cardData = *it.value();
             nodeRectsCollection.updateNodeRectPropertiesDisplay(
-                    cardId, cardData.getLabels(), cardData.getCustomProperties(),effectiveSetting);
+                    cardId, cardData.getLabelSymbols(), cardData.getCustomProperties(), table);
         }
 
     }, this);
@@ -1884,16 +2803,21 @@ void BoardView::updatePropertiesDisplayOfAllCards() {
     routine->start();
 }
 
-void BoardView::updateRelationshipBundles() {
-    // show all EdgeArrow's of relationships
-    relationshipsCollection.setAllEdgeArrowsVisible();
+CardPropertiesToShow::CompiledTable BoardView::compileCardPropertiesToShowSettings() const {
+    // merge (cascade) workspace's setting with board's setting
+    CardPropertiesToShow effectiveSetting = cardPropertiesToShowSettings.onWorkspace;
+    effectiveSetting.updateWith(cardPropertiesToShowSettings.onBoard);
+    return effectiveSetting.compile();
+}
 
-    // update bundles
-    relationshipBundlesCollection.update();
+void BoardView::updateRelationshipBundles() {
+    QSet<RelationshipId> newlyBundledRels;
+    QSet<RelationshipId> unbundledRels;
+    relationshipBundlesCollection.update(&newlyBundledRels, &unbundledRels);
 
-    // hide EdgeArrow's of bundled relationships
-    const auto rels = relationshipBundlesCollection.getBundledRelationships();
-    relationshipsCollection.hideEdgeArrows(rels);
+    // show EdgeArrow's of relationships no longer bundled, and hide those of newly bundled ones
+    relationshipsCollection.setEdgeArrowsVisible(unbundledRels);
+    relationshipsCollection.hideEdgeArrows(newlyBundledRels);
 }
 
 void BoardView::moveFollowerItemsInComovingState(
@@ -1912,6 +2836,7 @@ void BoardView::moveFollowerItemsInComovingState(
             QRectF rect = groupBox->getRect();
             rect.moveTopLeft(it.value() + displacement);
             groupBox->setRect(rect);
+            groupBoxesCollection.updateSpatialIndex(groupBoxId);
         }
 
         // relationship bundles
@@ -1929,53 +2854,356 @@ void BoardView::moveFollowerItemsInComovingState(
             QRectF rect = nodeRect->getRect();
             rect.moveTopLeft(it.value() + displacement);
             nodeRect->setRect(rect);
+            nodeRectsCollection.updateSpatialIndex(cardId);
         }
 
         // relationship bundles
         relationshipBundlesCollection.updateBundlesConnectingNodeRect(cardId);
     }
 
-    // EdgeArrow's
+    // follower DataViewBox'es
+    const auto followerCustomDataQueryIdToInitialPos
+            = comovingStateData.followerCustomDataQueryIdToInitialPos;
+    for (auto it = followerCustomDataQueryIdToInitialPos.constBegin();
+            it != followerCustomDataQueryIdToInitialPos.constEnd(); ++it) {
+        const int customDataQueryId = it.key();
+        DataViewBox *box = dataViewBoxesCollection.get(customDataQueryId);
+        if (box != nullptr) {
+            QRectF rect = box->getRect();
+            rect.moveTopLeft(it.value() + displacement);
+            box->setRect(rect);
+            dataViewBoxesCollection.updateSpatialIndex(customDataQueryId);
+        }
+    }
+
+    // EdgeArrow's
+    QSet<RelationshipId> affectedRelIds;
+    for (auto it = followerCardIdToInitialPos.constBegin();
+            it != followerCardIdToInitialPos.constEnd(); ++it) {
+        const int cardId = it.key();
+        affectedRelIds += getEdgeArrowsConnectingNodeRect(cardId);
+    }
+
+    for (const auto &relId: qAsConst(affectedRelIds)) {
+        constexpr bool updateOtherEdgeArrows = false;
+        relationshipsCollection.updateEdgeArrow(relId, updateOtherEdgeArrows);
+    }
+}
+
+void BoardView::savePositionsOfComovingItems(
+        const ComovingStateData &comovingStateData, BoardItemsBulkUpdate bulkUpdate) {
+    const auto groupBoxIds = keySet(comovingStateData.followerGroupBoxIdToInitialPos);
+    const auto cardIds = keySet(comovingStateData.followerCardIdToInitialPos);
+    const auto customDataQueryIds
+            = keySet(comovingStateData.followerCustomDataQueryIdToInitialPos);
+
+    for (const int groupBoxId: groupBoxIds) {
+        GroupBox *groupBox = groupBoxesCollection.get(groupBoxId);
+        if (groupBox == nullptr)
+            continue;
+
+        GroupBoxNodePropertiesUpdate update;
+        update.rect = groupBox->getRect();
+        bulkUpdate.groupBoxIdToUpdate.insert(groupBoxId, update);
+    }
+
+    for (const int cardId: cardIds) {
+        const auto nodeRectRectOpt = nodeRectsCollection.getNodeRectRect(cardId);
+        if (!nodeRectRectOpt.has_value())
+            continue;
+
+        NodeRectDataUpdate update;
+        update.rect = nodeRectRectOpt.value();
+        bulkUpdate.cardIdToNodeRectUpdate.insert(cardId, update);
+    }
+
+    for (const int customDataQueryId: customDataQueryIds) {
+        DataViewBox *box = dataViewBoxesCollection.get(customDataQueryId);
+        if (box == nullptr)
+            continue;
+
+        DataViewBoxDataUpdate update;
+        update.rect = box->getRect();
+        bulkUpdate.customDataQueryIdToDataViewBoxUpdate.insert(customDataQueryId, update);
+    }
+
+    if (!bulkUpdate.isEmpty()) {
+        Services::instance()->getAppData()->updateBoardItemsInBulk(
+                EventSource(this), this->boardId, bulkUpdate);
+    }
+}
+
+void BoardView::setSelection(const Selection &newSelection) {
+    selection = newSelection;
+
+    nodeRectsCollection.setHighlightedCardIds(selection.cardIds);
+    groupBoxesCollection.setHighlightedGroupBoxes(selection.groupBoxIds);
+    dataViewBoxesCollection.setHighlightedDataViewBoxes(selection.customDataQueryIds);
+
+    // call AppData
+    const int highlightedCardId
+            = (selection.cardIds.count() == 1) ? *selection.cardIds.constBegin() : -1;
+    Services::instance()->getAppData()
+            ->setSingleHighlightedCardId(EventSource(this), highlightedCardId);
+}
+
+void BoardView::clearSelection() {
+    if (!selection.isEmpty())
+        setSelection(Selection());
+}
+
+void BoardView::activateComovingWithSelection() {
+    comovingStateData.activate();
+    comovingStateData.clearFollowers();
+    comovingStateData.isMovingSelection = true;
+
+    QSet<int> groupBoxIds = selection.groupBoxIds;
+    QSet<int> cardIds = selection.cardIds;
+    for (const int groupBoxId: qAsConst(selection.groupBoxIds)) {
+        const auto [descendantGroupBoxes, descendantCards]
+                = groupBoxTree.getAllDescendants(groupBoxId);
+        groupBoxIds += descendantGroupBoxes;
+        cardIds += descendantCards;
+    }
+
+    for (const int groupBoxId: qAsConst(groupBoxIds)) {
+        if (GroupBox *groupBox = groupBoxesCollection.get(groupBoxId); groupBox != nullptr) {
+            comovingStateData.followerGroupBoxIdToInitialPos.insert(
+                    groupBoxId, groupBox->getRect().topLeft());
+        }
+    }
+    for (const int cardId: qAsConst(cardIds)) {
+        const auto nodeRectRectOpt = nodeRectsCollection.getNodeRectRect(cardId);
+        if (nodeRectRectOpt.has_value()) {
+            comovingStateData.followerCardIdToInitialPos.insert(
+                    cardId, nodeRectRectOpt.value().topLeft());
+        }
+    }
+    for (const int customDataQueryId: qAsConst(selection.customDataQueryIds)) {
+        if (DataViewBox *box = dataViewBoxesCollection.get(customDataQueryId); box != nullptr) {
+            comovingStateData.followerCustomDataQueryIdToInitialPos.insert(
+                    customDataQueryId, box->getRect().topLeft());
+        }
+    }
+}
+
+void BoardView::animateAutoLayoutResult(
+        const QVector<int> &cardIds, const QVector<int> &groupBoxIds,
+        const ForceDirectedLayout::Result &result) {
+    Q_ASSERT(autoLayoutAnimation == nullptr);
+
+    QVector<QRectF> initialNodeRectRects;
+    for (const int cardId: cardIds)
+        initialNodeRectRects << nodeRectsCollection.getNodeRectRect(cardId).value_or(QRectF());
+
+    QVector<QRectF> initialGroupBoxRects;
+    for (const int groupBoxId: groupBoxIds) {
+        GroupBox *groupBox = groupBoxesCollection.get(groupBoxId);
+        initialGroupBoxRects << ((groupBox != nullptr) ? groupBox->getRect() : QRectF());
+    }
+
+    // final rects, snapped to grid: the group-boxes are snapped first (outwards, parents before
+    // children), and then each item is kept within the contents rect of its snapped parent
+    QHash<int, int> groupBoxIdToIndex;
+    for (int i = 0; i < groupBoxIds.count(); ++i)
+        groupBoxIdToIndex.insert(groupBoxIds.at(i), i);
+
+    QMarginsF groupBoxContentsMargins; // (same for all group-boxes)
+    for (const int groupBoxId: groupBoxIds) {
+        if (GroupBox *groupBox = groupBoxesCollection.get(groupBoxId); groupBox != nullptr) {
+            groupBoxContentsMargins
+                    = diffMargins(groupBox->getRect(), groupBox->getContentsRect());
+            break;
+        }
+    }
+
+    QVector<QRectF> finalGroupBoxRects = result.groupRects;
+    {
+        auto getDepth = [this, &groupBoxIdToIndex](int groupBoxId) {
+            int depth = 0;
+            while (groupBoxIdToIndex.contains(groupBoxId)) {
+                groupBoxId = groupBoxTree.getParentOfGroupBox(groupBoxId);
+                ++depth;
+            }
+            return depth;
+        };
+
+        QVector<std::pair<int, int>> depthAndIndex;
+        for (int i = 0; i < groupBoxIds.count(); ++i)
+            depthAndIndex << std::make_pair(getDepth(groupBoxIds.at(i)), i);
+        std::sort(depthAndIndex.begin(), depthAndIndex.end());
+
+        for (const auto &[depth, i]: qAsConst(depthAndIndex)) {
+            const QRectF &rect = finalGroupBoxRects.at(i);
+            QRectF snapped(
+                    QPointF(std::floor(rect.left() / boardSnapGridSize) * boardSnapGridSize,
+                            std::floor(rect.top() / boardSnapGridSize) * boardSnapGridSize),
+                    QPointF(std::ceil(rect.right() / boardSnapGridSize) * boardSnapGridSize,
+                            std::ceil(rect.bottom() / boardSnapGridSize) * boardSnapGridSize));
+
+            const int parentIndex = groupBoxIdToIndex.value(
+                    groupBoxTree.getParentOfGroupBox(groupBoxIds.at(i)), -1);
+            if (parentIndex != -1) {
+                const QRectF bounds = finalGroupBoxRects.at(parentIndex)
+                        .marginsRemoved(groupBoxContentsMargins);
+                snapped = placeRectWithin(snapped, bounds, boardSnapGridSize)
+                          .intersected(bounds); // (shrinks `snapped` if it's too large)
+            }
+            finalGroupBoxRects[i] = snapped;
+        }
+    }
+
+    QVector<QRectF> finalNodeRectRects = result.boxRects;
+    for (int i = 0; i < cardIds.count(); ++i) {
+        QRectF &rect = finalNodeRectRects[i];
+        rect.moveTopLeft(quantize(rect.topLeft(), boardSnapGridSize));
+
+        const int parentIndex = groupBoxIdToIndex.value(
+                groupBoxTree.getParentGroupBoxOfCard(cardIds.at(i)), -1);
+        if (parentIndex != -1) {
+            const QRectF bounds = finalGroupBoxRects.at(parentIndex)
+                    .marginsRemoved(groupBoxContentsMargins);
+            rect = placeRectWithin(rect, bounds, boardSnapGridSize);
+        }
+    }
+
+    //
+    auto interpolate = [](const QVector<QRectF> &from, const QVector<QRectF> &to, const double t) {
+        QVector<QRectF> rects;
+        rects.reserve(from.count());
+        for (int i = 0; i < from.count(); ++i) {
+            const QRectF &r0 = from.at(i);
+            const QRectF &r1 = to.at(i);
+            rects << QRectF(
+                    r0.topLeft() + (r1.topLeft() - r0.topLeft()) * t,
+                    QSizeF(r0.width() + (r1.width() - r0.width()) * t,
+                           r0.height() + (r1.height() - r0.height()) * t));
+        }
+        return rects;
+    };
+
+    autoLayoutAnimation = new QVariantAnimation(this);
+    autoLayoutAnimation->setDuration(autoLayoutAnimationMsec);
+    autoLayoutAnimation->setEasingCurve(QEasingCurve::OutCubic);
+    autoLayoutAnimation->setStartValue(0.0);
+    autoLayoutAnimation->setEndValue(1.0);
+
+    connect(autoLayoutAnimation, &QVariantAnimation::valueChanged,
+            this, [=](const QVariant &value) {
+        const double t = value.toDouble();
+        setRectsOfNodeRectsAndGroupBoxes(
+                cardIds, interpolate(initialNodeRectRects, finalNodeRectRects, t),
+                groupBoxIds, interpolate(initialGroupBoxRects, finalGroupBoxRects, t));
+    });
+
+    connect(autoLayoutAnimation, &QVariantAnimation::finished, this, [=]() {
+        autoLayoutAnimation->deleteLater();
+        autoLayoutAnimation = nullptr;
+
+        setRectsOfNodeRectsAndGroupBoxes(
+                cardIds, finalNodeRectRects, groupBoxIds, finalGroupBoxRects);
+        adjustSceneRect();
+        graphicsView->setInteractive(true);
+
+        // save (in one bulk update, so that the layout is saved atomically)
+        BoardItemsBulkUpdate bulkUpdate;
+        for (int i = 0; i < cardIds.count(); ++i) {
+            if (!nodeRectsCollection.contains(cardIds.at(i)))
+                continue;
+
+            NodeRectDataUpdate update;
+            update.rect = finalNodeRectRects.at(i);
+            bulkUpdate.cardIdToNodeRectUpdate.insert(cardIds.at(i), update);
+        }
+        for (int i = 0; i < groupBoxIds.count(); ++i) {
+            if (groupBoxesCollection.get(groupBoxIds.at(i)) == nullptr)
+                continue;
+
+            GroupBoxNodePropertiesUpdate update;
+            update.rect = finalGroupBoxRects.at(i);
+            bulkUpdate.groupBoxIdToUpdate.insert(groupBoxIds.at(i), update);
+        }
+        if (!bulkUpdate.isEmpty()) {
+            Services::instance()->getAppData()->updateBoardItemsInBulk(
+                    EventSource(this), this->boardId, bulkUpdate);
+        }
+    });
+
+    autoLayoutAnimation->start();
+}
+
+QRectF BoardView::placeRectWithin(const QRectF &rect, const QRectF &bounds, const double grid) {
+    // (in each dimension) `pos` is kept within [lo, hi], on the grid if possible
+    auto place = [grid](const double pos, const double lo, const double hi) {
+        if (hi < lo)
+            return lo;
+        const double loOnGrid = std::ceil(lo / grid) * grid;
+        const double hiOnGrid = std::floor(hi / grid) * grid;
+        if (loOnGrid <= hiOnGrid)
+            return std::clamp(pos, loOnGrid, hiOnGrid);
+        return std::clamp(pos, lo, hi);
+    };
+
+    QRectF result = rect;
+    result.moveTopLeft(QPointF(
+            place(rect.left(), bounds.left(), bounds.right() - rect.width()),
+            place(rect.top(), bounds.top(), bounds.bottom() - rect.height())));
+    return result;
+}
+
+void BoardView::setRectsOfNodeRectsAndGroupBoxes(
+        const QVector<int> &cardIds, const QVector<QRectF> &nodeRectRects,
+        const QVector<int> &groupBoxIds, const QVector<QRectF> &groupBoxRects) {
+    Q_ASSERT(cardIds.count() == nodeRectRects.count());
+    Q_ASSERT(groupBoxIds.count() == groupBoxRects.count());
+
+    // group-boxes
+    for (int i = 0; i < groupBoxIds.count(); ++i) {
+        const int groupBoxId = groupBoxIds.at(i);
+        GroupBox *groupBox = groupBoxesCollection.get(groupBoxId);
+        if (groupBox == nullptr)
+            continue;
+
+        groupBox->setRect(groupBoxRects.at(i));
+        groupBoxesCollection.updateSpatialIndex(groupBoxId);
+        relationshipBundlesCollection.updateBundlesConnectingGroupBox(groupBoxId);
+    }
+
+    // NodeRect's
     QSet<RelationshipId> affectedRelIds;
-    for (auto it = followerCardIdToInitialPos.constBegin();
-            it != followerCardIdToInitialPos.constEnd(); ++it) {
-        const int cardId = it.key();
+    for (int i = 0; i < cardIds.count(); ++i) {
+        const int cardId = cardIds.at(i);
+        NodeRect *nodeRect = nodeRectsCollection.get(cardId);
+        if (nodeRect == nullptr)
+            continue;
+
+        nodeRect->setRect(nodeRectRects.at(i));
+        nodeRectsCollection.updateSpatialIndex(cardId);
+        relationshipBundlesCollection.updateBundlesConnectingNodeRect(cardId);
         affectedRelIds += getEdgeArrowsConnectingNodeRect(cardId);
     }
 
+    // EdgeArrow's (each updated once)
     for (const auto &relId: qAsConst(affectedRelIds)) {
         constexpr bool updateOtherEdgeArrows = false;
         relationshipsCollection.updateEdgeArrow(relId, updateOtherEdgeArrows);
     }
 }
 
-void BoardView::savePositionsOfComovingItems(const ComovingStateData &comovingStateData) {
-    const auto groupBoxIds = keySet(comovingStateData.followerGroupBoxIdToInitialPos);
-    const auto cardIds = keySet(comovingStateData.followerCardIdToInitialPos);
-
-    for (const int groupBoxId: groupBoxIds) {
-        GroupBox *groupBox = groupBoxesCollection.get(groupBoxId);
-        if (groupBox == nullptr)
-            return;
+void BoardView::stopAutoLayout() {
+    const bool wasActive = (autoLayout != nullptr || autoLayoutAnimation != nullptr);
 
-        GroupBoxNodePropertiesUpdate update;
-        update.rect = groupBox->getRect();
+    delete autoLayout; // (cancels the computation and waits for it)
+    autoLayout = nullptr;
 
-        Services::instance()->getAppData()->updateGroupBoxProperties(
-                EventSource(this), groupBoxId, update);
+    if (autoLayoutAnimation != nullptr) {
+        autoLayoutAnimation->stop(); // (does not emit finished())
+        delete autoLayoutAnimation;
+        autoLayoutAnimation = nullptr;
     }
 
-    for (const int cardId: cardIds) {
-        const auto nodeRectRectOpt = nodeRectsCollection.getNodeRectRect(cardId);
-        if (!nodeRectRectOpt.has_value())
-            return;
-
-        NodeRectDataUpdate update;
-        update.rect = nodeRectRectOpt.value();
-
-        Services::instance()->getAppData()->updateNodeRectProperties(
-                EventSource(this), this->boardId, cardId, update);
-    }
+    if (wasActive)
+        graphicsView->setInteractive(true);
 }
 
 void BoardView::getWorkspaceId(std::function<void (const int workspaceId)> callback) {
@@ -2016,17 +3244,38 @@ QRectF BoardView::getContentsRectInCanvasCoordinates() const {
     );
 }
 
+QRectF BoardView::computeBoundingRectOfBoxes(const Board &board) {
+    QVector<QRectF> rects;
+    for (const NodeRectData &data: qAsConst(board.cardIdToNodeRectData))
+        rects << data.rect;
+    for (const DataViewBoxData &data: qAsConst(board.customDataQueryIdToDataViewBoxData))
+        rects << data.rect;
+    for (const GroupBoxData &data: qAsConst(board.groupBoxIdToData))
+        rects << data.rect;
+    for (const SettingBoxData &data: qAsConst(board.settingBoxesData))
+        rects << data.rect;
+    return boundingRectOfRects(rects);
+}
+
 QColor BoardView::getSceneBackgroundColor(const bool isDarkTheme) {
     return isDarkTheme ? QColor(darkThemeBoardBackground) : QColor(230, 230, 230);
 }
 
 QColor BoardView::getEdgeArrowLineColor() const {
     const bool isDarkTheme = Services::instance()->getAppDataReadonly()->getIsDarkTheme();
-    return isDarkTheme ? QColor(175, 175, 175) : QColor(100, 100, 100);
+    return computeEdgeArrowLineColor(isDarkTheme);
 }
 
 QColor BoardView::getEdgeArrowLabelColor() const {
     const bool isDarkTheme = Services::instance()->getAppDataReadonly()->getIsDarkTheme();
+    return computeEdgeArrowLabelColor(isDarkTheme);
+}
+
+QColor BoardView::computeEdgeArrowLineColor(const bool isDarkTheme) {
+    return isDarkTheme ? QColor(175, 175, 175) : QColor(100, 100, 100);
+}
+
+QColor BoardView::computeEdgeArrowLabelColor(const bool isDarkTheme) {
     return isDarkTheme ? QColor(darkThemeStandardTextColor) : QColor(Qt::black);
 }
 
@@ -2058,9 +3307,88 @@ void BoardView::moveSceneRelativeToView(const QPointF &displacement) {
     graphicsView->centerOn(newViewCenter);
 }
 
+QPoint BoardView::getScrollBarsValues() const {
+    return {graphicsView->horizontalScrollBar()->value(),
+            graphicsView->verticalScrollBar()->value()};
+}
+
+void BoardView::onViewScrolled() {
+    // keep `zoomPreview` (if shown) in sync with the view
+    const QPoint scrollPos = getScrollBarsValues();
+    zoomPreview->panBy(scrollPos - zoomPreviewScrollPos);
+    zoomPreviewScrollPos = scrollPos;
+
+    if (!zoomPreview->isPreviewing()) // (otherwise done when the preview is committed)
+        updateContentsMaterializationDebouncer->tryAct();
+    updateMinimapViewport();
+}
+
+QRectF BoardView::getViewportRectInCanvas(const double marginFraction) const {
+    const QRect viewportRect = graphicsView->viewport()->rect();
+    const QRectF viewportRectInScene(
+            graphicsView->mapToScene(viewportRect.topLeft()),
+            graphicsView->mapToScene(viewportRect.bottomRight()));
+    const QRectF rectInCanvas(
+            canvas->mapFromScene(viewportRectInScene.topLeft()),
+            canvas->mapFromScene(viewportRectInScene.bottomRight()));
+
+    const double marginX = rectInCanvas.width() * marginFraction;
+    const double marginY = rectInCanvas.height() * marginFraction;
+    return rectInCanvas.marginsAdded(QMarginsF(marginX, marginY, marginX, marginY));
+}
+
+void BoardView::setRenderingProfilerShown(const bool show) {
+    renderingProfilerOverlay->setVisible(show); // (also enables/disables the profiler)
+    if (show)
+        renderingProfilerOverlay->raise();
+
+    // let EdgeArrow's paint() be called (see RenderingProfiler::onTopLevelItemPaintStarted())
+    const auto items = canvas->childItems();
+    for (QGraphicsItem *item: items) {
+        if (auto *edgeArrow = dynamic_cast<EdgeArrow *>(item); edgeArrow != nullptr)
+            edgeArrow->setProfilingEnabled(show);
+    }
+}
+
+void BoardView::updateMinimapNodeRect(const int cardId) {
+    NodeRect *nodeRect = nodeRectsCollection.get(cardId);
+    if (nodeRect == nullptr)
+        minimap->removeNodeRect(cardId);
+    else
+        minimap->setNodeRect(cardId, nodeRect->getRect(), nodeRect->getColor());
+}
+
+void BoardView::updateMinimapGroupBox(const int groupBoxId) {
+    GroupBox *groupBox = groupBoxesCollection.get(groupBoxId);
+    if (groupBox == nullptr)
+        minimap->removeGroupBox(groupBoxId);
+    else
+        minimap->setGroupBox(groupBoxId, groupBox->getRect(), groupBox->getColor());
+}
+
+void BoardView::updateMinimapViewport() {
+    if (!minimap->isVisible())
+        return;
+
+    if (zoomPreview->isPreviewing()) {
+        const QSizeF viewportSize
+                = QSizeF(graphicsView->viewport()->size()) / zoomPreview->getViewScale();
+        minimap->setViewportRect(QRectF(zoomPreview->getViewTopLeft(), viewportSize));
+        return;
+    }
+    minimap->setViewportRect(getViewportRectInCanvas(0));
+}
+
+void BoardView::adjustMinimapPosition() {
+    constexpr int margin = 8;
+    minimap->move(
+            graphicsView->width() - minimap->width() - margin,
+            graphicsView->height() - minimap->height() - margin);
+}
+
 QColor BoardView::computeNodeRectDisplayColor(
-        const QColor &nodeRectOwnColor, const QSet<QString> &cardLabels,
-        const QVector<LabelAndColor> &cardLabelsAndAssociatedColors,
+        const QColor &nodeRectOwnColor, const QSet<Symbol> &cardLabels,
+        const LabelRulesTable<QColor> &cardLabelColorsTable,
         const QColor &boardDefaultColorForNodeRect, const bool invertLightness) {
     std::function<QColor ()> funcGetColor1 = [&]() {
         // 1. NodeRect's own color
@@ -2068,10 +3396,8 @@ QColor BoardView::computeNodeRectDisplayColor(
             return nodeRectOwnColor;
 
         // 2. card labels & board's `cardLabelsAndAssociatedColors`
-        for (const auto &labelAndColor: cardLabelsAndAssociatedColors) {
-            if (cardLabels.contains(labelAndColor.first))
-                return labelAndColor.second;
-        }
+        if (const QColor *color = cardLabelColorsTable.lookUp(cardLabels); color != nullptr)
+            return *color;
 
         // 3. board's default
         if (boardDefaultColorForNodeRect.isValid())
@@ -2112,76 +3438,21 @@ QColor BoardView::computeSettingBoxDisplayColor(
 }
 
 QSet<RelationshipId> BoardView::getEdgeArrowsConnectingNodeRect(const int cardId) {
-    QSet<RelationshipId> result;
-
-    const auto relIds = relationshipsCollection.getAllRelationshipIds();
-    for (const RelationshipId &relId: relIds) {
-        if (relId.connectsCard(cardId))
-            result << relId;
-    }
-
-    return result;
-}
-
-QLineF BoardView::computeArrowLineConnectingRects(
-        const QRectF &fromRect, const QRectF &toRect,
-        const int parallelIndex, const int parallelCount) {
-    // Compute the vector for translating the center-to-center line. The result must be invariant
-    // if `fromRect` and `toRect` are swapped.
-    QPointF vecTranslation;
-    {
-        constexpr double spacing = 22;
-        const double shiftDistance = (parallelIndex - (parallelCount - 1.0) / 2.0) * spacing;
-
-        //
-        QPointF p1 = fromRect.center();
-        QPointF p2 = toRect.center();
-
-        const int x1 = nearestInteger(p1.x() * 100);
-        const int x2 = nearestInteger(p2.x() * 100);
-        if (x1 > x2) {
-            std::swap(p1, p2);
-        }
-        else if (x1 == x2) {
-            const int y1 = nearestInteger(p1.y() * 100);
-            const int y2 = nearestInteger(p2.y() * 100);
-            if (y1 > y2)
-                std::swap(p1, p2);
-        }
-
-        const QLineF lineNormal = QLineF(p1, p2).normalVector().unitVector();
-        const QPointF vecNormal(lineNormal.dx(), lineNormal.dy());
-        vecTranslation = vecNormal * shiftDistance;
-    }
-
-    //
-    const QLineF lineC2CTranslated
-            = QLineF(fromRect.center(), toRect.center())
-              .translated(vecTranslation);
-
-    //
-    bool intersect;
-    QPointF intersectionPoint;
-
-    intersect = rectEdgeIntersectsWithLine(fromRect, lineC2CTranslated, &intersectionPoint);
-    const QPointF startPoint = intersect ?  intersectionPoint : fromRect.center();
-
-    intersect = rectEdgeIntersectsWithLine(toRect, lineC2CTranslated, &intersectionPoint);
-    const QPointF endPoint = intersect ? intersectionPoint : toRect.center();
-
-    return {startPoint, endPoint};
+    return relationshipsCollection.getRelationshipsConnectingCard(cardId);
 }
 
 QString BoardView::computeCardPropertiesDisplay(
-        CardPropertiesToShow effectiveCardPropertiesToShowSetting, const QSet<QString> &cardLabels,
-        const QHash<QString, QJsonValue> &cardCustomProperties) {
+        const CardPropertiesToShow::CompiledTable &cardPropertiesToShowTable,
+        const QSet<Symbol> &cardLabels, const QHash<QString, QJsonValue> &cardCustomProperties) {
     // 1. determine properties display format by labels
-    const CardPropertiesToShow::PropertiesAndDisplayFormats propertiesDisplayFormat
-            = effectiveCardPropertiesToShowSetting.getPropertiesToShow(cardLabels);
+    const CardPropertiesToShow::PropertiesAndDisplayFormats *propertiesDisplayFormat
+            = cardPropertiesToShowTable.lookUp(cardLabels);
+    if (propertiesDisplayFormat == nullptr)
+        return "";
 
     // 2. determine properties display text
     QStringList displayOfProperties;
-    for (const auto &[propertyName, format]: propertiesDisplayFormat) {
+    for (const auto &[propertyName, format]: *propertiesDisplayFormat) {
         QString valueDisplay;
         if (!cardCustomProperties.contains(propertyName)) {
             if (format.stringIfNotExists.has_value())
@@ -2220,7 +3491,13 @@ NodeRect *BoardView::NodeRectsCollection::createNodeRect(
     cardIdToNodeRect.insert(cardId, nodeRect);
     cardIdToNodeRectOwnColor.insert(cardId, nodeRectOwnColor);
     nodeRect->setZValue(zValueForNodeRects);
+    nodeRect->setMarkdownRenderCache(boardView->markdownRenderCache);
+    nodeRect->setContentsMaterialized(
+            boardView->levelOfDetail == LevelOfDetail::Full
+            && rect.intersects(
+                boardView->getViewportRectInCanvas(contentsMaterializeMarginFraction)));
     nodeRect->initialize();
+    nodeRect->setLevelOfDetail(boardView->levelOfDetail);
 
     const QVector<QString> nodeLabelsVec
             = sortByOrdering(cardData.getLabels(), userLabelsList, false);
@@ -2230,6 +3507,9 @@ NodeRect *BoardView::NodeRectsCollection::createNodeRect(
     nodeRect->setRect(rect);
     nodeRect->setColor(displayColor);
     nodeRect->setPropertiesDisplay(propertiesDisplay);
+    boundingRectsIndex.set(cardId, nodeRect->boundingRect());
+    boardView->autoEdgeRouting.markBoxRectChanged(QRectF(), nodeRect->boundingRect());
+    boardView->updateMinimapNodeRect(cardId);
 
     // set up connections
     QPointer<NodeRect> nodeRectPtr(nodeRect);
@@ -2239,6 +3519,10 @@ NodeRect *BoardView::NodeRectsCollection::createNodeRect(
         if (nodeRectPtr.isNull())
             return;
 
+        if (boardView->selection.cardIds.contains(nodeRectPtr->getCardId()))
+            return; // (keep the selection, which may be moved)
+        boardView->clearSelection();
+
         setHighlightedCardIds({nodeRectPtr->getCardId()});
         boardView->groupBoxesCollection.setHighlightedGroupBoxes({});
 
@@ -2251,6 +3535,14 @@ NodeRect *BoardView::NodeRectsCollection::createNodeRect(
         if (!nodeRectPtr)
             return;
         boardView->itemMovingResizingStateData.activateWithTargetNodeRect(cardId);
+
+        // enter co-moving state if the NodeRect is selected, let the other selected items
+        // follow the move
+        if (boardView->selection.cardIds.contains(cardId) && boardView->selection.count() > 1) {
+            boardView->activateComovingWithSelection();
+            boardView->comovingStateData.followerCardIdToInitialPos.remove(cardId);
+            boardView->comovingStateData.followeeInitialPos = nodeRectPtr->getRect().topLeft();
+        }
     });
 
     QObject::connect(nodeRect, &NodeRect::aboutToResize, boardView, [this, cardId, nodeRectPtr]() {
@@ -2264,28 +3556,8 @@ NodeRect *BoardView::NodeRectsCollection::createNodeRect(
         if (!nodeRectPtr)
             return;
 
-        boardView->relationshipBundlesCollection.updateBundlesConnectingNodeRect(cardId);
-
-        // update edge arrows
-        const QSet<RelationshipId> relIds = boardView->getEdgeArrowsConnectingNodeRect(cardId);
-        for (const auto &relId: relIds) {
-            constexpr bool updateOtherEdgeArrows = false;
-            boardView->relationshipsCollection.updateEdgeArrow(relId, updateOtherEdgeArrows);
-        }
-
-        // can be added to a group-box?
-        {
-            const std::optional<int> groupBoxIdOpt
-                    = boardView->groupBoxesCollection.getDeepestEnclosingGroupBox(
-                            nodeRectPtr.data());
-
-            // -- highlight only the group-box
-            boardView->groupBoxesCollection.setHighlightedGroupBoxes(
-                    groupBoxIdOpt.has_value() ? QSet<int> {groupBoxIdOpt.value()} : QSet<int> {});
-
-            // -- set new parent to be applied when moving/resizing finishes
-            boardView->itemMovingResizingStateData.newParentGroupBoxId = groupBoxIdOpt.value_or(-1);
-        }
+        updateSpatialIndex(cardId);
+        boardView->frameUpdateScheduler.markNodeRectMovedOrResized(cardId);
     });
 
     QObject::connect(nodeRect, &NodeRect::finishedMovingOrResizing,
@@ -2294,15 +3566,24 @@ NodeRect *BoardView::NodeRectsCollection::createNodeRect(
             return;
 
         //
+        boardView->frameUpdateScheduler.flush();
         boardView->adjustSceneRect();
 
-        // call AppData -- NodeRect properties
+        // call AppData -- NodeRect properties (together with the co-moving items, if any)
         NodeRectDataUpdate update;
         update.rect = nodeRectPtr->getRect();
 
-        Services::instance()->getAppData()->updateNodeRectProperties(
-                EventSource(boardView),
-                boardView->boardId, nodeRectPtr->getCardId(), update);
+        if (boardView->comovingStateData.getIsActive()) {
+            BoardItemsBulkUpdate bulkUpdate;
+            bulkUpdate.cardIdToNodeRectUpdate.insert(cardId, update);
+            boardView->savePositionsOfComovingItems(boardView->comovingStateData, bulkUpdate);
+            boardView->comovingStateData.deactivate();
+        }
+        else {
+            Services::instance()->getAppData()->updateNodeRectProperties(
+                    EventSource(boardView),
+                    boardView->boardId, nodeRectPtr->getCardId(), update);
+        }
 
         // deactivate `itemMovingResizingStateData`, after necessary actions
         if (boardView->itemMovingResizingStateData.targetIsNodeRect(cardId)) { // should be true
@@ -2366,6 +3647,9 @@ void BoardView::NodeRectsCollection::closeNodeRect(
     if (nodeRect == nullptr)
         return;
     cardIdToNodeRectOwnColor.remove(cardId);
+    boardView->autoEdgeRouting.markBoxRectChanged(boundingRectsIndex.getRect(cardId), QRectF());
+    boundingRectsIndex.remove(cardId);
+    boardView->updateMinimapNodeRect(cardId);
 
     //
     boardView->graphicsScene->removeItem(nodeRect);
@@ -2387,14 +3671,14 @@ void BoardView::NodeRectsCollection::closeNodeRect(
 }
 
 void BoardView::NodeRectsCollection::updateNodeRectPropertiesDisplay(
-        const int cardId, const QSet<QString> &cardLabels,
+        const int cardId, const QSet<Symbol> &cardLabels,
         const QHash<QString, QJsonValue> &cardCustomProperties,
-        const CardPropertiesToShow &effectiveCardPropertiesToShow) {
+        const CardPropertiesToShow::CompiledTable &cardPropertiesToShowTable) {
     if (!cardIdToNodeRect.contains(cardId))
         return;
 
     const QString propertiesDisplay = computeCardPropertiesDisplay(
-            effectiveCardPropertiesToShow, cardLabels, cardCustomProperties);
+            cardPropertiesToShowTable, cardLabels, cardCustomProperties);
     cardIdToNodeRect.value(cardId)->setPropertiesDisplay(propertiesDisplay);
 }
 
@@ -2420,28 +3704,56 @@ QSet<int> BoardView::NodeRectsCollection::addToHighlightedCards(const QSet<int>
 }
 
 void BoardView::NodeRectsCollection::updateAllNodeRectColors() {
+    updateNodeRectColors(keySet(cardIdToNodeRect));
+}
+
+void BoardView::NodeRectsCollection::updateNodeRectColors(const QSet<int> &cardIds) {
     const bool isDarkTheme = Services::instance()->getAppDataReadonly()->getIsDarkTheme();
     const bool autoAdjustCardColorsForDarkTheme
             = Services::instance()->getAppDataReadonly()->getAutoAdjustCardColorsForDarkTheme();
 
-    for (auto it = cardIdToNodeRect.constBegin(); it != cardIdToNodeRect.constEnd(); ++it) {
-        const int cardId = it.key();
-        NodeRect *nodeRect = it.value();
+    for (const int cardId: cardIds) {
+        NodeRect *nodeRect = cardIdToNodeRect.value(cardId);
+        if (nodeRect == nullptr)
+            continue;
 
         const QColor color = computeNodeRectDisplayColor(
                 cardIdToNodeRectOwnColor.value(cardId, QColor()),
-                nodeRect->getNodeLabels(),
-                boardView->cardLabelsAndAssociatedColors, boardView->defaultNodeRectColor,
+                nodeRect->getNodeLabelSymbols(),
+                boardView->cardLabelColorsTable, boardView->defaultNodeRectColor,
                 autoAdjustCardColorsForDarkTheme && isDarkTheme);
         nodeRect->setColor(color);
+        boardView->updateMinimapNodeRect(cardId);
     }
 }
 
+void BoardView::NodeRectsCollection::setNodeRectOwnColor(const int cardId, const QColor &ownColor) {
+    if (cardIdToNodeRect.contains(cardId))
+        cardIdToNodeRectOwnColor.insert(cardId, ownColor);
+}
+
 void BoardView::NodeRectsCollection::setAllNodeRectsTextEditorIgnoreWheelEvent(const bool b) {
     for (auto it = cardIdToNodeRect.constBegin(); it != cardIdToNodeRect.constEnd(); ++it)
         it.value()->setTextEditorIgnoreWheelEvent(b);
 }
 
+void BoardView::NodeRectsCollection::setLevelOfDetailOfAll(const LevelOfDetail lod) {
+    for (auto it = cardIdToNodeRect.constBegin(); it != cardIdToNodeRect.constEnd(); ++it)
+        it.value()->setLevelOfDetail(lod);
+}
+
+void BoardView::NodeRectsCollection::updateContentsMaterialization(
+        const QRectF &materializeRegion, const QRectF &keepRegion) {
+    for (auto it = cardIdToNodeRect.constBegin(); it != cardIdToNodeRect.constEnd(); ++it) {
+        NodeRect *nodeRect = it.value();
+        const QRectF rect = nodeRect->getRect();
+        if (rect.intersects(materializeRegion))
+            nodeRect->setContentsMaterialized(true);
+        else if (!rect.intersects(keepRegion))
+            nodeRect->setContentsMaterialized(false);
+    }
+}
+
 bool BoardView::NodeRectsCollection::contains(const int cardId) const {
     return cardIdToNodeRect.contains(cardId);
 }
@@ -2460,6 +3772,33 @@ QSet<int> BoardView::NodeRectsCollection::getAllCardIds() const {
     return keySet(cardIdToNodeRect);
 }
 
+QSet<int> BoardView::NodeRectsCollection::getCardIdsInRect(const QRectF &rect) const {
+    return boundingRectsIndex.queryContainedIn(rect);
+}
+
+QSet<int> BoardView::NodeRectsCollection::getCardIdsByLabels(
+        std::function<bool (const QSet<Symbol> &)> predicate) const {
+    QSet<int> cardIds;
+    for (auto it = cardIdToNodeRect.constBegin(); it != cardIdToNodeRect.constEnd(); ++it) {
+        if (predicate(it.value()->getNodeLabelSymbols()))
+            cardIds << it.key();
+    }
+    return cardIds;
+}
+
+int BoardView::NodeRectsCollection::getCount() const {
+    return cardIdToNodeRect.count();
+}
+
+int BoardView::NodeRectsCollection::getCountOfMaterialized() const {
+    int count = 0;
+    for (auto it = cardIdToNodeRect.constBegin(); it != cardIdToNodeRect.constEnd(); ++it) {
+        if (it.value()->getContentsMaterialized())
+            ++count;
+    }
+    return count;
+}
+
 QHash<int, QSet<QString> > BoardView::NodeRectsCollection::getCardIdToLabels() const {
     QHash<int, QSet<QString> > cardIdToLabels;
     for (auto it = cardIdToNodeRect.constBegin(); it != cardIdToNodeRect.constEnd(); ++it)
@@ -2472,14 +3811,53 @@ QColor BoardView::NodeRectsCollection::getNodeRectOwnColor(const int cardId) con
 }
 
 QRectF BoardView::NodeRectsCollection::getBoundingRectOfAllNodeRects() const {
-    QRectF result;
-    for (auto it = cardIdToNodeRect.constBegin(); it != cardIdToNodeRect.constEnd(); ++it) {
-        if (result.isNull())
-            result = it.value()->boundingRect();
-        else
-            result = result.united(it.value()->boundingRect());
+    return boundingRectsIndex.boundingRect();
+}
+
+void BoardView::NodeRectsCollection::updateSpatialIndex(const int cardId) {
+    NodeRect *nodeRect = cardIdToNodeRect.value(cardId);
+    if (nodeRect == nullptr)
+        return;
+    boardView->autoEdgeRouting.markBoxRectChanged(
+            boundingRectsIndex.getRect(cardId), nodeRect->boundingRect());
+    boundingRectsIndex.set(cardId, nodeRect->boundingRect());
+    boardView->updateMinimapNodeRect(cardId);
+}
+
+void BoardView::NodeRectsCollection::applyMovedOrResized(const int cardId) {
+    NodeRect *nodeRect = cardIdToNodeRect.value(cardId);
+    if (nodeRect == nullptr)
+        return;
+
+    boardView->relationshipBundlesCollection.updateBundlesConnectingNodeRect(cardId);
+
+    // update edge arrows
+    const QSet<RelationshipId> relIds = boardView->getEdgeArrowsConnectingNodeRect(cardId);
+    for (const auto &relId: relIds) {
+        constexpr bool updateOtherEdgeArrows = false;
+        boardView->relationshipsCollection.updateEdgeArrow(relId, updateOtherEdgeArrows);
+    }
+
+    // move the selected items along (they keep their parent group-boxes)
+    if (boardView->comovingStateData.isMovingSelection) {
+        const QPointF displacement
+                = nodeRect->getRect().topLeft() - boardView->comovingStateData.followeeInitialPos;
+        boardView->moveFollowerItemsInComovingState(displacement, boardView->comovingStateData);
+        return;
+    }
+
+    // can be added to a group-box?
+    {
+        const std::optional<int> groupBoxIdOpt
+                = boardView->groupBoxesCollection.getDeepestEnclosingGroupBox(nodeRect);
+
+        // -- highlight only the group-box
+        boardView->groupBoxesCollection.setHighlightedGroupBoxes(
+                groupBoxIdOpt.has_value() ? QSet<int> {groupBoxIdOpt.value()} : QSet<int> {});
+
+        // -- set new parent to be applied when moving/resizing finishes
+        boardView->itemMovingResizingStateData.newParentGroupBoxId = groupBoxIdOpt.value_or(-1);
     }
-    return result;
 }
 
 //====
@@ -2493,8 +3871,12 @@ EdgeArrow *BoardView::RelationshipsCollection::createEdgeArrow(
     auto *edgeArrow = new EdgeArrow(boardView->canvas);
     relIdToEdgeArrow.insert(relId, edgeArrow);
     cardIdPairToParallelRels[QSet<int> {relId.startCardId, relId.endCardId}] << relId;
+    cardIdToRels[relId.startCardId] << relId;
+    cardIdToRels[relId.endCardId] << relId;
 
     edgeArrow->setZValue(zValueForEdgeArrows);
+    edgeArrow->setLevelOfDetail(boardView->levelOfDetail);
+    edgeArrow->setProfilingEnabled(RenderingProfiler::instance()->isEnabled());
 
     edgeArrow->setLineWidth(edgeArrowData.lineWidth);
     edgeArrow->setLineColor(edgeArrowData.lineColor);
@@ -2506,6 +3888,8 @@ EdgeArrow *BoardView::RelationshipsCollection::createEdgeArrow(
     constexpr bool updateOtherEdgeArrows = true;
     updateEdgeArrow(relId, updateOtherEdgeArrows);
 
+    boardView->autoEdgeRouting.markRelationshipsChanged({relId});
+
     // connections
     QPointer<EdgeArrow> edgeArrowPtr(edgeArrow);
 
@@ -2515,6 +3899,8 @@ EdgeArrow *BoardView::RelationshipsCollection::createEdgeArrow(
             return;
 
         //
+        boardView->autoEdgeRouting.onJointsSetByUser(relId);
+
         constexpr bool updateOtherEdgeArrows = true;
         updateEdgeArrow(relId, updateOtherEdgeArrows);
 
@@ -2579,12 +3965,30 @@ void BoardView::RelationshipsCollection::removeEdgeArrows(const QSet<Relationshi
         cardIdPairToParallelRels[cardIdPair].remove(relId);
         if (cardIdPairToParallelRels[cardIdPair].isEmpty())
             cardIdPairToParallelRels.remove(cardIdPair);
+
+        for (const int cardId: cardIdPair) {
+            auto it = cardIdToRels.find(cardId);
+            if (it == cardIdToRels.end())
+                continue;
+            it.value().remove(relId);
+            if (it.value().isEmpty())
+                cardIdToRels.erase(it);
+        }
     }
+
+    boardView->autoEdgeRouting.markRelationshipsChanged(relIds);
 }
 
-void BoardView::RelationshipsCollection::setAllEdgeArrowsVisible() {
-    for (auto it = relIdToEdgeArrow.constBegin(); it != relIdToEdgeArrow.constEnd(); ++it)
-        it.value()->setVisible(true);
+void BoardView::RelationshipsCollection::setJoints(
+        const RelationshipId &relId, const QVector<QPointF> &joints) {
+    EdgeArrow *edgeArrow = relIdToEdgeArrow.value(relId);
+    if (edgeArrow == nullptr)
+        return;
+
+    edgeArrow->setJoints(joints);
+
+    constexpr bool updateOtherEdgeArrows = true;
+    updateEdgeArrow(relId, updateOtherEdgeArrows);
 }
 
 void BoardView::RelationshipsCollection::setLineColorAndLabelColorOfAllEdgeArrows(
@@ -2595,6 +3999,20 @@ void BoardView::RelationshipsCollection::setLineColorAndLabelColorOfAllEdgeArrow
     }
 }
 
+void BoardView::RelationshipsCollection::setLevelOfDetailOfAll(const LevelOfDetail lod) {
+    for (auto it = relIdToEdgeArrow.constBegin(); it != relIdToEdgeArrow.constEnd(); ++it)
+        it.value()->setLevelOfDetail(lod);
+}
+
+void BoardView::RelationshipsCollection::setEdgeArrowsVisible(
+        const QSet<RelationshipId> &relIds) {
+    for (const auto &rel: relIds) {
+        EdgeArrow *edgeArrow = relIdToEdgeArrow.value(rel);
+        if (edgeArrow != nullptr)
+            edgeArrow->setVisible(true);
+    }
+}
+
 void BoardView::RelationshipsCollection::hideEdgeArrows(const QSet<RelationshipId> &relIds) {
     for (const auto &rel: relIds) {
         EdgeArrow *edgeArrow = relIdToEdgeArrow.value(rel);
@@ -2607,10 +4025,31 @@ QSet<RelationshipId> BoardView::RelationshipsCollection::getAllRelationshipIds()
     return keySet(relIdToEdgeArrow);
 }
 
+bool BoardView::RelationshipsCollection::contains(const RelationshipId &relId) const {
+    return relIdToEdgeArrow.contains(relId);
+}
+
+int BoardView::RelationshipsCollection::getCount() const {
+    return relIdToEdgeArrow.count();
+}
+
+QSet<RelationshipId> BoardView::RelationshipsCollection::getRelationshipsConnectingCard(
+        const int cardId) const {
+    return cardIdToRels.value(cardId);
+}
+
+QVector<QPointF> BoardView::RelationshipsCollection::getJoints(
+        const RelationshipId &relId) const {
+    EdgeArrow *edgeArrow = relIdToEdgeArrow.value(relId);
+    return (edgeArrow != nullptr) ? edgeArrow->getJoints() : QVector<QPointF> {};
+}
+
 QHash<RelationshipId, QVector<QPointF>>
 BoardView::RelationshipsCollection::getRelIdToJoints() const {
     QHash<RelationshipId, QVector<QPointF>> relIdToJoints;
     for (auto it = relIdToEdgeArrow.constBegin(); it != relIdToEdgeArrow.constEnd(); ++it) {
+        if (boardView->autoEdgeRouting.isAutoRouted(it.key()))
+            continue;
         const auto joints = it.value()->getJoints();
         if (!joints.isEmpty())
             relIdToJoints.insert(it.key(), joints);
@@ -2662,20 +4101,7 @@ void BoardView::RelationshipsCollection::updateSingleEdgeArrow(
     }
 
     //
-    edgeArrow->setLabel(relId.type);
-}
-
-QVector<RelationshipId> BoardView::RelationshipsCollection::sortRelationshipIds(
-        const QSet<RelationshipId> relIds) {
-    QVector<RelationshipId> result(relIds.constBegin(), relIds.constEnd());
-    std::sort(
-            result.begin(), result.end(),
-            [](const RelationshipId &a, const RelationshipId &b) ->bool {
-                return std::tie(a.startCardId, a.endCardId, a.type)
-                        < std::tie(b.startCardId, b.endCardId, b.type);
-            }
-    );
-    return result;
+    edgeArrow->setLabel(relId.type.toString());
 }
 
 QLineF BoardView::RelationshipsCollection::computeEdgeArrowLineWithoutJoint(
@@ -2696,39 +4122,18 @@ QLineF BoardView::RelationshipsCollection::computeEdgeArrowLineWithoutJoint(
 std::pair<QPointF, QPointF>
 BoardView::RelationshipsCollection::computeEndpointsOfEdgeArrowWithJoint(
         const RelationshipId &relId, const QPointF &firstJoint, const QPointF &lastJoint) {
-    QPointF startPoint;
-    {
-        const auto rectOfStartNodeRectOpt
-                = boardView->nodeRectsCollection.getNodeRectRect(relId.startCardId);
-        Q_ASSERT(rectOfStartNodeRectOpt.has_value());
-
-        const QLineF line(rectOfStartNodeRectOpt.value().center(), firstJoint);
-        QPointF intersectionPoint;
-        const bool intersects = rectEdgeIntersectsWithLine(
-                rectOfStartNodeRectOpt.value(), line, &intersectionPoint);
-        if (intersects)
-            startPoint = intersectionPoint;
-        else
-            startPoint = rectOfStartNodeRectOpt.value().center();
-    }
+    const auto rectOfStartNodeRectOpt
+            = boardView->nodeRectsCollection.getNodeRectRect(relId.startCardId);
+    Q_ASSERT(rectOfStartNodeRectOpt.has_value());
 
-    QPointF endPoint;
-    {
-        const auto rectOfEndNodeRectOpt
-                = boardView->nodeRectsCollection.getNodeRectRect(relId.endCardId);
-        Q_ASSERT(rectOfEndNodeRectOpt.has_value());
-
-        const QLineF line(rectOfEndNodeRectOpt.value().center(), lastJoint);
-        QPointF intersectionPoint;
-        const bool intersects = rectEdgeIntersectsWithLine(
-                rectOfEndNodeRectOpt.value(), line, &intersectionPoint);
-        if (intersects)
-            endPoint = intersectionPoint;
-        else
-            endPoint = rectOfEndNodeRectOpt.value().center();
-    }
+    const auto rectOfEndNodeRectOpt
+            = boardView->nodeRectsCollection.getNodeRectRect(relId.endCardId);
+    Q_ASSERT(rectOfEndNodeRectOpt.has_value());
 
-    return {startPoint, endPoint};
+    return {
+        computeLineEndOnRectEdge(rectOfStartNodeRectOpt.value(), firstJoint),
+        computeLineEndOnRectEdge(rectOfEndNodeRectOpt.value(), lastJoint)
+    };
 }
 
 DataViewBox *BoardView::DataViewBoxesCollection::createDataViewBox(
@@ -2741,15 +4146,50 @@ DataViewBox *BoardView::DataViewBoxesCollection::createDataViewBox(
     customDataQueryIdToDataViewBoxOwnColor.insert(customDataQueryId, dataViewBoxOwnColor);
     box->setZValue(zValueForNodeRects);
     box->initialize();
+    box->setLevelOfDetail(boardView->levelOfDetail);
 
     box->setTitle(customDataQueryData.title);
     box->setQuery(customDataQueryData.queryCypher, customDataQueryData.queryParameters);
     box->setRect(rect);
     box->setColor(displayColor);
+    boundingRectsIndex.set(customDataQueryId, box->boundingRect());
 
     // set up connections
     QPointer<DataViewBox> boxPtr(box);
 
+    QObject::connect(box, &DataViewBox::leftButtonPressedOrClicked, boardView, [this, boxPtr]() {
+        if (!boxPtr)
+            return;
+        if (!boardView->selection.customDataQueryIds.contains(boxPtr->getCustomDataQueryId()))
+            boardView->clearSelection();
+    });
+
+    QObject::connect(
+            box, &DataViewBox::aboutToMove, boardView, [this, customDataQueryId, boxPtr]() {
+        if (!boxPtr)
+            return;
+
+        // enter co-moving state if the DataViewBox is selected, let the other selected items
+        // follow the move
+        const auto &selection = boardView->selection;
+        if (selection.customDataQueryIds.contains(customDataQueryId) && selection.count() > 1) {
+            boardView->activateComovingWithSelection();
+            boardView->comovingStateData.followerCustomDataQueryIdToInitialPos
+                    .remove(customDataQueryId);
+            boardView->comovingStateData.followeeInitialPos = boxPtr->getRect().topLeft();
+        }
+    });
+
+    QObject::connect(
+            box, &DataViewBox::movedOrResized, boardView, [this, customDataQueryId, boxPtr]() {
+        if (!boxPtr)
+            return;
+
+        updateSpatialIndex(customDataQueryId);
+        if (boardView->comovingStateData.getIsActive())
+            boardView->frameUpdateScheduler.markDataViewBoxMovedOrResized(customDataQueryId);
+    });
+
     QObject::connect(
             box, &DataViewBox::getCardIdsOfBoard, boardView, [this](QSet<int> *cardIds) {
         *cardIds = boardView->nodeRectsCollection.getAllCardIds();
@@ -2791,15 +4231,25 @@ DataViewBox *BoardView::DataViewBoxesCollection::createDataViewBox(
             return;
 
         //
+        boardView->frameUpdateScheduler.flush();
         boardView->adjustSceneRect();
 
-        // call AppData
+        // call AppData (together with the co-moving items, if any)
         DataViewBoxDataUpdate update;
         update.rect = boxPtr->getRect();
 
-        Services::instance()->getAppData()->updateDataViewBoxProperties(
-                EventSource(boardView),
-                boardView->boardId, boxPtr->getCustomDataQueryId(), update);
+        if (boardView->comovingStateData.getIsActive()) {
+            BoardItemsBulkUpdate bulkUpdate;
+            bulkUpdate.customDataQueryIdToDataViewBoxUpdate.insert(
+                    boxPtr->getCustomDataQueryId(), update);
+            boardView->savePositionsOfComovingItems(boardView->comovingStateData, bulkUpdate);
+            boardView->comovingStateData.deactivate();
+        }
+        else {
+            Services::instance()->getAppData()->updateDataViewBoxProperties(
+                    EventSource(boardView),
+                    boardView->boardId, boxPtr->getCustomDataQueryId(), update);
+        }
     });
 
     QObject::connect(box, &DataViewBox::closeByUser, boardView, [this, boxPtr]() {
@@ -2816,16 +4266,45 @@ void BoardView::DataViewBoxesCollection::closeDataViewBox(const int customDataQu
     DataViewBox *box = customDataQueryIdToDataViewBox.take(customDataQueryId);
     if (box == nullptr)
         return;
-    customDataQueryIdToDataViewBoxOwnColor.remove(customDataQueryId);
-
-    //
-    boardView->graphicsScene->removeItem(box);
-    box->deleteLater();
+    customDataQueryIdToDataViewBoxOwnColor.remove(customDataQueryId);
+    boundingRectsIndex.remove(customDataQueryId);
+
+    //
+    boardView->graphicsScene->removeItem(box);
+    box->deleteLater();
+
+    //
+    boardView->graphicsScene->invalidate(QRectF(), QGraphicsScene::BackgroundLayer);
+    // This is to deal with the QGraphicsView problem
+    // https://forum.qt.io/topic/157478/qgraphicsscene-incorrect-artifacts-on-scrolling-bug
+}
+
+void BoardView::DataViewBoxesCollection::updateDataViewBox(
+        const int customDataQueryId, const CustomDataQuery &customDataQueryData) {
+    DataViewBox *box = customDataQueryIdToDataViewBox.value(customDataQueryId);
+    if (box == nullptr)
+        return;
+
+    box->setTitle(customDataQueryData.title);
+    box->setQuery(customDataQueryData.queryCypher, customDataQueryData.queryParameters);
+}
+
+void BoardView::DataViewBoxesCollection::setHighlightedDataViewBoxes(
+        const QSet<int> &customDataQueryIds) {
+    for (auto it = customDataQueryIdToDataViewBox.constBegin();
+            it != customDataQueryIdToDataViewBox.constEnd(); ++it) {
+        it.value()->setIsHighlighted(customDataQueryIds.contains(it.key()));
+    }
+}
+
+void BoardView::DataViewBoxesCollection::setDataViewBoxOwnColor(
+        const int customDataQueryId, const QColor &ownColor) {
+    DataViewBox *box = customDataQueryIdToDataViewBox.value(customDataQueryId);
+    if (box == nullptr)
+        return;
 
-    //
-    boardView->graphicsScene->invalidate(QRectF(), QGraphicsScene::BackgroundLayer);
-    // This is to deal with the QGraphicsView problem
-    // https://forum.qt.io/topic/157478/qgraphicsscene-incorrect-artifacts-on-scrolling-bug
+    customDataQueryIdToDataViewBoxOwnColor.insert(customDataQueryId, ownColor);
+    box->setColor(computeDataViewBoxDisplayColor(ownColor, QColor()));
 }
 
 void BoardView::DataViewBoxesCollection::setAllDataViewBoxesTextEditorIgnoreWheelEvent(
@@ -2836,24 +4315,51 @@ void BoardView::DataViewBoxesCollection::setAllDataViewBoxesTextEditorIgnoreWhee
     }
 }
 
+void BoardView::DataViewBoxesCollection::setLevelOfDetailOfAll(const LevelOfDetail lod) {
+    for (auto it = customDataQueryIdToDataViewBox.constBegin();
+            it != customDataQueryIdToDataViewBox.constEnd(); ++it) {
+        it.value()->setLevelOfDetail(lod);
+    }
+}
+
 bool BoardView::DataViewBoxesCollection::contains(const int customDataQueryId) const {
     return customDataQueryIdToDataViewBox.contains(customDataQueryId);
 }
 
+DataViewBox *BoardView::DataViewBoxesCollection::get(const int customDataQueryId) const {
+    return customDataQueryIdToDataViewBox.value(customDataQueryId);
+}
+
 QSet<int> BoardView::DataViewBoxesCollection::getAllCustomDataQueryIds() const {
     return keySet(customDataQueryIdToDataViewBox);
 }
 
+QSet<int> BoardView::DataViewBoxesCollection::getCustomDataQueryIdsInRect(
+        const QRectF &rect) const {
+    return boundingRectsIndex.queryContainedIn(rect);
+}
+
 QRectF BoardView::DataViewBoxesCollection::getBoundingRectOfAllDataViewBoxes() const {
-    QRectF result;
-    for (auto it = customDataQueryIdToDataViewBox.constBegin();
-            it != customDataQueryIdToDataViewBox.constEnd(); ++it) {
-        if (result.isNull())
-            result = it.value()->boundingRect();
-        else
-            result = result.united(it.value()->boundingRect());
+    return boundingRectsIndex.boundingRect();
+}
+
+void BoardView::DataViewBoxesCollection::updateSpatialIndex(const int customDataQueryId) {
+    DataViewBox *box = customDataQueryIdToDataViewBox.value(customDataQueryId);
+    if (box == nullptr)
+        return;
+    boundingRectsIndex.set(customDataQueryId, box->boundingRect());
+}
+
+void BoardView::DataViewBoxesCollection::applyMovedOrResized(const int customDataQueryId) {
+    DataViewBox *box = customDataQueryIdToDataViewBox.value(customDataQueryId);
+    if (box == nullptr)
+        return;
+
+    if (boardView->comovingStateData.getIsActive()) {
+        const QPointF displacement
+                = box->getRect().topLeft() - boardView->comovingStateData.followeeInitialPos;
+        boardView->moveFollowerItemsInComovingState(displacement, boardView->comovingStateData);
     }
-    return result;
 }
 
 //====
@@ -2867,13 +4373,17 @@ GroupBox *BoardView::GroupBoxesCollection::createGroupBox(
     groupBoxes.insert(groupBoxId, groupBox);
     groupBox->setZValue(zValueForNodeRects);
     groupBox->initialize();
+    groupBox->setLevelOfDetail(boardView->levelOfDetail);
 
     groupBox->setTitle(groupBoxData.title);
     groupBox->setRect(groupBoxData.rect);
     groupBox->setBorderWidth(3);
+    boundingRectsIndex.set(groupBoxId, groupBox->boundingRect());
+    boardView->autoEdgeRouting.markBoxRectChanged(QRectF(), groupBox->boundingRect());
 
     const bool isDarkTheme = Services::instance()->getAppDataReadonly()->getIsDarkTheme();
     groupBox->setColor(computeGroupBoxColor(isDarkTheme));
+    boardView->updateMinimapGroupBox(groupBoxId);
 
     // set up connections
     QPointer<GroupBox> groupBoxPtr(groupBox);
@@ -2883,6 +4393,10 @@ GroupBox *BoardView::GroupBoxesCollection::createGroupBox(
         if (!groupBoxPtr)
             return;
 
+        if (boardView->selection.groupBoxIds.contains(groupBoxId))
+            return; // (keep the selection, which may be moved)
+        boardView->clearSelection();
+
         constexpr bool unhighlightOtherItems = true;
         highlightGroupBoxAndDescendants(groupBoxId, unhighlightOtherItems);
     });
@@ -2899,7 +4413,16 @@ GroupBox *BoardView::GroupBoxesCollection::createGroupBox(
         boardView->itemMovingResizingStateData.activateWithTargetGroupBox(
                 groupBoxId, descendantGroupBoxes, descendantCards);
 
-        // enter co-moving state, let all descendants follow the move
+        // enter co-moving state, let all the other selected items (if the group-box is
+        // selected) or all descendants follow the move
+        const auto &selection = boardView->selection;
+        if (selection.groupBoxIds.contains(groupBoxId) && selection.count() > 1) {
+            boardView->activateComovingWithSelection();
+            boardView->comovingStateData.followerGroupBoxIdToInitialPos.remove(groupBoxId);
+            boardView->comovingStateData.followeeInitialPos = groupBoxPtr->getRect().topLeft();
+            return;
+        }
+
         boardView->comovingStateData.activate();
         boardView->comovingStateData.clearFollowers();
         for (const int groupBoxId: descendantGroupBoxes) {
@@ -2961,40 +4484,8 @@ GroupBox *BoardView::GroupBoxesCollection::createGroupBox(
         if (!groupBoxPtr)
             return;
 
-        boardView->relationshipBundlesCollection.updateBundlesConnectingGroupBox(groupBoxId);
-
-        // can be added to a group-box?
-        {
-            const auto groupBoxesBeingMoved
-                    = boardView->itemMovingResizingStateData.descendantGroupBoxesOfTargetGroupBox
-                      + QSet<int> {groupBoxId};
-            const std::optional<int> addToGroupBoxIdOpt = getDeepestEnclosingGroupBox(
-                    groupBoxPtr.data(),
-                    groupBoxesBeingMoved // groupBoxIdsToExclude
-            );
-
-            // -- highlight `addToGroupBoxIdOpt`, unhighlight other group-boxes except
-            //    `groupBoxesBeingMoved`
-            if (addToGroupBoxIdOpt.has_value())
-                addToHighlightedGroupBoxes({addToGroupBoxIdOpt.value()});
-
-            QSet<int> groupBoxesToUnhighlight = keySet(groupBoxes) - groupBoxesBeingMoved;
-            if (addToGroupBoxIdOpt.has_value())
-                groupBoxesToUnhighlight.remove(addToGroupBoxIdOpt.value());
-            unhighlightGroupBoxes(groupBoxesToUnhighlight);
-
-            // -- set new parent to be applied when moving/resizing finishes
-            boardView->itemMovingResizingStateData.newParentGroupBoxId
-                    = addToGroupBoxIdOpt.value_or(-1);
-        }
-
-        //
-        if (boardView->comovingStateData.getIsActive()) {
-            const QPointF displacement
-                    = groupBoxPtr->getRect().topLeft()
-                      - boardView->comovingStateData.followeeInitialPos;
-            boardView->moveFollowerItemsInComovingState(displacement, boardView->comovingStateData);
-        }
+        updateSpatialIndex(groupBoxId);
+        boardView->frameUpdateScheduler.markGroupBoxMovedOrResized(groupBoxId);
     });
 
     QObject::connect(
@@ -3004,20 +4495,24 @@ GroupBox *BoardView::GroupBoxesCollection::createGroupBox(
             return;
 
         //
+        boardView->frameUpdateScheduler.flush();
         boardView->adjustSceneRect();
 
-        // save properties of `groupBoxId`
+        // save properties of `groupBoxId` (together with the positions of co-moving items, if
+        // any, and deactivate `comovingStateData`)
         GroupBoxNodePropertiesUpdate update;
         update.rect = groupBoxPtr->getRect();
 
-        Services::instance()->getAppData()->updateGroupBoxProperties(
-                EventSource(boardView), groupBoxId, update);
-
-        // save position of co-moving items and deactivate `comovingStateData`
         if (boardView->comovingStateData.getIsActive()) {
-            boardView->savePositionsOfComovingItems(boardView->comovingStateData);
+            BoardItemsBulkUpdate bulkUpdate;
+            bulkUpdate.groupBoxIdToUpdate.insert(groupBoxId, update);
+            boardView->savePositionsOfComovingItems(boardView->comovingStateData, bulkUpdate);
             boardView->comovingStateData.deactivate();
         }
+        else {
+            Services::instance()->getAppData()->updateGroupBoxProperties(
+                    EventSource(boardView), groupBoxId, update);
+        }
 
         // deactivate `itemMovingResizingStateData`, after necessary actions
         if (boardView->itemMovingResizingStateData.targetIsGroupBox(groupBoxId)) { // should be true
@@ -3065,6 +4560,10 @@ void BoardView::GroupBoxesCollection::removeGroupBox(const int groupBoxId) {
     GroupBox *groupBox = groupBoxes.take(groupBoxId);
     if (groupBox == nullptr)
         return;
+    boardView->autoEdgeRouting.markBoxRectChanged(
+            boundingRectsIndex.getRect(groupBoxId), QRectF());
+    boundingRectsIndex.remove(groupBoxId);
+    boardView->updateMinimapGroupBox(groupBoxId);
 
     //
     boardView->graphicsScene->removeItem(groupBox);
@@ -3096,8 +4595,15 @@ void BoardView::GroupBoxesCollection::unhighlightGroupBoxes(const QSet<int> &gro
 }
 
 void BoardView::GroupBoxesCollection::setColorOfAllGroupBoxes(const QColor &color) {
-    for (auto it = groupBoxes.constBegin(); it != groupBoxes.constEnd(); ++it)
+    for (auto it = groupBoxes.constBegin(); it != groupBoxes.constEnd(); ++it) {
         it.value()->setColor(color);
+        boardView->updateMinimapGroupBox(it.key());
+    }
+}
+
+void BoardView::GroupBoxesCollection::setLevelOfDetailOfAll(const LevelOfDetail lod) {
+    for (auto it = groupBoxes.constBegin(); it != groupBoxes.constEnd(); ++it)
+        it.value()->setLevelOfDetail(lod);
 }
 
 GroupBox *BoardView::GroupBoxesCollection::get(const int groupBoxId) {
@@ -3108,15 +4614,12 @@ QSet<int> BoardView::GroupBoxesCollection::getAllGroupBoxIds() const {
     return keySet(groupBoxes);
 }
 
+QSet<int> BoardView::GroupBoxesCollection::getGroupBoxIdsInRect(const QRectF &rect) const {
+    return boundingRectsIndex.queryContainedIn(rect);
+}
+
 QRectF BoardView::GroupBoxesCollection::getBoundingRectOfAllGroupBoxes() const {
-    QRectF result;
-    for (auto it = groupBoxes.constBegin(); it != groupBoxes.constEnd(); ++it) {
-        if (result.isNull())
-            result = it.value()->boundingRect();
-        else
-            result = result.united(it.value()->boundingRect());
-    }
-    return result;
+    return boundingRectsIndex.boundingRect();
 }
 
 std::optional<int> BoardView::GroupBoxesCollection::getDeepestEnclosingGroupBox(
@@ -3124,13 +4627,15 @@ std::optional<int> BoardView::GroupBoxesCollection::getDeepestEnclosingGroupBox(
     const QRectF rect = boardBoxItem->boundingRect();
 
     // find group-boxes whose contents rects enclose `rect`, excluding `groupBoxIdToExclude`
+    // (the contents rect of a group-box is within its bounding rect)
     QSet<int> enclosingGroupBoxes;
-    for (auto it = groupBoxes.constBegin(); it != groupBoxes.constEnd(); ++it) {
-        if (groupBoxIdsToExclude.contains(it.key()))
+    const QSet<int> candidates = boundingRectsIndex.queryContaining(rect);
+    for (const int groupBoxId: candidates) {
+        if (groupBoxIdsToExclude.contains(groupBoxId))
             continue;
-        GroupBox *const &groupBox = it.value();
-        if (groupBox->getContentsRect().contains(rect))
-            enclosingGroupBoxes << it.key();
+        GroupBox *groupBox = groupBoxes.value(groupBoxId);
+        if (groupBox != nullptr && groupBox->getContentsRect().contains(rect))
+            enclosingGroupBoxes << groupBoxId;
     }
 
     if (enclosingGroupBoxes.isEmpty())
@@ -3148,6 +4653,57 @@ std::optional<int> BoardView::GroupBoxesCollection::getDeepestEnclosingGroupBox(
     return deepestGroupBox;
 }
 
+void BoardView::GroupBoxesCollection::updateSpatialIndex(const int groupBoxId) {
+    GroupBox *groupBox = groupBoxes.value(groupBoxId);
+    if (groupBox == nullptr)
+        return;
+    boardView->autoEdgeRouting.markBoxRectChanged(
+            boundingRectsIndex.getRect(groupBoxId), groupBox->boundingRect());
+    boundingRectsIndex.set(groupBoxId, groupBox->boundingRect());
+    boardView->updateMinimapGroupBox(groupBoxId);
+}
+
+void BoardView::GroupBoxesCollection::applyMovedOrResized(const int groupBoxId) {
+    GroupBox *groupBox = groupBoxes.value(groupBoxId);
+    if (groupBox == nullptr)
+        return;
+
+    boardView->relationshipBundlesCollection.updateBundlesConnectingGroupBox(groupBoxId);
+
+    // can be added to a group-box? (not if moving the selected items, which keep their parents)
+    if (!boardView->comovingStateData.isMovingSelection) {
+        const auto groupBoxesBeingMoved
+                = boardView->itemMovingResizingStateData.descendantGroupBoxesOfTargetGroupBox
+                  + QSet<int> {groupBoxId};
+        const std::optional<int> addToGroupBoxIdOpt = getDeepestEnclosingGroupBox(
+                groupBox,
+                groupBoxesBeingMoved // groupBoxIdsToExclude
+        );
+
+        // -- highlight `addToGroupBoxIdOpt`, unhighlight other group-boxes except
+        //    `groupBoxesBeingMoved`
+        if (addToGroupBoxIdOpt.has_value())
+            addToHighlightedGroupBoxes({addToGroupBoxIdOpt.value()});
+
+        QSet<int> groupBoxesToUnhighlight = keySet(groupBoxes) - groupBoxesBeingMoved;
+        if (addToGroupBoxIdOpt.has_value())
+            groupBoxesToUnhighlight.remove(addToGroupBoxIdOpt.value());
+        unhighlightGroupBoxes(groupBoxesToUnhighlight);
+
+        // -- set new parent to be applied when moving/resizing finishes
+        boardView->itemMovingResizingStateData.newParentGroupBoxId
+                = addToGroupBoxIdOpt.value_or(-1);
+    }
+
+    //
+    if (boardView->comovingStateData.getIsActive()) {
+        const QPointF displacement
+                = groupBox->getRect().topLeft()
+                  - boardView->comovingStateData.followeeInitialPos;
+        boardView->moveFollowerItemsInComovingState(displacement, boardView->comovingStateData);
+    }
+}
+
 void BoardView::GroupBoxesCollection::highlightGroupBoxAndDescendants(
         const int groupBoxIdToHighlight, const bool unhlighlightOtherItems) {
     // highlight `groupBoxId` & all its descendants
@@ -3186,135 +4742,368 @@ void BoardView::ComovingStateData::activate() {
 
 void BoardView::ComovingStateData::deactivate() {
     isActive = false;
+    isMovingSelection = false;
     clearFollowers();
 }
 
 //======
 
-void BoardView::RelationshipBundlesCollection::update() {
-    relBundlesByGroupBoxId.clear();
+BoardView::FrameUpdateScheduler::FrameUpdateScheduler(BoardView *boardView)
+        : boardView(boardView)
+        , timer(new QTimer(boardView)) {
+    timer->setSingleShot(true);
+    timer->setInterval(frameIntervalMsec);
+    QObject::connect(timer, &QTimer::timeout, boardView, [this]() {
+        flush();
+    });
+}
 
-    //
-    QVector<int> groupBoxIdsFromDFS;
-    const QHash<int, QSet<int>> groupBoxIdToDescendantCards
-            = boardView->groupBoxTree.getDescendantCardsOfEveryGroupBox(&groupBoxIdsFromDFS);
+void BoardView::FrameUpdateScheduler::markNodeRectMovedOrResized(const int cardId) {
+    movedNodeRects << cardId;
+    schedule();
+}
 
-    // consider every group-box in a topological order (predecessor first)
-    QHash<int, QSet<RelationshipId>> cardIdToBundledRels;
+void BoardView::FrameUpdateScheduler::markGroupBoxMovedOrResized(const int groupBoxId) {
+    movedGroupBoxes << groupBoxId;
+    schedule();
+}
 
-    for (const int groupBoxId: qAsConst(groupBoxIdsFromDFS)) {
-        const QSet<int> cardsWithin = groupBoxIdToDescendantCards.value(groupBoxId);
+void BoardView::FrameUpdateScheduler::markDataViewBoxMovedOrResized(
+        const int customDataQueryId) {
+    movedDataViewBoxes << customDataQueryId;
+    schedule();
+}
 
-        // For every card in `cardsWithin`, find the set of possible bundles as if the group
-        // contains only that card, not considering the already-bundled relationships.
-        // Then take the intersection of the obtained bundle sets.
-        QSet<RelationshipsBundle> bundlesOfGroup;
+void BoardView::FrameUpdateScheduler::flush() {
+    timer->stop();
 
-        for (auto it = cardsWithin.constBegin(); it != cardsWithin.constEnd(); ++it) {
-            const int cardId = *it;
-            // get all possible bundles as if the group contains only this card, not considering
-            // the already-bundled relationships
-            QSet<RelationshipsBundle> possibleBundles1;
+    const QSet<int> groupBoxIds = movedGroupBoxes;
+    const QSet<int> cardIds = movedNodeRects;
+    const QSet<int> customDataQueryIds = movedDataViewBoxes;
+    movedGroupBoxes.clear();
+    movedNodeRects.clear();
+    movedDataViewBoxes.clear();
 
-            const auto allRels = boardView->relationshipsCollection.getAllRelationshipIds();
-            for (const RelationshipId &rel: allRels) {
-                if (cardIdToBundledRels.value(cardId).contains(rel)) // relationship already bundled
-                    continue;
+    for (const int groupBoxId: groupBoxIds)
+        boardView->groupBoxesCollection.applyMovedOrResized(groupBoxId);
+    for (const int cardId: cardIds)
+        boardView->nodeRectsCollection.applyMovedOrResized(cardId);
+    for (const int customDataQueryId: customDataQueryIds)
+        boardView->dataViewBoxesCollection.applyMovedOrResized(customDataQueryId);
+}
 
-                int theOtherCard;
-                const bool connectsThisCard = rel.connectsCard(cardId, &theOtherCard);
-                if (!connectsThisCard)
-                    continue;
+void BoardView::FrameUpdateScheduler::cancel() {
+    timer->stop();
+    movedGroupBoxes.clear();
+    movedNodeRects.clear();
+    movedDataViewBoxes.clear();
+}
 
-                if (cardsWithin.contains(theOtherCard)) // `theOtherCard` is not external card
-                    continue;
+void BoardView::FrameUpdateScheduler::schedule() {
+    // (The first change in a frame starts the timer. The changes that follow within the frame
+    // are applied together.)
+    if (!timer->isActive())
+        timer->start();
+}
 
-                RelationshipsBundle bundle;
-                {
-                    bundle.groupBoxId = groupBoxId;
-                    bundle.externalCardId = theOtherCard;
-                    bundle.relationshipType = rel.type;
-                    bundle.direction = (cardId == rel.startCardId)
-                            ? RelationshipsBundle::Direction::OutFromGroup
-                            : RelationshipsBundle::Direction::IntoGroup;
-                }
-                possibleBundles1 << bundle;
-            }
+//======
 
-            //
-            if (it == cardsWithin.constBegin()) {
-                if (possibleBundles1.isEmpty())
-                    break;
-                bundlesOfGroup = possibleBundles1;
-            }
-            else {
-                bundlesOfGroup &= possibleBundles1;
-                if (bundlesOfGroup.isEmpty())
-                    break;
-            }
+BoardView::AutoEdgeRouting::AutoEdgeRouting(BoardView *boardView)
+        : boardView(boardView)
+        , timer(new QTimer(boardView)) {
+    timer->setSingleShot(true);
+    timer->setInterval(delayMsec);
+    QObject::connect(timer, &QTimer::timeout, boardView, [this]() {
+        startRouting();
+    });
+}
+
+void BoardView::AutoEdgeRouting::setEnabled(const bool enabled_) {
+    if (enabled_ == enabled)
+        return;
+    enabled = enabled_;
+
+    if (enabled) {
+        relsToRoute = boardView->relationshipsCollection.getAllRelationshipIds();
+        schedule();
+    }
+    else {
+        const QSet<RelationshipId> routedRels = autoRoutedRels;
+        clear();
+        for (const RelationshipId &relId: routedRels)
+            boardView->relationshipsCollection.setJoints(relId, {});
+    }
+}
+
+bool BoardView::AutoEdgeRouting::isEnabled() const {
+    return enabled;
+}
+
+void BoardView::AutoEdgeRouting::markBoxRectChanged(
+        const QRectF &oldRect, const QRectF &newRect) {
+    if (!enabled)
+        return;
+
+    QSet<int> corridorIds;
+    if (!oldRect.isNull())
+        corridorIds += corridorsIndex.queryIntersecting(oldRect);
+    if (!newRect.isNull())
+        corridorIds += corridorsIndex.queryIntersecting(newRect);
+    if (corridorIds.isEmpty())
+        return;
+
+    for (const int corridorId: qAsConst(corridorIds))
+        relsToRoute << corridorIdToRelId.value(corridorId);
+    schedule();
+}
+
+void BoardView::AutoEdgeRouting::markRelationshipsChanged(const QSet<RelationshipId> &relIds) {
+    if (!enabled)
+        return;
+
+    for (const RelationshipId &relId: relIds) {
+        if (boardView->relationshipsCollection.contains(relId)) {
+            relsToRoute << relId;
+        }
+        else {
+            autoRoutedRels.remove(relId);
+            relsToRoute.remove(relId);
+            removeCorridor(relId);
         }
+    }
+    if (!relsToRoute.isEmpty())
+        schedule();
+}
 
-        // add to `cardIdToBundledRels`
-        for (const int cardId: cardsWithin) {
-            QSet<RelationshipId> bundledRels;
-            for (const RelationshipsBundle &bundle: qAsConst(bundlesOfGroup)) {
-                if (bundle.direction == RelationshipsBundle::Direction::IntoGroup) {
-                    bundledRels
-                            << RelationshipId(bundle.externalCardId, cardId, bundle.relationshipType);
-                }
-                else {
-                    bundledRels
-                            << RelationshipId(cardId, bundle.externalCardId, bundle.relationshipType);
-                }
-            }
-            cardIdToBundledRels[cardId] += bundledRels;
+void BoardView::AutoEdgeRouting::onJointsSetByUser(const RelationshipId &relId) {
+    if (!enabled)
+        return;
+
+    autoRoutedRels.remove(relId);
+    removeCorridor(relId);
+
+    // (An arrow whose joints are all removed by the user is routed again.)
+    if (boardView->relationshipsCollection.getJoints(relId).isEmpty()) {
+        relsToRoute << relId;
+        schedule();
+    }
+}
+
+bool BoardView::AutoEdgeRouting::isAutoRouted(const RelationshipId &relId) const {
+    return autoRoutedRels.contains(relId);
+}
+
+void BoardView::AutoEdgeRouting::clear() {
+    timer->stop();
+
+    delete router; // (cancels the computation and waits for it)
+    router = nullptr;
+    relIdsBeingRouted.clear();
+
+    autoRoutedRels.clear();
+    relsToRoute.clear();
+
+    corridorsIndex.clear();
+    relIdToCorridorId.clear();
+    corridorIdToRelId.clear();
+}
+
+bool BoardView::AutoEdgeRouting::canRoute(const RelationshipId &relId) const {
+    if (!boardView->relationshipsCollection.contains(relId))
+        return false;
+    return autoRoutedRels.contains(relId)
+            || boardView->relationshipsCollection.getJoints(relId).isEmpty();
+}
+
+void BoardView::AutoEdgeRouting::schedule() {
+    // (Each change restarts the timer, so that routing is done when the changes pause.)
+    timer->start();
+}
+
+void BoardView::AutoEdgeRouting::startRouting() {
+    if (!enabled || relsToRoute.isEmpty())
+        return;
+    if (router != nullptr)
+        return; // will be started again when `router` finishes
+
+    // snapshot of the rects of NodeRect's & group-boxes
+    QVector<QRectF> obstacles;
+    const QSet<int> cardIds = boardView->nodeRectsCollection.getAllCardIds();
+    for (const int cardId: cardIds) {
+        const auto rectOpt = boardView->nodeRectsCollection.getNodeRectRect(cardId);
+        if (rectOpt.has_value())
+            obstacles << rectOpt.value();
+    }
+    const QSet<int> groupBoxIds = boardView->groupBoxesCollection.getAllGroupBoxIds();
+    for (const int groupBoxId: groupBoxIds) {
+        GroupBox *groupBox = boardView->groupBoxesCollection.get(groupBoxId);
+        if (groupBox != nullptr)
+            obstacles << groupBox->getRect();
+    }
+
+    //
+    QVector<EdgeRouter::Request> requests;
+    for (const RelationshipId &relId: qAsConst(relsToRoute)) {
+        if (!canRoute(relId))
+            continue;
+
+        const auto startRectOpt
+                = boardView->nodeRectsCollection.getNodeRectRect(relId.startCardId);
+        const auto endRectOpt
+                = boardView->nodeRectsCollection.getNodeRectRect(relId.endCardId);
+        if (!startRectOpt.has_value() || !endRectOpt.has_value())
+            continue;
+
+        requests << EdgeRouter::Request {
+                relIdsBeingRouted.count(), startRectOpt.value(), endRectOpt.value()};
+        relIdsBeingRouted << relId;
+    }
+    relsToRoute.clear();
+
+    if (requests.isEmpty())
+        return;
+
+    //
+    router = new EdgeRouter(obstacles, requests, EdgeRouter::Parameters(), boardView);
+    QObject::connect(router, &EdgeRouter::finished,
+                     boardView, [this, routerPtr=QPointer(router)](const bool ok) {
+        if (!routerPtr || routerPtr != router)
+            return; // (canceled & deleted)
+        onRoutingFinished(ok);
+    });
+    router->start();
+}
+
+void BoardView::AutoEdgeRouting::onRoutingFinished(const bool ok) {
+    const QVector<RelationshipId> relIds = relIdsBeingRouted;
+    const QVector<EdgeRouter::Request> requests = router->getRequests();
+    const QVector<QVector<QPointF>> result
+            = ok ? router->getResult() : QVector<QVector<QPointF>> {};
+
+    router->deleteLater();
+    router = nullptr;
+    relIdsBeingRouted.clear();
+
+    //
+    if (ok) {
+        Q_ASSERT(result.count() == relIds.count());
+        for (int i = 0; i < relIds.count(); ++i) {
+            const RelationshipId &relId = relIds.at(i);
+            if (!canRoute(relId))
+                continue; // (removed, or joints set by user, while routing)
+
+            const QVector<QPointF> &joints = result.at(i);
+            boardView->relationshipsCollection.setJoints(relId, joints);
+            if (joints.isEmpty())
+                autoRoutedRels.remove(relId);
+            else
+                autoRoutedRels << relId;
+
+            // corridor
+            QRectF corridor = requests.at(i).startRect.united(requests.at(i).endRect);
+            for (const QPointF &joint: joints)
+                corridor = corridor.united(QRectF(joint, QSizeF(1, 1)));
+            setCorridor(relId, corridor);
         }
+    }
 
-        //
-        relBundlesByGroupBoxId.insert(groupBoxId, bundlesOfGroup);
+    // changes made while routing
+    if (!relsToRoute.isEmpty())
+        schedule();
+}
+
+void BoardView::AutoEdgeRouting::setCorridor(
+        const RelationshipId &relId, const QRectF &corridor) {
+    int corridorId = relIdToCorridorId.value(relId, -1);
+    if (corridorId == -1) {
+        corridorId = nextCorridorId++;
+        relIdToCorridorId.insert(relId, corridorId);
+        corridorIdToRelId.insert(corridorId, relId);
     }
+    corridorsIndex.set(corridorId, corridor);
+}
+
+void BoardView::AutoEdgeRouting::removeCorridor(const RelationshipId &relId) {
+    const int corridorId = relIdToCorridorId.value(relId, -1);
+    if (corridorId == -1)
+        return;
+    relIdToCorridorId.remove(relId);
+    corridorIdToRelId.remove(corridorId);
+    corridorsIndex.remove(corridorId);
+}
+
+//======
+
+BoardView::RelationshipBundlesCollection::RelationshipBundlesCollection(BoardView *boardView)
+        : boardView(boardView)
+        , bundler(
+            &boardView->groupBoxTree,
+            [boardView](const int cardId) {
+                return boardView->relationshipsCollection.getRelationshipsConnectingCard(cardId);
+            }
+        ) {
+}
+
+void BoardView::RelationshipBundlesCollection::update(
+        QSet<RelationshipId> *newlyBundledRels, QSet<RelationshipId> *unbundledRels) {
+    RenderingProfiler::ScopedOperation scopedOperation(
+            RenderingProfiler::Operation::UpdateRelationshipBundles);
+
+    const RelationshipBundler::Changes changes = bundler.update();
 
     //
-    bundledRels.clear();
-    for (auto it = cardIdToBundledRels.constBegin(); it != cardIdToBundledRels.constEnd(); ++it)
-        bundledRels += it.value();
+    QSet<GroupBoxAndCard> affectedGroupBoxAndCardPairs;
+
+    for (const RelationshipsBundle &bundle: changes.removedBundles) {
+        const GroupBoxAndCard groupBoxAndCard {bundle.groupBoxId, bundle.externalCardId};
+        affectedGroupBoxAndCardPairs << groupBoxAndCard;
+
+        auto it1 = relBundlesByExternalCardId.find(bundle.externalCardId);
+        if (it1 != relBundlesByExternalCardId.end()) {
+            it1.value().remove(bundle);
+            if (it1.value().isEmpty())
+                relBundlesByExternalCardId.erase(it1);
+        }
+
+        auto it2 = relBundlesByGroupBoxAndCard.find(groupBoxAndCard);
+        if (it2 != relBundlesByGroupBoxAndCard.end()) {
+            it2.value().remove(bundle);
+            if (it2.value().isEmpty())
+                relBundlesByGroupBoxAndCard.erase(it2);
+        }
 
-    // compute `relBundlesByExternalCardId` & `groupBoxAndCardToBundles`
-    QSet<RelationshipsBundle> allBundles;
-    for (auto it = relBundlesByGroupBoxId.constBegin();
-            it != relBundlesByGroupBoxId.constEnd(); ++it) {
-        allBundles += it.value();
+        removeEdgeArrow(bundle);
     }
 
-    relBundlesByExternalCardId.clear();
-    relBundlesByGroupBoxAndCard.clear();
-    for (const RelationshipsBundle &bundle: qAsConst(allBundles)) {
+    for (const RelationshipsBundle &bundle: changes.addedBundles) {
+        const GroupBoxAndCard groupBoxAndCard {bundle.groupBoxId, bundle.externalCardId};
+        affectedGroupBoxAndCardPairs << groupBoxAndCard;
+
         relBundlesByExternalCardId[bundle.externalCardId] << bundle;
-        relBundlesByGroupBoxAndCard[{bundle.groupBoxId, bundle.externalCardId}] << bundle;
+        relBundlesByGroupBoxAndCard[groupBoxAndCard] << bundle;
+
+        createEdgeArrow(bundle);
     }
 
+    // the parallel indices of the other bundles connecting the same pair may have changed
+    for (const GroupBoxAndCard &groupBoxAndCard: qAsConst(affectedGroupBoxAndCardPairs))
+        updateParallelEdgeArrows(groupBoxAndCard);
+
     //
-    redrawBundleArrows();
+    *newlyBundledRels = changes.newlyBundledRels;
+    *unbundledRels = changes.unbundledRels;
 }
 
 void BoardView::RelationshipBundlesCollection::updateBundlesConnectingGroupBox(
         const int groupBoxId) {
-    const QSet<RelationshipsBundle> bundles = relBundlesByGroupBoxId.value(groupBoxId);
+    const QSet<RelationshipsBundle> bundles = bundler.getBundlesOfGroupBox(groupBoxId);
 
     QSet<int> externalCardIds;
     for (const auto &bundle: bundles)
         externalCardIds << bundle.externalCardId;
 
-    for (const int cardId: qAsConst(externalCardIds)) {
-        const QSet<RelationshipsBundle> parallelBundles
-                = relBundlesByGroupBoxAndCard.value({groupBoxId, cardId});
-
-        int index = 0;
-        for (const auto &bundle: parallelBundles) {
-            updateEdgeArrow(bundle, index, parallelBundles.count());
-            ++index;
-        }
-    }
+    for (const int cardId: qAsConst(externalCardIds))
+        updateParallelEdgeArrows({groupBoxId, cardId});
 }
 
 void BoardView::RelationshipBundlesCollection::updateBundlesConnectingNodeRect(const int cardId) {
@@ -3324,25 +5113,13 @@ void BoardView::RelationshipBundlesCollection::updateBundlesConnectingNodeRect(c
     for (const auto &bundle: bundles)
         groupBoxIds << bundle.groupBoxId;
 
-    for (const int groupBoxId: qAsConst(groupBoxIds)) {
-        const QSet<RelationshipsBundle> parallelBundles
-                = relBundlesByGroupBoxAndCard.value({groupBoxId, cardId});
-
-        int index = 0;
-        for (const auto &bundle: parallelBundles) {
-            updateEdgeArrow(bundle, index, parallelBundles.count());
-            ++index;
-        }
-    }
+    for (const int groupBoxId: qAsConst(groupBoxIds))
+        updateParallelEdgeArrows({groupBoxId, cardId});
 }
 
 QSet<RelationshipsBundle> BoardView::RelationshipBundlesCollection::getBundlesOfGroupBox(
         const int groupBoxId) const {
-    return relBundlesByGroupBoxId.value(groupBoxId);
-}
-
-QSet<RelationshipId> BoardView::RelationshipBundlesCollection::getBundledRelationships() const {
-    return bundledRels;
+    return bundler.getBundlesOfGroupBox(groupBoxId);
 }
 
 QRectF BoardView::RelationshipBundlesCollection::getBoundingRectOfAllArrows() const {
@@ -3366,40 +5143,37 @@ void BoardView::RelationshipBundlesCollection::setLineColorAndLabelColorOfAllEdg
     }
 }
 
-void BoardView::RelationshipBundlesCollection::redrawBundleArrows() {
-    // remove current edge arrows
-    for (auto it = relBundleToEdgeArrow.constBegin(); it != relBundleToEdgeArrow.constEnd(); ++it) {
-        EdgeArrow *edgeArrow = it.value();
-        boardView->graphicsScene->removeItem(edgeArrow);
-        delete edgeArrow;
+void BoardView::RelationshipBundlesCollection::setLevelOfDetailOfAll(const LevelOfDetail lod) {
+    for (auto it = relBundleToEdgeArrow.constBegin();
+            it != relBundleToEdgeArrow.constEnd(); ++it) {
+        it.value()->setLevelOfDetail(lod);
     }
-    relBundleToEdgeArrow.clear();
+}
 
-    //
+void BoardView::RelationshipBundlesCollection::createEdgeArrow(
+        const RelationshipsBundle &bundle) {
     constexpr double lineWidth = 4;
-    const QColor lineColor = boardView->getEdgeArrowLineColor();
-    const QColor labelColor = boardView->getEdgeArrowLabelColor();
-
-    for (auto it = relBundlesByGroupBoxAndCard.constBegin();
-            it != relBundlesByGroupBoxAndCard.constEnd(); ++it) {
-        const QSet<RelationshipsBundle> &parallelBundles = it.value();
-        int index = 0;
-        for (const auto &bundle: parallelBundles) {
-            // create EdgeArrow
-            auto *edgeArrow = new EdgeArrow(boardView->canvas);
-            relBundleToEdgeArrow.insert(bundle, edgeArrow);
 
-            edgeArrow->setZValue(zValueForEdgeArrows);
-            edgeArrow->setLineWidth(lineWidth);
-            edgeArrow->setLineColor(lineColor);
-            edgeArrow->setLabelColor(labelColor);
+    auto *edgeArrow = new EdgeArrow(boardView->canvas);
+    relBundleToEdgeArrow.insert(bundle, edgeArrow);
 
-            updateEdgeArrow(bundle, index, parallelBundles.count());
+    edgeArrow->setZValue(zValueForEdgeArrows);
+    edgeArrow->setLevelOfDetail(boardView->levelOfDetail);
+    edgeArrow->setProfilingEnabled(RenderingProfiler::instance()->isEnabled());
+    edgeArrow->setLineWidth(lineWidth);
+    edgeArrow->setLineColor(boardView->getEdgeArrowLineColor());
+    edgeArrow->setLabelColor(boardView->getEdgeArrowLabelColor());
+    // (endpoints are set by updateEdgeArrow())
+}
+
+void BoardView::RelationshipBundlesCollection::removeEdgeArrow(
+        const RelationshipsBundle &bundle) {
+    EdgeArrow *edgeArrow = relBundleToEdgeArrow.take(bundle);
+    if (edgeArrow == nullptr)
+        return;
 
-            //
-            ++index;
-        }
-    }
+    boardView->graphicsScene->removeItem(edgeArrow);
+    delete edgeArrow;
 }
 
 void BoardView::RelationshipBundlesCollection::updateEdgeArrow(
@@ -3411,7 +5185,19 @@ void BoardView::RelationshipBundlesCollection::updateEdgeArrow(
 
     auto *edgeArrow = relBundleToEdgeArrow.value(bundle);
     edgeArrow->setStartEndPoint(line.p1(), line.p2());
-    edgeArrow->setLabel(bundle.relationshipType);
+    edgeArrow->setLabel(bundle.relationshipType.toString());
+}
+
+void BoardView::RelationshipBundlesCollection::updateParallelEdgeArrows(
+        const GroupBoxAndCard &groupBoxAndCard) {
+    const QSet<RelationshipsBundle> parallelBundles
+            = relBundlesByGroupBoxAndCard.value(groupBoxAndCard);
+
+    int index = 0;
+    for (const auto &bundle: parallelBundles) {
+        updateEdgeArrow(bundle, index, parallelBundles.count());
+        ++index;
+    }
 }
 
 QLineF BoardView::RelationshipBundlesCollection::computeEdgeArrowLine(
@@ -3469,6 +5255,19 @@ BoardView::ContextMenu::ContextMenu(BoardView *boardView_)
             boardView->onUserToCreateNewGroup(requestScenePos);
         });
     }
+    {
+        auto *action = menu->addAction("Auto-Layout Cards");
+        connect(action, &QAction::triggered, boardView, [this]() {
+            boardView->onUserToAutoLayOutCards();
+        });
+    }
+    {
+        auto *action = menu->addAction("Route Arrows Around Cards");
+        action->setCheckable(true);
+        connect(action, &QAction::toggled, boardView, [this](bool checked) {
+            boardView->onUserToToggleAutoEdgeRouting(checked);
+        });
+    }
     {
         auto *action = menu->addAction("Create New Data Query");
         connect(action, &QAction::triggered, boardView, [this]() {
@@ -3476,6 +5275,37 @@ BoardView::ContextMenu::ContextMenu(BoardView *boardView_)
         });
     }
     menu->addSeparator();
+    {
+        auto *action = menu->addAction("Close Selected Items");
+        selectionActions << action;
+        connect(action, &QAction::triggered, boardView, [this]() {
+            boardView->onUserToCloseSelectedItems();
+        });
+    }
+    {
+        auto *action = menu->addAction("Set Color of Selected Items...");
+        selectionActions << action;
+        connect(action, &QAction::triggered, boardView, [this]() {
+            boardView->onUserToSetColorOfSelectedItems();
+        });
+    }
+    {
+        auto *action = menu->addAction("Add Label to Selected Cards...");
+        selectionActions << action;
+        connect(action, &QAction::triggered, boardView, [this]() {
+            constexpr bool toAdd = true;
+            boardView->onUserToAddOrRemoveLabelOfSelectedCards(toAdd);
+        });
+    }
+    {
+        auto *action = menu->addAction("Remove Label from Selected Cards...");
+        selectionActions << action;
+        connect(action, &QAction::triggered, boardView, [this]() {
+            constexpr bool toAdd = false;
+            boardView->onUserToAddOrRemoveLabelOfSelectedCards(toAdd);
+        });
+    }
+    menu->addSeparator();
     {
         auto *action = menu->addAction("Open Settings...");
         connect(action, &QAction::triggered, boardView, [this]() {
@@ -3491,6 +5321,11 @@ void BoardView::ContextMenu::setActionIcons() {
         it.key()->setIcon(Icons::getIcon(it.value(), theme));
 }
 
+void BoardView::ContextMenu::setSelectionActionsEnabled(const bool enabled) {
+    for (QAction *action: qAsConst(selectionActions))
+        action->setEnabled(enabled);
+}
+
 //======
 
 BoardView::SettingBoxesCollection::SettingBoxesCollection(BoardView *boardView)
@@ -3967,7 +5802,7 @@ void BoardView::SettingBoxesCollection::applyBoardSetting(
         }
 
         boardView->cardPropertiesToShowSettings.onBoard = *cardPropertiesToShow;
-        boardView->updatePropertiesDisplayOfAllCards();
+        boardView->onCardPropertiesToShowSettingsUpdated();
 
         //
         BoardNodePropertiesUpdate update;
@@ -12,13 +12,21 @@
 #include "models/group_box_tree.h"
 #include "models/node_rect_data.h"
 #include "models/relationship.h"
+#include "models/relationship_bundler.h"
 #include "models/relationships_bundle.h"
 #include "models/settings/abstract_setting.h"
 #include "widgets/common_types.h"
+#include "utilities/edge_router.h"
+#include "utilities/force_directed_layout.h"
+#include "utilities/label_rules_table.h"
+#include "utilities/rect_tree.h"
+#include "utilities/symbol.h"
+#include "utilities/tiled_png_export.h"
 #include "widgets/icons.h"
 
 class ActionDebouncer;
 class BoardBoxItem;
+class BoardMinimap;
 class Card;
 struct CardLabelToColorMapping;
 struct CardPropertiesToShow;
@@ -28,8 +36,14 @@ class EdgeArrow;
 struct EdgeArrowData;
 class GraphicsScene;
 class GroupBox;
+class MarkdownRenderCache;
 class NodeRect;
+class QProgressBar;
+class RenderingProfilerOverlay;
+class QTimer;
+class QVariantAnimation;
 class SettingBox;
+class ZoomPreviewOverlay;
 
 class BoardView : public QFrame
 {
@@ -43,7 +57,10 @@ public:
     //!   + \c canClose() must return true
     //! \param boardIdToLoad: if = -1, will only close the board
     //! \param callback: parameter \e highlightedCardIdChanged will be true if highlighted Card ID
-    //!                  changed to -1
+    //!                  changed to -1. If the loading is superseded (by another call of this
+    //!                  method before it finishes), \e loadOk will be true, since it is not a
+    //!                  failure (the board is left closed, and the later call reports its own
+    //!                  result).
     //!
     void loadBoard(
             const int boardIdToLoad,
@@ -54,6 +71,16 @@ public:
     void applyZoomAction(const ZoomAction zoomAction);
     void toggleCardPreview();
 
+    //!
+    //! Shows/hides an overlay of rendering statistics (see \c RenderingProfiler).
+    //!
+    void toggleRenderingProfiler();
+
+    //!
+    //! Shows/hides a minimap of the board (see \c BoardMinimap).
+    //!
+    void toggleMinimap();
+
     using LabelAndColor = std::pair<QString, QColor>;
 
     //!
@@ -74,6 +101,13 @@ public:
     QPointF getViewTopLeftPos() const; // in canvas coordinates
     double getZoomRatio() const;
 
+    //!
+    //! Normally set via the signal AppDataReadonly::fontSizeScaleFactorChanged(). Use the setter
+    //! to initialize a BoardView created after the signal was emitted.
+    //!
+    double getGraphicsGeometryScaleFactor() const;
+    void setGraphicsGeometryScaleFactor(const double factor);
+
     QVector<LabelAndColor> getCardLabelsAndAssociatedColors() const {
         return cardLabelsAndAssociatedColors;
     }
@@ -83,12 +117,34 @@ public:
 
     bool canClose() const;
 
-    //
-    QImage renderAsImage();
+    //!
+    //! Unhighlights all items and clears the selection. Call this before the view is hidden
+    //! while its board stays loaded.
+    //! \param highlightedCardIdChanged: will be true if a card was highlighted
+    //!
+    void clearHighlights(bool *highlightedCardIdChanged);
+
+    //!
+    //! The count of graphics items (NodeRect's, EdgeArrow's, etc.) of the loaded board, and a
+    //! rough estimate of the memory they use. Used to limit the boards kept loaded.
+    //!
+    int getItemsCount() const;
+    qint64 getEstimatedMemoryUsage() const; // (bytes)
+
+    //!
+    //! Records the board at scale 1.0 into horizontal bands for \c TiledPngExport. The band
+    //! height is chosen so that the export's pixel buffers fit in \e memoryCapBytes.
+    //! \return false if the board can't be exported within \e memoryCapBytes
+    //!
+    bool recordForImageExport(
+            const qint64 memoryCapBytes, TiledPngExport::Source *source, QString *errorMsg);
 
     //
     bool eventFilter(QObject *watched, QEvent *event) override;
 
+protected:
+    void showEvent(QShowEvent *event) override;
+
 signals:
     void workspaceCardLabelToColorMappingUpdatedViaSettingBox(
             const int workspaceId, const CardLabelToColorMapping &cardLabelToColorMapping);
@@ -97,6 +153,8 @@ signals:
     void hasWorkspaceSettingsPendingUpdateChanged(bool hasWorkspaceSettingsPendingUpdate);
 
 private:
+    friend class BoardVectorExport; // (draws boards with the same colors & properties display)
+
     static inline const QSizeF defaultNewNodeRectSize {200, 120};
     static inline const QSizeF defaultNewDataViewBoxSize {400, 400};
     static inline const QSizeF defaultNewSettingBoxSize {450, 600};
@@ -107,9 +165,15 @@ private:
     constexpr static double zValueForNodeRects {10.0};
     constexpr static double zValueForEdgeArrows {15.0};
 
+    constexpr static int loadingTimeSliceMsec {12};
+            // when loading a board, items are created in time slices of this length
+    constexpr static int maxCachedMarkdownCharacters {4000000};
+            // total length of the card texts whose previews are cached
+
     int boardId {-1}; // -1: no board loaded
 
     QVector<LabelAndColor> cardLabelsAndAssociatedColors; // in the order of precedence (high to low)
+    LabelRulesTable<QColor> cardLabelColorsTable; // compiled from `cardLabelsAndAssociatedColors`
     QColor defaultNodeRectColor;
 
     struct CardPropertiesToShowSettings
@@ -118,9 +182,14 @@ private:
         CardPropertiesToShow onBoard;
     };
     CardPropertiesToShowSettings cardPropertiesToShowSettings;
+    CardPropertiesToShow::CompiledTable cardPropertiesToShowTable;
+            // compiled from `cardPropertiesToShowSettings` (board's setting cascaded over
+            // workspace's)
 
+    int loadGeneration {0}; // incremented by loadBoard() & closeAll()
     double zoomScale {1.0};
     double graphicsGeometryScaleFactor {1.0};
+    LevelOfDetail levelOfDetail {LevelOfDetail::Full}; // of all items, determined by canvas scale
 
     GroupBoxTree groupBoxTree;
 
@@ -128,6 +197,14 @@ private:
     QGraphicsView *graphicsView {nullptr};
     GraphicsScene *graphicsScene {nullptr};
     QGraphicsRectItem *canvas {nullptr}; // draw everything on this
+    QGraphicsRectItem *rubberBandItem {nullptr}; // (in scene coordinates, not on `canvas`)
+    QProgressBar *loadingProgressBar {nullptr}; // shown while a board's items are being created
+    RenderingProfilerOverlay *renderingProfilerOverlay {nullptr};
+    BoardMinimap *minimap {nullptr};
+    ZoomPreviewOverlay *zoomPreview {nullptr}; // (a child of `graphicsView->viewport()`)
+    QTimer *zoomSettleTimer {nullptr}; // commits the zoom preview when the gesture settles
+    QPoint zoomPreviewScrollPos; // values of the scroll bars when last synced with `zoomPreview`
+    QPointF zoomPreviewAnchorPos; // (in viewport pixels) the anchor of the last zoom step
 
     struct ContextMenu
     {
@@ -136,13 +213,18 @@ private:
         QPointF requestScenePos;
 
         void setActionIcons();
+        void setSelectionActionsEnabled(const bool enabled);
     private:
         BoardView *boardView;
         QHash<QAction *, Icon> actionToIcon;
+        QVector<QAction *> selectionActions; // (acting on the selected items)
     };
     ContextMenu contextMenu {this};
 
     ActionDebouncer *handleSettingsEditedDebouncer {nullptr};
+    ActionDebouncer *updateContentsMaterializationDebouncer {nullptr};
+
+    MarkdownRenderCache *markdownRenderCache {nullptr}; // for the previews of NodeRect's
 
     // setup
     void setUpWidgets();
@@ -163,6 +245,13 @@ private:
     void onUserToCloseDataViewBox(const int customDataQueryId);
     void onUserToSetGroupBoxTitle(const int groupBoxId, const QString &newTitle);
     void onUserToRemoveGroupBox(const int groupBoxId);
+    void onUserToAutoLayOutCards();
+    void onUserToToggleAutoEdgeRouting(const bool enable);
+    void onUserToCloseSelectedItems();
+    void onUserToSetColorOfSelectedItems();
+    void onUserToAddOrRemoveLabelOfSelectedCards(const bool toAdd);
+    void onRubberBandChanged(const QRectF &sceneRect);
+    void onRubberBandFinished(const QRectF &sceneRect);
     void onBackgroundClicked();
 
     void reparentNodeRectInGroupBoxTree(const int cardId, const int newParentGroupBox);
@@ -185,19 +274,56 @@ private:
     //!   - graphicsView is resized,
     //!   - NodeRect, DataViewBox, etc. is added/moved/resized/removed,
     //!   - canvas's scale is set.
+    //! \param extraContentsRect: in canvas coordinates. Used while a board's items are being
+    //!                           created, to include the items not yet created.
     //!
-    void adjustSceneRect();
+    void adjustSceneRect(const QRectF &extraContentsRect = QRectF());
 
     //!
+    //! Zooming is first previewed by scaling a cached image of the viewport (see
+    //! \c ZoomPreviewOverlay). The canvas is scaled only when the zoom gesture settles (see
+    //! \c commitZoomPreview()).
     //! \param zoomAction
     //! \param anchorScenePos: a point on the canvas at this position will be stationary relative
     //!                        to view
     //!
     void doApplyZoomAction(const ZoomAction zoomAction, const QPointF &anchorScenePos);
 
+    //!
+    //! Sets the canvas scale & view position to those of the zoom preview, if there's one in
+    //! progress, and then reveals the re-rendered view progressively.
+    //!
+    void commitZoomPreview();
+    void cancelZoomPreview();
+    constexpr static int zoomSettleDelayMsec {150};
+
     void updateCanvasScale(const double scale, const QPointF &anchorScenePos);
 
-    void updatePropertiesDisplayOfAllCards();
+    //!
+    //! Determines the level of detail from canvas scale, and applies it to all items if it
+    //! changes. Newly created items get the current level of detail.
+    //!
+    void updateLevelOfDetail();
+
+    constexpr static double minCanvasScaleForFullDetail {0.6};
+    constexpr static double minCanvasScaleForTitles {0.3};
+    static LevelOfDetail computeLevelOfDetail(const double canvasScale);
+
+    //!
+    //! Recompiles `cardPropertiesToShowTable` from `cardPropertiesToShowSettings`, and updates
+    //! the properties display of only the cards for which the result changes.
+    //!
+    void onCardPropertiesToShowSettingsUpdated();
+    CardPropertiesToShow::CompiledTable compileCardPropertiesToShowSettings() const;
+
+    //!
+    //! Materializes the contents (text editors) of NodeRect's near the viewport, and releases
+    //! those far from it. Call this (via `updateContentsMaterializationDebouncer`) when the view
+    //! is scrolled, resized or zoomed.
+    //!
+    constexpr static double contentsMaterializeMarginFraction {0.5};
+    constexpr static double contentsKeepMarginFraction {1.0};
+    void updateContentsMaterialization();
 
     //
     class NodeRectsCollection
@@ -224,30 +350,62 @@ private:
                 bool *highlightedCardIdUpdated);
 
         void updateNodeRectPropertiesDisplay(
-                const int cardId, const QSet<QString> &cardLabels,
+                const int cardId, const QSet<Symbol> &cardLabels,
                 const QHash<QString, QJsonValue> &cardCustomProperties,
-                const CardPropertiesToShow &effectiveCardPropertiesToShow);
+                const CardPropertiesToShow::CompiledTable &cardPropertiesToShowTable);
 
         void setHighlightedCardIds(const QSet<int> &cardIdsToHighlight);
         QSet<int> addToHighlightedCards(const QSet<int> &cardIdsToHighlight);
                 // returns all cards that are in highlighted state
 
         void updateAllNodeRectColors();
+        void updateNodeRectColors(const QSet<int> &cardIds);
+        void setNodeRectOwnColor(const int cardId, const QColor &ownColor);
+                // call updateNodeRectColors() afterwards
         void setAllNodeRectsTextEditorIgnoreWheelEvent(const bool b);
+        void setLevelOfDetailOfAll(const LevelOfDetail lod);
+
+        //!
+        //! Materializes the contents of NodeRect's intersecting \e materializeRegion, and
+        //! releases those of NodeRect's not intersecting \e keepRegion (which should contain
+        //! \e materializeRegion). The margin between the two regions prevents thrashing.
+        //! \param materializeRegion, keepRegion: in canvas coordinates
+        //!
+        void updateContentsMaterialization(
+                const QRectF &materializeRegion, const QRectF &keepRegion);
 
         bool contains(const int cardId) const;
         NodeRect *get(const int cardId) const;
         std::optional<QRectF> getNodeRectRect(const int cardId) const;
                 // returns nullopt if NodeRect not found
         QSet<int> getAllCardIds() const;
+        QSet<int> getCardIdsInRect(const QRectF &rect) const;
+                // NodeRect's contained in `rect` (in canvas coordinates)
+        QSet<int> getCardIdsByLabels(
+                std::function<bool (const QSet<Symbol> &cardLabels)> predicate) const;
+        int getCount() const;
+        int getCountOfMaterialized() const; // count of NodeRect's with contents materialized
         QHash<int, QSet<QString>> getCardIdToLabels() const;
         QColor getNodeRectOwnColor(const int cardId) const;
         QRectF getBoundingRectOfAllNodeRects() const; // returns QRectF() if no NodeRect exists
 
+        //!
+        //! Call this after the rect of the NodeRect is changed.
+        //!
+        void updateSpatialIndex(const int cardId);
+
+        //!
+        //! Updates what depends on the geometry of the NodeRect being moved/resized by user
+        //! (relationship bundles, EdgeArrow's, and the group-box to be added to). Called by
+        //! \c FrameUpdateScheduler.
+        //!
+        void applyMovedOrResized(const int cardId);
+
     private:
         BoardView *const boardView;
         QHash<int, NodeRect *> cardIdToNodeRect;
         QHash<int, QColor> cardIdToNodeRectOwnColor;
+        RectTree boundingRectsIndex; // bounding rects of NodeRect's
     };
     NodeRectsCollection nodeRectsCollection {this};
 
@@ -274,13 +432,25 @@ private:
 
         void removeEdgeArrows(const QSet<RelationshipId> &relIds);
 
-        void setAllEdgeArrowsVisible();
+        //!
+        //! Sets the joints of an existing EdgeArrow, and updates it (and the EdgeArrow's
+        //! connecting the same cards). Does not save to AppData.
+        //!
+        void setJoints(const RelationshipId &relId, const QVector<QPointF> &joints);
+
+        void setEdgeArrowsVisible(const QSet<RelationshipId> &relIds);
         void setLineColorAndLabelColorOfAllEdgeArrows(
                 const QColor &lineColor, const QColor &labelColor);
+        void setLevelOfDetailOfAll(const LevelOfDetail lod);
         void hideEdgeArrows(const QSet<RelationshipId> &relIds);
 
         QSet<RelationshipId> getAllRelationshipIds() const;
+        bool contains(const RelationshipId &relId) const;
+        int getCount() const;
+        QSet<RelationshipId> getRelationshipsConnectingCard(const int cardId) const;
+        QVector<QPointF> getJoints(const RelationshipId &relId) const; // empty if not found
         QHash<RelationshipId, QVector<QPointF>> getRelIdToJoints() const;
+                // joints set by user (not including those of `AutoEdgeRouting`)
         QRectF getBoundingRectOfAllEdgeArrows() const; // returns QRectF() if no EdgeArrow exists
 
     private:
@@ -288,11 +458,12 @@ private:
         QHash<RelationshipId, EdgeArrow *> relIdToEdgeArrow;
         QHash<QSet<int>, QSet<RelationshipId>> cardIdPairToParallelRels;
                 // "parallel relationships" := those connecting the same pair of cards
+        QHash<int, QSet<RelationshipId>> cardIdToRels;
+                // cardIdToRels[c] is the relationships (with EdgeArrow) starting or ending at c
 
         void updateSingleEdgeArrow(
                 const RelationshipId &relId,
                 const int parallelIndex, const int countOfParallelRelsWithoutJoint);
-        static QVector<RelationshipId> sortRelationshipIds(const QSet<RelationshipId> relIds);
         QLineF computeEdgeArrowLineWithoutJoint(
                 const RelationshipId &relId, const int parallelIndex, const int parallelCount);
         std::pair<QPointF, QPointF> computeEndpointsOfEdgeArrowWithJoint(
@@ -315,17 +486,42 @@ private:
 
         void closeDataViewBox(const int customDataQueryId);
 
+        //!
+        //! Does nothing if the DataViewBox does not exist.
+        //!
+        void updateDataViewBox(
+                const int customDataQueryId, const CustomDataQuery &customDataQueryData);
+
+        void setHighlightedDataViewBoxes(const QSet<int> &customDataQueryIds);
+        void setDataViewBoxOwnColor(const int customDataQueryId, const QColor &ownColor);
+                // also updates the display color
         void setAllDataViewBoxesTextEditorIgnoreWheelEvent(const bool ignoreWheelEvent);
+        void setLevelOfDetailOfAll(const LevelOfDetail lod);
 
         bool contains(const int customDataQueryId) const;
+        DataViewBox *get(const int customDataQueryId) const; // returns nullptr if not found
         QSet<int> getAllCustomDataQueryIds() const;
+        QSet<int> getCustomDataQueryIdsInRect(const QRectF &rect) const;
+                // DataViewBox'es contained in `rect` (in canvas coordinates)
         QRectF getBoundingRectOfAllDataViewBoxes() const;
                 // returns QRectF() if no DataViewBox exists
 
+        //!
+        //! Call this after the rect of the DataViewBox is changed.
+        //!
+        void updateSpatialIndex(const int customDataQueryId);
+
+        //!
+        //! Moves the co-moving items, if any, with the DataViewBox being moved by user. Called
+        //! by \c FrameUpdateScheduler.
+        //!
+        void applyMovedOrResized(const int customDataQueryId);
+
     private:
         BoardView *const boardView;
         QHash<int, DataViewBox *> customDataQueryIdToDataViewBox;
         QHash<int, QColor> customDataQueryIdToDataViewBoxOwnColor;
+        RectTree boundingRectsIndex; // bounding rects of DataViewBox'es
     };
     DataViewBoxesCollection dataViewBoxesCollection {this};
 
@@ -343,9 +539,12 @@ private:
         void unhighlightGroupBoxes(const QSet<int> &groupBoxIds);
 
         void setColorOfAllGroupBoxes(const QColor &color);
+        void setLevelOfDetailOfAll(const LevelOfDetail lod);
 
         GroupBox *get(const int groupBoxId); // returns nullptr if not found
         QSet<int> getAllGroupBoxIds() const;
+        QSet<int> getGroupBoxIdsInRect(const QRectF &rect) const;
+                // group-boxes contained in `rect` (in canvas coordinates)
         QRectF getBoundingRectOfAllGroupBoxes() const; // returns QRectF() if no GroupBox exists
 
         //!
@@ -357,9 +556,22 @@ private:
                 const BoardBoxItem *boardBoxItem,
                 const QSet<int> &groupBoxIdsToExclude = QSet<int> {});
 
+        //!
+        //! Call this after the rect of the group-box is changed.
+        //!
+        void updateSpatialIndex(const int groupBoxId);
+
+        //!
+        //! Updates what depends on the geometry of the group-box being moved/resized by user
+        //! (relationship bundles, the group-box to be added to, and the co-moving items). Called
+        //! by \c FrameUpdateScheduler.
+        //!
+        void applyMovedOrResized(const int groupBoxId);
+
     private:
         BoardView *const boardView;
         QHash<int, GroupBox *> groupBoxes;
+        RectTree boundingRectsIndex; // bounding rects of group-boxes
 
         void highlightGroupBoxAndDescendants(
                 const int groupBoxIdToHighlight, const bool unhlighlightOtherItems);
@@ -370,33 +582,44 @@ private:
     class RelationshipBundlesCollection
     {
     public:
-        explicit RelationshipBundlesCollection(BoardView *boardView) : boardView(boardView) {}
+        explicit RelationshipBundlesCollection(BoardView *boardView);
 
         //!
-        //! Updates the whole collection. This can be called when a relationship is created/removed,
-        //! a NodeRect is created/removed, or the GroupBoxTree is modified.
+        //! Marks what has changed (see \c RelationshipBundler). Call \c update() afterwards.
         //!
-        void update();
+        void markAllChanged() { bundler.markAllChanged(); }
+        void markCardChanged(const int cardId) { bundler.markCardChanged(cardId); }
+        void markRelationshipsChanged(const QSet<RelationshipId> &relIds) {
+            bundler.markRelationshipsChanged(relIds);
+        }
+        void markGroupBoxChanged(const int groupBoxId) { bundler.markGroupBoxChanged(groupBoxId); }
+
+        //!
+        //! Recomputes the bundles affected by the marked changes, and updates only the affected
+        //! bundle arrows.
+        //! \param newlyBundledRels: relationships that become bundled
+        //! \param unbundledRels: relationships that are no longer bundled
+        //!
+        void update(QSet<RelationshipId> *newlyBundledRels, QSet<RelationshipId> *unbundledRels);
 
         void updateBundlesConnectingGroupBox(const int groupBoxId);
         void updateBundlesConnectingNodeRect(const int cardId);
 
         //
         QSet<RelationshipsBundle> getBundlesOfGroupBox(const int groupBoxId) const;
-        QSet<RelationshipId> getBundledRelationships() const;
         QRectF getBoundingRectOfAllArrows() const; // returns QRectF() if no bundle exists
 
         //
         void setLineColorAndLabelColorOfAllEdgeArrows(
                 const QColor &lineColor, const QColor &labelColor);
+        void setLevelOfDetailOfAll(const LevelOfDetail lod);
 
     private:
         BoardView *const boardView;
+        RelationshipBundler bundler;
 
         // data
-        QHash<int, QSet<RelationshipsBundle>> relBundlesByGroupBoxId;
         QHash<int, QSet<RelationshipsBundle>> relBundlesByExternalCardId;
-        QSet<RelationshipId> bundledRels;
 
         using GroupBoxAndCard = std::pair<int, int>;
         QHash<GroupBoxAndCard, QSet<RelationshipsBundle>> relBundlesByGroupBoxAndCard;
@@ -404,17 +627,15 @@ private:
 
         // EdgeArrow's
         QHash<RelationshipsBundle, EdgeArrow *> relBundleToEdgeArrow;
-        void redrawBundleArrows();
+        void createEdgeArrow(const RelationshipsBundle &bundle);
+        void removeEdgeArrow(const RelationshipsBundle &bundle);
         void updateEdgeArrow(
                 const RelationshipsBundle &bundle, const int parallelIndex, const int parallelCount);
+        void updateParallelEdgeArrows(const GroupBoxAndCard &groupBoxAndCard);
 
         //
-        static QHash<RelationshipsBundle, int> computeBundleToParallelIndex(
-                const QHash<int, QSet<RelationshipsBundle>> &relBundlesByGroupBoxId);
         QLineF computeEdgeArrowLine(
                 const RelationshipsBundle &bundle, const int parallelIndex, const int parallelCount);
-
-
     };
     RelationshipBundlesCollection relationshipBundlesCollection {this};
 
@@ -525,6 +746,10 @@ private:
         QPointF followeeInitialPos;
         QHash<int, QPointF> followerGroupBoxIdToInitialPos;
         QHash<int, QPointF> followerCardIdToInitialPos; // (initial positions of NodeRect's)
+        QHash<int, QPointF> followerCustomDataQueryIdToInitialPos;
+                // (initial positions of DataViewBox'es)
+        bool isMovingSelection {false};
+                // whether the followee & followers are the selected items (see `selection`)
 
         //
         void activate();
@@ -533,6 +758,7 @@ private:
         void clearFollowers() {
             followerGroupBoxIdToInitialPos.clear();
             followerCardIdToInitialPos.clear();
+            followerCustomDataQueryIdToInitialPos.clear();
         }
     private:
         bool isActive {false};
@@ -543,28 +769,221 @@ private:
     void moveFollowerItemsInComovingState(
             const QPointF &displacement, const ComovingStateData &comovingStateData);
             // does not save to AppData
-    void savePositionsOfComovingItems(const ComovingStateData &comovingStateData);
+
+    //!
+    //! Saves the positions of the followers together with \e bulkUpdate (the update of the
+    //! followee) in a single write.
+    //!
+    void savePositionsOfComovingItems(
+            const ComovingStateData &comovingStateData, BoardItemsBulkUpdate bulkUpdate);
+
+    // multi-selection (by rubber band)
+    struct Selection
+    {
+        QSet<int> cardIds;
+        QSet<int> groupBoxIds;
+        QSet<int> customDataQueryIds;
+
+        bool isEmpty() const {
+            return cardIds.isEmpty() && groupBoxIds.isEmpty() && customDataQueryIds.isEmpty();
+        }
+        int count() const {
+            return cardIds.count() + groupBoxIds.count() + customDataQueryIds.count();
+        }
+    };
+    Selection selection; // the selected items are shown highlighted
+
+    //!
+    //! Highlights exactly the items of \e newSelection.
+    //!
+    void setSelection(const Selection &newSelection);
+    void clearSelection(); // does nothing if `selection` is empty
+
+    //!
+    //! Enters the co-moving state with all the selected items, and the descendants of the
+    //! selected group-boxes, as followers. The caller should then remove the followee from the
+    //! followers and set `comovingStateData.followeeInitialPos`.
+    //!
+    void activateComovingWithSelection();
+
+    //!
+    //! Coalesces the work following the moving/resizing of an item by user (see
+    //! \c applyMovedOrResized() of the collections), and performs it at most once per display
+    //! frame, since mouse-move events can arrive several times per frame.
+    //!
+    class FrameUpdateScheduler
+    {
+    public:
+        explicit FrameUpdateScheduler(BoardView *boardView);
+
+        void markNodeRectMovedOrResized(const int cardId);
+        void markGroupBoxMovedOrResized(const int groupBoxId);
+        void markDataViewBoxMovedOrResized(const int customDataQueryId);
+
+        //!
+        //! Performs the pending work now. Call this before the results are used (e.g., when
+        //! moving/resizing finishes).
+        //!
+        void flush();
+
+        //!
+        //! Drops the pending work.
+        //!
+        void cancel();
+
+    private:
+        constexpr static int frameIntervalMsec {16};
+
+        BoardView *const boardView;
+        QTimer *timer;
+        QSet<int> movedNodeRects;
+        QSet<int> movedGroupBoxes;
+        QSet<int> movedDataViewBoxes;
+
+        void schedule();
+    };
+    FrameUpdateScheduler frameUpdateScheduler {this};
+
+    //!
+    //! When enabled, routes the EdgeArrow's having no joints set by user around NodeRect's and
+    //! group-boxes, by setting their joints (which are not saved). The routes are computed in a
+    //! background thread by \c EdgeRouter. After rects change, only the routes whose corridors
+    //! (the bounding rects of the routes and their cards) intersect the old or new rects are
+    //! recomputed, when the changes pause.
+    //!
+    class AutoEdgeRouting
+    {
+    public:
+        explicit AutoEdgeRouting(BoardView *boardView);
+
+        void setEnabled(const bool enabled);
+        bool isEnabled() const;
+
+        //!
+        //! Call this after a NodeRect or group-box is created, moved, resized or removed.
+        //! \param oldRect: null if the box is created
+        //! \param newRect: null if the box is removed
+        //!
+        void markBoxRectChanged(const QRectF &oldRect, const QRectF &newRect);
+
+        //!
+        //! Call this after EdgeArrow's are created or removed.
+        //!
+        void markRelationshipsChanged(const QSet<RelationshipId> &relIds);
+
+        //!
+        //! Call this when the user has set the joints of an EdgeArrow. It will not be routed
+        //! unless its joints are all removed.
+        //!
+        void onJointsSetByUser(const RelationshipId &relId);
+
+        bool isAutoRouted(const RelationshipId &relId) const;
+
+        //!
+        //! Clears all data (including the pending and running routing), without resetting the
+        //! joints of EdgeArrow's. Call this when all items are closed.
+        //!
+        void clear();
+
+    private:
+        constexpr static int delayMsec {150};
+
+        BoardView *const boardView;
+        bool enabled {false};
+        QTimer *timer; // delays routing while the rects keep changing
+        EdgeRouter *router {nullptr}; // while routing
+        QVector<RelationshipId> relIdsBeingRouted; // (the requests of `router`)
+
+        QSet<RelationshipId> autoRoutedRels; // (EdgeArrow's whose joints are set by this)
+        QSet<RelationshipId> relsToRoute;
+
+        RectTree corridorsIndex;
+        QHash<RelationshipId, int> relIdToCorridorId;
+        QHash<int, RelationshipId> corridorIdToRelId;
+        int nextCorridorId {0};
+
+        bool canRoute(const RelationshipId &relId) const;
+                // EdgeArrow exists and has no joints set by user
+        void schedule();
+        void startRouting();
+        void onRoutingFinished(const bool ok);
+        void setCorridor(const RelationshipId &relId, const QRectF &corridor);
+        void removeCorridor(const RelationshipId &relId);
+    };
+    AutoEdgeRouting autoEdgeRouting {this};
+
+    // auto-layout
+    constexpr static int autoLayoutAnimationMsec {800};
+    constexpr static double autoLayoutGroupBoxPadding {16.0};
+            // extra space between a group-box's contents rect and its child items
+
+    ForceDirectedLayout *autoLayout {nullptr}; // while the layout is being computed
+    QVariantAnimation *autoLayoutAnimation {nullptr}; // while the result is being animated
+
+    //!
+    //! Moves the NodeRect's & group-boxes from their current rects to the layout's \e result
+    //! (animated), then saves the new rects. The graphics view stays non-interactive until then.
+    //! \param cardIds, groupBoxIds: the IDs of the layout's boxes and groups, respectively
+    //!
+    void animateAutoLayoutResult(
+            const QVector<int> &cardIds, const QVector<int> &groupBoxIds,
+            const ForceDirectedLayout::Result &result);
+
+    //!
+    //! Moves \e rect (without resizing it) to within \e bounds, to a position on the grid if
+    //! possible. If \e rect is larger than \e bounds, its top-left is at that of \e bounds.
+    //!
+    static QRectF placeRectWithin(const QRectF &rect, const QRectF &bounds, const double grid);
+
+    //!
+    //! Sets the rects, and updates what depends on them (spatial indices, relationship bundles
+    //! and EdgeArrow's). Does not save to AppData.
+    //!
+    void setRectsOfNodeRectsAndGroupBoxes(
+            const QVector<int> &cardIds, const QVector<QRectF> &nodeRectRects,
+            const QVector<int> &groupBoxIds, const QVector<QRectF> &groupBoxRects);
+
+    //!
+    //! Cancels the computation or the animation of auto-layout (without saving), if any.
+    //!
+    void stopAutoLayout();
 
     // tools
     void getWorkspaceId(std::function<void (const int workspaceId)> callback);
             // `workspaceId` can be -1
 
     QRectF getContentsRectInCanvasCoordinates() const;
+    static QRectF computeBoundingRectOfBoxes(const Board &board);
+            // NodeRect's, DataViewBox's, group-boxes & setting-boxes of `board`
 
     static QColor getSceneBackgroundColor(const bool isDarkTheme);
     QColor getEdgeArrowLineColor() const; // calls AppDataReadonly
     QColor getEdgeArrowLabelColor() const; // calls AppDataReadonly
+    static QColor computeEdgeArrowLineColor(const bool isDarkTheme);
+    static QColor computeEdgeArrowLabelColor(const bool isDarkTheme);
     static QColor computeGroupBoxColor(const bool isDarkTheme);
 
     QPoint getScreenPosFromScenePos(const QPointF &scenePos) const;
     QPointF getViewCenterInScene() const;
     void setViewTopLeftPos(const QPointF &canvasPos);
     void moveSceneRelativeToView(const QPointF &displacement); // displacement: in pixel
+    QPoint getScrollBarsValues() const;
+    void onViewScrolled();
+    QRectF getViewportRectInCanvas(const double marginFraction) const;
+            // the viewport's rect expanded by `marginFraction` of its width & height on each side
+
+    void setRenderingProfilerShown(const bool show); // also applies to the EdgeArrow's
+
+    // minimap
+    void updateMinimapNodeRect(const int cardId); // removes it from the minimap if not found
+    void updateMinimapGroupBox(const int groupBoxId); // removes it from the minimap if not found
+    void updateMinimapViewport();
+    void adjustMinimapPosition(); // (at the bottom-right corner of `graphicsView`)
 
     static QColor computeNodeRectDisplayColor(
             const QColor &nodeRectOwnColor,
-            const QSet<QString> &cardLabels,
-            const QVector<LabelAndColor> &cardLabelsAndAssociatedColors,
+            const QSet<Symbol> &cardLabels,
+            const LabelRulesTable<QColor> &cardLabelColorsTable,
             const QColor &boardDefaultColorForNodeRect,
             const bool invertLightness);
     static QColor computeDataViewBoxDisplayColor(
@@ -574,13 +993,9 @@ private:
 
     QSet<RelationshipId> getEdgeArrowsConnectingNodeRect(const int cardId);
 
-    static QLineF computeArrowLineConnectingRects(
-            const QRectF &fromRect, const QRectF &toRect,
-            const int parallelIndex, const int parallelCount);
-
     static QString computeCardPropertiesDisplay(
-            CardPropertiesToShow effectiveCardPropertiesToShowSetting,
-            const QSet<QString> &cardLabels,
+            const CardPropertiesToShow::CompiledTable &cardPropertiesToShowTable,
+            const QSet<Symbol> &cardLabels,
             const QHash<QString, QJsonValue> &cardCustomProperties);
 };
 
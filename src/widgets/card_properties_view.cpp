@@ -213,7 +213,7 @@ void CardPropertiesView::loadCard(const int cardIdToLoad) {
         Services::instance()->getAppDataReadonly()->queryCards(
             {cardIdToLoad},
             // callback
-            [this, cardIdToLoad](bool ok, const QHash<int, Card> &cardsData) {
+            [this, cardIdToLoad](bool ok, const QHash<int, CardSnapshot> &cardsData) {
                 if (!ok || !cardsData.contains(cardIdToLoad)) {
                     qWarning().noquote()
                             << QString("could not get data of card %1").arg(cardIdToLoad);
@@ -221,7 +221,7 @@ void CardPropertiesView::loadCard(const int cardIdToLoad) {
                     return;
                 }
 
-                Card cardData = cardsData.value(cardIdToLoad);
+                const Card &cardData = *cardsData.value(cardIdToLoad);
                 loadCardProperties(cardData.title, cardData.getCustomProperties());
                 labelLoadingMsg->setVisible(false);
                 if (!cardData.getCustomProperties().isEmpty()) {
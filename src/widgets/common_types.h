@@ -3,4 +3,13 @@
 
 enum class ZoomAction { ZoomIn, ZoomOut, ResetZoom };
 
+//!
+//! Level of detail of board items, depending on the zoom scale.
+//!
+enum class LevelOfDetail {
+    Full,
+    TitleOnly, //!< hides small texts (e.g., card text & properties, arrow labels)
+    BoxOnly //!< draws boxes & arrows without any text
+};
+
 #endif // COMMON_TYPES_H
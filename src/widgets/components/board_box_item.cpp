@@ -78,18 +78,38 @@ void BoardBoxItem::setColor(const QColor &color_) {
 }
 
 void BoardBoxItem::setIsHighlighted(const bool isHighlighted_) {
+    if (isHighlighted_ == isHighlighted)
+        return;
     isHighlighted = isHighlighted_;
     update();
 }
 
+void BoardBoxItem::setLevelOfDetail(const LevelOfDetail lod) {
+    if (lod == levelOfDetail)
+        return;
+    levelOfDetail = lod;
+
+    captionBarLeftTextItem->setVisible(levelOfDetail != LevelOfDetail::BoxOnly);
+    captionBarRightTextItem->setVisible(levelOfDetail == LevelOfDetail::Full);
+    adjustContents();
+}
+
 QRectF BoardBoxItem::getRect() const {
     return borderOuterRect;
 }
 
+QColor BoardBoxItem::getColor() const {
+    return color;
+}
+
 bool BoardBoxItem::getIsHighlighted() const {
     return isHighlighted;
 }
 
+LevelOfDetail BoardBoxItem::getLevelOfDetail() const {
+    return levelOfDetail;
+}
+
 QRectF BoardBoxItem::getContentsRect() const {
     return contentsRectItem->rect();
 }
@@ -136,8 +156,14 @@ QPainterPath BoardBoxItem::shape() const {
 
 void BoardBoxItem::paint(
         QPainter *painter, const QStyleOptionGraphicsItem */*option*/, QWidget */*widget*/) {
+    RenderingProfiler::instance()->onTopLevelItemPaintStarted(getPaintedClass());
+
     painter->save();
 
+    const bool boxOnly = (levelOfDetail == LevelOfDetail::BoxOnly);
+    if (boxOnly) // (rounded corners & antialiasing are not noticeable at this level)
+        painter->setRenderHint(QPainter::Antialiasing, false);
+
     // draw border rect
     {
         std::optional<Qt::PenStyle> penStyle;
@@ -156,7 +182,7 @@ void BoardBoxItem::paint(
 
         painter->setBrush(Qt::NoBrush);
         painter->setPen(QPen {QBrush(color), borderWidth, penStyle.value()});
-        const double radius = borderWidth;
+        const double radius = boxOnly ? 0.0 : borderWidth;
         painter->drawRoundedRect(
                 borderOuterRect.marginsRemoved(uniformMarginsF(borderWidth / 2.0)),
                 radius, radius);
@@ -6,6 +6,8 @@
 #include <QGraphicsView>
 #include <QMenu>
 #include <QRectF>
+#include "widgets/common_types.h"
+#include "widgets/rendering_profiler.h"
 
 class GraphicsItemMoveResize;
 
@@ -44,9 +46,18 @@ public:
     void setColor(const QColor &color_);
     void setIsHighlighted(const bool isHighlighted_);
 
+    //!
+    //! Hides the caption bar's right text below \c LevelOfDetail::Full and its left text at
+    //! \c LevelOfDetail::BoxOnly, then calls \c adjustContents(). Does nothing if \e lod is
+    //! the current level.
+    //!
+    void setLevelOfDetail(const LevelOfDetail lod);
+
     //
     QRectF getRect() const;
+    QColor getColor() const;
     bool getIsHighlighted() const;
+    LevelOfDetail getLevelOfDetail() const;
     QRectF getContentsRect() const;
 
     //
@@ -56,6 +67,12 @@ public:
             QPainter *painter, const QStyleOptionGraphicsItem *option,
             QWidget *widget) override;
 
+    // ==== tools ====
+
+    static QBrush getContentsRectItemBrush(
+            const ContentsBackgroundType contentsBackgroundType, const bool isDarkTheme);
+    static QColor getCaptionBarTextColor(const bool isDarkTheme);
+
 signals:
     void aboutToMove();
     void aboutToResize(QRectF *mustKeepEnclosingRect);
@@ -90,6 +107,7 @@ private:
     double borderWidth {5.0};
     QColor color {160, 160, 160};
     bool isHighlighted {false};
+    LevelOfDetail levelOfDetail {LevelOfDetail::Full};
 
     QRectF captionBarRect;
     double captionBarFontHeight;
@@ -139,11 +157,7 @@ private:
     virtual void onMouseLeftPressed(const bool isOnCaptionBar, const Qt::KeyboardModifiers modifiers);
     virtual void onMouseLeftClicked(const bool isOnCaptionBar, const Qt::KeyboardModifiers modifiers);
 
-    // ==== tools ====
-
-    static QBrush getContentsRectItemBrush(
-            const ContentsBackgroundType contentsBackgroundType, const bool isDarkTheme);
-    static QColor getCaptionBarTextColor(const bool isDarkTheme);
+    virtual RenderingProfiler::PaintedClass getPaintedClass() const = 0; // for profiling
 };
 
 #endif // BOARDBOXITEM_H
@@ -0,0 +1,108 @@
+#include <QMouseEvent>
+#include <QPainter>
+#include "board_minimap.h"
+
+BoardMinimap::BoardMinimap(QWidget *parent)
+        : QFrame(parent)
+        , renderer(new MinimapRenderer(QSize(0, 0), this)) {
+    setFrameShape(QFrame::Box);
+    setLineWidth(1);
+    setCursor(Qt::PointingHandCursor);
+
+    renderer->setPaused(true);
+    QFrame::setVisible(false);
+
+    connect(renderer, &MinimapRenderer::imageUpdated, this, [this]() {
+        update();
+    });
+}
+
+void BoardMinimap::setVisible(bool visible) {
+    renderer->setPaused(!visible);
+    QFrame::setVisible(visible);
+}
+
+void BoardMinimap::setBackgroundColor(const QColor &color) {
+    renderer->setBackgroundColor(color);
+}
+
+void BoardMinimap::setViewportColor(const QColor &color) {
+    viewportColor = color;
+    update();
+}
+
+void BoardMinimap::setNodeRect(const int cardId, const QRectF &rect, const QColor &color) {
+    MinimapRenderer::Item item;
+    item.rect = rect;
+    item.fillColor = color;
+    renderer->setItem({NodeRectsLayer, cardId}, item);
+}
+
+void BoardMinimap::removeNodeRect(const int cardId) {
+    renderer->removeItem({NodeRectsLayer, cardId});
+}
+
+void BoardMinimap::setGroupBox(const int groupBoxId, const QRectF &rect, const QColor &color) {
+    MinimapRenderer::Item item;
+    item.rect = rect;
+    item.borderColor = color;
+    renderer->setItem({GroupBoxesLayer, groupBoxId}, item);
+}
+
+void BoardMinimap::removeGroupBox(const int groupBoxId) {
+    renderer->removeItem({GroupBoxesLayer, groupBoxId});
+}
+
+void BoardMinimap::clear() {
+    renderer->clear();
+}
+
+void BoardMinimap::setViewportRect(const QRectF &rect) {
+    if (rect == viewportRect)
+        return;
+    viewportRect = rect;
+    if (isVisible())
+        update();
+}
+
+void BoardMinimap::paintEvent(QPaintEvent *event) {
+    {
+        QPainter painter(this);
+        const QRect contents = contentsRect();
+        painter.setClipRect(contents);
+        painter.drawImage(contents.topLeft(), renderer->getImage());
+
+        if (!renderer->getSceneRect().isNull() && !viewportRect.isNull()) {
+            const QRectF rect
+                    = renderer->mapFromScene(viewportRect).translated(contents.topLeft());
+            QColor fillColor = viewportColor;
+            fillColor.setAlpha(40);
+            painter.setPen(QPen(viewportColor, 1.5));
+            painter.setBrush(fillColor);
+            painter.drawRect(rect);
+        }
+    }
+
+    QFrame::paintEvent(event); // (draws the frame)
+}
+
+void BoardMinimap::resizeEvent(QResizeEvent *event) {
+    QFrame::resizeEvent(event);
+    renderer->setImageSize(contentsRect().size());
+}
+
+void BoardMinimap::mousePressEvent(QMouseEvent *event) {
+    if (event->button() != Qt::LeftButton || renderer->getSceneRect().isNull()) {
+        QFrame::mousePressEvent(event);
+        return;
+    }
+    emit userToCenterViewOn(renderer->mapToScene(event->pos() - contentsRect().topLeft()));
+}
+
+void BoardMinimap::mouseMoveEvent(QMouseEvent *event) {
+    if (!(event->buttons() & Qt::LeftButton) || renderer->getSceneRect().isNull()) {
+        QFrame::mouseMoveEvent(event);
+        return;
+    }
+    emit userToCenterViewOn(renderer->mapToScene(event->pos() - contentsRect().topLeft()));
+}
@@ -0,0 +1,53 @@
+#ifndef BOARD_MINIMAP_H
+#define BOARD_MINIMAP_H
+
+#include <QFrame>
+#include "utilities/minimap_renderer.h"
+
+//!
+//! A small overview (to be floating on a graphics view) of the NodeRect's and group-boxes of a
+//! board, with a frame showing the viewport. Clicking or dragging on it emits
+//! \c userToCenterViewOn().
+//!
+//! The overview is a cached low-resolution render (see \c MinimapRenderer), which is updated
+//! only where the items change. Rendering is paused while this is hidden.
+//!
+//! Coordinates are those of the board's canvas.
+//!
+class BoardMinimap : public QFrame
+{
+    Q_OBJECT
+public:
+    explicit BoardMinimap(QWidget *parent = nullptr);
+
+    void setVisible(bool visible) override;
+
+    void setBackgroundColor(const QColor &color);
+    void setViewportColor(const QColor &color);
+
+    void setNodeRect(const int cardId, const QRectF &rect, const QColor &color);
+    void removeNodeRect(const int cardId);
+    void setGroupBox(const int groupBoxId, const QRectF &rect, const QColor &color);
+    void removeGroupBox(const int groupBoxId);
+    void clear();
+
+    void setViewportRect(const QRectF &rect);
+
+signals:
+    void userToCenterViewOn(const QPointF &pos);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+
+private:
+    enum Layer {GroupBoxesLayer = 0, NodeRectsLayer = 1};
+
+    MinimapRenderer *renderer;
+    QRectF viewportRect;
+    QColor viewportColor {36, 128, 220};
+};
+
+#endif // BOARD_MINIMAP_H
@@ -64,6 +64,22 @@ void CustomTextEdit::setMarkdown(const QString &text) {
     textChangeIsByUser = true;
 }
 
+void CustomTextEdit::setDocumentCopy(const QTextDocument *document) {
+    textChangeIsByUser = false;
+
+    //
+    QTextDocument *oldDocument = textEdit->document();
+    QTextDocument *newDocument = document->clone(textEdit);
+    newDocument->setDefaultFont(oldDocument->defaultFont());
+    textEdit->setDocument(newDocument);
+
+    if (oldDocument->parent() == textEdit) // (a copy set previously; not deleted by `textEdit`)
+        delete oldDocument;
+
+    //
+    textChangeIsByUser = true;
+}
+
 void CustomTextEdit::setReadOnly(const bool readonly) {
     textEdit->setReadOnly(readonly);
 }
@@ -82,51 +98,13 @@ void CustomTextEdit::setVerticalScrollBarTurnedOn(const bool b) {
 
 void CustomTextEdit::setLineHeightPercent(const int percentage) {
     textChangeIsByUser = false;
-
-    //
-    auto cursor = textEdit->textCursor();
-    cursor.movePosition(QTextCursor::Start);
-    while (true) {
-        auto blockFormat = cursor.blockFormat();
-        blockFormat.setLineHeight(percentage, QTextBlockFormat::ProportionalHeight);
-
-        cursor.movePosition(QTextCursor::EndOfBlock, QTextCursor::KeepAnchor); // select the block
-        cursor.setBlockFormat(blockFormat);
-
-        bool ok = cursor.movePosition(QTextCursor::NextBlock);
-        if (!ok)
-            break;
-    }
-
-    //
+    applyLineHeightPercent(textEdit->document(), percentage);
     textChangeIsByUser = true;
 }
 
 void CustomTextEdit::setParagraphSpacing(const double spacing) {
     textChangeIsByUser = false;
-
-    //
-    auto cursor = textEdit->textCursor();
-    cursor.movePosition(QTextCursor::Start);
-    while (true) {
-        cursor.movePosition(QTextCursor::EndOfBlock, QTextCursor::KeepAnchor); // select the block
-
-        const bool isListItem = (cursor.block().textList() != nullptr);
-        if (!isListItem) {
-            auto blockFormat = cursor.blockFormat();
-            blockFormat.setTopMargin(spacing / 2.0);
-            blockFormat.setBottomMargin(spacing / 2.0);
-
-            cursor.setBlockFormat(blockFormat);
-        }
-
-        // move to next block
-        bool ok = cursor.movePosition(QTextCursor::NextBlock);
-        if (!ok)
-            break;
-    }
-
-    //
+    applyParagraphSpacing(textEdit->document(), spacing);
     textChangeIsByUser = true;
 }
 
@@ -160,6 +138,44 @@ int CustomTextEdit::currentTextCursorPosition() const {
     return textEdit->textCursor().position();
 }
 
+void CustomTextEdit::applyLineHeightPercent(QTextDocument *document, const int percentage) {
+    QTextCursor cursor(document);
+    cursor.movePosition(QTextCursor::Start);
+    while (true) {
+        auto blockFormat = cursor.blockFormat();
+        blockFormat.setLineHeight(percentage, QTextBlockFormat::ProportionalHeight);
+
+        cursor.movePosition(QTextCursor::EndOfBlock, QTextCursor::KeepAnchor); // select the block
+        cursor.setBlockFormat(blockFormat);
+
+        bool ok = cursor.movePosition(QTextCursor::NextBlock);
+        if (!ok)
+            break;
+    }
+}
+
+void CustomTextEdit::applyParagraphSpacing(QTextDocument *document, const double spacing) {
+    QTextCursor cursor(document);
+    cursor.movePosition(QTextCursor::Start);
+    while (true) {
+        cursor.movePosition(QTextCursor::EndOfBlock, QTextCursor::KeepAnchor); // select the block
+
+        const bool isListItem = (cursor.block().textList() != nullptr);
+        if (!isListItem) {
+            auto blockFormat = cursor.blockFormat();
+            blockFormat.setTopMargin(spacing / 2.0);
+            blockFormat.setBottomMargin(spacing / 2.0);
+
+            cursor.setBlockFormat(blockFormat);
+        }
+
+        // move to next block
+        bool ok = cursor.movePosition(QTextCursor::NextBlock);
+        if (!ok)
+            break;
+    }
+}
+
 bool CustomTextEdit::eventFilter(QObject *watched, QEvent *event) {
     if (watched == textEdit) {
         if (event->type() == QEvent::KeyPress) {
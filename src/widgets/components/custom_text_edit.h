@@ -22,6 +22,12 @@ public:
     void setPlainText(const QString &text);
     void setMarkdown(const QString &text);
 
+    //!
+    //! Shows a copy of \e document (with the current default font), e.g., one from a cache of
+    //! rendered documents.
+    //!
+    void setDocumentCopy(const QTextDocument *document);
+
     void setReadOnly(const bool readonly);
     void enableSetEveryWheelEventAccepted(const bool enable);
     void obtainFocus();
@@ -55,6 +61,10 @@ public:
     //
     bool eventFilter(QObject *watched, QEvent *event) override;
 
+    // tools (only touch `document`, so can be used in any thread)
+    static void applyLineHeightPercent(QTextDocument *document, const int percentage);
+    static void applyParagraphSpacing(QTextDocument *document, const double spacing);
+
 signals:
     void textEdited();
     void clicked();
@@ -10,6 +10,7 @@
 #include "services.h"
 #include "utilities/filenames_util.h"
 #include "utilities/json_util.h"
+#include "widgets/components/profiled_proxy_widget.h"
 #include "widgets/widgets_constants.h"
 
 DataViewBox::DataViewBox(const int customDataQueryId, QGraphicsItem *parent)
@@ -24,7 +25,7 @@ DataViewBox::DataViewBox(const int customDataQueryId, QGraphicsItem *parent)
         , queryParamsErrorMsgItem(new CustomGraphicsTextItem) //
         , labelQueryResult(new QGraphicsSimpleTextItem) //
         , textEdit(new CustomTextEdit(nullptr))
-        , textEditProxyWidget(new QGraphicsProxyWidget) { //
+        , textEditProxyWidget(new ProfiledProxyWidget) { //
 }
 
 DataViewBox::~DataViewBox() {
@@ -480,6 +481,10 @@ void DataViewBox::onMouseLeftClicked(
     // do nothing
 }
 
+RenderingProfiler::PaintedClass DataViewBox::getPaintedClass() const {
+    return RenderingProfiler::PaintedClass::DataViewBox;
+}
+
 void DataViewBox::setResultDisplayFormat(const ResultDisplayFormat format) {
     if (resultDisplayFormat == format)
         return;
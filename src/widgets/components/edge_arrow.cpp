@@ -9,22 +9,24 @@
 #include "services.h"
 #include "utilities/geometry_util.h"
 #include "widgets/components/drag_point_events_handler.h"
+#include "widgets/rendering_profiler.h"
 
 constexpr double vicinityCriterion = 4;
 
 EdgeArrow::EdgeArrow(QGraphicsItem *parent)
         : QGraphicsObject(parent)
+        , vicinity(vicinityCriterion)
         , labelItem(new QGraphicsSimpleTextItem(this))
         , arrowHeadItem(new QGraphicsPolygonItem(this))
         , dragPointEventsHandler(new DragPointEventsHandler(this)) {
-    setFlag(QGraphicsItem::ItemHasNoContents);
+    setFlag(QGraphicsItem::ItemHasNoContents, !RenderingProfiler::instance()->isEnabled());
     setAcceptHoverEvents(true);
 
     arrowHeadItem->setPen(Qt::NoPen);
 
     {
         QFont font;
-        font.setPixelSize(13);
+        font.setPixelSize(labelFontPixelSize);
         labelItem->setFont(font);
     }
 
@@ -62,25 +64,55 @@ void EdgeArrow::setJoints(const QVector<QPointF> &joints_){
     adjustChildItems();
 }
 
+void EdgeArrow::setLevelOfDetail(const LevelOfDetail lod) {
+    if (lod == levelOfDetail)
+        return;
+    levelOfDetail = lod;
+    adjustLabelItem();
+}
+
 void EdgeArrow::setAllowAddingJoints(const bool allow) {
     allowAddingJoints = allow;
 }
 
+void EdgeArrow::setProfilingEnabled(const bool enabled) {
+    setFlag(QGraphicsItem::ItemHasNoContents, !enabled);
+}
+
 QVector<QPointF> EdgeArrow::getJoints() const {
     return joints;
 }
 
 QRectF EdgeArrow::boundingRect() const {
-    return currentShape.boundingRect();
+    return vicinity.boundingRect();
 }
 
 QPainterPath EdgeArrow::shape() const {
-    return currentShape;
+    return vicinity.path();
+}
+
+bool EdgeArrow::contains(const QPointF &point) const {
+    return vicinity.contains(point);
+}
+
+bool EdgeArrow::collidesWithPath(
+        const QPainterPath &path, Qt::ItemSelectionMode mode) const {
+    // Mouse & hover events are dispatched by testing items against a 1-pixel rect around the
+    // cursor. When that rect is small compared to the vicinity, test its center analytically
+    // instead of intersecting it with shape(). Other cases fall back to the default.
+    const QRectF pathRect = path.controlPointRect();
+    if (mode == Qt::IntersectsItemShape
+            && pathRect.width() <= vicinityCriterion && pathRect.height() <= vicinityCriterion) {
+        return vicinity.contains(pathRect.center());
+    }
+    return QGraphicsObject::collidesWithPath(path, mode);
 }
 
 void EdgeArrow::paint(
         QPainter */*painter*/, const QStyleOptionGraphicsItem */*option*/, QWidget */*widget*/) {
-    // do nothing
+    // (the child items do the painting)
+    RenderingProfiler::instance()->onTopLevelItemPaintStarted(
+            RenderingProfiler::PaintedClass::EdgeArrow);
 }
 
 void EdgeArrow::hoverMoveEvent(QGraphicsSceneHoverEvent *event) {
@@ -88,22 +120,9 @@ void EdgeArrow::hoverMoveEvent(QGraphicsSceneHoverEvent *event) {
         return;
 
     //
-    int jointIndex = -1;
-    int lineIndex = -1;
-    for (int i = 0; i < joints.count(); ++i) {
-        if (vicinityOfJoint(joints.at(i)).contains(event->pos())) {
-            jointIndex = i;
-            break;
-        }
-    }
-    if (jointIndex == -1) {
-        for (int i = 0; i < lineItems.count(); ++i) {
-            if (vicinityOfLine(lineItems.at(i)->line()).contains(event->pos())) {
-                lineIndex = i;
-                break;
-            }
-        }
-    }
+    const int jointIndex = vicinity.findJointAt(event->pos());
+    const int lineIndex = (jointIndex == -1) ? vicinity.findSegmentAt(event->pos()) : -1;
+        // (line index is also the segment index)
 
     //
     dragPointData.clear();
@@ -209,7 +228,7 @@ void EdgeArrow::adjustChildItems() {
     }
 
     // arrow head
-    const double arrowHeadSize = (4.0 * lineWidth * lineWidth + 16) / (lineWidth + 1.0);
+    const double arrowHeadSize = computeArrowHeadSize(lineWidth);
 
     const QPolygonF polygon = computeArrowHeadPolygon(
             lineItems.last()->line(), arrowHeadSize);
@@ -217,10 +236,29 @@ void EdgeArrow::adjustChildItems() {
     arrowHeadItem->setBrush(lineColor);
 
     // label
+    adjustLabelItem();
+
+    // update `vicinity`
+    QVector<QPointF> points;
+    points.reserve(joints.count() + 2);
+    points << startPoint << joints << endPoint;
+
+    prepareGeometryChange(); // (bounding rect & shape are about to change)
+    vicinity.setPoints(points);
+}
+
+void EdgeArrow::adjustLabelItem() {
+    if (levelOfDetail != LevelOfDetail::Full) {
+        labelItem->setVisible(false);
+        return;
+    }
+    if (lineItems.isEmpty()) // (not adjusted yet)
+        return;
+
+    labelItem->setVisible(true);
     labelItem->setText(label);
     const QSizeF textBoundingSize = labelItem->boundingRect().size();
 
-    constexpr double labelAndLineSpacing = 2.0;
     constexpr bool textIsAbove = true;
     const auto [textPos, textRotationClockwise] = computeLabelPositionAndRotation(
             lineItems.first()->line(), textBoundingSize, labelAndLineSpacing, textIsAbove);
@@ -228,9 +266,6 @@ void EdgeArrow::adjustChildItems() {
 
     labelItem->setPos(textPos);
     labelItem->setRotation(textRotationClockwise);
-
-    // update `currentShape`
-    currentShape = updateShape();
 }
 
 std::pair<QPointF, double> EdgeArrow::computeLabelPositionAndRotation(
@@ -260,6 +295,10 @@ std::pair<QPointF, double> EdgeArrow::computeLabelPositionAndRotation(
     return {textPos, textRotationClockwise};
 }
 
+double EdgeArrow::computeArrowHeadSize(const double lineWidth) {
+    return (4.0 * lineWidth * lineWidth + 16) / (lineWidth + 1.0);
+}
+
 QPolygonF EdgeArrow::computeArrowHeadPolygon(const QLineF &line, const double size) {
     constexpr double theta = 27; // degree
 
@@ -277,29 +316,6 @@ QPolygonF EdgeArrow::computeArrowHeadPolygon(const QLineF &line, const double si
     return QPolygonF(QVector<QPointF> {line1.p2(), line1.p1(), line2.p2(), line1.p2()});
 }
 
-QPainterPath EdgeArrow::updateShape() const {
-    QPainterPath path;
-    path.setFillRule(Qt::WindingFill);
-
-    for (QGraphicsLineItem *lineItems: qAsConst(lineItems))
-        path.addPath(vicinityOfLine(lineItems->line()));
-
-    for (const QPointF &joint: qAsConst(joints))
-        path.addPath(vicinityOfJoint(joint));
-
-    return path;
-}
-
-QPainterPath EdgeArrow::vicinityOfLine(const QLineF line) {
-    return tiltedRect(line, vicinityCriterion * 2.0);
-}
-
-QPainterPath EdgeArrow::vicinityOfJoint(const QPointF joint) {
-    QPainterPath path;
-    path.addRect(squareCenteredAt(joint, vicinityCriterion * 2.0));
-    return path;
-}
-
 //====
 
 EdgeArrow::DragPoint::DragPoint(EdgeArrow *edgeArrow)
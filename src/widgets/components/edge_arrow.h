@@ -7,6 +7,8 @@
 #include <QGraphicsRectItem>
 #include <QGraphicsSimpleTextItem>
 #include <QPolygonF>
+#include "utilities/polyline_vicinity.h"
+#include "widgets/common_types.h"
 
 class DragPointEventsHandler;
 
@@ -24,17 +26,56 @@ public:
     void setLineColor(const QColor &color);
     void setJoints(const QVector<QPointF> &joints);
 
+    //!
+    //! The label is hidden (and not laid out) below \c LevelOfDetail::Full.
+    //!
+    void setLevelOfDetail(const LevelOfDetail lod);
+
     void setAllowAddingJoints(const bool allow);
 
+    //!
+    //! While profiling is enabled, \c paint() is called (for \c RenderingProfiler to attribute
+    //! the painting of the child items to this class).
+    //!
+    void setProfilingEnabled(const bool enabled);
+
     //
     QVector<QPointF> getJoints() const;
 
     //
     QRectF boundingRect() const override;
     QPainterPath shape() const override;
+    bool contains(const QPointF &point) const override; // analytic, without using shape()
+    bool collidesWithPath(
+            const QPainterPath &path, Qt::ItemSelectionMode mode) const override;
     void paint(
             QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
 
+    // ==== tools ====
+
+    static double computeArrowHeadSize(const double lineWidth);
+
+    //!
+    //! \param line
+    //! \param size: approximate length of the arrow head
+    //! \return
+    //!
+    static QPolygonF computeArrowHeadPolygon(const QLineF &line, const double size);
+
+    static constexpr double labelAndLineSpacing {2.0}; // (the label is beside the first segment)
+    static constexpr int labelFontPixelSize {13};
+
+    //!
+    //! \param line
+    //! \param labelBoundingSize
+    //! \param spacing: between label text and line
+    //! \param textIsAbove: if true [false], put text above [below] the line
+    //! \return (position, rotation-angle-clockwise)
+    //!
+    static std::pair<QPointF, double> computeLabelPositionAndRotation(
+            const QLineF &line, const QSizeF &labelBoundingSize,
+            const double spacing, const bool textIsAbove);
+
 signals:
     void jointMoved();
     void finishedUpdatingJoints(const QVector<QPointF> &joints);
@@ -51,8 +92,9 @@ private:
     QString label;
     bool allowAddingJoints {false};
     QVector<QPointF> joints;
+    LevelOfDetail levelOfDetail {LevelOfDetail::Full};
 
-    QPainterPath currentShape;
+    PolylineVicinity vicinity; // defines the hit-test shape & bounding rect
 
     // child items
     QVector<QGraphicsLineItem *> lineItems;
@@ -95,32 +137,10 @@ private:
     void setUpConnections();
 
     void adjustChildItems();
+    void adjustLabelItem();
 
     bool eventFilterForDragPoint(QEvent *event);
 
-    //
-
-    //!
-    //! \param line
-    //! \param labelBoundingSize
-    //! \param spacing: between label text and line
-    //! \param textIsAbove: if true [false], put text above [below] the line
-    //! \return (position, rotation-angle-clockwise)
-    //!
-    static std::pair<QPointF, double> computeLabelPositionAndRotation(
-            const QLineF &line, const QSizeF &labelBoundingSize,
-            const double spacing, const bool textIsAbove);
-
-    //!
-    //! \param line
-    //! \param size: approximate length of the arrow head
-    //! \return
-    //!
-    static QPolygonF computeArrowHeadPolygon(const QLineF &line, const double size);
-
-    QPainterPath updateShape() const;
-    static QPainterPath vicinityOfLine(const QLineF line);
-    static QPainterPath vicinityOfJoint(const QPointF joint);
 };
 
 #endif // EDGE_ARROW_H
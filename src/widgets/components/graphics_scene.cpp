@@ -7,6 +7,7 @@
 #include <QTimer>
 #include "graphics_scene.h"
 #include "utilities/numbers_util.h"
+#include "widgets/rendering_profiler.h"
 
 GraphicsScene::GraphicsScene(QObject *parent)
         : QGraphicsScene(parent)
@@ -51,7 +52,8 @@ void GraphicsScene::keyPressEvent(QKeyEvent *event) {
 
     case State::RightDragScrolling: [[fallthrough]];
     case State::LeftDragScrollStandby: [[fallthrough]];
-    case State::LeftDragScrolling:
+    case State::LeftDragScrolling: [[fallthrough]];
+    case State::RubberBandSelecting:
         event->accept();
         return;
     }
@@ -81,7 +83,8 @@ void GraphicsScene::keyReleaseEvent(QKeyEvent *event) {
         event->accept();
         return;
 
-    case State::LeftDragScrolling:
+    case State::LeftDragScrolling: [[fallthrough]];
+    case State::RubberBandSelecting:
         event->accept();
         return;
     }
@@ -101,6 +104,15 @@ void GraphicsScene::mousePressEvent(QGraphicsSceneMouseEvent *event) {
             state = State::RightPressed;
         }
         QGraphicsScene::mousePressEvent(event); // perform default behavior
+
+        if (!event->isAccepted()
+                && event->button() == Qt::LeftButton
+                && event->modifiers() == Qt::ShiftModifier) {
+            rubberBandStartScenePos = event->scenePos();
+            state = State::RubberBandSelecting;
+            emit rubberBandChanged(getRubberBandRect(event->scenePos()));
+            event->accept(); // (so that the following move & release events are received)
+        }
         return;
 
     case State::RightPressed:
@@ -119,7 +131,8 @@ void GraphicsScene::mousePressEvent(QGraphicsSceneMouseEvent *event) {
         event->accept();
         return;
 
-    case State::LeftDragScrolling:
+    case State::LeftDragScrolling: [[fallthrough]];
+    case State::RubberBandSelecting:
         event->accept();
         return;
     }
@@ -166,6 +179,11 @@ void GraphicsScene::mouseMoveEvent(QGraphicsSceneMouseEvent *event) {
         dragScroll(viewCenterBeforeDragScroll, event->screenPos() - mousePressScreenPos);
         event->accept();
         return;
+
+    case State::RubberBandSelecting:
+        emit rubberBandChanged(getRubberBandRect(event->scenePos()));
+        event->accept();
+        return;
     }
     Q_ASSERT(false); // case not implemented
 }
@@ -218,6 +236,14 @@ void GraphicsScene::mouseReleaseEvent(QGraphicsSceneMouseEvent *event) {
         }
         event->accept();
         return;
+
+    case State::RubberBandSelecting:
+        if (event->button() == Qt::LeftButton) {
+            state = State::Normal;
+            emit rubberBandFinished(getRubberBandRect(event->scenePos()));
+        }
+        event->accept();
+        return;
     }
     Q_ASSERT(false); // case not implemented
 }
@@ -231,7 +257,8 @@ void GraphicsScene::mouseDoubleClickEvent(QGraphicsSceneMouseEvent *event) {
 
     case State::RightDragScrolling: [[fallthrough]];
     case State::LeftDragScrollStandby: [[fallthrough]];
-    case State::LeftDragScrolling:
+    case State::LeftDragScrolling: [[fallthrough]];
+    case State::RubberBandSelecting:
         event->accept();
         return;
     }
@@ -296,6 +323,11 @@ void GraphicsScene::focusOutEvent(QFocusEvent *event) {
         endDragScolling();
         state = State::Normal;
         break;
+
+    case State::RubberBandSelecting:
+        state = State::Normal;
+        emit rubberBandCanceled();
+        break;
     }
 
     QGraphicsScene::focusOutEvent(event);
@@ -312,6 +344,18 @@ void GraphicsScene::contextMenuEvent(QGraphicsSceneContextMenuEvent *event) {
     }
 }
 
+void GraphicsScene::drawBackground(QPainter *painter, const QRectF &rect) {
+    // (called by the view at the start of each painting)
+    RenderingProfiler::instance()->onFrameStarted();
+    QGraphicsScene::drawBackground(painter, rect);
+}
+
+void GraphicsScene::drawForeground(QPainter *painter, const QRectF &rect) {
+    // (called by the view at the end of each painting)
+    QGraphicsScene::drawForeground(painter, rect);
+    RenderingProfiler::instance()->onFrameFinished();
+}
+
 void GraphicsScene::startDragScrolling() {
     if (auto *view = getView(); view != nullptr)
         view->viewport()->setCursor(Qt::ClosedHandCursor);
@@ -359,6 +403,10 @@ QPointF GraphicsScene::getViewCenterInScene() const {
     return view->mapToScene(view->viewport()->width() / 2, view->viewport()->height() / 2);
 }
 
+QRectF GraphicsScene::getRubberBandRect(const QPointF &currentScenePos) const {
+    return QRectF(rubberBandStartScenePos, currentScenePos).normalized();
+}
+
 int GraphicsScene::discretizeWheelDelta(const int delta) {
     if (delta >= 90)
         return 120;
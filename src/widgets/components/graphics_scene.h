@@ -8,7 +8,9 @@
 //!
 //! A subclass of QGraphicsScene that responds to mouse and keyboard events for
 //!   - drag-scrolling (scrolling by mouse dragging) the QGraphicsView,
-//!   - zooming in/out.
+//!   - zooming in/out,
+//!   - rubber-band selection (Shift + left-dragging on the background).
+//! It also marks the frames (paintings of the view) for \c RenderingProfiler.
 //!
 class GraphicsScene : public QGraphicsScene
 {
@@ -22,6 +24,10 @@ signals:
     void clickedOnBackground();
     void userToZoomInOut(bool zoomIn, const QPointF &anchorScenePos);
 
+    void rubberBandChanged(const QRectF &sceneRect);
+    void rubberBandFinished(const QRectF &sceneRect);
+    void rubberBandCanceled();
+
     void viewScrollingStarted();
     void viewScrollingFinished();
 
@@ -35,12 +41,15 @@ protected:
     void wheelEvent(QGraphicsSceneWheelEvent *event) override;
     void focusOutEvent(QFocusEvent *event) override;
     void contextMenuEvent(QGraphicsSceneContextMenuEvent *event) override;
+    void drawBackground(QPainter *painter, const QRectF &rect) override;
+    void drawForeground(QPainter *painter, const QRectF &rect) override;
 
 private:
     enum class State {
         Normal,
         RightPressed, RightDragScrolling,
-        LeftDragScrollStandby, LeftDragScrolling
+        LeftDragScrollStandby, LeftDragScrolling,
+        RubberBandSelecting
     };
     State state {State::Normal};
 
@@ -48,6 +57,7 @@ private:
     QPointF viewCenterBeforeDragScroll; // center of view in scene coordinates
     bool isSpaceKeyPressed {false};
     bool isLeftButtonPressed {false};
+    QPointF rubberBandStartScenePos;
 
     QTimer *timerResetAccumulatedWheelDelta;
     int accumulatedWheelDelta {0};
@@ -61,6 +71,7 @@ private:
 
     QGraphicsView *getView() const; // can be nullptr
     QPointF getViewCenterInScene() const;
+    QRectF getRubberBandRect(const QPointF &currentScenePos) const;
 
     //!
     //! \return a divisor of 120 (times -1 if \e delta is negative), or 0 \e delta is 0
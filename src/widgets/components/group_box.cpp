@@ -83,3 +83,7 @@ void GroupBox::onMouseLeftClicked(
         const bool /*isOnCaptionBar*/, const Qt::KeyboardModifiers /*modifiers*/) {
     // do nothing
 }
+
+RenderingProfiler::PaintedClass GroupBox::getPaintedClass() const {
+    return RenderingProfiler::PaintedClass::GroupBox;
+}
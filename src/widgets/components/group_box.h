@@ -38,6 +38,7 @@ private:
     void adjustContents() override;
     void onMouseLeftPressed(const bool isOnCaptionBar, const Qt::KeyboardModifiers modifiers) override;
     void onMouseLeftClicked(const bool isOnCaptionBar, const Qt::KeyboardModifiers modifiers) override;
+    RenderingProfiler::PaintedClass getPaintedClass() const override;
 };
 
 #endif // GROUPBOX_H
@@ -6,25 +6,32 @@
 #include "services.h"
 #include "utilities/colors_util.h"
 #include "utilities/margins_util.h"
+#include "utilities/markdown_render_cache.h"
 #include "widgets/components/custom_graphics_text_item.h"
 #include "widgets/components/custom_text_edit.h"
+#include "widgets/components/profiled_proxy_widget.h"
+#include "widgets/components/static_text_item.h"
 #include "widgets/widgets_constants.h"
 
 constexpr double textEditLineHeightPercentage = 120;
+constexpr int textEditFontPixelSize = 16;
+constexpr int maxTextLengthToRenderPreviewInPlace = 2000;
+        // longer texts are rendered in background (plain text is shown meanwhile)
 
 NodeRect::NodeRect(const int cardId, QGraphicsItem *parent)
     : BoardBoxItem(getCreationParameters(), parent)
     , cardId(cardId)
     , titleItem(new CustomGraphicsTextItem) // parent is set in setUpContents()
     , propertiesItem(new CustomGraphicsTextItem) // parent is set in setUpContents()
-    , textEdit(new CustomTextEdit(nullptr))
-    , textEditProxyWidget(new QGraphicsProxyWidget) // parent is set in setUpContents()
-    , textEditFocusIndicator(new QGraphicsRectItem(this)){
+    , textEditFocusIndicator(new QGraphicsRectItem(this))
+    , textSnapshotItem(new StaticTextItem) { // parent is set in setUpContents()
 }
 
 NodeRect::~NodeRect() {
     // Handle the TextEdit embeded in `textEditProxyWidget` exclusively. Without this, the program
     // crashes for unknown reason.
+    if (textEditProxyWidget == nullptr)
+        return;
     auto *textEdit = textEditProxyWidget->widget();
     if (textEdit != nullptr) {
         textEditProxyWidget->setWidget(nullptr);
@@ -36,6 +43,7 @@ NodeRect::~NodeRect() {
 
 void NodeRect::setNodeLabels(const QStringList &labels) {
     nodeLabels = labels;
+    nodeLabelSymbols = toSymbolSet(labels);
 
     constexpr bool bold = true;
     setCaptionBarLeftText(getNodeLabelsString(nodeLabels), bold);
@@ -54,11 +62,17 @@ void NodeRect::setPropertiesDisplay(const QString &propertiesDisplayText) {
 void NodeRect::setText(const QString &text) {
     plainText = text;
     textEditIsPreviewMode = false;
-    textEdit->setPlainText(text);
-    textEdit->setLineHeightPercent(textEditLineHeightPercentage);
+    textSnapshotItem->setText(text);
+    textEditCursorPositionWhenReleased = 0;
+
+    if (textEdit != nullptr) {
+        textEdit->setPlainText(text);
+        textEdit->setLineHeightPercent(textEditLineHeightPercentage);
+    }
     adjustContents();
 
-    textEdit->setTextCursorPosition(0);
+    if (textEdit != nullptr)
+        textEdit->setTextCursorPosition(0);
 }
 
 void NodeRect::setEditable(const bool editable) {
@@ -68,31 +82,49 @@ void NodeRect::setEditable(const bool editable) {
     titleItem->setTextInteractionState(
             editable ? TextInteractionState::Editable : TextInteractionState::Selectable);
 
-    textEdit->setReadOnly(
-            !computeTextEditEditable(nodeRectIsEditable, textEditIsPreviewMode));
+    if (textEdit != nullptr) {
+        textEdit->setReadOnly(
+                !computeTextEditEditable(nodeRectIsEditable, textEditIsPreviewMode));
+    }
 }
 
 void NodeRect::setTextEditorIgnoreWheelEvent(const bool b) {
     textEditIgnoreWheelEvent = b;
 }
 
+void NodeRect::setMarkdownRenderCache(MarkdownRenderCache *cache) {
+    markdownRenderCache = cache;
+}
+
 void NodeRect::togglePreview() {
     textEditIsPreviewMode = !textEditIsPreviewMode;
 
+    if (textEdit == nullptr) {
+        // (preview will be shown when `textEdit` is created)
+        if (textEditIsPreviewMode) {
+            textEditCursorPositionBeforePreviewMode = textEditCursorPositionWhenReleased;
+            if (markdownRenderCache != nullptr) {
+                markdownRenderCache->requestRendering(
+                        plainText, MarkdownRenderCache::Priority::Background, nullptr, this);
+            }
+        }
+        else {
+            textEditCursorPositionWhenReleased = textEditCursorPositionBeforePreviewMode;
+        }
+        return;
+    }
+
     if (textEditIsPreviewMode) {
         textEditCursorPositionBeforePreviewMode = textEdit->currentTextCursorPosition();
-
-        textEdit->setMarkdown(plainText);
-        textEdit->document()->setIndentWidth(20);
-        textEdit->setParagraphSpacing(20);
+        showPreviewInTextEdit();
     }
     else {
         textEdit->clear(true);
         textEdit->setPlainText(plainText);
+        textEdit->setLineHeightPercent(textEditLineHeightPercentage);
 
         textEdit->setTextCursorPosition(textEditCursorPositionBeforePreviewMode);
     }
-    textEdit->setLineHeightPercent(textEditLineHeightPercentage);
 
     textEdit->setReadOnly(
             !computeTextEditEditable(nodeRectIsEditable, textEditIsPreviewMode));
@@ -101,6 +133,31 @@ void NodeRect::togglePreview() {
     adjustContents();
 }
 
+void NodeRect::setContentsMaterialized(const bool materialized) {
+    if (contentsContainer == nullptr) { // not initialized yet
+        contentsMaterialized = materialized; // will be applied in setUpContents()
+        return;
+    }
+
+    if (materialized == contentsMaterialized)
+        return;
+
+    if (materialized) {
+        createTextEdit();
+    }
+    else {
+        if (textEditHasFocus)
+            return;
+        releaseTextEdit();
+    }
+    contentsMaterialized = materialized;
+    adjustContents();
+}
+
+bool NodeRect::getContentsMaterialized() const {
+    return contentsMaterialized;
+}
+
 int NodeRect::getCardId() const {
     return cardId;
 }
@@ -109,16 +166,20 @@ QSet<QString> NodeRect::getNodeLabels() const {
     return QSet<QString>(nodeLabels.constBegin(), nodeLabels.constEnd());
 }
 
+QSet<Symbol> NodeRect::getNodeLabelSymbols() const {
+    return nodeLabelSymbols;
+}
+
 QString NodeRect::getTitle() const {
     return titleItem->toPlainText();
 }
 
 QString NodeRect::getText() const {
-    return textEdit->toPlainText();
+    return plainText;
 }
 
 bool NodeRect::sceneEventFilter(QGraphicsItem *watched, QEvent *event) {
-    if (watched == textEditProxyWidget) {
+    if (watched == textEditProxyWidget && textEditProxyWidget != nullptr) {
         if (event->type() == QEvent::GraphicsSceneWheel) {
             if (textEditIgnoreWheelEvent)
                 return true;
@@ -180,7 +241,9 @@ void NodeRect::adjustCaptionBarContextMenuBeforePopup(QMenu */*contextMenu*/) {
     }
 }
 
-void NodeRect::setUpContents(QGraphicsItem *contentsContainer) {
+void NodeRect::setUpContents(QGraphicsItem *contentsContainer_) {
+    contentsContainer = contentsContainer_;
+
     titleItem->setParentItem(contentsContainer);
     titleItem->setEnableContextMenu(false);
 
@@ -189,10 +252,7 @@ void NodeRect::setUpContents(QGraphicsItem *contentsContainer) {
     using TextInteractionState = CustomGraphicsTextItem::TextInteractionState;
     propertiesItem->setTextInteractionState(TextInteractionState::Selectable);
 
-    //
-    textEditProxyWidget->setParentItem(contentsContainer);
-    textEdit->setVisible(false);
-    textEditProxyWidget->setWidget(textEdit);
+    textSnapshotItem->setParentItem(contentsContainer);
 
     // get view's font
     QFont fontOfView;
@@ -221,23 +281,17 @@ void NodeRect::setUpContents(QGraphicsItem *contentsContainer) {
         propertiesItem->setFont(font);
     }
 
-    //
-    textEdit->enableSetEveryWheelEventAccepted(true);
-    textEdit->setReadOnly(!computeTextEditEditable(nodeRectIsEditable, textEditIsPreviewMode));
-    textEdit->setReplaceTabBySpaces(4);
-    textEdit->setFrameShape(QFrame::NoFrame);
-    textEdit->setMinimumHeight(10);
-    textEdit->setContextMenuPolicy(Qt::NoContextMenu);
+    // -- text snapshot
+    {
+        QFont font = fontOfView;
+        font.setPixelSize(textEditFontPixelSize);
 
-    constexpr int textEditFontPixelSize = 16;
-    textEdit->setStyleSheet(
-            "QTextEdit {"
-            "  font-size: " + QString::number(textEditFontPixelSize) + "px;" +
-            "}"
-            "QScrollBar:vertical {"
-            "  width: 12px;"
-            "}"
-    );
+        textSnapshotItem->setFont(font);
+    }
+
+    //
+    if (contentsMaterialized)
+        createTextEdit();
 
     //
     const bool isDarkTheme = Services::instance()->getAppDataReadonly()->getIsDarkTheme();
@@ -251,10 +305,6 @@ void NodeRect::setUpContents(QGraphicsItem *contentsContainer) {
     const QString cardIdStr = (cardId >= 0) ? QString("Card %1").arg(cardId) : "";
     setCaptionBarRightText(cardIdStr);
 
-    // ==== install event filter ====
-
-    textEditProxyWidget->installSceneEventFilter(this);
-
     // ==== connections ====
 
     // titleItem
@@ -269,6 +319,7 @@ void NodeRect::setUpContents(QGraphicsItem *contentsContainer) {
     });
 
     connect(titleItem, &CustomGraphicsTextItem::tabKeyPressed, this, [this]() {
+        setContentsMaterialized(true);
         textEdit->obtainFocus();
     });
 
@@ -277,33 +328,12 @@ void NodeRect::setUpContents(QGraphicsItem *contentsContainer) {
         emit leftButtonPressedOrClicked();
     });
 
-    // textEdit
-    connect(textEdit, &CustomTextEdit::textEdited, this, [this]() {
-        if (!textEditIsPreviewMode) {
-            plainText = textEdit->toPlainText();
-            emit titleTextUpdated(std::nullopt, plainText);
-        }
-        //
-        textEdit->setVerticalScrollBarTurnedOn(!plainText.isEmpty());
-    });
-
-    connect(textEdit, &CustomTextEdit::clicked, this, [this]() {
-        emit leftButtonPressedOrClicked();
-    });
-
-    connect(textEdit, &CustomTextEdit::focusedIn, this, [this]() {
-        textEditFocusIndicator->setVisible(true);
-    });
-
-    connect(textEdit, &CustomTextEdit::focusedOut, this, [this]() {
-        textEditFocusIndicator->setVisible(false);
-    });
-
     //
     connect(Services::instance()->getAppDataReadonly(), &AppDataReadonly::isDarkThemeUpdated,
             this, [this](const bool isDarkTheme) {
         titleItem->setDefaultTextColor(getNormalTextColor(isDarkTheme));
         propertiesItem->setDefaultTextColor(getDimTextColor(isDarkTheme));
+        textSnapshotItem->setColor(getNormalTextColor(isDarkTheme));
         textEditFocusIndicator->setPen(
                 getTextEditFocusIndicator(isDarkTheme, textEditFocusIndicatorLineWidth));
     });
@@ -316,9 +346,20 @@ void NodeRect::adjustContents() {
     const QColor normalTextColor = getNormalTextColor(isDarkTheme);
     const QColor dimTextColor = getDimTextColor(isDarkTheme);
 
+    // (Below full detail, the hidden text items are not laid out.)
+    const LevelOfDetail lod = getLevelOfDetail();
+    const bool showsTitle = (lod != LevelOfDetail::BoxOnly);
+    const bool showsText = (lod == LevelOfDetail::Full) || textEditHasFocus;
+
     // title
     double yBottom = 0;
-    {
+    if (!showsTitle) {
+        titleItem->setVisible(false);
+        yBottom = contentsRect.top();
+    }
+    else {
+        titleItem->setVisible(true);
+
         constexpr int padding = 3;
         const double minHeight = QFontMetrics(titleItem->font()).height();
 
@@ -334,7 +375,7 @@ void NodeRect::adjustContents() {
 
     // properties
     {
-        if (propertiesItem->toPlainText().isEmpty()) {
+        if (!showsText || propertiesItem->toPlainText().isEmpty()) {
             propertiesItem->setVisible(false);
         }
         else {
@@ -354,21 +395,32 @@ void NodeRect::adjustContents() {
     // text
     double textEditHeight;
     {
-        textEdit->setVerticalScrollBarTurnedOn(!plainText.isEmpty());
-
-        //
         constexpr int leftPadding = 3;
-
         textEditHeight = contentsRect.bottom() - yBottom;
-        if (textEditHeight < 0.1) {
-            textEditProxyWidget->setVisible(false);
+
+        if (textEdit != nullptr) {
+            textEdit->setVerticalScrollBarTurnedOn(!plainText.isEmpty());
+
+            if (!showsText || textEditHeight < 0.1) {
+                textEditProxyWidget->setVisible(false);
+            }
+            else {
+                textEditProxyWidget->resize(contentsRect.width() - leftPadding, textEditHeight);
+                textEditProxyWidget->setVisible(true);
+            }
+
+            textEditProxyWidget->setPos(contentsRect.left() + leftPadding, yBottom);
+            textSnapshotItem->setVisible(false);
         }
         else {
-            textEditProxyWidget->resize(contentsRect.width() - leftPadding, textEditHeight);
-            textEditProxyWidget->setVisible(true);
+            constexpr int topPadding = 4; // to approximately match the text position in `textEdit`
+            textSnapshotItem->setColor(normalTextColor);
+            textSnapshotItem->setRect(
+                    QRectF(contentsRect.left() + leftPadding, yBottom + topPadding,
+                           contentsRect.width() - leftPadding * 2,
+                           std::max(textEditHeight - topPadding, 0.0)));
+            textSnapshotItem->setVisible(showsText && textEditHeight >= 0.1);
         }
-
-        textEditProxyWidget->setPos(contentsRect.left() + leftPadding, yBottom);
     }
 
     // textEditFocusIndicator
@@ -379,6 +431,129 @@ void NodeRect::adjustContents() {
     );
 }
 
+void NodeRect::createTextEdit() {
+    if (textEdit != nullptr)
+        return;
+    Q_ASSERT(contentsContainer != nullptr);
+
+    textEdit = new CustomTextEdit(nullptr);
+    textEditProxyWidget = new ProfiledProxyWidget(contentsContainer);
+    textEdit->setVisible(false);
+    textEditProxyWidget->setWidget(textEdit);
+
+    //
+    textEdit->enableSetEveryWheelEventAccepted(true);
+    textEdit->setReplaceTabBySpaces(4);
+    textEdit->setFrameShape(QFrame::NoFrame);
+    textEdit->setMinimumHeight(10);
+    textEdit->setContextMenuPolicy(Qt::NoContextMenu);
+
+    textEdit->setStyleSheet(
+            "QTextEdit {"
+            "  font-size: " + QString::number(textEditFontPixelSize) + "px;" +
+            "}"
+            "QScrollBar:vertical {"
+            "  width: 12px;"
+            "}"
+    );
+
+    // set text
+    if (textEditIsPreviewMode) {
+        showPreviewInTextEdit();
+    }
+    else {
+        textEdit->setPlainText(plainText);
+        textEdit->setLineHeightPercent(textEditLineHeightPercentage);
+    }
+    textEdit->setReadOnly(!computeTextEditEditable(nodeRectIsEditable, textEditIsPreviewMode));
+    if (!textEditIsPreviewMode)
+        textEdit->setTextCursorPosition(textEditCursorPositionWhenReleased);
+
+    // ==== install event filter ====
+
+    textEditProxyWidget->installSceneEventFilter(this);
+
+    // ==== connections ====
+
+    connect(textEdit, &CustomTextEdit::textEdited, this, [this]() {
+        if (!textEditIsPreviewMode) {
+            plainText = textEdit->toPlainText();
+            textSnapshotItem->setText(plainText);
+            emit titleTextUpdated(std::nullopt, plainText);
+        }
+        //
+        textEdit->setVerticalScrollBarTurnedOn(!plainText.isEmpty());
+    });
+
+    connect(textEdit, &CustomTextEdit::clicked, this, [this]() {
+        emit leftButtonPressedOrClicked();
+    });
+
+    connect(textEdit, &CustomTextEdit::focusedIn, this, [this]() {
+        textEditHasFocus = true;
+        textEditFocusIndicator->setVisible(true);
+    });
+
+    connect(textEdit, &CustomTextEdit::focusedOut, this, [this]() {
+        textEditHasFocus = false;
+        textEditFocusIndicator->setVisible(false);
+    });
+}
+
+void NodeRect::releaseTextEdit() {
+    if (textEdit == nullptr)
+        return;
+
+    if (!textEditIsPreviewMode)
+        textEditCursorPositionWhenReleased = textEdit->currentTextCursorPosition();
+
+    // (see the destructor)
+    textEditProxyWidget->setWidget(nullptr);
+    textEdit->deleteLater();
+    textEdit = nullptr;
+
+    textEditProxyWidget->setVisible(false);
+    textEditProxyWidget->deleteLater();
+    textEditProxyWidget = nullptr;
+
+    textEditHasFocus = false;
+    textEditFocusIndicator->setVisible(false);
+}
+
+void NodeRect::showPreviewInTextEdit() {
+    Q_ASSERT(textEdit != nullptr && textEditIsPreviewMode);
+
+    if (markdownRenderCache == nullptr) {
+        textEdit->setMarkdown(plainText);
+        formatPreviewDocument(textEdit->document());
+        return;
+    }
+
+    const QTextDocument *document = markdownRenderCache->get(plainText);
+    if (document == nullptr && plainText.length() <= maxTextLengthToRenderPreviewInPlace)
+        document = markdownRenderCache->renderNow(plainText);
+    if (document != nullptr) {
+        textEdit->setDocumentCopy(document);
+        return;
+    }
+
+    // show the plain text until the preview is rendered
+    textEdit->setPlainText(plainText);
+    textEdit->setLineHeightPercent(textEditLineHeightPercentage);
+
+    markdownRenderCache->requestRendering(
+            plainText, MarkdownRenderCache::Priority::Visible,
+            // callback
+            [this, text = plainText](const QTextDocument *document) {
+                if (textEdit == nullptr || !textEditIsPreviewMode || plainText != text)
+                    return;
+                textEdit->setDocumentCopy(document);
+                adjustContents();
+            },
+            this
+    );
+}
+
 void NodeRect::onMouseLeftPressed(const bool isOnCaptionBar, const Qt::KeyboardModifiers modifiers) {
     if (modifiers == Qt::NoModifier) {
         emit leftButtonPressedOrClicked();
@@ -394,6 +569,10 @@ void NodeRect::onMouseLeftClicked(
     // do nothing
 }
 
+RenderingProfiler::PaintedClass NodeRect::getPaintedClass() const {
+    return RenderingProfiler::PaintedClass::NodeRect;
+}
+
 QString NodeRect::getNodeLabelsString(const QStringList &labels) {
     QStringList labels2;
     for (const QString &label: labels)
@@ -401,6 +580,12 @@ QString NodeRect::getNodeLabelsString(const QStringList &labels) {
     return labels2.join(" ");
 }
 
+void NodeRect::formatPreviewDocument(QTextDocument *document) {
+    document->setIndentWidth(20);
+    CustomTextEdit::applyParagraphSpacing(document, 20);
+    CustomTextEdit::applyLineHeightPercent(document, textEditLineHeightPercentage);
+}
+
 bool NodeRect::computeTextEditEditable(
         const bool nodeRectIsEditable, const bool textEditIsPreviewMode) {
     return !textEditIsPreviewMode && nodeRectIsEditable;
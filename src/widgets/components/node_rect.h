@@ -5,11 +5,15 @@
 #include <QGraphicsRectItem>
 #include <QGraphicsView>
 #include <QSet>
+#include "utilities/symbol.h"
 #include "widgets/components/board_box_item.h"
 #include "widgets/icons.h"
 
 class CustomGraphicsTextItem;
 class CustomTextEdit;
+class MarkdownRenderCache;
+class StaticTextItem;
+class QTextDocument;
 
 class NodeRect : public BoardBoxItem
 {
@@ -27,14 +31,37 @@ public:
 
     void setTextEditorIgnoreWheelEvent(const bool b);
 
+    //!
+    //! The preview is taken from \e cache (if not nullptr), whose formatter should be
+    //! \c formatPreviewDocument().
+    //!
+    void setMarkdownRenderCache(MarkdownRenderCache *cache);
+
     void togglePreview();
 
+    //!
+    //! When the contents are not materialized, the text is drawn as a static snapshot, and the
+    //! (heavyweight) text editor is not created. Contents are materialized by default.
+    //! This can be called before or after this item is initialized. Releasing is ignored while
+    //! the text editor has focus.
+    //!
+    void setContentsMaterialized(const bool materialized);
+    bool getContentsMaterialized() const;
+
     //
     int getCardId() const;
     QSet<QString> getNodeLabels() const;
+    QSet<Symbol> getNodeLabelSymbols() const;
     QString getTitle() const;
     QString getText() const;
 
+    // tools
+
+    static QString getNodeLabelsString(const QStringList &labels);
+    static QColor getNormalTextColor(const bool isDarkTheme);
+    static QColor getDimTextColor(const bool isDarkTheme);
+    static void formatPreviewDocument(QTextDocument *document); // thread-safe
+
 signals:
     void leftButtonPressedOrClicked();
     void ctrlLeftButtonPressedOnCaptionBar();
@@ -55,13 +82,19 @@ private:
     const int cardId;
     const double textEditFocusIndicatorLineWidth {2.0};
     QStringList nodeLabels;
+    QSet<Symbol> nodeLabelSymbols;
     bool textEditIgnoreWheelEvent {false};
     bool nodeRectIsEditable {false};
 
     QString plainText;
     bool textEditIsPreviewMode {false};
+    MarkdownRenderCache *markdownRenderCache {nullptr};
     int textEditCursorPositionBeforePreviewMode {0};
 
+    bool contentsMaterialized {true};
+    int textEditCursorPositionWhenReleased {0};
+    bool textEditHasFocus {false};
+
     QHash<QAction *, Icon> contextMenuActionToIcon;
 
     // content items
@@ -71,9 +104,16 @@ private:
     CustomGraphicsTextItem *propertiesItem;
     // -- text (Use QTextEdit rather than QGraphicsTextItem. The latter does not have scrolling
     //    functionality.)
-    CustomTextEdit *textEdit;
-    QGraphicsProxyWidget *textEditProxyWidget;
+    QGraphicsItem *contentsContainer {nullptr}; // set in setUpContents()
+    CustomTextEdit *textEdit {nullptr}; // nullptr when contents are not materialized
+    QGraphicsProxyWidget *textEditProxyWidget {nullptr};
+            // nullptr when contents are not materialized
     QGraphicsRectItem *textEditFocusIndicator;
+    StaticTextItem *textSnapshotItem; // shown when contents are not materialized
+
+    void createTextEdit(); // creates `textEdit` & `textEditProxyWidget`
+    void releaseTextEdit();
+    void showPreviewInTextEdit(); // call when `textEdit` exists & in preview mode
 
     // override
     QMenu *createCaptionBarContextMenu() override;
@@ -82,13 +122,11 @@ private:
     void adjustContents() override;
     void onMouseLeftPressed(const bool isOnCaptionBar, const Qt::KeyboardModifiers modifiers) override;
     void onMouseLeftClicked(const bool isOnCaptionBar, const Qt::KeyboardModifiers modifiers) override;
+    RenderingProfiler::PaintedClass getPaintedClass() const override;
 
     // tools
-    static QString getNodeLabelsString(const QStringList &labels);
     static bool computeTextEditEditable(
             const bool nodeRectIsEditable, const bool textEditIsPreviewMode);
-    static QColor getNormalTextColor(const bool isDarkTheme);
-    static QColor getDimTextColor(const bool isDarkTheme);
     static QPen getTextEditFocusIndicator(const bool isDarkTheme, const double indicatorLineWidth);
 };
 
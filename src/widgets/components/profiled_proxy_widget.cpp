@@ -0,0 +1,13 @@
+#include "profiled_proxy_widget.h"
+#include "widgets/rendering_profiler.h"
+
+ProfiledProxyWidget::ProfiledProxyWidget(QGraphicsItem *parent)
+        : QGraphicsProxyWidget(parent) {
+}
+
+void ProfiledProxyWidget::paint(
+        QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) {
+    RenderingProfiler::ScopedNestedPaint scopedNestedPaint(
+            RenderingProfiler::PaintedClass::ProxyWidget);
+    QGraphicsProxyWidget::paint(painter, option, widget);
+}
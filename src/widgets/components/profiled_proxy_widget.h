@@ -0,0 +1,20 @@
+#ifndef PROFILED_PROXY_WIDGET_H
+#define PROFILED_PROXY_WIDGET_H
+
+#include <QGraphicsProxyWidget>
+
+//!
+//! A \c QGraphicsProxyWidget whose painting is measured by \c RenderingProfiler.
+//!
+class ProfiledProxyWidget : public QGraphicsProxyWidget
+{
+    Q_OBJECT
+public:
+    explicit ProfiledProxyWidget(QGraphicsItem *parent = nullptr);
+
+    void paint(
+            QPainter *painter, const QStyleOptionGraphicsItem *option,
+            QWidget *widget) override;
+};
+
+#endif // PROFILED_PROXY_WIDGET_H
@@ -0,0 +1,89 @@
+#include <QGraphicsScene>
+#include <QTimer>
+#include "rendering_profiler_overlay.h"
+#include "utilities/trace_recorder.h"
+#include "widgets/rendering_profiler.h"
+
+RenderingProfilerOverlay::RenderingProfilerOverlay(QGraphicsScene *scene, QWidget *parent)
+        : QLabel(parent)
+        , scene(scene)
+        , refreshTimer(new QTimer(this)) {
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    setTextFormat(Qt::PlainText);
+    setMargin(6);
+    setStyleSheet(
+            "QLabel {"
+            "  font-family: monospace;"
+            "  font-size: 11px;"
+            "  color: #e0e0e0;"
+            "  background: rgba(0, 0, 0, 170);"
+            "}");
+    QLabel::setVisible(false);
+
+    refreshTimer->setInterval(1000);
+    connect(refreshTimer, &QTimer::timeout, this, [this]() {
+        refresh();
+    });
+}
+
+void RenderingProfilerOverlay::setVisible(bool visible) {
+    RenderingProfiler::instance()->setEnabled(visible);
+    QLabel::setVisible(visible);
+}
+
+void RenderingProfilerOverlay::showEvent(QShowEvent *event) {
+    QLabel::showEvent(event);
+    refreshTimer->start();
+    refresh();
+}
+
+void RenderingProfilerOverlay::hideEvent(QHideEvent *event) {
+    QLabel::hideEvent(event);
+    refreshTimer->stop(); // (also when the parent is hidden, so as not to take the stats)
+}
+
+void RenderingProfilerOverlay::refresh() {
+    const RenderingProfiler::Stats stats = RenderingProfiler::instance()->takeStats();
+
+    QStringList lines;
+    {
+        const double fps = (stats.durationMsec > 0)
+                ? stats.framesCount * 1000.0 / stats.durationMsec : 0.0;
+        const double averageFrameMsec = (stats.framesCount > 0)
+                ? stats.totalFrameMsec / stats.framesCount : 0.0;
+        lines << QString("FPS: %1  (frame avg %2 ms, max %3 ms)")
+                 .arg(fps, 0, 'f', 1)
+                 .arg(averageFrameMsec, 0, 'f', 2)
+                 .arg(stats.maxFrameMsec, 0, 'f', 2);
+    }
+
+    // (the index method is NoIndex unless changed, in which case there's no BSP tree)
+    const QString bspDepth = (scene->itemIndexMethod() == QGraphicsScene::BspTreeIndex)
+            ? QString::number(scene->bspTreeDepth()) : QString("n/a (no index)");
+    lines << QString("scene items: %1  BSP depth: %2").arg(scene->items().count()).arg(bspDepth);
+
+    lines << "paint time (ms/s):";
+    for (int i = 0; i < RenderingProfiler::paintedClassesCount; ++i) {
+        const auto paintedClass = RenderingProfiler::PaintedClass(i);
+        const double msecPerSec = (stats.durationMsec > 0)
+                ? stats.paintMsec[i] * 1000.0 / stats.durationMsec : 0.0;
+        lines << QString("  %1 %2")
+                 .arg(RenderingProfiler::getName(paintedClass) + ":", -15)
+                 .arg(msecPerSec, 7, 'f', 2);
+    }
+
+    lines << "operations (count, ms):";
+    for (int i = 0; i < RenderingProfiler::operationsCount; ++i) {
+        const auto operation = RenderingProfiler::Operation(i);
+        lines << QString("  %1 %2 %3")
+                 .arg(RenderingProfiler::getName(operation) + ":", -39)
+                 .arg(stats.operationCounts[i], 4)
+                 .arg(stats.operationMsec[i], 8, 'f', 2);
+    }
+
+    if (TraceRecorder::instance()->isRecording())
+        lines << "recording trace...";
+
+    setText(lines.join("\n"));
+    adjustSize();
+}
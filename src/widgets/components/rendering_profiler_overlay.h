@@ -0,0 +1,33 @@
+#ifndef RENDERING_PROFILER_OVERLAY_H
+#define RENDERING_PROFILER_OVERLAY_H
+
+#include <QLabel>
+
+class QGraphicsScene;
+class QTimer;
+
+//!
+//! A label (to be floating on a graphics view) that shows the statistics of
+//! \c RenderingProfiler, refreshed every second. \c RenderingProfiler is enabled while this is
+//! shown.
+//!
+class RenderingProfilerOverlay : public QLabel
+{
+    Q_OBJECT
+public:
+    explicit RenderingProfilerOverlay(QGraphicsScene *scene, QWidget *parent = nullptr);
+
+    void setVisible(bool visible) override;
+
+protected:
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+
+private:
+    QGraphicsScene *const scene;
+    QTimer *refreshTimer;
+
+    void refresh();
+};
+
+#endif // RENDERING_PROFILER_OVERLAY_H
@@ -6,6 +6,7 @@
 #include "widgets/widgets_constants.h"
 #include "widgets/components/custom_graphics_text_item.h"
 #include "widgets/components/custom_text_edit.h"
+#include "widgets/components/profiled_proxy_widget.h"
 
 SettingBox::SettingBox(QGraphicsItem *parent)
     : BoardBoxItem(CreationParameters {}, parent) {
@@ -103,7 +104,7 @@ void SettingBox::setUpContents(QGraphicsItem *contentsContainer) {
     labelSetting = new QGraphicsSimpleTextItem(contentsContainer);
 
     textEdit = new CustomTextEdit(nullptr);
-    textEditProxyWidget = new QGraphicsProxyWidget(contentsContainer);
+    textEditProxyWidget = new ProfiledProxyWidget(contentsContainer);
     textEdit->setVisible(false);
     textEditProxyWidget->setWidget(textEdit);
 
@@ -380,6 +381,10 @@ void SettingBox::onMouseLeftClicked(
     // do nothing
 }
 
+RenderingProfiler::PaintedClass SettingBox::getPaintedClass() const {
+    return RenderingProfiler::PaintedClass::SettingBox;
+}
+
 QColor SettingBox::getTitleItemDefaultTextColor(const bool isDarkTheme) {
     return isDarkTheme ? QColor(darkThemeStandardTextColor) : QColor(Qt::black);
 }
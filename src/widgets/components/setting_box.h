@@ -61,6 +61,7 @@ private:
     void adjustContents() override;
     void onMouseLeftPressed(const bool isOnCaptionBar, const Qt::KeyboardModifiers modifiers) override;
     void onMouseLeftClicked(const bool isOnCaptionBar, const Qt::KeyboardModifiers modifiers) override;
+    RenderingProfiler::PaintedClass getPaintedClass() const override;
 
     // tools
     static QColor getTitleItemDefaultTextColor(const bool isDarkTheme);
@@ -0,0 +1,51 @@
+#include <QPainter>
+#include "static_text_item.h"
+
+StaticTextItem::StaticTextItem(QGraphicsItem *parent)
+        : QGraphicsItem(parent) {
+    setAcceptedMouseButtons(Qt::NoButton);
+    staticText.setTextFormat(Qt::RichText);
+    staticText.setPerformanceHint(QStaticText::AggressiveCaching);
+}
+
+void StaticTextItem::setText(const QString &text) {
+    // (use rich text so that line breaks are kept)
+    staticText.setText(
+            text.left(maxTextLength).toHtmlEscaped().replace('\n', "<br>"));
+    update();
+}
+
+void StaticTextItem::setFont(const QFont &font_) {
+    font = font_;
+    staticText.prepare(QTransform(), font);
+    update();
+}
+
+void StaticTextItem::setColor(const QColor &color_) {
+    color = color_;
+    update();
+}
+
+void StaticTextItem::setRect(const QRectF &rect_) {
+    prepareGeometryChange();
+    rect = rect_;
+    staticText.setTextWidth(rect.width());
+    update();
+}
+
+QRectF StaticTextItem::boundingRect() const {
+    return rect;
+}
+
+void StaticTextItem::paint(
+        QPainter *painter, const QStyleOptionGraphicsItem */*option*/, QWidget */*widget*/) {
+    if (rect.isEmpty())
+        return;
+
+    painter->save();
+    painter->setClipRect(rect);
+    painter->setFont(font);
+    painter->setPen(color);
+    painter->drawStaticText(rect.topLeft(), staticText);
+    painter->restore();
+}
@@ -0,0 +1,40 @@
+#ifndef STATIC_TEXT_ITEM_H
+#define STATIC_TEXT_ITEM_H
+
+#include <QFont>
+#include <QGraphicsItem>
+#include <QStaticText>
+
+//!
+//! Draws a plain text wrapped to the width of a rect and clipped to the rect. The text layout is
+//! cached (via \c QStaticText), so that repainting is cheap. This item keeps no text document and
+//! does not accept mouse events.
+//!
+class StaticTextItem : public QGraphicsItem
+{
+public:
+    explicit StaticTextItem(QGraphicsItem *parent = nullptr);
+
+    //!
+    //! Only the beginning of a long text is kept.
+    //!
+    void setText(const QString &text);
+    void setFont(const QFont &font);
+    void setColor(const QColor &color);
+    void setRect(const QRectF &rect);
+
+    QRectF boundingRect() const override;
+    void paint(
+            QPainter *painter, const QStyleOptionGraphicsItem *option,
+            QWidget *widget) override;
+
+private:
+    static constexpr int maxTextLength {2000};
+
+    QRectF rect;
+    QFont font;
+    QColor color {Qt::black};
+    QStaticText staticText;
+};
+
+#endif // STATIC_TEXT_ITEM_H
@@ -0,0 +1,112 @@
+#include <QPainter>
+#include <QTimer>
+#include "zoom_preview_overlay.h"
+
+ZoomPreviewOverlay::ZoomPreviewOverlay(QWidget *viewport)
+        : QWidget(viewport)
+        , revealTimer(new QTimer(this)) {
+    setAttribute(Qt::WA_OpaquePaintEvent, true);
+    setAttribute(Qt::WA_TransparentForMouseEvents, true);
+    QWidget::setVisible(false);
+
+    revealTimer->setInterval(revealIntervalMsec);
+    connect(revealTimer, &QTimer::timeout, this, [this]() {
+        revealNextTiles();
+    });
+}
+
+void ZoomPreviewOverlay::start(
+        const QImage &viewportImage, const QPointF &viewTopLeft_, const double viewScale_,
+        const QColor &backgroundColor_) {
+    revealTimer->stop();
+    tilesToReveal.clear();
+
+    tileCache.capture(viewportImage, viewTopLeft_, viewScale_);
+    backgroundColor = backgroundColor_;
+    viewTopLeft = viewTopLeft_;
+    viewScale = viewScale_;
+    previewing = true;
+
+    if (parentWidget() != nullptr)
+        setGeometry(parentWidget()->rect());
+    clearMask();
+    raise();
+    show();
+    update();
+}
+
+void ZoomPreviewOverlay::zoomTo(const double viewScale_, const QPointF &anchorPos) {
+    Q_ASSERT(viewScale_ > 0);
+    if (!previewing)
+        return;
+
+    const QPointF anchor = viewTopLeft + anchorPos / viewScale;
+    viewScale = viewScale_;
+    viewTopLeft = anchor - anchorPos / viewScale;
+    update();
+}
+
+void ZoomPreviewOverlay::setView(const QPointF &viewTopLeft_, const double viewScale_) {
+    Q_ASSERT(viewScale_ > 0);
+    viewTopLeft = viewTopLeft_;
+    viewScale = viewScale_;
+    update();
+}
+
+void ZoomPreviewOverlay::panBy(const QPoint &displacement) {
+    if (!isVisible())
+        return;
+
+    move(0, 0);
+    if (!displacement.isNull()) {
+        viewTopLeft += QPointF(displacement) / viewScale;
+        update();
+    }
+}
+
+void ZoomPreviewOverlay::startRevealing(const QPointF &centerPos) {
+    if (!previewing)
+        return;
+    previewing = false;
+
+    tilesToReveal = ViewportTileCache::computeTilesByDistance(size(), centerPos);
+    coveredRegion = QRegion(rect());
+    revealTimer->start();
+}
+
+void ZoomPreviewOverlay::cancel() {
+    revealTimer->stop();
+    tilesToReveal.clear();
+    previewing = false;
+    tileCache.clear();
+    hide();
+}
+
+bool ZoomPreviewOverlay::isPreviewing() const {
+    return previewing;
+}
+
+QPointF ZoomPreviewOverlay::getViewTopLeft() const {
+    return viewTopLeft;
+}
+
+double ZoomPreviewOverlay::getViewScale() const {
+    return viewScale;
+}
+
+void ZoomPreviewOverlay::paintEvent(QPaintEvent */*event*/) {
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::SmoothPixmapTransform, true);
+    tileCache.draw(&painter, size(), viewTopLeft, viewScale, backgroundColor);
+}
+
+void ZoomPreviewOverlay::revealNextTiles() {
+    for (int i = 0; i < tilesRevealedPerInterval && !tilesToReveal.isEmpty(); ++i)
+        coveredRegion -= tilesToReveal.takeFirst();
+
+    if (tilesToReveal.isEmpty() || coveredRegion.isEmpty()) {
+        cancel();
+        return;
+    }
+    setMask(coveredRegion); // (the viewport repaints the uncovered tiles)
+}
@@ -0,0 +1,81 @@
+#ifndef ZOOM_PREVIEW_OVERLAY_H
+#define ZOOM_PREVIEW_OVERLAY_H
+
+#include <QRegion>
+#include <QVector>
+#include <QWidget>
+#include "utilities/viewport_tile_cache.h"
+
+class QTimer;
+
+//!
+//! An opaque overlay (to be a child of a graphics view's viewport, covering it) showing a cached
+//! image of the viewport scaled & translated, so that a zoom gesture can be previewed without
+//! re-rendering the scene on each step.
+//!
+//! After \c startRevealing(), the overlay is removed tile by tile, nearest to the given point
+//! first, so that the viewport re-renders only the revealed tiles in each frame. (Since this is
+//! opaque, the viewport does not paint the region covered by this.)
+//!
+//! The view positions are in the coordinates of the viewed contents (e.g., the board's canvas).
+//! Mouse events pass through this.
+//!
+class ZoomPreviewOverlay : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit ZoomPreviewOverlay(QWidget *viewport);
+
+    //!
+    //! Shows the overlay, with \e viewportImage captured from the view having top-left corner at
+    //! \e viewTopLeft and scale \e viewScale.
+    //!
+    void start(
+            const QImage &viewportImage, const QPointF &viewTopLeft, const double viewScale,
+            const QColor &backgroundColor);
+
+    //!
+    //! Changes the previewed scale, keeping the point at \e anchorPos (in pixels, relative to
+    //! this) stationary.
+    //!
+    void zoomTo(const double viewScale, const QPointF &anchorPos);
+    void setView(const QPointF &viewTopLeft, const double viewScale);
+
+    //!
+    //! Call this when the viewport is scrolled (also while revealing). Keeps this at the
+    //! viewport's top-left corner, since \c QWidget::scroll() moves the child widgets as well.
+    //! \param displacement: in pixels
+    //!
+    void panBy(const QPoint &displacement);
+
+    //!
+    //! Ends the previewing and starts removing the overlay progressively.
+    //!
+    void startRevealing(const QPointF &centerPos);
+    void cancel(); // hides immediately
+
+    bool isPreviewing() const; // false while revealing
+    QPointF getViewTopLeft() const;
+    double getViewScale() const;
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    ViewportTileCache tileCache;
+    QColor backgroundColor;
+    QPointF viewTopLeft;
+    double viewScale {1.0};
+    bool previewing {false};
+
+    QVector<QRect> tilesToReveal; // in the order of revealing
+    QRegion coveredRegion;
+    QTimer *revealTimer;
+
+    void revealNextTiles();
+
+    constexpr static int revealIntervalMsec {16};
+    constexpr static int tilesRevealedPerInterval {8};
+};
+
+#endif // ZOOM_PREVIEW_OVERLAY_H
@@ -49,6 +49,13 @@ void DialogOptions::setUpWidgets() {
         Services::instance()->getAppData()->updateExportOutputDir(EventSource(this), newOutputDir);
     });
 
+    ui->spinBoxExportImageMemoryCapMb->setValue(
+            Services::instance()->getAppDataReadonly()->getExportImageMemoryCapMb());
+    connect(ui->spinBoxExportImageMemoryCapMb, &QSpinBox::editingFinished, this, [this]() {
+        Services::instance()->getAppData()->updateExportImageMemoryCapMb(
+                EventSource(this), ui->spinBoxExportImageMemoryCapMb->value());
+    });
+
     //
     setStyleSheet(
             "QDialog QFrame {"
@@ -1,7 +1,9 @@
 #include <cmath>
 #include <QApplication>
 #include <QCloseEvent>
+#include <QDateTime>
 #include <QDebug>
+#include <QDir>
 #include <QIcon>
 #include <QKeySequence>
 #include <QMessageBox>
@@ -18,17 +20,24 @@
 #include "utilities/message_box.h"
 #include "utilities/periodic_checker.h"
 #include "utilities/screens_utils.h"
+#include "utilities/trace_recorder.h"
 #include "widgets/app_style_sheet.h"
 #include "widgets/board_view.h"
 #include "widgets/dialogs/dialog_options.h"
 #include "widgets/dialogs/dialog_user_card_labels.h"
 #include "widgets/dialogs/dialog_user_relationship_types.h"
+#include "widgets/rendering_profiler.h"
 #include "widgets/right_sidebar.h"
 #include "widgets/workspace_frame.h"
 #include "widgets/workspaces_list.h"
 
 using ContinuationContext = AsyncRoutineWithErrorFlag::ContinuationContext;
 
+namespace {
+const QString noWorkspaceOpenText {"No workspace is open"};
+const QString loadingText {"Loading..."};
+}
+
 MainWindow::MainWindow(QWidget *parent)
         : QMainWindow(parent)
         , ui(new Ui::MainWindow)
@@ -78,6 +87,7 @@ void MainWindow::load(std::function<void (bool)> callback) {
 
     workspacesList->setEnabled(false);
     workspaceFrame->setEnabled(false);
+    noWorkspaceOpenSign->setText(loadingText); // (shown only if no workspace is open)
 
     //
     class AsyncRoutineWithVars : public AsyncRoutineWithErrorFlag
@@ -88,71 +98,73 @@ void MainWindow::load(std::function<void (bool)> callback) {
         QString errorMsg;
     };
     auto *routine = new AsyncRoutineWithVars;
+    routine->setName("MainWindow::load");
 
-    //
-    routine->addStep([this, routine]() {
-        // close `workspaceFrame`
-        workspaceFrame->loadWorkspace(
-                -1,
-                // callback
-                [this, routine](bool loadOk, bool highlightedCardIdChanged) {
-                    ContinuationContext context(routine);
-
-                    if (loadOk) {
-                        workspacesList->setSelectedWorkspaceId(-1);
-                    }
-                    else {
-                        routine->errorMsg
-                                = QString("Could not close workspace.");
-                        context.setErrorFlag();
-                    }
-
-                    if (highlightedCardIdChanged) {
-                        // call AppData
-                        Services::instance()->getAppData()
-                                ->setSingleHighlightedCardId(EventSource(this), -1);
-                    }
-                }
-        );
-    }, this);
+    // closing `workspaceFrame` and the DB reads are independent, so they are done in parallel
+    routine->addParallelSteps({
+        {[this, routine]() {
+            // close `workspaceFrame`
+            workspaceFrame->loadWorkspace(
+                    -1,
+                    // callback
+                    [this, routine](bool loadOk, bool highlightedCardIdChanged) {
+                        ContinuationContext context(routine);
 
-    routine->addStep([this, routine]() {
-        // get workspaces-list properties
-        Services::instance()->getAppDataReadonly()->getWorkspacesListProperties(
-                [routine](bool ok, WorkspacesListProperties properties) {
-                    ContinuationContext context(routine);
+                        if (loadOk) {
+                            workspacesList->setSelectedWorkspaceId(-1);
+                        }
+                        else {
+                            routine->errorMsg
+                                    = QString("Could not close workspace.");
+                            context.setErrorFlag();
+                        }
 
-                    if (!ok) {
-                        routine->errorMsg
-                                = "Could not get workspaces list properties. See logs for details.";
-                        context.setErrorFlag();
-                    }
-                    else {
-                        routine->workspacesListProperties = properties;
+                        if (highlightedCardIdChanged) {
+                            // call AppData
+                            Services::instance()->getAppData()
+                                    ->setSingleHighlightedCardId(EventSource(this), -1);
+                        }
                     }
-                },
-                this
-        );
-    }, this);
+            );
+        }, this},
+        {[this, routine]() {
+            // get workspaces-list properties
+            Services::instance()->getAppDataReadonly()->getWorkspacesListProperties(
+                    [routine](bool ok, WorkspacesListProperties properties) {
+                        ContinuationContext context(routine);
 
-    routine->addStep([this, routine]() {
-        // get workspaces
-        Services::instance()->getAppDataReadonly()->getWorkspaces(
-                [routine](bool ok, const QHash<int, Workspace> &workspaces) {
-                    ContinuationContext context(routine);
+                        if (!ok) {
+                            routine->errorMsg
+                                    = "Could not get workspaces list properties. "
+                                      "See logs for details.";
+                            context.setErrorFlag();
+                        }
+                        else {
+                            routine->workspacesListProperties = properties;
+                        }
+                    },
+                    this
+            );
+        }, this},
+        {[this, routine]() {
+            // get workspaces
+            Services::instance()->getAppDataReadonly()->getWorkspaces(
+                    [routine](bool ok, const QHash<int, Workspace> &workspaces) {
+                        ContinuationContext context(routine);
 
-                    if (!ok) {
-                        routine->errorMsg
-                                = "Could not get data of workspaces. See logs for details.";
-                        context.setErrorFlag();
-                    }
-                    else {
-                        routine->workspaces = workspaces;
-                    }
-                },
-                this
-        );
-    }, this);
+                        if (!ok) {
+                            routine->errorMsg
+                                    = "Could not get data of workspaces. See logs for details.";
+                            context.setErrorFlag();
+                        }
+                        else {
+                            routine->workspaces = workspaces;
+                        }
+                    },
+                    this
+            );
+        }, this}
+    });
 
     routine->addStep([this, routine]() {
         // populate `workspacesList`
@@ -214,6 +226,7 @@ void MainWindow::load(std::function<void (bool)> callback) {
 
         workspacesList->setEnabled(true);
         workspaceFrame->setEnabled(true);
+        noWorkspaceOpenSign->setText(noWorkspaceOpenText);
 
         if (routine->errorFlag) {
             showWarningMessageBox(this, " ", routine->errorMsg);
@@ -333,7 +346,7 @@ void MainWindow::setUpWidgets() {
             vBoxLayout->addWidget(workspaceFrame);
             workspaceFrame->setVisible(false);
 
-            noWorkspaceOpenSign = new QLabel("No workspace is open");
+            noWorkspaceOpenSign = new QLabel(noWorkspaceOpenText);
             vBoxLayout->addWidget(noWorkspaceOpenSign);
             vBoxLayout->setAlignment(noWorkspaceOpenSign, Qt::AlignCenter);
         }
@@ -482,6 +495,31 @@ void MainWindow::setUpMainMenu() {
             action->setShortcut(QKeySequence(Qt::CTRL + Qt::Key_0));
             this->addAction(action); // without this, the shortcut won't work
         }
+        {
+            auto *action = submenu->addAction("Toggle Minimap", this, [this]() {
+                if (workspaceFrame->isVisible())
+                    workspaceFrame->toggleMinimap();
+            });
+            action->setShortcut(QKeySequence(Qt::CTRL + Qt::Key_M));
+            this->addAction(action); // without this, the shortcut won't work
+        }
+        submenu->addSeparator();
+        {
+            auto *action = submenu->addAction("Toggle Rendering Profiler", this, [this]() {
+                if (workspaceFrame->isVisible())
+                    workspaceFrame->toggleRenderingProfiler();
+            });
+            action->setShortcut(QKeySequence(Qt::CTRL + Qt::SHIFT + Qt::Key_P));
+            this->addAction(action); // without this, the shortcut won't work
+        }
+        {
+            auto *action = submenu->addAction("Record Rendering Trace");
+            action->setCheckable(true);
+            connect(action, &QAction::triggered, this, [this, action]() {
+                const bool isRecording = onUserToToggleRenderingTraceRecording();
+                action->setChecked(isRecording);
+            });
+        }
     }
     {
         auto *action = mainMenu->addAction("Options...", this, [this]() {
@@ -996,6 +1034,40 @@ void MainWindow::openOptionsDialog() {
     dialog->open();
 }
 
+bool MainWindow::onUserToToggleRenderingTraceRecording() {
+    TraceRecorder *recorder = TraceRecorder::instance();
+
+    if (renderingTraceFilePath.isEmpty()) {
+        // start
+        if (recorder->isRecording()) {
+            showWarningMessageBox(this, " ", "Another trace is being recorded. Try again later.");
+            return false;
+        }
+
+        const QString fileName = QString("rendering_trace_%1.json")
+                .arg(QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss"));
+        const QString outputDir = Services::instance()->getAppDataReadonly()->getExportOutputDir();
+        renderingTraceFilePath = QDir(outputDir).filePath(fileName);
+        recorder->start(renderingTraceFilePath);
+
+        if (!RenderingProfiler::instance()->isEnabled() && workspaceFrame->isVisible())
+            workspaceFrame->toggleRenderingProfiler();
+        return true;
+    }
+    else {
+        // stop
+        const QString filePath = renderingTraceFilePath;
+        renderingTraceFilePath.clear();
+
+        const bool ok = recorder->finish();
+        if (ok)
+            showInformationMessageBox(this, " ", "Rendering trace saved to " + filePath);
+        else
+            showWarningMessageBox(this, " ", "Could not write file " + filePath);
+        return false;
+    }
+}
+
 void MainWindow::saveBeforeClose() {
     saveWindowSizePosDebounced->actNow();
     saveTopLeftPosAndZoomRatioOfCurrentBoard();
@@ -97,6 +97,14 @@ private:
     void onUserToReload();
     void openOptionsDialog();
 
+    //!
+    //! Starts/stops recording a trace of rendering (see \c RenderingProfiler) into a file in the
+    //! export output directory. The rendering profiler is shown when recording starts.
+    //! \return whether it is recording
+    //!
+    bool onUserToToggleRenderingTraceRecording();
+    QString renderingTraceFilePath; // empty if not recording a rendering trace
+
     // -- event handling tools
     ActionDebouncer *saveWindowSizePosDebounced;
 
@@ -0,0 +1,184 @@
+#include <algorithm>
+#include <QVector>
+#include "rendering_profiler.h"
+#include "utilities/trace_recorder.h"
+
+namespace {
+constexpr char traceCategory[] = "rendering";
+
+double nsecToMsec(const qint64 nsec) {
+    return nsec / 1e6;
+}
+} // namespace
+
+RenderingProfiler *RenderingProfiler::instance() {
+    static RenderingProfiler obj;
+    return &obj;
+}
+
+RenderingProfiler::RenderingProfiler() {
+    clock.start();
+}
+
+void RenderingProfiler::setEnabled(const bool enabled_) {
+    if (enabled_ && !enabled)
+        resetStats();
+    enabled = enabled_;
+}
+
+bool RenderingProfiler::isEnabled() const {
+    return enabled;
+}
+
+void RenderingProfiler::onFrameStarted() {
+    if (!enabled)
+        return;
+
+    const qint64 now = clock.nsecsElapsed();
+    inFrame = true;
+    frameStartNsec = now;
+    segmentClass = PaintedClass::Other;
+    segmentStartNsec = now;
+    nestedNsecInSegment = 0;
+    framePaintNsec.fill(0);
+
+    frameTraceSpanId = TraceRecorder::instance()->beginSpan("frame", traceCategory);
+}
+
+void RenderingProfiler::onFrameFinished() {
+    if (!inFrame)
+        return;
+
+    const qint64 now = clock.nsecsElapsed();
+    closeSegment(now);
+    inFrame = false;
+
+    //
+    const qint64 frameNsec = now - frameStartNsec;
+    ++framesCount;
+    totalFrameNsec += frameNsec;
+    maxFrameNsec = std::max(maxFrameNsec, frameNsec);
+    for (int i = 0; i < paintedClassesCount; ++i)
+        paintNsec[i] += framePaintNsec[i];
+
+    //
+    TraceRecorder::instance()->endSpan(frameTraceSpanId);
+    frameTraceSpanId = -1;
+
+    if (TraceRecorder::instance()->isRecording()) {
+        QVector<std::pair<QString, double>> values;
+        for (int i = 0; i < paintedClassesCount; ++i)
+            values << std::make_pair(getName(PaintedClass(i)), nsecToMsec(framePaintNsec[i]));
+        TraceRecorder::instance()->addCounterEvent("paint time (ms)", traceCategory, values);
+    }
+}
+
+void RenderingProfiler::onTopLevelItemPaintStarted(const PaintedClass paintedClass) {
+    if (!inFrame)
+        return;
+
+    const qint64 now = clock.nsecsElapsed();
+    closeSegment(now);
+
+    segmentClass = paintedClass;
+    segmentStartNsec = now;
+    nestedNsecInSegment = 0;
+}
+
+RenderingProfiler::Stats RenderingProfiler::takeStats() {
+    Stats stats;
+    stats.durationMsec = nsecToMsec(clock.nsecsElapsed() - statsStartNsec);
+    stats.framesCount = framesCount;
+    stats.totalFrameMsec = nsecToMsec(totalFrameNsec);
+    stats.maxFrameMsec = nsecToMsec(maxFrameNsec);
+    for (int i = 0; i < paintedClassesCount; ++i)
+        stats.paintMsec[i] = nsecToMsec(paintNsec[i]);
+    for (int i = 0; i < operationsCount; ++i) {
+        stats.operationCounts[i] = operationCounts[i];
+        stats.operationMsec[i] = nsecToMsec(operationNsec[i]);
+    }
+
+    resetStats();
+    return stats;
+}
+
+QString RenderingProfiler::getName(const PaintedClass paintedClass) {
+    switch (paintedClass) {
+    case PaintedClass::NodeRect: return "NodeRect";
+    case PaintedClass::EdgeArrow: return "EdgeArrow";
+    case PaintedClass::GroupBox: return "GroupBox";
+    case PaintedClass::DataViewBox: return "DataViewBox";
+    case PaintedClass::SettingBox: return "SettingBox";
+    case PaintedClass::ProxyWidget: return "proxy widgets";
+    case PaintedClass::Other: return "other";
+    }
+    Q_ASSERT(false); // case not implemented
+    return "";
+}
+
+QString RenderingProfiler::getName(const Operation operation) {
+    switch (operation) {
+    case Operation::UpdateRelationshipBundles: return "RelationshipBundlesCollection::update";
+    case Operation::AdjustSceneRect: return "adjustSceneRect";
+    case Operation::UpdateCanvasScale: return "updateCanvasScale";
+    }
+    Q_ASSERT(false); // case not implemented
+    return "";
+}
+
+void RenderingProfiler::closeSegment(const qint64 nowNsec) {
+    const qint64 nsec = nowNsec - segmentStartNsec - nestedNsecInSegment;
+    framePaintNsec[int(segmentClass)] += std::max<qint64>(nsec, 0);
+}
+
+void RenderingProfiler::resetStats() {
+    statsStartNsec = clock.nsecsElapsed();
+    framesCount = 0;
+    totalFrameNsec = 0;
+    maxFrameNsec = 0;
+    paintNsec.fill(0);
+    operationCounts.fill(0);
+    operationNsec.fill(0);
+}
+
+//====
+
+RenderingProfiler::ScopedNestedPaint::ScopedNestedPaint(const PaintedClass paintedClass)
+        : paintedClass(paintedClass) {
+    auto *profiler = RenderingProfiler::instance();
+    if (profiler->inFrame)
+        startNsec = profiler->clock.nsecsElapsed();
+}
+
+RenderingProfiler::ScopedNestedPaint::~ScopedNestedPaint() {
+    auto *profiler = RenderingProfiler::instance();
+    if (startNsec < 0 || !profiler->inFrame)
+        return;
+
+    const qint64 nsec = profiler->clock.nsecsElapsed() - startNsec;
+    profiler->framePaintNsec[int(paintedClass)] += nsec;
+    profiler->nestedNsecInSegment += nsec;
+}
+
+//====
+
+RenderingProfiler::ScopedOperation::ScopedOperation(const Operation operation)
+        : operation(operation) {
+    auto *profiler = RenderingProfiler::instance();
+    if (!profiler->enabled)
+        return;
+
+    startNsec = profiler->clock.nsecsElapsed();
+    traceSpanId = TraceRecorder::instance()->beginSpan(getName(operation), traceCategory);
+}
+
+RenderingProfiler::ScopedOperation::~ScopedOperation() {
+    if (startNsec < 0)
+        return;
+
+    auto *profiler = RenderingProfiler::instance();
+    ++profiler->operationCounts[int(operation)];
+    profiler->operationNsec[int(operation)] += profiler->clock.nsecsElapsed() - startNsec;
+
+    TraceRecorder::instance()->endSpan(traceSpanId);
+}
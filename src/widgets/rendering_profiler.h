@@ -0,0 +1,129 @@
+#ifndef RENDERING_PROFILER_H
+#define RENDERING_PROFILER_H
+
+#include <array>
+#include <QElapsedTimer>
+#include <QString>
+
+//!
+//! Measures the painting of board views: frames (paintings of the viewport), paint time per
+//! item class, and the time of some operations that affect rendering.
+//!
+//! The scene paints a top-level item's children right after the item, so the time from the
+//! start of a top-level item's paint to that of the next one (or to the end of the frame) is
+//! attributed to the top-level item's class. Time of nested paints (proxy widgets) is measured
+//! separately and excluded from the enclosing top-level item.
+//!
+//! When not enabled, the methods return immediately. When enabled and \c TraceRecorder is
+//! recording, frames and operations are also recorded as spans, and the paint times of each
+//! frame as counters.
+//!
+//! Use this class in the GUI thread only.
+//!
+class RenderingProfiler
+{
+public:
+    static RenderingProfiler *instance();
+
+    RenderingProfiler(const RenderingProfiler &) = delete;
+    RenderingProfiler &operator =(const RenderingProfiler &) = delete;
+
+    enum class PaintedClass {
+        NodeRect, EdgeArrow, GroupBox, DataViewBox, SettingBox, ProxyWidget,
+        Other // background & items not attributed to the above
+    };
+    static constexpr int paintedClassesCount = 7;
+
+    enum class Operation {UpdateRelationshipBundles, AdjustSceneRect, UpdateCanvasScale};
+    static constexpr int operationsCount = 3;
+
+    void setEnabled(const bool enabled);
+    bool isEnabled() const;
+
+    // ==== frames ====
+
+    void onFrameStarted(); // call at the start of painting the viewport
+    void onFrameFinished(); // call at the end of painting the viewport
+
+    //!
+    //! Call at the start of the \c paint() of each top-level item. (Items that normally have
+    //! the flag \c QGraphicsItem::ItemHasNoContents should unset it while profiling is enabled.)
+    //!
+    void onTopLevelItemPaintStarted(const PaintedClass paintedClass);
+
+    //!
+    //! Measures a paint nested in the painting of a top-level item.
+    //!
+    class ScopedNestedPaint
+    {
+    public:
+        explicit ScopedNestedPaint(const PaintedClass paintedClass);
+        ~ScopedNestedPaint();
+    private:
+        const PaintedClass paintedClass;
+        qint64 startNsec {-1}; // -1: not measuring
+    };
+
+    // ==== operations ====
+
+    class ScopedOperation
+    {
+    public:
+        explicit ScopedOperation(const Operation operation);
+        ~ScopedOperation();
+    private:
+        const Operation operation;
+        qint64 startNsec {-1}; // -1: not measuring
+        int traceSpanId {-1};
+    };
+
+    // ==== statistics ====
+
+    struct Stats
+    {
+        double durationMsec {0};
+        int framesCount {0};
+        double totalFrameMsec {0};
+        double maxFrameMsec {0};
+        std::array<double, paintedClassesCount> paintMsec {}; // indexed by `PaintedClass`
+        std::array<int, operationsCount> operationCounts {}; // indexed by `Operation`
+        std::array<double, operationsCount> operationMsec {}; // indexed by `Operation`
+    };
+
+    //!
+    //! \return statistics since the last call (or since enabled)
+    //!
+    Stats takeStats();
+
+    static QString getName(const PaintedClass paintedClass);
+    static QString getName(const Operation operation);
+
+private:
+    RenderingProfiler();
+
+    bool enabled {false};
+    QElapsedTimer clock;
+
+    // current frame
+    bool inFrame {false};
+    qint64 frameStartNsec {0};
+    PaintedClass segmentClass {PaintedClass::Other};
+    qint64 segmentStartNsec {0};
+    qint64 nestedNsecInSegment {0};
+    std::array<qint64, paintedClassesCount> framePaintNsec {};
+    int frameTraceSpanId {-1};
+
+    // since last takeStats()
+    qint64 statsStartNsec {0};
+    int framesCount {0};
+    qint64 totalFrameNsec {0};
+    qint64 maxFrameNsec {0};
+    std::array<qint64, paintedClassesCount> paintNsec {};
+    std::array<int, operationsCount> operationCounts {};
+    std::array<qint64, operationsCount> operationNsec {};
+
+    void closeSegment(const qint64 nowNsec);
+    void resetStats();
+};
+
+#endif // RENDERING_PROFILER_H
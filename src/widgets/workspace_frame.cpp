@@ -1,6 +1,8 @@
 #include <QDebug>
 #include <QHBoxLayout>
 #include <QInputDialog>
+#include <QPointer>
+#include <QProgressDialog>
 #include <QPushButton>
 #include <QToolButton>
 #include <QVBoxLayout>
@@ -13,7 +15,9 @@
 #include "utilities/maps_util.h"
 #include "utilities/message_box.h"
 #include "utilities/periodic_checker.h"
+#include "utilities/tiled_png_export.h"
 #include "widgets/app_style_sheet.h"
+#include "widgets/board_vector_export.h"
 #include "widgets/board_view.h"
 #include "widgets/components/custom_tab_bar.h"
 #include "widgets/dialogs/dialog_workspace_card_colors.h"
@@ -40,23 +44,79 @@ void WorkspaceFrame::loadWorkspace(
     public:
         bool highlightedCardIdChanged {false};
         Workspace workspaceData;
-        QHash<int, QString> boardIdToName;
+        QHash<int, QString> allBoardIdToName;
+        QHash<int, QString> boardIdToName; // boards of the workspace
         int boardIdToOpen {-1};
     };
     auto *routine = new AsyncRoutineWithVars;
+    routine->setName("WorkspaceFrame::loadWorkspace");
+
+    // closing the boards and the DB reads are independent, so they are done in parallel
+    routine->addParallelSteps({
+        {[this, routine]() {
+            // close `boardView` and the resident boards
+            removeAllResidentBoardViews();
+
+            boardView->setVisible(true);
+            boardView->loadBoard(-1, [routine](bool loadOk, bool highlightedCardIdChanged) {
+                ContinuationContext context(routine);
+                if (!loadOk) {
+                    qWarning().noquote() << "could not close the board";
+                    context.setErrorFlag();
+                }
+                routine->highlightedCardIdChanged |= highlightedCardIdChanged;
+            });
+        }, this},
+        {[this, routine, workspaceIdToLoad]() {
+            // get workspace data
+            if (workspaceIdToLoad == -1) {
+                routine->nextStep();
+                return;
+            }
 
-    routine->addStep([this, routine]() {
-        // close `boardView`
-        boardView->setVisible(true);
-        boardView->loadBoard(-1, [routine](bool loadOk, bool highlightedCardIdChanged) {
-            ContinuationContext context(routine);
-            if (!loadOk) {
-                qWarning().noquote() << "could not close the board";
-                context.setErrorFlag();
+            Services::instance()->getAppDataReadonly()->getWorkspaces(
+                    [routine, workspaceIdToLoad](
+                            bool ok, const QHash<int, Workspace> &workspacesData) {
+                        ContinuationContext context(routine);
+
+                        if (!ok) {
+                            context.setErrorFlag();
+                            return;
+                        }
+
+                        if (!workspacesData.contains(workspaceIdToLoad)) {
+                            qWarning().noquote()
+                                    << QString("could not get data of workspace %1")
+                                       .arg(workspaceIdToLoad);
+                            context.setErrorFlag();
+                            return;
+                        }
+
+                        routine->workspaceData = workspacesData.value(workspaceIdToLoad);
+                    },
+                    this
+            );
+        }, this},
+        {[this, routine, workspaceIdToLoad]() {
+            // get board names
+            if (workspaceIdToLoad == -1) {
+                routine->nextStep();
+                return;
             }
-            routine->highlightedCardIdChanged |= highlightedCardIdChanged;
-        });
-    }, this);
+
+            Services::instance()->getAppDataReadonly()->getBoardIdsAndNames(
+                    [routine](bool ok, const QHash<int, QString> &boardIdToName) {
+                        ContinuationContext context(routine);
+                        if (!ok) {
+                            context.setErrorFlag();
+                            return;
+                        }
+                        routine->allBoardIdToName = boardIdToName;
+                    },
+                    this
+            );
+        }, this}
+    });
 
     routine->addStep([this, routine]() {
         // clear `boardsTabBar`
@@ -70,70 +130,22 @@ void WorkspaceFrame::loadWorkspace(
         workspaceToolBar->setWorkspaceName("");
     }, this);
 
-    routine->addStep([this, routine, workspaceIdToLoad]() {
-        // get workspace data
-        if (workspaceIdToLoad == -1) {
-            routine->nextStep();
-            return;
-        }
-
-        Services::instance()->getAppDataReadonly()->getWorkspaces(
-                [routine, workspaceIdToLoad](bool ok, const QHash<int, Workspace> &workspacesData) {
-                    ContinuationContext context(routine);
-
-                    if (!ok) {
-                        context.setErrorFlag();
-                        return;
-                    }
-
-                    if (!workspacesData.contains(workspaceIdToLoad)) {
-                        qWarning().noquote()
-                                << QString("could not get data of workspace %1")
-                                   .arg(workspaceIdToLoad);
-                        context.setErrorFlag();
-                        return;
-                    }
-
-                    routine->workspaceData = workspacesData.value(workspaceIdToLoad);
-                },
-                this
-        );
-    }, this);
-
-    routine->addStep([this, routine, workspaceIdToLoad]() {
-        // get board names
-        if (workspaceIdToLoad == -1) {
-            routine->nextStep();
-            return;
-        }
-
-        Services::instance()->getAppDataReadonly()->getBoardIdsAndNames(
-                [routine](bool ok, const QHash<int, QString> &boardIdToName) {
-                    ContinuationContext context(routine);
-                    if (!ok) {
-                        context.setErrorFlag();
-                        return;
-                    }
-
-                    const QSet<int> boardIds = routine->workspaceData.boardIds;
-                    for (const int id: boardIds) {
-                        if (!boardIdToName.contains(id)) {
-                            qWarning().noquote()
-                                    << QString("could not get the name of board %1").arg(id);
-                            context.setErrorFlag();
-                            return;
-                        }
-                        routine->boardIdToName.insert(id, boardIdToName.value(id));
-                    }
-                },
-                this
-        );
-    }, this);
-
     routine->addStep([this, routine]() {
-        // populate `boardsTabBar` and determine `routine->boardIdToOpen`
+        // get names of the workspace's boards, populate `boardsTabBar`, and determine
+        // `routine->boardIdToOpen`
         ContinuationContext context(routine);
 
+        const QSet<int> boardIds = routine->workspaceData.boardIds;
+        for (const int id: boardIds) {
+            if (!routine->allBoardIdToName.contains(id)) {
+                qWarning().noquote() << QString("could not get the name of board %1").arg(id);
+                context.setErrorFlag();
+                return;
+            }
+            routine->boardIdToName.insert(id, routine->allBoardIdToName.value(id));
+        }
+
+        //
         const QVector<int> sortedBoardIds = sortByOrdering(
                 keySet(routine->boardIdToName), routine->workspaceData.boardsOrdering, false);
         for (const int boardId: sortedBoardIds) {
@@ -223,8 +235,20 @@ void WorkspaceFrame::toggleCardPreview() {
         boardView->toggleCardPreview();
 }
 
+void WorkspaceFrame::toggleRenderingProfiler() {
+    if (boardView->isVisible())
+        boardView->toggleRenderingProfiler();
+}
+
+void WorkspaceFrame::toggleMinimap() {
+    if (boardView->isVisible())
+        boardView->toggleMinimap();
+}
+
 void WorkspaceFrame::prepareToClose() {
-    boardView->prepareToClose();
+    const auto views = getAllBoardViews();
+    for (BoardView *view: views)
+        view->prepareToClose();
 }
 
 int WorkspaceFrame::getWorkspaceId() const {
@@ -249,7 +273,12 @@ double WorkspaceFrame::getBoardViewZoomRatio() const {
 }
 
 bool WorkspaceFrame::canClose() const {
-    return boardView->canClose();
+    const auto views = getAllBoardViews();
+    for (BoardView *view: views) {
+        if (!view->canClose())
+            return false;
+    }
+    return true;
 }
 
 void WorkspaceFrame::setUpWidgets() {
@@ -266,9 +295,7 @@ void WorkspaceFrame::setUpWidgets() {
         layout->addWidget(boardsTabBar);
 
         //
-        boardView = new BoardView;
-        layout->addWidget(boardView);
-        boardView->setVisible(false);
+        boardView = createBoardView(); // (added to `layout`)
 
         //
         noBoardSign = new NoBoardSign;
@@ -315,8 +342,38 @@ void WorkspaceFrame::setUpConnections() {
         saveBoardsOrdering();
     });
 
-    // `boardView`
-    connect(boardView, &BoardView::workspaceCardLabelToColorMappingUpdatedViaSettingBox,
+    // `noBoardSign`
+    connect(noBoardSign, &NoBoardSign::userToAddBoard, this, [this]() {
+        onUserToAddBoard();
+    });
+}
+
+BoardView *WorkspaceFrame::createBoardView() {
+    auto *view = new BoardView;
+    view->setVisible(false);
+
+    auto *layout = qobject_cast<QVBoxLayout *>(this->layout());
+    Q_ASSERT(layout != nullptr);
+    const int noBoardSignIndex = layout->indexOf(noBoardSign); // can be -1
+    layout->insertWidget(noBoardSignIndex, view);
+
+    //
+    if (boardView != nullptr)
+        view->setGraphicsGeometryScaleFactor(boardView->getGraphicsGeometryScaleFactor());
+    if (workspaceId != -1) {
+        view->setColorsAssociatedWithLabels(
+                cardLabelToColorMapping.cardLabelsAndAssociatedColors,
+                cardLabelToColorMapping.defaultNodeRectColor);
+        view->cardPropertiesToShowSettingOnWorkspaceUpdated(cardPropertiesToShow);
+    }
+
+    //
+    setUpBoardViewConnections(view);
+    return view;
+}
+
+void WorkspaceFrame::setUpBoardViewConnections(BoardView *view) {
+    connect(view, &BoardView::workspaceCardLabelToColorMappingUpdatedViaSettingBox,
             this,
             [this](const int workspaceId, const CardLabelToColorMapping &cardLabelToColorMapping) {
         if (this->workspaceId != workspaceId) {
@@ -328,7 +385,7 @@ void WorkspaceFrame::setUpConnections() {
         onCardLabelToColorMappingUpdated(cardLabelToColorMapping);
     });
 
-    connect(boardView, &BoardView::workspaceCardPropertiesToShowUpdatedViaSettingBox,
+    connect(view, &BoardView::workspaceCardPropertiesToShowUpdatedViaSettingBox,
             this,
             [this](const int workspaceId, const CardPropertiesToShow &cardPropertiesToShow) {
         if (this->workspaceId != workspaceId) {
@@ -340,17 +397,123 @@ void WorkspaceFrame::setUpConnections() {
         onCardPropertiesToShowUpdated(cardPropertiesToShow);
     });
 
-    connect(boardView, &BoardView::hasWorkspaceSettingsPendingUpdateChanged,
-            this, [this](bool hasWorkspaceSettingsPendingUpdate) {
+    connect(view, &BoardView::hasWorkspaceSettingsPendingUpdateChanged,
+            this, [this, view](bool hasWorkspaceSettingsPendingUpdate) {
+        if (view != boardView)
+            return;
         workspaceToolBar->setWorkspaceSettingsMenuEnabled(!hasWorkspaceSettingsPendingUpdate);
     });
+}
 
-    // `noBoardSign`
-    connect(noBoardSign, &NoBoardSign::userToAddBoard, this, [this]() {
-        onUserToAddBoard();
+void WorkspaceFrame::showBoard(
+        const int boardIdToShow, std::function<void (bool, bool)> callback) {
+    Q_ASSERT(boardIdToShow != -1);
+
+    if (boardView->getBoardId() == boardIdToShow) {
+        boardView->setVisible(true);
+        callback(true, false);
+        return;
+    }
+
+    // keep the board currently shown resident
+    bool highlightedCardIdChanged = false;
+    BoardView *emptyView = nullptr; // a BoardView with no board loaded
+    if (boardView->getBoardId() != -1) {
+        boardView->clearHighlights(&highlightedCardIdChanged);
+        boardView->setVisible(false);
+        residentBoardViews << boardView;
+    }
+    else {
+        emptyView = boardView;
+    }
+
+    // find `boardIdToShow` in `residentBoardViews`
+    BoardView *residentView = nullptr;
+    for (int i = 0; i < residentBoardViews.count(); ++i) {
+        if (residentBoardViews.at(i)->getBoardId() == boardIdToShow) {
+            residentView = residentBoardViews.takeAt(i);
+            break;
+        }
+    }
+
+    if (residentView != nullptr) {
+        if (emptyView != nullptr) {
+            emptyView->setVisible(false);
+            emptyView->deleteLater();
+        }
+
+        boardView = residentView;
+        boardView->setVisible(true);
+        limitResidentBoardViews();
+
+        callback(true, highlightedCardIdChanged);
+        return;
+    }
+
+    // load the board
+    boardView = (emptyView != nullptr) ? emptyView : createBoardView();
+    boardView->setVisible(true);
+    limitResidentBoardViews();
+
+    boardView->loadBoard(
+            boardIdToShow,
+            // callback
+            [callback, highlightedCardIdChanged](bool ok, bool highlightedCardIdChanged2) {
+                callback(ok, highlightedCardIdChanged || highlightedCardIdChanged2);
+            }
+    );
+}
+
+void WorkspaceFrame::removeResidentBoardView(const int boardId) {
+    for (int i = 0; i < residentBoardViews.count(); ++i) {
+        if (residentBoardViews.at(i)->getBoardId() == boardId) {
+            unloadAndDeleteBoardView(residentBoardViews.takeAt(i));
+            return;
+        }
+    }
+}
+
+void WorkspaceFrame::removeAllResidentBoardViews() {
+    for (BoardView *view: qAsConst(residentBoardViews))
+        unloadAndDeleteBoardView(view);
+    residentBoardViews.clear();
+}
+
+void WorkspaceFrame::limitResidentBoardViews() {
+    const ResidentBoardsLimit limit = Services::instance()->getResidentBoardsLimit();
+
+    int itemsCount = 0;
+    qint64 estimatedBytes = 0;
+    for (const BoardView *view: qAsConst(residentBoardViews)) {
+        itemsCount += view->getItemsCount();
+        estimatedBytes += view->getEstimatedMemoryUsage();
+    }
+
+    while (!residentBoardViews.isEmpty()
+           && (itemsCount > limit.maxItemsCount || estimatedBytes > limit.maxEstimatedBytes)) {
+        BoardView *view = residentBoardViews.takeFirst(); // least recently shown
+        itemsCount -= view->getItemsCount();
+        estimatedBytes -= view->getEstimatedMemoryUsage();
+        unloadAndDeleteBoardView(view);
+    }
+}
+
+void WorkspaceFrame::unloadAndDeleteBoardView(BoardView *view) {
+    view->setVisible(false);
+    view->prepareToClose();
+
+    // (close the items as usual before deleting `view`)
+    QPointer<BoardView> viewPtr(view);
+    view->loadBoard(-1, [viewPtr](bool /*loadOk*/, bool /*highlightedCardIdChanged*/) {
+        if (viewPtr)
+            viewPtr->deleteLater();
     });
 }
 
+QVector<BoardView *> WorkspaceFrame::getAllBoardViews() const {
+    return QVector<BoardView *> {boardView} + residentBoardViews;
+}
+
 void WorkspaceFrame::onUserToAddBoard() {
     class AsyncRoutineWithVars : public AsyncRoutineWithErrorFlag
     {
@@ -418,7 +581,7 @@ void WorkspaceFrame::onUserToAddBoard() {
 
     routine->addStep([this, routine]() {
         // load board
-        boardView->loadBoard(
+        showBoard(
                 routine->newBoardId,
                 // callback
                 [this, routine](bool ok, bool highlightedCardIdChanged) {
@@ -496,16 +659,155 @@ void WorkspaceFrame::onUserToRenameExportBoardToImage(const int boardId) {
     const QString fileName
             = QString("%1__%2.png")
               .arg(makeValidFileName(workspaceName), makeValidFileName(boardName));
-    const QImage image = boardView->renderAsImage();
-
-    //
     const QString outputDir = Services::instance()->getAppDataReadonly()->getExportOutputDir();
     const QString filePath = QDir(outputDir).filePath(fileName);
-    const bool ok = image.save(filePath);
-    if (ok)
-        QMessageBox::information(this, " ", "Successfully exported to " + filePath);
-    else
-        QMessageBox::warning(this, " ", "Failed to write image file " + filePath);
+
+    // record the board (the export then runs in background, without touching the board)
+    const qint64 memoryCapBytes
+            = qint64(Services::instance()->getAppDataReadonly()->getExportImageMemoryCapMb())
+              * 1024 * 1024;
+    TiledPngExport::Source source;
+    QString errorMsg;
+    const bool ok = boardView->recordForImageExport(memoryCapBytes, &source, &errorMsg);
+    if (!ok) {
+        QMessageBox::warning(this, " ", errorMsg);
+        return;
+    }
+
+    //
+    const int bandsCount = source.bandRecordings.count();
+    auto *exportJob = new TiledPngExport(source, filePath, this);
+
+    auto *progressDialog = new QProgressDialog(
+            QString("Exporting %1 x %2 image...")
+                .arg(source.imageSize.width()).arg(source.imageSize.height()),
+            "Cancel", 0, bandsCount, this);
+    progressDialog->setWindowModality(Qt::WindowModal);
+    progressDialog->setMinimumDuration(500);
+    progressDialog->setAutoReset(false);
+    progressDialog->setAutoClose(false);
+
+    connect(progressDialog, &QProgressDialog::canceled, exportJob, &TiledPngExport::cancel);
+
+    connect(exportJob, &TiledPngExport::progressUpdated,
+            progressDialog, [progressDialog](const int finishedBandsCount, const int /*count*/) {
+        progressDialog->setValue(finishedBandsCount);
+    });
+
+    connect(exportJob, &TiledPngExport::finished,
+            this, [this, exportJob, progressDialog, filePath](
+                const bool succeeded, const bool canceled, const QString &exportErrorMsg) {
+        progressDialog->close();
+        progressDialog->deleteLater();
+        exportJob->deleteLater();
+
+        if (canceled)
+            return;
+        if (succeeded)
+            QMessageBox::information(this, " ", "Successfully exported to " + filePath);
+        else
+            QMessageBox::warning(this, " ", exportErrorMsg);
+    });
+
+    exportJob->start();
+}
+
+void WorkspaceFrame::onUserToExportBoardToVectorFile(
+        const int boardId, const BoardVectorExport::FileFormat format) {
+    class AsyncRoutineWithVars : public AsyncRoutineWithErrorFlag
+    {
+    public:
+        QStringList userLabelsList;
+        std::optional<BoardSnapshot> boardSnapshot;
+        QString errorMsg;
+    };
+    auto *routine = new AsyncRoutineWithVars;
+    routine->setName("WorkspaceFrame::onUserToExportBoardToVectorFile");
+
+    //
+    routine->addParallelSteps({
+        {
+            [this, routine]() {
+                // get user labels (for the order of labels shown)
+                using StringListPair = std::pair<QStringList, QStringList>;
+                Services::instance()->getAppDataReadonly()->getUserLabelsAndRelationshipTypes(
+                        // callback
+                        [routine](bool ok, const StringListPair &labelsAndRelTypes) {
+                            ContinuationContext context(routine);
+                            if (ok)
+                                routine->userLabelsList = labelsAndRelTypes.first;
+                        },
+                        this
+                );
+            },
+            this
+        },
+        {
+            [this, routine, boardId]() {
+                // get board snapshot (the board need not be opened)
+                Services::instance()->getAppDataReadonly()->getBoardSnapshot(
+                        boardId,
+                        // callback
+                        [routine, boardId](bool ok, std::optional<BoardSnapshot> snapshot) {
+                            ContinuationContext context(routine);
+                            if (!ok || !snapshot.has_value()) {
+                                context.setErrorFlag();
+                                routine->errorMsg
+                                        = QString("Could not load board %1").arg(boardId);
+                                return;
+                            }
+                            routine->boardSnapshot = std::move(snapshot);
+                        },
+                        this
+                );
+            },
+            this
+        }
+    });
+
+    routine->addStep([this, routine, boardId, format]() {
+        // write file
+        ContinuationContext context(routine);
+
+        BoardVectorExport::Style style;
+        {
+            auto *appDataReadonly = Services::instance()->getAppDataReadonly();
+            style.isDarkTheme = appDataReadonly->getIsDarkTheme();
+            style.autoAdjustCardColorsForDarkTheme
+                    = appDataReadonly->getAutoAdjustCardColorsForDarkTheme();
+            style.cardLabelToColorMapping = cardLabelToColorMapping;
+            style.cardPropertiesToShow = cardPropertiesToShow;
+            style.userLabelsList = routine->userLabelsList;
+        }
+        const BoardVectorExport boardExport(routine->boardSnapshot.value(), style);
+
+        const QString boardName = boardsTabBar->getItemNameById(boardId);
+        const QString fileName
+                = QString("%1__%2.%3")
+                  .arg(makeValidFileName(workspaceName), makeValidFileName(boardName),
+                       BoardVectorExport::getFileExtension(format));
+        const QString outputDir
+                = Services::instance()->getAppDataReadonly()->getExportOutputDir();
+        const QString filePath = QDir(outputDir).filePath(fileName);
+
+        QString errorMsg;
+        const bool ok = boardExport.writeFile(filePath, format, &errorMsg);
+        if (!ok) {
+            context.setErrorFlag();
+            routine->errorMsg = errorMsg;
+            return;
+        }
+        showInformationMessageBox(this, " ", "Successfully exported to " + filePath);
+    }, this);
+
+    routine->addStep([this, routine]() {
+        // final step
+        ContinuationContext context(routine);
+        if (routine->errorFlag)
+            showWarningMessageBox(this, " ", routine->errorMsg);
+    }, this);
+
+    routine->start();
 }
 
 void WorkspaceFrame::onUserSelectedBoard(const int boardId) {
@@ -543,8 +845,8 @@ void WorkspaceFrame::onUserSelectedBoard(const int boardId) {
     }, this);
 
     routine->addStep([this, routine, boardId]() {
-        // load board
-        boardView->loadBoard(
+        // show board
+        showBoard(
                 boardId,
                 // callback
                 [this, routine, boardId](bool ok, bool highlightedCardIdChanged) {
@@ -630,9 +932,42 @@ void WorkspaceFrame::onUserToRemoveBoard(const int boardIdToRemove) {
             ->setAutoDelete()->start();
     }, this);
 
-    routine->addStep([this, routine, boardIdToLoad]() {
-        // load board
+    routine->addStep([this, routine, boardIdToRemove]() {
+        // unload the removed board
+        removeResidentBoardView(boardIdToRemove);
+
+        if (boardView->getBoardId() != boardIdToRemove) {
+            routine->nextStep();
+            return;
+        }
+
         boardView->loadBoard(
+                -1,
+                // callback
+                [this, routine, boardIdToRemove](bool ok, bool highlightedCardIdChanged) {
+                    ContinuationContext context(routine);
+                    if (!ok) {
+                        context.setErrorFlag();
+                        routine->errorMsg
+                                = QString("Could not close board %1").arg(boardIdToRemove);
+                    }
+
+                    if (highlightedCardIdChanged) {
+                        Services::instance()->getAppData()
+                                ->setSingleHighlightedCardId(EventSource(this), -1);
+                    }
+                }
+        );
+    }, this);
+
+    routine->addStep([this, routine, boardIdToLoad]() {
+        // show board
+        if (boardIdToLoad == -1) {
+            routine->nextStep();
+            return;
+        }
+
+        showBoard(
                 boardIdToLoad,
                 // callback
                 [this, routine, boardIdToLoad](bool ok, bool highlightedCardIdChanged) {
@@ -696,9 +1031,12 @@ void WorkspaceFrame::onUserToSetCardColors() {
         }
         onCardLabelToColorMappingUpdated(newSetting); // saves to AppData
 
-        // inform `boardView` to update the corresponding SettingBox that is shown in it
-        boardView->updateSettingBoxOnWorkspaceSetting(
-                workspaceId, SettingCategory::CardLabelToColorMapping);
+        // inform the BoardView's to update the corresponding SettingBox that is shown in them
+        const auto views = getAllBoardViews();
+        for (BoardView *view: views) {
+            view->updateSettingBoxOnWorkspaceSetting(
+                    workspaceId, SettingCategory::CardLabelToColorMapping);
+        }
     });
 
     dialog->open();
@@ -708,10 +1046,13 @@ void WorkspaceFrame::onCardLabelToColorMappingUpdated(
         const CardLabelToColorMapping &cardLabelToColorMapping_) {
     cardLabelToColorMapping = cardLabelToColorMapping_;
 
-    // set `boardView`'s card color mapping to the same as this->cardLabelToColorMapping
-    boardView->setColorsAssociatedWithLabels(
-            cardLabelToColorMapping.cardLabelsAndAssociatedColors,
-            cardLabelToColorMapping.defaultNodeRectColor);
+    // set the BoardView's card color mapping to the same as this->cardLabelToColorMapping
+    const auto views = getAllBoardViews();
+    for (BoardView *view: views) {
+        view->setColorsAssociatedWithLabels(
+                cardLabelToColorMapping.cardLabelsAndAssociatedColors,
+                cardLabelToColorMapping.defaultNodeRectColor);
+    }
 
     //
     WorkspaceNodePropertiesUpdate update;
@@ -728,7 +1069,9 @@ void WorkspaceFrame::onCardPropertiesToShowUpdated(
     cardPropertiesToShow = cardPropertiesToShow_;
 
     //
-    boardView->cardPropertiesToShowSettingOnWorkspaceUpdated(cardPropertiesToShow);
+    const auto views = getAllBoardViews();
+    for (BoardView *view: views)
+        view->cardPropertiesToShowSettingOnWorkspaceUpdated(cardPropertiesToShow);
 
     //
     WorkspaceNodePropertiesUpdate update;
@@ -945,6 +1288,22 @@ WorkspaceFrame::ContextMenu::ContextMenu(WorkspaceFrame *workspaceFrame_)
             workspaceFrame->onUserToRenameExportBoardToImage(boardTabContextMenuTargetBoardId);
         });
     }
+    {
+        auto *action = menu->addAction("Export to SVG");
+        actionToIcon.insert(action, Icon::FileSave);
+        connect(action, &QAction::triggered, workspaceFrame, [this]() {
+            workspaceFrame->onUserToExportBoardToVectorFile(
+                    boardTabContextMenuTargetBoardId, BoardVectorExport::FileFormat::Svg);
+        });
+    }
+    {
+        auto *action = menu->addAction("Export to PDF");
+        actionToIcon.insert(action, Icon::FileSave);
+        connect(action, &QAction::triggered, workspaceFrame, [this]() {
+            workspaceFrame->onUserToExportBoardToVectorFile(
+                    boardTabContextMenuTargetBoardId, BoardVectorExport::FileFormat::Pdf);
+        });
+    }
     {
         auto *action = menu->addAction("Delete Board");
         actionToIcon.insert(action, Icon::Delete);
@@ -7,6 +7,7 @@
 #include "app_event_source.h"
 #include "models/settings/card_label_color_mapping.h"
 #include "models/settings/card_properties_to_show.h"
+#include "widgets/board_vector_export.h"
 #include "widgets/common_types.h"
 #include "widgets/components/simple_toolbar.h"
 #include "widgets/icons.h"
@@ -37,6 +38,8 @@ public:
     void showButtonRightSidebar();
     void applyZoomAction(const ZoomAction zoomAction);
     void toggleCardPreview();
+    void toggleRenderingProfiler();
+    void toggleMinimap();
 
     void prepareToClose();
 
@@ -67,7 +70,9 @@ private:
 
     WorkspaceToolBar *workspaceToolBar {nullptr};
     CustomTabBar *boardsTabBar {nullptr};
-    BoardView *boardView {nullptr};
+    BoardView *boardView {nullptr}; // the one shown
+    QVector<BoardView *> residentBoardViews;
+            // hidden BoardView's whose boards are kept loaded, least recently shown first
     NoBoardSign *noBoardSign {nullptr};
 
     struct ContextMenu
@@ -87,10 +92,33 @@ private:
     void setUpWidgets();
     void setUpConnections();
 
+    BoardView *createBoardView(); // the returned BoardView is hidden
+    void setUpBoardViewConnections(BoardView *view);
+
+    //!
+    //! Shows the board in `boardView`. If the board is in `residentBoardViews`, its BoardView is
+    //! swapped in without reloading; otherwise the board is loaded. The BoardView shown before
+    //! is kept in `residentBoardViews` (with its highlights cleared), and least recently shown
+    //! ones are unloaded if the limit of resident boards is exceeded.
+    //! Before calling this method, `boardView->canClose()` must return true.
+    //! \param boardIdToShow: cannot be -1
+    //!
+    void showBoard(
+            const int boardIdToShow,
+            std::function<void (bool ok, bool highlightedCardIdChanged)> callback);
+
+    void removeResidentBoardView(const int boardId); // does nothing if the board is not resident
+    void removeAllResidentBoardViews();
+    void limitResidentBoardViews(); // see Services::getResidentBoardsLimit()
+    static void unloadAndDeleteBoardView(BoardView *view);
+    QVector<BoardView *> getAllBoardViews() const; // `boardView` & `residentBoardViews`
+
     //
     void onUserToAddBoard();
     void onUserToRenameBoard(const int boardId);
     void onUserToRenameExportBoardToImage(const int boardId);
+    void onUserToExportBoardToVectorFile(
+            const int boardId, const BoardVectorExport::FileFormat format);
     void onUserSelectedBoard(const int boardId);
     void onUserToRemoveBoard(const int boardIdToRemove);
     void onUserToSetCardColors();
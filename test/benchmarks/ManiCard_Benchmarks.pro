@@ -0,0 +1,47 @@
+include(gtest_dependency.pri)
+
+TEMPLATE = app
+CONFIG += console c++17
+CONFIG -= app_bundle
+CONFIG += thread
+
+QT += testlib
+
+
+SOURCES += \
+        ../../src/models/card.cpp \
+        ../../src/models/group_box_tree.cpp \
+        ../../src/models/relationship.cpp \
+        ../../src/models/relationship_bundler.cpp \
+        ../../src/models/relationships_bundle.cpp \
+        ../../src/utilities/geometry_util.cpp \
+        ../../src/utilities/json_util.cpp \
+        ../../src/utilities/polyline_vicinity.cpp \
+        ../../src/utilities/rect_tree.cpp \
+        ../../src/utilities/symbol.cpp \
+        main.cpp         \
+        models/card_footprint_benchmark.cpp \
+        models/relationship_bundler_benchmark.cpp \
+        utilities/polyline_vicinity_benchmark.cpp \
+        utilities/rect_tree_benchmark.cpp
+
+
+HEADERS += \
+    ../../src/models/card.h \
+    ../../src/models/group_box_tree.h \
+    ../../src/models/relationship.h \
+    ../../src/models/relationship_bundler.h \
+    ../../src/models/relationships_bundle.h \
+    ../../src/utilities/flat_map.h \
+    ../../src/utilities/geometry_util.h \
+    ../../src/utilities/json_util.h \
+    ../../src/utilities/polyline_vicinity.h \
+    ../../src/utilities/rect_tree.h \
+    ../../src/utilities/symbol.h \
+    benchmark_util.h
+
+
+INCLUDEPATH += ../../src/
+DEPENDPATH += ../../src/
+
+DEFINES += QT_MESSAGELOGCONTEXT
@@ -0,0 +1,25 @@
+#ifndef BENCHMARK_UTIL_H
+#define BENCHMARK_UTIL_H
+
+#include <QtGlobal>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+//!
+//! \return number of bytes currently allocated on the heap (by \c malloc(), which is also used by
+//!         \c operator \c new), or -1 if it cannot be measured on this platform
+//!
+inline qint64 heapBytesInUse() {
+#if defined(__GLIBC__)
+#if __GLIBC_PREREQ(2, 33)
+    return static_cast<qint64>(mallinfo2().uordblks);
+#else
+    return static_cast<qint64>(mallinfo().uordblks);
+#endif
+#else
+    return -1;
+#endif
+}
+
+#endif // BENCHMARK_UTIL_H
@@ -0,0 +1,87 @@
+#include <vector>
+#include <gtest/gtest.h>
+#include <QDebug>
+#include <QHash>
+#include <QJsonValue>
+#include <QSet>
+#include <QStringList>
+#include "benchmark_util.h"
+#include "models/card.h"
+
+namespace {
+constexpr int cardCount = 100000;
+
+//!
+//! The layout of \c Card before it was made compact, for comparison.
+//!
+struct LegacyCard
+{
+    QSet<QString> labels;
+    QString title;
+    QString text;
+    QStringList tags;
+    QHash<QString, QJsonValue> customProperties;
+};
+
+// Each call returns a newly allocated string, as is the case for data parsed from DB responses.
+QString str(const char *s) {
+    return QString::fromUtf8(s);
+}
+
+void fillCard(Card &card, const int i) {
+    card.addLabels(QStringList {str("Person"), str("Project")});
+    card.title = QString("Card title %1").arg(i);
+    card.text = QString("Some text of card %1").arg(i);
+    card.tags = QStringList {str("tag1")};
+    card.insertCustomProperty(str("status"), str("active"));
+    card.insertCustomProperty(str("priority"), i % 5);
+    card.insertCustomProperty(str("due"), str("2024-12-31"));
+}
+
+void fillCard(LegacyCard &card, const int i) {
+    card.labels = QSet<QString> {str("Person"), str("Project")};
+    card.title = QString("Card title %1").arg(i);
+    card.text = QString("Some text of card %1").arg(i);
+    card.tags = QStringList {str("tag1")};
+    card.customProperties.insert(str("status"), str("active"));
+    card.customProperties.insert(str("priority"), i % 5);
+    card.customProperties.insert(str("due"), str("2024-12-31"));
+}
+
+template <class CardType>
+qint64 measureBytesPerCard() {
+    const qint64 before = heapBytesInUse();
+
+    std::vector<CardType> cards(cardCount);
+    for (int i = 0; i < cardCount; ++i)
+        fillCard(cards[i], i);
+
+    const qint64 after = heapBytesInUse();
+    return (after - before) / cardCount;
+}
+} // namespace
+
+TEST(CardFootprint, BytesPerCard) {
+    if (heapBytesInUse() < 0)
+        GTEST_SKIP() << "heap usage cannot be measured on this platform";
+
+    // intern the symbols beforehand, so that the (one-time) growth of the symbol table is not
+    // counted
+    {
+        Card card;
+        fillCard(card, 0);
+    }
+
+    //
+    const qint64 compactBytes = measureBytesPerCard<Card>();
+    const qint64 legacyBytes = measureBytesPerCard<LegacyCard>();
+
+    qInfo().noquote()
+            << QString("sizeof(Card) = %1, sizeof(LegacyCard) = %2")
+               .arg(sizeof(Card)).arg(sizeof(LegacyCard));
+    qInfo().noquote()
+            << QString("footprint per card (including heap): Card %1 bytes, LegacyCard %2 bytes")
+               .arg(compactBytes).arg(legacyBytes);
+
+    EXPECT_LT(compactBytes, legacyBytes);
+}
@@ -0,0 +1,234 @@
+#include <random>
+#include <gtest/gtest.h>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QSet>
+#include "models/group_box_tree.h"
+#include "models/relationship_bundler.h"
+
+namespace {
+// 50 top-level group-boxes, each having 3 child group-boxes, each of which has 2 child
+// group-boxes (500 group-boxes in total). Each of the 300 leaf group-boxes has 10 cards.
+constexpr int topLevelGroupBoxCount = 50;
+constexpr int leafCardCount = 10;
+constexpr int externalCardCount = 2000;
+constexpr int relationshipCount = 20000;
+constexpr int incrementalUpdateCount = 200;
+
+struct SyntheticBoard
+{
+    GroupBoxTree tree;
+    QHash<int, QSet<RelationshipId>> cardIdToRels;
+    QSet<RelationshipId> allRels;
+    QVector<int> groupedCards;
+    QVector<int> leafGroupBoxes;
+
+    void addRelationship(const RelationshipId &rel) {
+        allRels << rel;
+        cardIdToRels[rel.startCardId] << rel;
+        cardIdToRels[rel.endCardId] << rel;
+    }
+
+    void removeRelationship(const RelationshipId &rel) {
+        allRels.remove(rel);
+        cardIdToRels[rel.startCardId].remove(rel);
+        cardIdToRels[rel.endCardId].remove(rel);
+    }
+};
+
+void buildBoard(SyntheticBoard *board, std::mt19937 &gen) {
+    constexpr int externalCardIdStart = 100000;
+    const QStringList types {"RELATES_TO", "DEPENDS_ON", "REFERS_TO", "PART_OF"};
+
+    int nextGroupBoxId = 1;
+    int nextCardId = 1;
+    for (int i = 0; i < topLevelGroupBoxCount; ++i) {
+        const int top = nextGroupBoxId++;
+        board->tree.containerNode(GroupBoxTree::rootId).addChildGroupBoxes({top});
+        for (int j = 0; j < 3; ++j) {
+            const int mid = nextGroupBoxId++;
+            board->tree.containerNode(top).addChildGroupBoxes({mid});
+            for (int k = 0; k < 2; ++k) {
+                const int leaf = nextGroupBoxId++;
+                board->tree.containerNode(mid).addChildGroupBoxes({leaf});
+                board->leafGroupBoxes << leaf;
+
+                // the cards of a leaf all relate to a "hub" external card, so they are bundled
+                const int hubCardId = externalCardIdStart + (leaf % externalCardCount);
+                QSet<int> cards;
+                for (int c = 0; c < leafCardCount; ++c) {
+                    const int cardId = nextCardId++;
+                    cards << cardId;
+                    board->groupedCards << cardId;
+                    board->addRelationship(RelationshipId(cardId, hubCardId, types.at(0)));
+                }
+                board->tree.containerNode(leaf).addChildCards(cards);
+            }
+        }
+    }
+
+    // random relationships
+    std::uniform_int_distribution<int> groupedCardDist(0, board->groupedCards.count() - 1);
+    std::uniform_int_distribution<int> externalCardDist(0, externalCardCount - 1);
+    std::uniform_int_distribution<int> typeDist(1, types.count() - 1);
+    while (board->allRels.count() < relationshipCount) {
+        const int card1 = board->groupedCards.at(groupedCardDist(gen));
+        const int card2 = (gen() % 4 == 0)
+                ? board->groupedCards.at(groupedCardDist(gen))
+                : externalCardIdStart + externalCardDist(gen);
+        if (card1 == card2)
+            continue;
+        board->addRelationship(RelationshipId(card1, card2, types.at(typeDist(gen))));
+    }
+}
+
+//!
+//! The full recomputation that was used before \c RelationshipBundler, for comparison.
+//! (It copied the set of all relationships for every card. Here it is copied once per group-box
+//! to keep the benchmark short, so the legacy time is an underestimate.)
+//!
+QSet<RelationshipsBundle> legacyComputeBundles(const SyntheticBoard &board) {
+    QVector<int> groupBoxIdsFromDFS;
+    const QHash<int, QSet<int>> groupBoxIdToDescendantCards
+            = board.tree.getDescendantCardsOfEveryGroupBox(&groupBoxIdsFromDFS);
+    const QHash<int, QSet<RelationshipId>> &cardIdToRels = board.cardIdToRels;
+
+    QHash<int, QSet<RelationshipId>> cardIdToBundledRels;
+    QSet<RelationshipsBundle> allBundles;
+
+    for (const int groupBoxId: qAsConst(groupBoxIdsFromDFS)) {
+        const QSet<int> cardsWithin = groupBoxIdToDescendantCards.value(groupBoxId);
+        QSet<RelationshipsBundle> bundlesOfGroup;
+
+        QSet<RelationshipId> allRels; // (as `getAllRelationshipIds()` was)
+        for (auto it = cardIdToRels.constBegin(); it != cardIdToRels.constEnd(); ++it)
+            allRels += it.value();
+
+        for (auto it = cardsWithin.constBegin(); it != cardsWithin.constEnd(); ++it) {
+            const int cardId = *it;
+            QSet<RelationshipsBundle> possibleBundles1;
+
+            for (const RelationshipId &rel: qAsConst(allRels)) {
+                if (cardIdToBundledRels.value(cardId).contains(rel))
+                    continue;
+
+                int theOtherCard;
+                if (!rel.connectsCard(cardId, &theOtherCard))
+                    continue;
+                if (cardsWithin.contains(theOtherCard))
+                    continue;
+
+                RelationshipsBundle bundle;
+                {
+                    bundle.groupBoxId = groupBoxId;
+                    bundle.externalCardId = theOtherCard;
+                    bundle.relationshipType = rel.type;
+                    bundle.direction = (cardId == rel.startCardId)
+                            ? RelationshipsBundle::Direction::OutFromGroup
+                            : RelationshipsBundle::Direction::IntoGroup;
+                }
+                possibleBundles1 << bundle;
+            }
+
+            if (it == cardsWithin.constBegin()) {
+                if (possibleBundles1.isEmpty())
+                    break;
+                bundlesOfGroup = possibleBundles1;
+            }
+            else {
+                bundlesOfGroup &= possibleBundles1;
+                if (bundlesOfGroup.isEmpty())
+                    break;
+            }
+        }
+
+        for (const int cardId: cardsWithin) {
+            for (const RelationshipsBundle &bundle: qAsConst(bundlesOfGroup)) {
+                cardIdToBundledRels[cardId] << (
+                        (bundle.direction == RelationshipsBundle::Direction::IntoGroup)
+                        ? RelationshipId(bundle.externalCardId, cardId, bundle.relationshipType)
+                        : RelationshipId(cardId, bundle.externalCardId, bundle.relationshipType));
+            }
+        }
+        allBundles += bundlesOfGroup;
+    }
+    return allBundles;
+}
+} // namespace
+
+TEST(RelationshipBundler, SyntheticBoard500Groups20kRelationships) {
+    std::mt19937 gen(2024);
+    SyntheticBoard board;
+    buildBoard(&board, gen);
+
+    RelationshipBundler bundler(
+            &board.tree,
+            [&board](const int cardId) { return board.cardIdToRels.value(cardId); });
+
+    // legacy full recomputation
+    QElapsedTimer timer;
+    timer.start();
+    const QSet<RelationshipsBundle> legacyBundles = legacyComputeBundles(board);
+    const qint64 legacyFullUsec = timer.nsecsElapsed() / 1000;
+
+    // full computation
+    timer.start();
+    bundler.markAllChanged();
+    bundler.update();
+    const qint64 fullUsec = timer.nsecsElapsed() / 1000;
+
+    EXPECT_EQ(bundler.getAllBundles(), legacyBundles);
+
+    // incremental updates: toggle a relationship, or move a card to another leaf group-box
+    std::uniform_int_distribution<int> groupedCardDist(0, board.groupedCards.count() - 1);
+    std::uniform_int_distribution<int> leafDist(0, board.leafGroupBoxes.count() - 1);
+
+    qint64 incrementalTotalUsec = 0;
+    for (int i = 0; i < incrementalUpdateCount; ++i) {
+        const int cardId = board.groupedCards.at(groupedCardDist(gen));
+
+        timer.start();
+        if (i % 2 == 0) {
+            const RelationshipId rel(cardId, 100000 + static_cast<int>(gen() % 50), "NEW_TYPE");
+            if (board.allRels.contains(rel))
+                board.removeRelationship(rel);
+            else
+                board.addRelationship(rel);
+            bundler.markRelationshipsChanged({rel});
+        }
+        else {
+            bundler.markCardChanged(cardId);
+            board.tree.reparentExistingCard(cardId, board.leafGroupBoxes.at(leafDist(gen)));
+            bundler.markCardChanged(cardId);
+        }
+        bundler.update();
+        incrementalTotalUsec += timer.nsecsElapsed() / 1000;
+    }
+    const double incrementalAvgUsec = double(incrementalTotalUsec) / incrementalUpdateCount;
+
+    // check against a full recomputation
+    {
+        RelationshipBundler fullBundler(
+                &board.tree,
+                [&board](const int cardId) { return board.cardIdToRels.value(cardId); });
+        fullBundler.markAllChanged();
+        fullBundler.update();
+        EXPECT_EQ(bundler.getAllBundles(), fullBundler.getAllBundles());
+        EXPECT_EQ(bundler.getBundledRelationships(), fullBundler.getBundledRelationships());
+    }
+
+    qInfo().noquote()
+            << QString("%1 group-boxes, %2 relationships, %3 bundles")
+               .arg(board.tree.getGroupBoxesCount()).arg(board.allRels.count())
+               .arg(legacyBundles.count());
+    qInfo().noquote()
+            << QString("legacy full recomputation: %1 ms").arg(legacyFullUsec / 1000.0);
+    qInfo().noquote()
+            << QString("RelationshipBundler full computation: %1 ms").arg(fullUsec / 1000.0);
+    qInfo().noquote()
+            << QString("RelationshipBundler incremental update: %1 ms on average")
+               .arg(incrementalAvgUsec / 1000.0);
+
+    EXPECT_LT(incrementalAvgUsec, double(legacyFullUsec));
+}
@@ -0,0 +1,123 @@
+#include <random>
+#include <gtest/gtest.h>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QPainterPath>
+#include "utilities/geometry_util.h"
+#include "utilities/polyline_vicinity.h"
+
+namespace {
+constexpr int arrowCount = 5000;
+constexpr int moveStepCount = 20;
+constexpr double vicinityRadius = 4;
+
+struct Arrow
+{
+    QPointF startPoint;
+    QPointF endPoint;
+    QVector<QPointF> joints;
+
+    QVector<QPointF> points() const {
+        return QVector<QPointF> {startPoint} + joints + QVector<QPointF> {endPoint};
+    }
+};
+
+//!
+//! The shape that \c EdgeArrow rebuilt on every change before \c PolylineVicinity was used.
+//!
+QPainterPath buildLegacyShape(const Arrow &arrow) {
+    QPainterPath path;
+    path.setFillRule(Qt::WindingFill);
+
+    const QVector<QPointF> points = arrow.points();
+    for (int i = 0; i < points.count() - 1; ++i)
+        path.addPath(tiltedRect(QLineF(points.at(i), points.at(i + 1)), vicinityRadius * 2.0));
+
+    for (const QPointF &joint: arrow.joints) {
+        QPainterPath jointPath;
+        jointPath.addRect(squareCenteredAt(joint, vicinityRadius * 2.0));
+        path.addPath(jointPath);
+    }
+    return path;
+}
+} // namespace
+
+TEST(PolylineVicinity, MoveArrows) {
+    std::mt19937 gen(2024);
+    std::uniform_real_distribution<double> posDist(0, 20000);
+    std::uniform_int_distribution<int> jointsCountDist(0, 2);
+
+    QVector<Arrow> arrows;
+    for (int i = 0; i < arrowCount; ++i) {
+        Arrow arrow;
+        arrow.startPoint = QPointF(posDist(gen), posDist(gen));
+        arrow.endPoint = QPointF(posDist(gen), posDist(gen));
+        const int jointsCount = jointsCountDist(gen);
+        for (int j = 0; j < jointsCount; ++j)
+            arrow.joints << QPointF(posDist(gen), posDist(gen));
+        arrows << arrow;
+    }
+
+    // On each step, every arrow's end point is moved (as when the cards are dragged), after
+    // which its bounding rect is queried and it is hit-tested at one point (as for hovering).
+    std::uniform_real_distribution<double> stepDist(-20, 20);
+    QVector<QPointF> moves;
+    for (int i = 0; i < moveStepCount; ++i)
+        moves << QPointF(stepDist(gen), stepDist(gen));
+
+    // -- legacy
+    QElapsedTimer timer;
+    QVector<Arrow> arrows1 = arrows;
+    int legacyHitCount = 0;
+    double legacyBoundingArea = 0;
+
+    timer.start();
+    for (const QPointF &move: qAsConst(moves)) {
+        for (Arrow &arrow: arrows1) {
+            arrow.endPoint += move;
+            const QPainterPath shape = buildLegacyShape(arrow);
+            const QRectF boundingRect = shape.boundingRect();
+            legacyBoundingArea += boundingRect.width() * boundingRect.height();
+            if (shape.contains(arrow.startPoint + QPointF(3, 3)))
+                ++legacyHitCount;
+        }
+    }
+    const qint64 legacyUsec = timer.nsecsElapsed() / 1000;
+
+    // -- PolylineVicinity
+    QVector<Arrow> arrows2 = arrows;
+    QVector<PolylineVicinity> vicinities(arrowCount, PolylineVicinity(vicinityRadius));
+    int hitCount = 0;
+    double boundingArea = 0;
+
+    timer.start();
+    for (const QPointF &move: qAsConst(moves)) {
+        for (int i = 0; i < arrowCount; ++i) {
+            Arrow &arrow = arrows2[i];
+            arrow.endPoint += move;
+            vicinities[i].setPoints(arrow.points());
+            const QRectF boundingRect = vicinities.at(i).boundingRect();
+            boundingArea += boundingRect.width() * boundingRect.height();
+            if (vicinities.at(i).contains(arrow.startPoint + QPointF(3, 3)))
+                ++hitCount;
+        }
+    }
+    const qint64 vicinityUsec = timer.nsecsElapsed() / 1000;
+
+    EXPECT_EQ(hitCount, legacyHitCount);
+
+    //
+    const int updatesCount = arrowCount * moveStepCount;
+    qInfo().noquote()
+            << QString("%1 arrows moved %2 times").arg(arrowCount).arg(moveStepCount);
+    qInfo().noquote()
+            << QString("legacy shape: %1 us per update").arg(double(legacyUsec) / updatesCount);
+    qInfo().noquote()
+            << QString("PolylineVicinity: %1 us per update")
+               .arg(double(vicinityUsec) / updatesCount);
+    qInfo().noquote()
+            << QString("mean bounding-rect area: legacy %1, PolylineVicinity %2")
+               .arg(legacyBoundingArea / updatesCount).arg(boundingArea / updatesCount);
+
+    EXPECT_LT(vicinityUsec, legacyUsec);
+}
@@ -0,0 +1,142 @@
+#include <random>
+#include <gtest/gtest.h>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QSet>
+#include "utilities/rect_tree.h"
+
+namespace {
+// A board of 500 group-boxes (100 top-level ones, each containing 4 smaller ones) and 5000
+// cards scattered over a 40000 x 40000 area.
+constexpr int topLevelGroupBoxCount = 100;
+constexpr int cardCount = 5000;
+constexpr int dragStepCount = 2000;
+constexpr double boardSize = 40000;
+
+struct SyntheticBoard
+{
+    QHash<int, QRectF> groupBoxIdToRect;
+    QHash<int, QRectF> cardIdToRect;
+};
+
+void buildBoard(SyntheticBoard *board, std::mt19937 &gen) {
+    std::uniform_real_distribution<double> posDist(0, boardSize - 2000);
+
+    int nextGroupBoxId = 1;
+    for (int i = 0; i < topLevelGroupBoxCount; ++i) {
+        const QRectF topRect(posDist(gen), posDist(gen), 2000, 2000);
+        board->groupBoxIdToRect.insert(nextGroupBoxId++, topRect);
+        for (int j = 0; j < 4; ++j) {
+            const QRectF childRect(
+                    topRect.left() + 100 + (j % 2) * 950, topRect.top() + 100 + (j / 2) * 950,
+                    850, 850);
+            board->groupBoxIdToRect.insert(nextGroupBoxId++, childRect);
+        }
+    }
+
+    std::uniform_real_distribution<double> cardPosDist(0, boardSize - 300);
+    for (int cardId = 1; cardId <= cardCount; ++cardId)
+        board->cardIdToRect.insert(cardId, QRectF(cardPosDist(gen), cardPosDist(gen), 300, 200));
+}
+
+//!
+//! The linear scan done by \c BoardView before the spatial index was added.
+//!
+QSet<int> linearScanContaining(const QHash<int, QRectF> &idToRect, const QRectF &rect) {
+    QSet<int> result;
+    for (auto it = idToRect.constBegin(); it != idToRect.constEnd(); ++it) {
+        if (it.value().contains(rect))
+            result << it.key();
+    }
+    return result;
+}
+
+QRectF linearScanBoundingRect(const QHash<int, QRectF> &idToRect) {
+    QRectF result;
+    for (auto it = idToRect.constBegin(); it != idToRect.constEnd(); ++it) {
+        if (result.isNull())
+            result = it.value();
+        else
+            result = result.united(it.value());
+    }
+    return result;
+}
+} // namespace
+
+TEST(RectTree, DragCardOverSyntheticBoard) {
+    std::mt19937 gen(2024);
+    SyntheticBoard board;
+    buildBoard(&board, gen);
+
+    // build the indices
+    QElapsedTimer timer;
+    timer.start();
+
+    RectTree groupBoxesIndex;
+    for (auto it = board.groupBoxIdToRect.constBegin();
+            it != board.groupBoxIdToRect.constEnd(); ++it) {
+        groupBoxesIndex.set(it.key(), it.value());
+    }
+    RectTree cardsIndex;
+    for (auto it = board.cardIdToRect.constBegin(); it != board.cardIdToRect.constEnd(); ++it)
+        cardsIndex.set(it.key(), it.value());
+
+    const qint64 buildUsec = timer.nsecsElapsed() / 1000;
+
+    // simulate dragging a card: on each step, move it, then find the enclosing group-boxes and
+    // the bounding rect of all cards (as done on `movedOrResized` & when adjusting scene rect)
+    std::uniform_real_distribution<double> stepDist(-40, 40);
+    const int draggedCardId = 1;
+    QVector<QRectF> draggedCardRects;
+    {
+        QRectF rect = board.cardIdToRect.value(draggedCardId);
+        for (int i = 0; i < dragStepCount; ++i) {
+            rect.translate(stepDist(gen), stepDist(gen));
+            draggedCardRects << rect;
+        }
+    }
+
+    // -- linear scan
+    QHash<int, QRectF> cardIdToRect = board.cardIdToRect;
+    int linearEnclosingCount = 0;
+    QRectF linearBoundingRect;
+
+    timer.start();
+    for (const QRectF &rect: qAsConst(draggedCardRects)) {
+        cardIdToRect.insert(draggedCardId, rect);
+        linearEnclosingCount += linearScanContaining(board.groupBoxIdToRect, rect).count();
+        linearBoundingRect = linearScanBoundingRect(cardIdToRect);
+    }
+    const qint64 linearUsec = timer.nsecsElapsed() / 1000;
+
+    // -- RectTree
+    int indexEnclosingCount = 0;
+    QRectF indexBoundingRect;
+
+    timer.start();
+    for (const QRectF &rect: qAsConst(draggedCardRects)) {
+        cardsIndex.set(draggedCardId, rect);
+        indexEnclosingCount += groupBoxesIndex.queryContaining(rect).count();
+        indexBoundingRect = cardsIndex.boundingRect();
+    }
+    const qint64 indexUsec = timer.nsecsElapsed() / 1000;
+
+    EXPECT_EQ(indexEnclosingCount, linearEnclosingCount);
+    EXPECT_EQ(indexBoundingRect, linearBoundingRect);
+
+    //
+    qInfo().noquote()
+            << QString("%1 group-boxes, %2 cards, tree heights %3 & %4")
+               .arg(groupBoxesIndex.count()).arg(cardsIndex.count())
+               .arg(groupBoxesIndex.height()).arg(cardsIndex.height());
+    qInfo().noquote() << QString("building indices: %1 ms").arg(buildUsec / 1000.0);
+    qInfo().noquote()
+            << QString("linear scan: %1 us per drag step")
+               .arg(double(linearUsec) / dragStepCount);
+    qInfo().noquote()
+            << QString("RectTree: %1 us per drag step")
+               .arg(double(indexUsec) / dragStepCount);
+
+    EXPECT_LT(indexUsec, linearUsec);
+}
@@ -11,27 +11,76 @@ QT += testlib
 
 SOURCES += \
         ../../src/models/group_box_tree.cpp \
+        ../../src/models/relationship.cpp \
+        ../../src/models/relationship_bundler.cpp \
+        ../../src/models/relationships_bundle.cpp \
         ../../src/utilities/action_debouncer.cpp \
         ../../src/utilities/async_routine.cpp \
+        ../../src/utilities/background_job.cpp \
         ../../src/utilities/directed_graph.cpp \
+        ../../src/utilities/edge_router.cpp \
+        ../../src/utilities/force_directed_layout.cpp \
+        ../../src/utilities/geometry_util.cpp \
         ../../src/utilities/json_util.cpp \
+        ../../src/utilities/minimap_renderer.cpp \
+        ../../src/utilities/png_stream_writer.cpp \
+        ../../src/utilities/polyline_vicinity.cpp \
+        ../../src/utilities/rect_tree.cpp \
+        ../../src/utilities/symbol.cpp \
+        ../../src/utilities/time_slicing.cpp \
+        ../../src/utilities/trace_recorder.cpp \
+        ../../src/utilities/vector_drawing.cpp \
+        ../../src/utilities/viewport_tile_cache.cpp \
         main.cpp         \
         models/group_box_tree_unittest.cpp \
+        models/relationship_bundler_unittest.cpp \
         utilities/action_debouncer_unittest.cpp \
         utilities/async_routine_unittest.cpp \
         utilities/async_routine_with_error_flag_unittest.cpp \
+        utilities/background_job_unittest.cpp \
         utilities/directed_graph_unittest.cpp \
+        utilities/edge_router_unittest.cpp \
+        utilities/flat_map_unittest.cpp \
+        utilities/force_directed_layout_unittest.cpp \
         utilities/json_util_unittest.cpp \
-        utilities/variables_update_propagator_unittest.cpp
+        utilities/label_rules_table_unittest.cpp \
+        utilities/minimap_renderer_unittest.cpp \
+        utilities/png_stream_writer_unittest.cpp \
+        utilities/polyline_vicinity_unittest.cpp \
+        utilities/rect_tree_unittest.cpp \
+        utilities/symbol_unittest.cpp \
+        utilities/time_slicing_unittest.cpp \
+        utilities/trace_recorder_unittest.cpp \
+        utilities/variables_update_propagator_unittest.cpp \
+        utilities/vector_drawing_unittest.cpp \
+        utilities/viewport_tile_cache_unittest.cpp
 
 
 HEADERS += \
     ../../src/models/group_box_tree.h \
+    ../../src/models/relationship.h \
+    ../../src/models/relationship_bundler.h \
+    ../../src/models/relationships_bundle.h \
     ../../src/utilities/action_debouncer.h \
     ../../src/utilities/async_routine.h \
+    ../../src/utilities/background_job.h \
     ../../src/utilities/directed_graph.h \
+    ../../src/utilities/edge_router.h \
+    ../../src/utilities/flat_map.h \
+    ../../src/utilities/force_directed_layout.h \
+    ../../src/utilities/geometry_util.h \
     ../../src/utilities/json_util.h \
-    ../../src/utilities/variables_update_propagator.h
+    ../../src/utilities/label_rules_table.h \
+    ../../src/utilities/minimap_renderer.h \
+    ../../src/utilities/png_stream_writer.h \
+    ../../src/utilities/polyline_vicinity.h \
+    ../../src/utilities/rect_tree.h \
+    ../../src/utilities/symbol.h \
+    ../../src/utilities/time_slicing.h \
+    ../../src/utilities/trace_recorder.h \
+    ../../src/utilities/variables_update_propagator.h \
+    ../../src/utilities/vector_drawing.h \
+    ../../src/utilities/viewport_tile_cache.h
 
 
 INCLUDEPATH += ../../src/
@@ -39,4 +88,7 @@ DEPENDPATH += ../../src/
 
 DEFINES += QT_MESSAGELOGCONTEXT
 
+# zlib (which Qt itself is built against), for PngStreamWriter
+LIBS += -lz
+
 include(boost_dependency.pri)
@@ -0,0 +1,172 @@
+#include <random>
+#include <gtest/gtest.h>
+#include <QHash>
+#include <QSet>
+#include "models/group_box_tree.h"
+#include "models/relationship_bundler.h"
+
+namespace {
+
+class Relationships
+{
+public:
+    void add(const RelationshipId &rel) {
+        cardIdToRels[rel.startCardId] << rel;
+        cardIdToRels[rel.endCardId] << rel;
+    }
+
+    void remove(const RelationshipId &rel) {
+        cardIdToRels[rel.startCardId].remove(rel);
+        cardIdToRels[rel.endCardId].remove(rel);
+    }
+
+    QSet<RelationshipId> ofCard(const int cardId) const {
+        return cardIdToRels.value(cardId);
+    }
+
+    RelationshipBundler::GetRelationshipsOfCard getter() const {
+        return [this](const int cardId) { return ofCard(cardId); };
+    }
+
+private:
+    QHash<int, QSet<RelationshipId>> cardIdToRels;
+};
+
+RelationshipsBundle makeBundle(
+        const int groupBoxId, const int externalCardId, const QString &type,
+        const RelationshipsBundle::Direction direction) {
+    RelationshipsBundle bundle;
+    bundle.groupBoxId = groupBoxId;
+    bundle.externalCardId = externalCardId;
+    bundle.relationshipType = Symbol(type);
+    bundle.direction = direction;
+    return bundle;
+}
+
+} // namespace
+
+TEST(RelationshipBundlerTests, BundlesAndIncrementalUpdate) {
+    // group-box 1 contains cards 11 & 12, and group-box 2, which contains card 13
+    GroupBoxTree tree;
+    tree.containerNode(GroupBoxTree::rootId).addChildGroupBoxes({1});
+    tree.containerNode(1).addChildCards({11, 12});
+    tree.containerNode(1).addChildGroupBoxes({2});
+    tree.containerNode(2).addChildCards({13});
+
+    Relationships rels;
+    rels.add(RelationshipId(11, 100, "R"));
+    rels.add(RelationshipId(12, 100, "R"));
+    rels.add(RelationshipId(13, 100, "R"));
+    rels.add(RelationshipId(200, 13, "S"));
+
+    RelationshipBundler bundler(&tree, rels.getter());
+    bundler.markAllChanged();
+    auto changes = bundler.update();
+
+    const auto bundleR1 = makeBundle(1, 100, "R", RelationshipsBundle::Direction::OutFromGroup);
+    const auto bundleS2 = makeBundle(2, 200, "S", RelationshipsBundle::Direction::IntoGroup);
+    EXPECT_EQ(bundler.getBundlesOfGroupBox(1), QSet<RelationshipsBundle> {bundleR1});
+    EXPECT_EQ(bundler.getBundlesOfGroupBox(2), QSet<RelationshipsBundle> {bundleS2});
+            // (13 -[R]-> 100 is already bundled by group-box 1)
+    EXPECT_EQ(changes.addedBundles, (QSet<RelationshipsBundle> {bundleR1, bundleS2}));
+    EXPECT_EQ(changes.newlyBundledRels.count(), 4);
+    EXPECT_TRUE(changes.unbundledRels.isEmpty());
+
+    // remove 12 -[R]-> 100
+    rels.remove(RelationshipId(12, 100, "R"));
+    bundler.markRelationshipsChanged({RelationshipId(12, 100, "R")});
+    changes = bundler.update();
+
+    const auto bundleR2 = makeBundle(2, 100, "R", RelationshipsBundle::Direction::OutFromGroup);
+    EXPECT_TRUE(bundler.getBundlesOfGroupBox(1).isEmpty());
+    EXPECT_EQ(bundler.getBundlesOfGroupBox(2), (QSet<RelationshipsBundle> {bundleR2, bundleS2}));
+    EXPECT_EQ(changes.removedBundles, QSet<RelationshipsBundle> {bundleR1});
+    EXPECT_EQ(changes.addedBundles, QSet<RelationshipsBundle> {bundleR2});
+    EXPECT_EQ(changes.unbundledRels,
+              (QSet<RelationshipId> {RelationshipId(11, 100, "R"), RelationshipId(12, 100, "R")}));
+    EXPECT_TRUE(changes.newlyBundledRels.isEmpty()); // (13 -[R]-> 100 stays bundled)
+
+    // move card 13 out of the tree
+    bundler.markCardChanged(13);
+    tree.removeCard(13);
+    bundler.markCardChanged(13);
+    changes = bundler.update();
+
+    EXPECT_TRUE(bundler.getAllBundles().isEmpty());
+    EXPECT_TRUE(bundler.getBundledRelationships().isEmpty());
+}
+
+TEST(RelationshipBundlerTests, IncrementalEqualsFullRecomputation) {
+    std::mt19937 gen(12345);
+    auto randomInt = [&gen](const int min, const int max) {
+        return std::uniform_int_distribution<int>(min, max)(gen);
+    };
+
+    // group-boxes 1..12 in a tree, cards 100..159 in group-boxes, external cards 200..209
+    GroupBoxTree tree;
+    tree.containerNode(GroupBoxTree::rootId).addChildGroupBoxes({1, 2, 3});
+    for (int g = 4; g <= 12; ++g)
+        tree.containerNode(randomInt(1, g - 1)).addChildGroupBoxes({g});
+    for (int c = 100; c < 160; ++c)
+        tree.containerNode(randomInt(1, 12)).addChildCards({c});
+
+    const QStringList types {"A", "B"};
+    auto randomRel = [&]() {
+        const int cardInGroup = randomInt(100, 159);
+        const int other = (randomInt(0, 3) == 0) ? randomInt(100, 159) : randomInt(200, 209);
+        const QString type = types.at(randomInt(0, 1));
+        return (randomInt(0, 1) == 0)
+                ? RelationshipId(cardInGroup, other, type)
+                : RelationshipId(other, cardInGroup, type);
+    };
+
+    Relationships rels;
+    QSet<RelationshipId> allRels;
+    for (int i = 0; i < 600; ++i) {
+        const auto rel = randomRel();
+        rels.add(rel);
+        allRels << rel;
+    }
+
+    RelationshipBundler bundler(&tree, rels.getter());
+    bundler.markAllChanged();
+    bundler.update();
+
+    for (int step = 0; step < 200; ++step) {
+        const int action = randomInt(0, 2);
+        if (action == 0) { // add or remove a relationship
+            const auto rel = randomRel();
+            if (allRels.contains(rel)) {
+                rels.remove(rel);
+                allRels.remove(rel);
+            }
+            else {
+                rels.add(rel);
+                allRels << rel;
+            }
+            bundler.markRelationshipsChanged({rel});
+        }
+        else if (action == 1) { // reparent a card
+            const int cardId = randomInt(100, 159);
+            bundler.markCardChanged(cardId);
+            tree.reparentExistingCard(cardId, randomInt(1, 12));
+            bundler.markCardChanged(cardId);
+        }
+        else { // reparent a group-box to root
+            const int groupBoxId = randomInt(4, 12);
+            bundler.markGroupBoxChanged(groupBoxId);
+            tree.reparentExistingGroupBox(groupBoxId, GroupBoxTree::rootId);
+            bundler.markGroupBoxChanged(groupBoxId);
+        }
+        bundler.update();
+
+        //
+        RelationshipBundler fullBundler(&tree, rels.getter());
+        fullBundler.markAllChanged();
+        fullBundler.update();
+
+        ASSERT_EQ(bundler.getAllBundles(), fullBundler.getAllBundles()) << "step " << step;
+        ASSERT_EQ(bundler.getBundledRelationships(), fullBundler.getBundledRelationships())
+                << "step " << step;
+    }
+}
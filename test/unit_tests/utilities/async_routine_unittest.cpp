@@ -4,6 +4,7 @@
 #include <QPointer>
 #include <QTest>
 #include <QThread>
+#include <QTimer>
 #include "utilities/async_routine.h"
 
 class AsyncRoutineTest : public testing::Test
@@ -200,3 +201,142 @@ TEST_F(AsyncRoutineTest, ContextRemoved) {
     ASSERT_TRUE(routineDeleted) << "routine not deleted (within time-out)";
     EXPECT_FALSE(stepPerformed);
 }
+
+//!
+//! Test that the tasks of parallel steps are all started before any of them completes, and that
+//! the routine continues only after all of them complete.
+//!
+TEST_F(AsyncRoutineTest, ParallelSteps) {
+    QPointer<AsyncRoutine> routine = new AsyncRoutine;
+    QString buffer;
+    routine->addStep([&buffer, routine]() {
+        buffer += '1';
+        routine->nextStep();
+    }, app);
+    routine->addParallelSteps({
+        {[&buffer, routine]() {
+            buffer += 'a';
+            QTimer::singleShot(100, app, [&buffer, routine]() {
+                buffer += 'A';
+                routine->nextStep();
+            });
+        }, app},
+        {[&buffer, routine]() {
+            buffer += 'b';
+            QTimer::singleShot(10, app, [&buffer, routine]() {
+                buffer += 'B';
+                routine->nextStep();
+            });
+        }, app}
+    });
+    routine->addStep([&buffer, routine]() {
+        buffer += '2';
+        routine->nextStep();
+    }, app);
+    routine->start();
+
+    //
+    const bool routineDeleted = QTest::qWaitFor([routine]()-> bool {
+        return routine.isNull();
+    }, 5000);
+    ASSERT_TRUE(routineDeleted) << "routine not deleted (within time-out)";
+    EXPECT_EQ(buffer, QString("1abBA2"));
+}
+
+//!
+//! Test that the tasks of parallel steps run in the threads of their own contexts.
+//!
+TEST_F(AsyncRoutineTest, ParallelStepsInDifferentThreads) {
+    QPointer<AsyncRoutine> routine = new AsyncRoutine;
+    QThread *thread1 = nullptr;
+    QThread *thread2 = nullptr;
+    routine->addParallelSteps({
+        {[&thread1, routine]() {
+            thread1 = QThread::currentThread();
+            routine->nextStep();
+        }, objInThread1},
+        {[&thread2, routine]() {
+            thread2 = QThread::currentThread();
+            routine->nextStep();
+        }, app}
+    });
+    routine->start();
+
+    //
+    const bool routineDeleted = QTest::qWaitFor([routine]()-> bool {
+        return routine.isNull();
+    }, 5000);
+    ASSERT_TRUE(routineDeleted) << "routine not deleted (within time-out)";
+    EXPECT_EQ(thread1, objInThread1->thread());
+    EXPECT_EQ(thread2, app->thread());
+}
+
+//!
+//! Test that if a task of parallel steps calls skipToFinalStep(), the routine waits for the other
+//! tasks and then skips to the final step.
+//!
+TEST_F(AsyncRoutineTest, ParallelStepsSkipToFinalStep) {
+    QPointer<AsyncRoutine> routine = new AsyncRoutine;
+    QString buffer;
+    routine->addParallelSteps({
+        {[&buffer, routine]() {
+            buffer += 'a';
+            routine->skipToFinalStep();
+        }, app},
+        {[&buffer, routine]() {
+            QTimer::singleShot(50, app, [&buffer, routine]() {
+                buffer += 'B';
+                routine->nextStep();
+            });
+        }, app}
+    });
+    routine->addStep([&buffer, routine]() {
+        buffer += '2';
+        routine->nextStep();
+    }, app);
+    routine->addStep([&buffer, routine]() {
+        buffer += '3';
+        routine->nextStep();
+    }, app);
+    routine->start();
+
+    //
+    const bool routineDeleted = QTest::qWaitFor([routine]()-> bool {
+        return routine.isNull();
+    }, 5000);
+    ASSERT_TRUE(routineDeleted) << "routine not deleted (within time-out)";
+    EXPECT_EQ(buffer, QString("aB3"));
+}
+
+//!
+//! Test that a task of parallel steps won't be performed if its context object is deleted, while
+//! the other tasks are.
+//!
+TEST_F(AsyncRoutineTest, ParallelStepsContextRemoved) {
+    QPointer<AsyncRoutine> routine = new AsyncRoutine;
+    auto *obj = new QObject(app);
+    QString buffer;
+    routine->addParallelSteps({
+        {[&buffer, routine]() {
+            buffer += 'a';
+            routine->nextStep();
+        }, obj},
+        {[&buffer, routine]() {
+            buffer += 'b';
+            routine->nextStep();
+        }, app}
+    });
+    routine->addStep([&buffer, routine]() {
+        buffer += '2';
+        routine->nextStep();
+    }, app);
+    delete obj;
+    routine->start();
+
+    //
+    const bool routineDeleted = QTest::qWaitFor([routine]()-> bool {
+        return routine.isNull();
+    }, 5000);
+    ASSERT_TRUE(routineDeleted) << "routine not deleted (within time-out)";
+    EXPECT_EQ(buffer, QString("b2"));
+}
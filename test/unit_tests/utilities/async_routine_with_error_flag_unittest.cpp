@@ -4,6 +4,7 @@
 #include <QPointer>
 #include <QTest>
 #include <QThread>
+#include <QTimer>
 #include "utilities/async_routine.h"
 
 class AsyncRoutineWithErrorFlagTest : public testing::Test
@@ -71,3 +72,75 @@ TEST_F(AsyncRoutineWithErrorFlagTest, HasSkip) {
 
     EXPECT_EQ(buffer, QString("13"));
 }
+
+TEST_F(AsyncRoutineWithErrorFlagTest, ParallelStepsNoError) {
+    QString buffer;
+    bool step2SawBothTasks = false;
+
+    QPointer<AsyncRoutineWithErrorFlag> routine = new AsyncRoutineWithErrorFlag;
+    routine->addParallelSteps({
+        {[routine, &buffer]() {
+            QTimer::singleShot(30, app, [routine, &buffer]() {
+                AsyncRoutineWithErrorFlag::ContinuationContext context(routine);
+                buffer += 'a';
+            });
+        }, app},
+        {[routine, &buffer]() {
+            AsyncRoutineWithErrorFlag::ContinuationContext context(routine);
+            buffer += 'b';
+        }, app}
+    });
+    routine->addStep([routine, &buffer, &step2SawBothTasks]() {
+        AsyncRoutineWithErrorFlag::ContinuationContext context(routine);
+        step2SawBothTasks = buffer.contains('a') && buffer.contains('b');
+        buffer += '2';
+    }, app);
+    routine->addStep([routine, &buffer]() {
+        AsyncRoutineWithErrorFlag::ContinuationContext context(routine);
+        buffer += routine->errorFlag ? 'E' : '3';
+    }, app);
+    routine->start();
+
+    const bool routineDeleted = QTest::qWaitFor([routine]()-> bool {
+        return routine.isNull();
+    }, 5000);
+    ASSERT_TRUE(routineDeleted) << "routine not deleted (within time-out)";
+
+    EXPECT_TRUE(step2SawBothTasks);
+    EXPECT_EQ(buffer, QString("ba23"));
+}
+
+TEST_F(AsyncRoutineWithErrorFlagTest, ParallelStepsWithError) {
+    QString buffer;
+
+    QPointer<AsyncRoutineWithErrorFlag> routine = new AsyncRoutineWithErrorFlag;
+    routine->addParallelSteps({
+        {[routine, &buffer]() {
+            AsyncRoutineWithErrorFlag::ContinuationContext context(routine);
+            buffer += 'a';
+            context.setErrorFlag();
+        }, app},
+        {[routine, &buffer]() {
+            QTimer::singleShot(30, app, [routine, &buffer]() {
+                AsyncRoutineWithErrorFlag::ContinuationContext context(routine);
+                buffer += 'b';
+            });
+        }, app}
+    });
+    routine->addStep([routine, &buffer]() {
+        AsyncRoutineWithErrorFlag::ContinuationContext context(routine);
+        buffer += '2';
+    }, app);
+    routine->addStep([routine, &buffer]() {
+        AsyncRoutineWithErrorFlag::ContinuationContext context(routine);
+        buffer += routine->errorFlag ? 'E' : '3';
+    }, app);
+    routine->start();
+
+    const bool routineDeleted = QTest::qWaitFor([routine]()-> bool {
+        return routine.isNull();
+    }, 5000);
+    ASSERT_TRUE(routineDeleted) << "routine not deleted (within time-out)";
+
+    EXPECT_EQ(buffer, QString("abE"));
+}
@@ -0,0 +1,64 @@
+#include <atomic>
+#include <QEventLoop>
+#include <QThread>
+#include <QTimer>
+#include <gtest/gtest.h>
+#include "utilities/background_job.h"
+
+TEST(BackgroundJob, RunAndFinish) {
+    QObject context;
+    BackgroundJob job;
+    EXPECT_FALSE(job.isRunning());
+
+    QEventLoop loop;
+    QThread *functionThread = nullptr;
+    bool finished = false;
+    job.start(
+            [&functionThread](const std::atomic<bool> &/*canceled*/) {
+                functionThread = QThread::currentThread();
+            },
+            // onFinished
+            [&]() {
+                finished = true;
+                EXPECT_EQ(QThread::currentThread(), context.thread());
+                EXPECT_FALSE(job.isRunning());
+                loop.quit();
+            },
+            &context
+    );
+    QTimer::singleShot(5000, &loop, &QEventLoop::quit);
+    loop.exec();
+
+    EXPECT_TRUE(finished);
+    EXPECT_NE(functionThread, nullptr);
+    EXPECT_NE(functionThread, QThread::currentThread());
+
+    // can be started again after finished
+    std::atomic<int> runsCount {0};
+    job.start([&runsCount](const std::atomic<bool> &/*canceled*/) {
+        ++runsCount;
+    });
+    while (job.isRunning())
+        QThread::msleep(1);
+    EXPECT_EQ(runsCount, 1);
+}
+
+TEST(BackgroundJob, CancelOnDestruction) {
+    std::atomic<bool> started {false};
+    std::atomic<bool> sawCanceled {false};
+    {
+        BackgroundJob job;
+        job.start([&](const std::atomic<bool> &canceled) {
+            started = true;
+            while (!canceled)
+                QThread::msleep(1);
+            sawCanceled = true;
+        });
+        while (!started)
+            QThread::msleep(1);
+        EXPECT_TRUE(job.isRunning());
+        EXPECT_FALSE(job.isCanceled());
+    } // (the destructor cancels & waits)
+
+    EXPECT_TRUE(sawCanceled);
+}
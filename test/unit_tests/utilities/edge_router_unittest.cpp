@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include "utilities/edge_router.h"
+#include "utilities/rect_tree.h"
+
+namespace {
+RectTree makeIndex(const QVector<QRectF> &rects) {
+    RectTree index;
+    for (int i = 0; i < rects.count(); ++i)
+        index.set(i, rects.at(i));
+    return index;
+}
+
+QVector<QPointF> getPolyline(
+        const QRectF &startRect, const QVector<QPointF> &joints, const QRectF &endRect) {
+    return QVector<QPointF> {startRect.center()} + joints + QVector<QPointF> {endRect.center()};
+}
+
+bool isOrthogonal(const QVector<QPointF> &polyline) {
+    for (int i = 0; i + 1 < polyline.count(); ++i) {
+        if (polyline.at(i).x() != polyline.at(i + 1).x()
+                && polyline.at(i).y() != polyline.at(i + 1).y()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool crossesRect(const QVector<QPointF> &polyline, const QRectF &rect) {
+    for (int i = 0; i + 1 < polyline.count(); ++i) {
+        // (segments are orthogonal)
+        const QRectF segmentRect = QRectF(polyline.at(i), polyline.at(i + 1)).normalized();
+        const bool overlapsX
+                = segmentRect.left() < rect.right() && rect.left() < segmentRect.right();
+        const bool overlapsY
+                = segmentRect.top() < rect.bottom() && rect.top() < segmentRect.bottom();
+        const bool insideX = rect.left() < segmentRect.left() && segmentRect.left() < rect.right();
+        const bool insideY = rect.top() < segmentRect.top() && segmentRect.top() < rect.bottom();
+        if ((overlapsX && insideY) || (overlapsY && insideX))
+            return true;
+    }
+    return false;
+}
+} // namespace
+
+TEST(EdgeRouter, StraightLineNotRouted) {
+    const QRectF startRect(0, 0, 100, 60);
+    const QRectF endRect(600, 200, 100, 60);
+    const RectTree index = makeIndex({startRect, endRect, QRectF(300, 400, 100, 60)});
+
+    EXPECT_TRUE(EdgeRouter::computeRoute(index, startRect, endRect, {}).isEmpty());
+}
+
+TEST(EdgeRouter, RouteAroundObstacles) {
+    const QRectF startRect(0, 0, 100, 60);
+    const QRectF endRect(600, 0, 100, 60);
+    const QVector<QRectF> obstacles {
+        QRectF(250, -100, 100, 260),
+        QRectF(420, -20, 60, 100)
+    };
+    const RectTree index = makeIndex(QVector<QRectF> {startRect, endRect} + obstacles);
+
+    const EdgeRouter::Parameters parameters;
+    const auto joints = EdgeRouter::computeRoute(index, startRect, endRect, parameters);
+    ASSERT_FALSE(joints.isEmpty());
+
+    const auto polyline = getPolyline(startRect, joints, endRect);
+    EXPECT_TRUE(isOrthogonal(polyline));
+    const double m = parameters.obstacleMargin - 1; // (clearance kept by the route)
+    for (const QRectF &obstacle: obstacles)
+        EXPECT_FALSE(crossesRect(polyline, obstacle.marginsAdded(QMarginsF(m, m, m, m))));
+
+    // the route leaves the start rect & enters the end rect along their center lines
+    EXPECT_FALSE(startRect.contains(joints.first()));
+    EXPECT_FALSE(endRect.contains(joints.last()));
+    EXPECT_TRUE(joints.first().x() == startRect.center().x()
+                || joints.first().y() == startRect.center().y());
+    EXPECT_TRUE(joints.last().x() == endRect.center().x()
+                || joints.last().y() == endRect.center().y());
+}
+
+TEST(EdgeRouter, IgnoreEnclosingRects) {
+    const QRectF startRect(0, 0, 100, 60);
+    const QRectF endRect(600, 0, 100, 60);
+    const QRectF groupRect(-50, -100, 800, 300); // encloses both
+    const QRectF obstacle(250, -50, 100, 160);
+
+    // only the group-box
+    {
+        const RectTree index = makeIndex({startRect, endRect, groupRect});
+        EXPECT_TRUE(EdgeRouter::computeRoute(index, startRect, endRect, {}).isEmpty());
+    }
+
+    // the group-box & an obstacle in it
+    {
+        const RectTree index = makeIndex({startRect, endRect, groupRect, obstacle});
+        const auto joints = EdgeRouter::computeRoute(index, startRect, endRect, {});
+        ASSERT_FALSE(joints.isEmpty());
+
+        const auto polyline = getPolyline(startRect, joints, endRect);
+        EXPECT_TRUE(isOrthogonal(polyline));
+        EXPECT_FALSE(crossesRect(polyline, obstacle));
+    }
+}
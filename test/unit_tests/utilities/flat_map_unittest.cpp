@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+#include <QString>
+#include "utilities/flat_map.h"
+
+TEST(FlatMap, InsertLookupRemove) {
+    FlatMap<int, QString> map;
+    EXPECT_TRUE(map.isEmpty());
+    EXPECT_FALSE(map.contains(1));
+    EXPECT_EQ(map.value(1, "x"), "x");
+
+    map.insert(3, "c");
+    map.insert(1, "a");
+    map.insert(2, "b");
+    EXPECT_EQ(map.count(), 3);
+    EXPECT_TRUE(map.contains(2));
+    EXPECT_EQ(map.value(1), "a");
+    EXPECT_EQ(map.value(3), "c");
+    EXPECT_EQ(map.value(4), QString());
+
+    // replace
+    map.insert(2, "bb");
+    EXPECT_EQ(map.count(), 3);
+    EXPECT_EQ(map.value(2), "bb");
+
+    // items are sorted by key
+    QVector<int> keys;
+    for (const auto &[key, value]: map)
+        keys << key;
+    EXPECT_EQ(keys, (QVector<int> {1, 2, 3}));
+
+    // remove
+    EXPECT_TRUE(map.remove(1));
+    EXPECT_FALSE(map.remove(1));
+    EXPECT_EQ(map.count(), 2);
+    EXPECT_FALSE(map.contains(1));
+    EXPECT_TRUE(map.contains(3));
+
+    map.clear();
+    EXPECT_TRUE(map.isEmpty());
+}
@@ -0,0 +1,112 @@
+#include <cmath>
+#include <QThreadPool>
+#include <gtest/gtest.h>
+#include "utilities/force_directed_layout.h"
+
+namespace {
+ForceDirectedLayout::Input makeInput(const int boxesCount) {
+    ForceDirectedLayout::Input input;
+    for (int i = 0; i < boxesCount; ++i) {
+        input.boxRects << QRectF((i * 37) % 500, (i * 53) % 400, 100 + 10 * (i % 3), 60);
+        input.boxParentGroups << -1;
+    }
+    return input;
+}
+
+QRectF boundingRect(const QVector<QRectF> &rects) {
+    QRectF result;
+    for (const QRectF &rect: rects)
+        result = result.isNull() ? rect : result.united(rect);
+    return result;
+}
+
+bool hasOverlap(const QVector<QRectF> &rects) {
+    for (int i = 0; i < rects.count(); ++i) {
+        for (int j = i + 1; j < rects.count(); ++j) {
+            if (rects.at(i).intersects(rects.at(j)))
+                return true;
+        }
+    }
+    return false;
+}
+
+double distance(const QRectF &rect1, const QRectF &rect2) {
+    const QPointF d = rect1.center() - rect2.center();
+    return std::sqrt(QPointF::dotProduct(d, d));
+}
+} // namespace
+
+TEST(ForceDirectedLayout, SizesAndNoOverlap) {
+    auto input = makeInput(50);
+    for (int i = 0; i + 1 < 50; i += 2)
+        input.edges << std::make_pair(i, i + 1);
+
+    QThreadPool threadPool;
+    const auto result = ForceDirectedLayout::compute(input, {}, &threadPool);
+
+    ASSERT_EQ(result.boxRects.count(), input.boxRects.count());
+    for (int i = 0; i < input.boxRects.count(); ++i)
+        EXPECT_EQ(result.boxRects.at(i).size(), input.boxRects.at(i).size());
+    EXPECT_FALSE(hasOverlap(result.boxRects));
+
+    // top-left corner of the bounding rect is kept
+    const QPointF d
+            = boundingRect(result.boxRects).topLeft() - boundingRect(input.boxRects).topLeft();
+    EXPECT_LT(std::abs(d.x()) + std::abs(d.y()), 1e-6);
+}
+
+TEST(ForceDirectedLayout, EdgesPullTogether) {
+    auto input = makeInput(3);
+    input.boxRects[0] = QRectF(0, 0, 100, 60);
+    input.boxRects[1] = QRectF(2000, 0, 100, 60);
+    input.boxRects[2] = QRectF(1000, 1000, 100, 60);
+    input.edges << std::make_pair(0, 1);
+
+    const auto result = ForceDirectedLayout::compute(input, {}, nullptr);
+
+    ASSERT_EQ(result.boxRects.count(), 3);
+    EXPECT_LT(distance(result.boxRects.at(0), result.boxRects.at(1)),
+              distance(result.boxRects.at(0), result.boxRects.at(2)));
+    EXPECT_LT(distance(result.boxRects.at(0), result.boxRects.at(1)),
+              distance(result.boxRects.at(1), result.boxRects.at(2)));
+}
+
+TEST(ForceDirectedLayout, GroupContainment) {
+    // groups: 0, 1 (in 0), 2 (empty); boxes 0-3 in group 0, 4-7 in group 1, others at top level
+    auto input = makeInput(16);
+    input.groupParents = {-1, 0, -1};
+    input.groupRects = {QRectF(), QRectF(), QRectF(0, 0, 200, 150)};
+    for (int i = 0; i < 8; ++i)
+        input.boxParentGroups[i] = (i < 4) ? 0 : 1;
+    input.edges << std::make_pair(0, 12) << std::make_pair(4, 13) << std::make_pair(5, 1);
+
+    ForceDirectedLayout::Parameters parameters;
+    parameters.groupMargins = QMarginsF(10, 30, 10, 10);
+    const auto result = ForceDirectedLayout::compute(input, parameters, nullptr);
+
+    ASSERT_EQ(result.boxRects.count(), 16);
+    ASSERT_EQ(result.groupRects.count(), 3);
+
+    for (int i = 0; i < 16; ++i) {
+        const bool inGroup0 = (i < 8);
+        const bool inGroup1 = (i >= 4 && i < 8);
+        EXPECT_EQ(result.groupRects.at(0).contains(result.boxRects.at(i)), inGroup0);
+        EXPECT_EQ(result.groupRects.at(1).intersects(result.boxRects.at(i)), inGroup1);
+        EXPECT_FALSE(result.groupRects.at(2).intersects(result.boxRects.at(i)));
+    }
+    EXPECT_TRUE(result.groupRects.at(0).contains(result.groupRects.at(1)));
+    EXPECT_FALSE(result.groupRects.at(0).intersects(result.groupRects.at(2)));
+    EXPECT_EQ(result.groupRects.at(2).size(), QSizeF(200, 150));
+
+    // margins
+    const QRectF contentsRect = boundingRect(result.boxRects.mid(4, 4));
+    EXPECT_EQ(result.groupRects.at(1), contentsRect.marginsAdded(parameters.groupMargins));
+}
+
+TEST(ForceDirectedLayout, Cancel) {
+    const auto input = makeInput(20);
+
+    const std::atomic<bool> canceled {true};
+    const auto result = ForceDirectedLayout::compute(input, {}, nullptr, &canceled);
+    EXPECT_TRUE(result.boxRects.isEmpty());
+}
@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+#include "utilities/label_rules_table.h"
+
+namespace {
+LabelRulesTable<int> makeTable(const QVector<std::pair<QString, int>> &rules) {
+    QVector<std::pair<Symbol, int>> symbolRules;
+    for (const auto &[label, value]: rules)
+        symbolRules << std::make_pair(Symbol(label), value);
+    return LabelRulesTable<int>(symbolRules);
+}
+} // namespace
+
+TEST(LabelRulesTable, LookUp) {
+    const auto table = makeTable({{"Person", 1}, {"Project", 2}, {"Person", 3}});
+
+    EXPECT_FALSE(table.isEmpty());
+    EXPECT_EQ(table.lookUp({}), nullptr);
+    EXPECT_EQ(table.lookUp(toSymbolSet(QStringList {"Other"})), nullptr);
+    EXPECT_EQ(table.value(toSymbolSet(QStringList {"Other"}), -1), -1);
+
+    // first rule of a label wins
+    EXPECT_EQ(table.value(toSymbolSet(QStringList {"Person"})), 1);
+    EXPECT_EQ(table.value(toSymbolSet(QStringList {"Project"})), 2);
+
+    // the rule of higher precedence applies
+    EXPECT_EQ(table.value(toSymbolSet(QStringList {"Project", "Person", "Other"})), 1);
+
+    EXPECT_TRUE(LabelRulesTable<int>().isEmpty());
+}
+
+TEST(LabelRulesTable, GivesSameResult) {
+    const auto table1 = makeTable({{"A", 1}, {"B", 2}, {"C", 3}});
+    const auto table2 = makeTable({{"X", 0}, {"A", 1}, {"C", 4}, {"B", 2}});
+
+    EXPECT_TRUE(table2.givesSameResult(table1, {}));
+    EXPECT_TRUE(table2.givesSameResult(table1, toSymbolSet(QStringList {"A", "C"})));
+    EXPECT_TRUE(table2.givesSameResult(table1, toSymbolSet(QStringList {"B"})));
+    EXPECT_FALSE(table2.givesSameResult(table1, toSymbolSet(QStringList {"C"})));
+    EXPECT_FALSE(table2.givesSameResult(table1, toSymbolSet(QStringList {"B", "C"})));
+    EXPECT_FALSE(table2.givesSameResult(table1, toSymbolSet(QStringList {"X"})));
+    EXPECT_FALSE(table1.givesSameResult(table2, toSymbolSet(QStringList {"X", "A"})));
+}
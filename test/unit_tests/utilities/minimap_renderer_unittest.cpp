@@ -0,0 +1,94 @@
+#include <QEventLoop>
+#include <QTimer>
+#include <gtest/gtest.h>
+#include "utilities/minimap_renderer.h"
+
+namespace {
+//!
+//! \return false if timed out
+//!
+bool waitForImageUpdated(MinimapRenderer *renderer, const int timeoutMsec = 5000) {
+    QEventLoop loop;
+    bool updated = false;
+    QObject::connect(renderer, &MinimapRenderer::imageUpdated, &loop, [&]() {
+        updated = true;
+        loop.quit();
+    });
+    QTimer::singleShot(timeoutMsec, &loop, &QEventLoop::quit);
+    loop.exec();
+    return updated;
+}
+
+void processEventsFor(const int msec) {
+    QEventLoop loop;
+    QTimer::singleShot(msec, &loop, &QEventLoop::quit);
+    loop.exec();
+}
+
+QColor pixelAt(const MinimapRenderer &renderer, const QPointF &scenePos) {
+    const QPointF p = renderer.mapFromScene(QRectF(scenePos, QSizeF(0, 0))).topLeft();
+    return renderer.getImage().pixelColor(int(p.x()), int(p.y()));
+}
+
+MinimapRenderer::Item makeItem(const QRectF &rect, const QColor &fillColor) {
+    MinimapRenderer::Item item;
+    item.rect = rect;
+    item.fillColor = fillColor;
+    return item;
+}
+} // namespace
+
+TEST(MinimapRenderer, RenderItems) {
+    MinimapRenderer renderer(QSize(100, 80));
+    renderer.setBackgroundColor(Qt::white);
+    renderer.setItem({1, 0}, makeItem(QRectF(0, 0, 400, 300), Qt::blue));
+    renderer.setItem({0, 0}, makeItem(QRectF(0, 0, 1000, 800), Qt::gray)); // drawn first
+    renderer.setItem({1, 1}, makeItem(QRectF(600, 500, 400, 300), Qt::red));
+    ASSERT_TRUE(waitForImageUpdated(&renderer));
+
+    EXPECT_TRUE(renderer.getSceneRect().contains(QRectF(0, 0, 1000, 800)));
+    EXPECT_EQ(pixelAt(renderer, {200, 150}), QColor(Qt::blue));
+    EXPECT_EQ(pixelAt(renderer, {800, 650}), QColor(Qt::red));
+    EXPECT_EQ(pixelAt(renderer, {500, 400}), QColor(Qt::gray));
+    EXPECT_EQ(renderer.getImage().pixelColor(0, 0), QColor(Qt::white));
+
+    // remove
+    renderer.removeItem({1, 1});
+    ASSERT_TRUE(waitForImageUpdated(&renderer));
+    EXPECT_EQ(pixelAt(renderer, {800, 650}), QColor(Qt::gray));
+}
+
+TEST(MinimapRenderer, OnlyDirtyTilesRendered) {
+    MinimapRenderer renderer(QSize(8 * MinimapRenderer::tileSize, 8 * MinimapRenderer::tileSize));
+    for (int i = 0; i < 400; ++i) {
+        const QRectF rect((i % 20) * 100, (i / 20) * 100, 60, 40);
+        renderer.setItem({0, i}, makeItem(rect, Qt::darkGreen));
+    }
+    ASSERT_TRUE(waitForImageUpdated(&renderer));
+    const int tilesCount1 = renderer.getRenderedTilesCount();
+    EXPECT_EQ(tilesCount1, 64);
+
+    // move one item a little
+    renderer.setItem({0, 0}, makeItem(QRectF(10, 10, 60, 40), Qt::darkGreen));
+    ASSERT_TRUE(waitForImageUpdated(&renderer));
+    const int tilesCount2 = renderer.getRenderedTilesCount();
+    EXPECT_GT(tilesCount2, tilesCount1);
+    EXPECT_LE(tilesCount2 - tilesCount1, 4);
+
+    // no change
+    renderer.setItem({0, 0}, makeItem(QRectF(10, 10, 60, 40), Qt::darkGreen));
+    processEventsFor(MinimapRenderer::delayMsec * 4);
+    EXPECT_EQ(renderer.getRenderedTilesCount(), tilesCount2);
+}
+
+TEST(MinimapRenderer, Paused) {
+    MinimapRenderer renderer(QSize(64, 64));
+    renderer.setPaused(true);
+    renderer.setItem({0, 0}, makeItem(QRectF(0, 0, 100, 100), Qt::red));
+    processEventsFor(MinimapRenderer::delayMsec * 4);
+    EXPECT_EQ(renderer.getRenderedTilesCount(), 0);
+
+    renderer.setPaused(false);
+    ASSERT_TRUE(waitForImageUpdated(&renderer));
+    EXPECT_EQ(pixelAt(renderer, {50, 50}), QColor(Qt::red));
+}
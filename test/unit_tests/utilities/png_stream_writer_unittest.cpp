@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include <QDir>
+#include <QImage>
+#include <QVector>
+#include "utilities/png_stream_writer.h"
+
+TEST(PngStreamWriter, WritesReadableImage) {
+    constexpr int width = 333;
+    constexpr int height = 257;
+
+    QImage expected(width, height, QImage::Format_ARGB32);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            if (x < 100)
+                expected.setPixel(x, y, qRgba((x * 3) & 0xFF, y & 0xFF, (x ^ y) & 0xFF, 255));
+            else if (x < 200)
+                expected.setPixel(x, y, qRgba(0x33, 0x66, 0x99, 255));
+            else
+                expected.setPixel(x, y, qRgba(x & 0xFF, (x * y) & 0xFF, 7, 128));
+        }
+    }
+
+    // write the rows in pieces of various heights
+    const QString filePath = QDir::temp().filePath("png_stream_writer_unittest.png");
+    PngStreamWriter writer;
+    ASSERT_TRUE(writer.open(filePath, expected.size()));
+
+    int y = 0;
+    int pieceHeight = 1;
+    while (y < height) {
+        const int h = std::min(pieceHeight, height - y);
+        EXPECT_TRUE(writer.appendRows(expected.copy(0, y, width, h)));
+        y += h;
+        pieceHeight = pieceHeight * 2 + 1;
+    }
+    EXPECT_FALSE(writer.appendRows(expected.copy(0, 0, width, 1))); // (too many rows)
+    ASSERT_TRUE(writer.finish());
+
+    //
+    QImage image;
+    ASSERT_TRUE(image.load(filePath, "PNG"));
+    EXPECT_EQ(image.convertToFormat(QImage::Format_ARGB32), expected);
+
+    QFile::remove(filePath);
+}
+
+TEST(PngStreamWriter, UnpremultipliesPixels) {
+    // columns of different alphas, including 0
+    const QVector<int> alphas {255, 200, 128, 17, 0};
+    constexpr int columnWidth = 4;
+
+    QImage premultiplied(alphas.count() * columnWidth, 10, QImage::Format_ARGB32_Premultiplied);
+    for (int y = 0; y < premultiplied.height(); ++y) {
+        for (int x = 0; x < premultiplied.width(); ++x) {
+            const int alpha = alphas.at(x / columnWidth);
+            premultiplied.setPixel(x, y, qPremultiply(qRgba(200, 100, 50, alpha)));
+        }
+    }
+
+    const QString filePath = QDir::temp().filePath("png_stream_writer_unittest_2.png");
+    PngStreamWriter writer;
+    ASSERT_TRUE(writer.open(filePath, premultiplied.size()));
+    EXPECT_TRUE(writer.appendRows(premultiplied));
+    ASSERT_TRUE(writer.finish());
+
+    QImage image;
+    ASSERT_TRUE(image.load(filePath, "PNG"));
+    image = image.convertToFormat(QImage::Format_ARGB32);
+    ASSERT_EQ(image.size(), premultiplied.size());
+
+    for (int y = 0; y < image.height(); ++y) {
+        for (int x = 0; x < image.width(); ++x) {
+            const QRgb pixel = image.pixel(x, y);
+            EXPECT_EQ(pixel, qUnpremultiply(premultiplied.pixel(x, y)));
+
+            const int alpha = alphas.at(x / columnWidth);
+            EXPECT_EQ(qAlpha(pixel), alpha);
+            if (alpha >= 128) { // (the color is recovered up to rounding)
+                EXPECT_NEAR(qRed(pixel), 200, 2);
+                EXPECT_NEAR(qGreen(pixel), 100, 2);
+                EXPECT_NEAR(qBlue(pixel), 50, 2);
+            }
+        }
+    }
+
+    QFile::remove(filePath);
+}
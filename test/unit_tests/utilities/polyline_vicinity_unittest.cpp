@@ -0,0 +1,56 @@
+#include <random>
+#include <gtest/gtest.h>
+#include "utilities/geometry_util.h"
+#include "utilities/polyline_vicinity.h"
+
+TEST(PolylineVicinity, Basics) {
+    PolylineVicinity vicinity(4);
+    EXPECT_EQ(vicinity.boundingRect(), QRectF());
+    EXPECT_FALSE(vicinity.contains(QPointF(0, 0)));
+
+    // start (0, 0) -> joint (100, 0) -> end (100, 100)
+    vicinity.setPoints({QPointF(0, 0), QPointF(100, 0), QPointF(100, 100)});
+    EXPECT_EQ(vicinity.boundingRect(), QRectF(-4, -4, 108, 108));
+
+    EXPECT_TRUE(vicinity.contains(QPointF(50, 3.9)));
+    EXPECT_FALSE(vicinity.contains(QPointF(50, 4.1)));
+    EXPECT_FALSE(vicinity.contains(QPointF(-1, 0))); // beyond the start point
+    EXPECT_TRUE(vicinity.contains(QPointF(103.9, 50)));
+
+    // the square around the joint covers the corner
+    EXPECT_TRUE(vicinity.contains(QPointF(103.5, -3.5)));
+    EXPECT_EQ(vicinity.findJointAt(QPointF(103.5, -3.5)), 0);
+    EXPECT_EQ(vicinity.findJointAt(QPointF(50, 0)), -1);
+
+    EXPECT_EQ(vicinity.findSegmentAt(QPointF(50, 1)), 0);
+    EXPECT_EQ(vicinity.findSegmentAt(QPointF(99, 50)), 1);
+    EXPECT_EQ(vicinity.findSegmentAt(QPointF(50, 50)), -1);
+
+    // degenerate segment
+    vicinity.setPoints({QPointF(10, 10), QPointF(10, 10)});
+    EXPECT_FALSE(vicinity.contains(QPointF(10, 10)));
+}
+
+TEST(PolylineVicinity, AgreesWithPath) {
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> posDist(0, 200);
+    std::uniform_int_distribution<int> jointsCountDist(0, 3);
+
+    PolylineVicinity vicinity(4);
+    for (int round = 0; round < 50; ++round) {
+        QVector<QPointF> points;
+        const int jointsCount = jointsCountDist(gen);
+        for (int i = 0; i < jointsCount + 2; ++i)
+            points << QPointF(posDist(gen), posDist(gen));
+        vicinity.setPoints(points);
+
+        const QPainterPath path = vicinity.path();
+        EXPECT_TRUE(vicinity.boundingRect().contains(path.boundingRect()));
+
+        for (int i = 0; i < 200; ++i) {
+            const QPointF p(posDist(gen), posDist(gen));
+            EXPECT_EQ(vicinity.contains(p), path.contains(p))
+                    << "at (" << p.x() << ", " << p.y() << ")";
+        }
+    }
+}
@@ -0,0 +1,93 @@
+#include <cmath>
+#include <random>
+#include <gtest/gtest.h>
+#include <QHash>
+#include <QSet>
+#include "utilities/rect_tree.h"
+
+TEST(RectTree, Basics) {
+    RectTree tree;
+    EXPECT_EQ(tree.count(), 0);
+    EXPECT_EQ(tree.boundingRect(), QRectF());
+    EXPECT_TRUE(tree.queryIntersecting(QRectF(0, 0, 100, 100)).isEmpty());
+
+    tree.set(1, QRectF(0, 0, 100, 100));
+    tree.set(2, QRectF(10, 10, 20, 20));
+    tree.set(3, QRectF(200, 0, 50, 50));
+    EXPECT_EQ(tree.count(), 3);
+    EXPECT_EQ(tree.boundingRect(), QRectF(0, 0, 250, 100));
+
+    EXPECT_EQ(tree.queryContaining(QRectF(15, 15, 5, 5)), (QSet<int> {1, 2}));
+    EXPECT_EQ(tree.queryContaining(QRectF(50, 50, 5, 5)), QSet<int> {1});
+    EXPECT_EQ(tree.queryIntersecting(QRectF(90, 0, 120, 10)), (QSet<int> {1, 3}));
+    EXPECT_EQ(tree.queryContainedIn(QRectF(5, -5, 300, 110)), (QSet<int> {2, 3}));
+    EXPECT_EQ(tree.queryContainedIn(QRectF(15, -5, 300, 110)), QSet<int> {3});
+
+    // update & remove
+    tree.set(3, QRectF(-100, -100, 10, 10));
+    EXPECT_EQ(tree.getRect(3), QRectF(-100, -100, 10, 10));
+    EXPECT_EQ(tree.boundingRect(), QRectF(-100, -100, 200, 200));
+
+    tree.remove(1);
+    tree.remove(1); // no effect
+    EXPECT_FALSE(tree.contains(1));
+    EXPECT_EQ(tree.queryContaining(QRectF(15, 15, 5, 5)), QSet<int> {2});
+    EXPECT_EQ(tree.boundingRect(), QRectF(-100, -100, 130, 130));
+
+    tree.clear();
+    EXPECT_EQ(tree.count(), 0);
+    EXPECT_EQ(tree.height(), 0);
+}
+
+TEST(RectTree, AgreesWithLinearScan) {
+    std::mt19937 gen(2024);
+    std::uniform_real_distribution<double> posDist(0, 2000);
+    std::uniform_real_distribution<double> sizeDist(1, 200);
+    auto randomRect = [&]() {
+        return QRectF(posDist(gen), posDist(gen), sizeDist(gen), sizeDist(gen));
+    };
+
+    RectTree tree;
+    QHash<int, QRectF> idToRect;
+
+    for (int step = 0; step < 5000; ++step) {
+        const int id = static_cast<int>(gen() % 300);
+        if (gen() % 3 != 0) {
+            const QRectF rect = randomRect();
+            tree.set(id, rect);
+            idToRect.insert(id, rect);
+        }
+        else {
+            tree.remove(id);
+            idToRect.remove(id);
+        }
+
+        if (step % 50 != 0)
+            continue;
+
+        const QRectF queryRect = randomRect();
+        const QRectF smallRect(queryRect.topLeft(), QSizeF(5, 5));
+        QSet<int> expectedIntersecting;
+        QSet<int> expectedContaining;
+        QSet<int> expectedContainedIn;
+        QRectF expectedBoundingRect;
+        for (auto it = idToRect.constBegin(); it != idToRect.constEnd(); ++it) {
+            if (it.value().intersects(queryRect))
+                expectedIntersecting << it.key();
+            if (it.value().contains(smallRect))
+                expectedContaining << it.key();
+            if (queryRect.contains(it.value()))
+                expectedContainedIn << it.key();
+            expectedBoundingRect = expectedBoundingRect.united(it.value());
+        }
+
+        ASSERT_EQ(tree.count(), idToRect.count());
+        ASSERT_EQ(tree.queryIntersecting(queryRect), expectedIntersecting) << "step " << step;
+        ASSERT_EQ(tree.queryContaining(smallRect), expectedContaining) << "step " << step;
+        ASSERT_EQ(tree.queryContainedIn(queryRect), expectedContainedIn) << "step " << step;
+        ASSERT_EQ(tree.boundingRect(), expectedBoundingRect) << "step " << step;
+    }
+
+    // balanced
+    EXPECT_LE(tree.height(), 4 * std::log2(tree.count() + 1));
+}
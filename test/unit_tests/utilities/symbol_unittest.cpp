@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+#include "utilities/symbol.h"
+
+TEST(Symbol, Interning) {
+    const Symbol a1("HAS_PART");
+    const Symbol a2(QString("HAS") + "_PART");
+    const Symbol b("DEPENDS_ON");
+
+    EXPECT_EQ(a1, a2);
+    EXPECT_EQ(a1.getId(), a2.getId());
+    EXPECT_NE(a1, b);
+
+    EXPECT_EQ(a1.toString(), "HAS_PART");
+    EXPECT_EQ(b.toString(), "DEPENDS_ON");
+
+    EXPECT_EQ(qHash(a1), qHash(a2));
+}
+
+TEST(Symbol, EmptyString) {
+    EXPECT_TRUE(Symbol().isEmpty());
+    EXPECT_EQ(Symbol(), Symbol(""));
+    EXPECT_EQ(Symbol(), Symbol(QString()));
+    EXPECT_EQ(Symbol().toString(), "");
+    EXPECT_FALSE(Symbol("x").isEmpty());
+}
+
+TEST(Symbol, SetConversions) {
+    const QSet<QString> strings {"Person", "Project", "Person2"};
+
+    const QSet<Symbol> symbols = toSymbolSet(strings);
+    EXPECT_EQ(symbols.count(), 3);
+    EXPECT_TRUE(symbols.contains(Symbol("Project")));
+    EXPECT_FALSE(symbols.contains(Symbol("Task")));
+
+    EXPECT_EQ(toStringSet(symbols), strings);
+    EXPECT_EQ(toSymbolSet(QStringList {"Person", "Project", "Person2", "Person"}), symbols);
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <QCoreApplication>
+#include <QPointer>
+#include <QTest>
+#include <QThread>
+#include "utilities/time_slicing.h"
+
+class TimeSlicingTest : public testing::Test
+{
+protected:
+    static void SetUpTestSuite() {
+        app = QCoreApplication::instance();
+        Q_ASSERT(app != nullptr);
+    }
+
+    inline static QCoreApplication *app = nullptr; // for convenience
+};
+
+TEST_F(TimeSlicingTest, ProcessesAllItemsInSlices) {
+    constexpr int itemCount = 20;
+    int processedCount = 0;
+    int sliceCount = 0;
+    bool finished = false;
+
+    runInTimeSlices(
+            // processNext
+            [&processedCount]() {
+                QThread::msleep(2);
+                ++processedCount;
+                return processedCount < itemCount;
+            },
+            10,
+            // onSliceFinished
+            [&sliceCount]() { ++sliceCount; },
+            // onFinished
+            [&finished]() { finished = true; },
+            app
+    );
+
+    const bool ok = QTest::qWaitFor([&finished]() { return finished; }, 5000);
+    ASSERT_TRUE(ok) << "not finished (within time-out)";
+
+    EXPECT_EQ(processedCount, itemCount);
+    EXPECT_GT(sliceCount, 1);
+    EXPECT_LT(sliceCount, itemCount);
+}
+
+TEST_F(TimeSlicingTest, YieldsToEventLoopBetweenSlices) {
+    int processedCount = 0;
+    int processedCountWhenEventHandled = -1;
+    bool finished = false;
+
+    runInTimeSlices(
+            // processNext
+            [&processedCount]() {
+                QThread::msleep(2);
+                ++processedCount;
+                return processedCount < 20;
+            },
+            5,
+            nullptr,
+            // onFinished
+            [&finished]() { finished = true; },
+            app
+    );
+
+    // posted after the first slice, handled before the last one
+    QMetaObject::invokeMethod(app, [&]() {
+        processedCountWhenEventHandled = processedCount;
+    }, Qt::QueuedConnection);
+
+    const bool ok = QTest::qWaitFor([&finished]() { return finished; }, 5000);
+    ASSERT_TRUE(ok) << "not finished (within time-out)";
+
+    EXPECT_GT(processedCountWhenEventHandled, 0);
+    EXPECT_LT(processedCountWhenEventHandled, 20);
+}
+
+TEST_F(TimeSlicingTest, StopsWhenContextDestroyed) {
+    auto *context = new QObject(app);
+    int processedCount = 0;
+    bool finished = false;
+
+    runInTimeSlices(
+            // processNext
+            [&processedCount]() {
+                QThread::msleep(2);
+                ++processedCount;
+                return true; // never ends
+            },
+            5,
+            nullptr,
+            // onFinished
+            [&finished]() { finished = true; },
+            context
+    );
+    delete context;
+
+    const int countAfterFirstSlice = processedCount;
+    QTest::qWait(50);
+
+    EXPECT_EQ(processedCount, countAfterFirstSlice);
+    EXPECT_FALSE(finished);
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include "utilities/trace_recorder.h"
+
+TEST(TraceRecorder, NotRecording) {
+    TraceRecorder *recorder = TraceRecorder::instance();
+    ASSERT_FALSE(recorder->isRecording());
+
+    EXPECT_EQ(recorder->beginSpan("a", "test"), -1);
+    recorder->endSpan(-1);
+    EXPECT_FALSE(recorder->finish());
+}
+
+TEST(TraceRecorder, WriteFile) {
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString filePath = dir.filePath("trace.json");
+
+    TraceRecorder *recorder = TraceRecorder::instance();
+    recorder->start(filePath);
+    ASSERT_TRUE(recorder->isRecording());
+
+    const int span1 = recorder->beginSpan("span1", "test");
+    const int span2 = recorder->beginSpan("span2", "db");
+    recorder->addInstantEvent("mark", "test");
+    recorder->endSpan(span1);
+    recorder->endSpan(span1); // no effect
+    recorder->beginSpan("not-ended", "test");
+    recorder->endSpan(span2);
+
+    ASSERT_TRUE(recorder->finish());
+    EXPECT_FALSE(recorder->isRecording());
+
+    //
+    QFile file(filePath);
+    ASSERT_TRUE(file.open(QIODevice::ReadOnly));
+    const QJsonObject obj = QJsonDocument::fromJson(file.readAll()).object();
+    const QJsonArray events = obj.value("traceEvents").toArray();
+
+    QStringList phasesAndNames;
+    double lastTimestamp = 0;
+    for (const auto &v: events) {
+        const QJsonObject event = v.toObject();
+        phasesAndNames << event.value("ph").toString() + ":" + event.value("name").toString();
+
+        const double timestamp = event.value("ts").toDouble();
+        EXPECT_GE(timestamp, lastTimestamp);
+        lastTimestamp = timestamp;
+
+        if (event.value("ph").toString() != "i")
+            EXPECT_TRUE(event.contains("id"));
+    }
+
+    EXPECT_EQ(
+            phasesAndNames,
+            QStringList({"b:span1", "b:span2", "i:mark", "e:span1", "e:span2"}));
+    EXPECT_EQ(events.at(1).toObject().value("cat").toString(), QString("db"));
+}
+
+TEST(TraceRecorder, CounterEvent) {
+    TraceRecorder *recorder = TraceRecorder::instance();
+    recorder->addCounterEvent("not recorded", "test", {{"a", 1.0}});
+
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    recorder->start(dir.filePath("trace.json"));
+    recorder->addCounterEvent("paint time", "test", {{"a", 1.5}, {"b", 2.0}});
+
+    const QJsonArray events = recorder->toJson().value("traceEvents").toArray();
+    ASSERT_TRUE(recorder->finish());
+
+    ASSERT_EQ(events.count(), 1);
+    const QJsonObject event = events.at(0).toObject();
+    EXPECT_EQ(event.value("ph").toString(), QString("C"));
+    EXPECT_EQ(event.value("name").toString(), QString("paint time"));
+    EXPECT_FALSE(event.contains("id"));
+
+    const QJsonObject args = event.value("args").toObject();
+    EXPECT_DOUBLE_EQ(args.value("a").toDouble(), 1.5);
+    EXPECT_DOUBLE_EQ(args.value("b").toDouble(), 2.0);
+}
@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include <QBuffer>
+#include <QXmlStreamReader>
+#include "utilities/vector_drawing.h"
+
+TEST(VectorDrawing, WrapText) {
+    VectorDrawing::Font font;
+    font.pixelSize = 10; // (estimated width of "aaa": 16.8, of " ": 3)
+
+    EXPECT_EQ(VectorDrawing::wrapText("aaa aaa aaa", font, 50),
+              (QStringList {"aaa aaa", "aaa"}));
+    EXPECT_EQ(VectorDrawing::wrapText("aaa aaa aaa", font, 20, 2),
+              (QStringList {"aaa", "aaa"}));
+
+    // a word wider than the width is broken
+    EXPECT_EQ(VectorDrawing::wrapText("aaaaaaaaaa", font, 30),
+              (QStringList {"aaaaa", "aaaaa"}));
+
+    // line breaks are kept
+    EXPECT_EQ(VectorDrawing::wrapText("a\n\nb", font, 100),
+              (QStringList {"a", "", "b"}));
+}
+
+TEST(VectorDrawing, WriteSvg) {
+    VectorDrawing drawing(QRectF(-10, -10, 200, 100));
+    drawing.setBackgroundColor(Qt::white);
+
+    drawing.beginClip(QRectF(0, 0, 50, 50));
+    drawing.addFilledRect(QRectF(0, 0, 50, 50), 4, QColor(255, 0, 0, 128));
+    drawing.addText(QPointF(2, 2), "<a & b>", VectorDrawing::Font(), Qt::black);
+    drawing.endClip();
+    drawing.addPolyline({QPointF(0, 0), QPointF(100, 50)}, Qt::blue, 2);
+    EXPECT_EQ(drawing.getOperationsCount(), 5);
+
+    //
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    QString errorMsg;
+    ASSERT_TRUE(drawing.writeSvg(&buffer, &errorMsg));
+    buffer.close();
+
+    //
+    QXmlStreamReader reader(buffer.data());
+    QStringList elementNames;
+    QString text;
+    QString viewBox;
+    while (!reader.atEnd()) {
+        reader.readNext();
+        if (!reader.isStartElement())
+            continue;
+        elementNames << reader.name().toString();
+        if (reader.name() == QLatin1String("svg"))
+            viewBox = reader.attributes().value("viewBox").toString();
+        else if (reader.name() == QLatin1String("text"))
+            text = reader.readElementText();
+    }
+    ASSERT_FALSE(reader.hasError());
+
+    EXPECT_EQ(viewBox, "-10 -10 200 100");
+    EXPECT_EQ(elementNames,
+              (QStringList {"svg", "rect", "clipPath", "rect", "g", "rect", "text", "polyline"}));
+    EXPECT_EQ(text, "<a & b>");
+}
@@ -0,0 +1,106 @@
+#include <QPainter>
+#include <QRegion>
+#include <gtest/gtest.h>
+#include "utilities/viewport_tile_cache.h"
+
+namespace {
+//!
+//! A 300x200 image, with its left half blue & right half red.
+//!
+QImage makeViewportImage() {
+    QImage image(300, 200, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::blue);
+    QPainter painter(&image);
+    painter.fillRect(QRect(150, 0, 150, 200), Qt::red);
+    return image;
+}
+
+QImage drawToImage(
+        const ViewportTileCache &cache, const QSize &viewSize,
+        const QPointF &viewTopLeft, const double viewScale, int *drawnCount = nullptr) {
+    QImage image(viewSize, QImage::Format_ARGB32_Premultiplied);
+    QPainter painter(&image);
+    const int count = cache.draw(&painter, viewSize, viewTopLeft, viewScale, Qt::white);
+    if (drawnCount != nullptr)
+        *drawnCount = count;
+    return image;
+}
+} // namespace
+
+TEST(ViewportTileCache, Capture) {
+    ViewportTileCache cache;
+    EXPECT_TRUE(cache.isEmpty());
+
+    cache.capture(makeViewportImage(), {0, 0}, 1.0);
+    EXPECT_EQ(cache.getViewSize(), QSize(300, 200));
+    EXPECT_EQ(cache.getTilesCount(), 3 * 2);
+
+    cache.clear();
+    EXPECT_TRUE(cache.isEmpty());
+}
+
+TEST(ViewportTileCache, DrawAtSameView) {
+    ViewportTileCache cache;
+    cache.capture(makeViewportImage(), {1000, 500}, 0.5);
+
+    int drawnCount;
+    const QImage image = drawToImage(cache, {300, 200}, {1000, 500}, 0.5, &drawnCount);
+    EXPECT_EQ(drawnCount, cache.getTilesCount());
+    EXPECT_EQ(image.pixelColor(10, 10), QColor(Qt::blue));
+    EXPECT_EQ(image.pixelColor(140, 190), QColor(Qt::blue));
+    EXPECT_EQ(image.pixelColor(160, 10), QColor(Qt::red));
+    EXPECT_EQ(image.pixelColor(290, 190), QColor(Qt::red));
+}
+
+TEST(ViewportTileCache, DrawZoomedAndPanned) {
+    ViewportTileCache cache;
+    cache.capture(makeViewportImage(), {0, 0}, 1.0);
+
+    // zoom in by 2 about the view's center (150, 100)
+    const double scale = 2.0;
+    const QPointF center(150, 100);
+    const QPointF topLeft = center - QPointF(150, 100) / scale;
+    EXPECT_EQ(cache.mapToView(center, topLeft, scale), center);
+
+    int drawnCount;
+    QImage image = drawToImage(cache, {300, 200}, topLeft, scale, &drawnCount);
+    EXPECT_LT(drawnCount, cache.getTilesCount()); // (the corner tiles are outside the view)
+    EXPECT_EQ(image.pixelColor(140, 100), QColor(Qt::blue));
+    EXPECT_EQ(image.pixelColor(160, 100), QColor(Qt::red));
+
+    // zoom out by 2 about the view's top-left corner
+    image = drawToImage(cache, {300, 200}, {0, 0}, 0.5);
+    EXPECT_EQ(image.pixelColor(70, 50), QColor(Qt::blue));
+    EXPECT_EQ(image.pixelColor(80, 50), QColor(Qt::red));
+    EXPECT_EQ(image.pixelColor(200, 150), QColor(Qt::white)); // (not covered)
+
+    // pan entirely away
+    image = drawToImage(cache, {300, 200}, {1000, 0}, 1.0, &drawnCount);
+    EXPECT_EQ(drawnCount, 0);
+    EXPECT_EQ(image.pixelColor(150, 100), QColor(Qt::white));
+}
+
+TEST(ViewportTileCache, DevicePixelRatio) {
+    QImage image(600, 400, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::green);
+    image.setDevicePixelRatio(2.0);
+
+    ViewportTileCache cache;
+    cache.capture(image, {0, 0}, 1.0);
+    EXPECT_EQ(cache.getViewSize(), QSize(300, 200));
+    EXPECT_EQ(cache.getTilesCount(), 3 * 2);
+}
+
+TEST(ViewportTileCache, TilesByDistance) {
+    const int n = ViewportTileCache::tileSize;
+    const QVector<QRect> tiles
+            = ViewportTileCache::computeTilesByDistance(QSize(3 * n, 2 * n + 10), {0, 0});
+    ASSERT_EQ(tiles.count(), 3 * 3);
+    EXPECT_EQ(tiles.first(), QRect(0, 0, n, n));
+    EXPECT_EQ(tiles.last(), QRect(2 * n, 2 * n, n, 10));
+
+    QRegion region;
+    for (const QRect &tile: tiles)
+        region += tile;
+    EXPECT_EQ(region, QRegion(0, 0, 3 * n, 2 * n + 10));
+}